@@ -39,6 +39,7 @@ enum BaseActionCodes_e {
     ACTION_CODE_LOBBY_CHAT        = 0x0A,    ///< Lobby chat message.
     ACTION_CODE_LOBBY_SWITCH_GAME = 0x0B,    ///< Switching to a mini-game.
     ACTION_CODE_JOIN_ERROR        = 0x0C,    ///< Error during join (e.g. duplicate name).
+    ACTION_CODE_BUNDLE            = 0x0D,    ///< Several server messages packed in one datagram (see BundleRecordHeader_St).
     
     ACTION_CODE_DISCOVERY_QUERY    = 0x10,    ///< Global server discovery query (broadcast).
     ACTION_CODE_DISCOVERY_INFO     = 0x11,    ///< Global server discovery response.
@@ -51,6 +52,16 @@ enum BaseActionCodes_e {
 */
 #define SERVER_PORT 8080
 
+/**
+    @brief Payload budget of one server datagram (a bundle, or a record sent alone).
+
+    1200 bytes keeps header + payload safely under a 1500-byte Ethernet MTU.
+    Modules that can emit large messages split them so that each record
+    (BundleRecordHeader_St included) fits: a larger one goes out alone and
+    IP-fragmented, lost entirely if any fragment is.
+*/
+#define BUNDLE_MTU 1200
+
 #pragma pack(push, 1)
 
 /**
@@ -63,6 +74,19 @@ typedef struct {
     bool isReliable;     ///< true if the message must be delivered reliably
 } GameTLVHeader_St;
 
+/**
+    @brief Prefix of each message inside an ACTION_CODE_BUNDLE datagram.
+
+    The bundle payload is a sequence of `[BundleRecordHeader_St][length bytes]`
+    records, each handled exactly as if it had arrived in its own datagram with
+    the same action and sender. Multi-byte fields are in network byte order.
+*/
+typedef struct {
+    u8   action;         ///< Action code the record would have had as a plain datagram
+    u16  senderId;       ///< Sender id the record would have had in RUDPHeader_St
+    u16  length;         ///< Size of the record payload that follows
+} BundleRecordHeader_St;
+
 /**
     @brief Shared structure for room information exchange.
 */
@@ -71,8 +95,23 @@ typedef struct {
     u16 playerCount;    ///< Current number of players
     char name[32];      ///< Display name
     char creator[32];   ///< Creator pseudo
+    u16 generation;     ///< Incarnation of the index, echoed back in SwitchGamePayload_St
 } RoomInfo_St;
 
+#define ROOM_ID_NEW 0xFFFF  ///< SwitchGamePayload_St.roomId asking the server to create a room
+
+/**
+    @brief Payload of ACTION_CODE_LOBBY_SWITCH_GAME, both directions (network byte order).
+
+    Room indices are recycled; the generation makes a stale id (from an old
+    room list) miss instead of landing in whatever room reuses the slot.
+*/
+typedef struct {
+    u8  gameId;         ///< MiniGameId_Et of the room
+    u16 roomId;         ///< Room index, or ROOM_ID_NEW
+    u16 generation;     ///< Generation of roomId (ignored for ROOM_ID_NEW)
+} SwitchGamePayload_St;
+
 #pragma pack(pop)
 
 /**
@@ -113,6 +152,20 @@ typedef void (*BroadcastMessage_Ft)(
 */
 );
 
+/**
+    @brief Per-tick context handed to GameServerInterface_St::onRoomTick.
+
+    The server fills dt, roomId and broadcast before the call. The module
+    may set sleepMs to skip ticks until it has work again; any action or
+    player leave for the room wakes it early.
+*/
+typedef struct {
+    f32                 dt;         ///< Real seconds elapsed since this room's previous tick
+    s32                 roomId;     ///< Room being ticked
+    BroadcastMessage_Ft broadcast;  ///< Same callback as the one given to onAction
+    u32                 sleepMs;    ///< Out: minimum delay before the next tick (0 = next server tick)
+} ServerTickContext_St;
+
 /**
     @brief Server-side game module interface (per-room game instance)
 */
@@ -145,7 +198,14 @@ typedef struct {
         BroadcastMessage_Ft broadcast
     );
 
-    void (*onTick)(void* state);               ///< Main server tick / simulation step
+    void (*onTick)(void* state);               ///< Legacy tick, called every server tick when onRoomTick is NULL
+
+    /**
+        @brief Main server tick / simulation step, preferred over onTick
+        @param state        Game instance
+        @param ctx          Elapsed time, room and broadcast callback; set ctx->sleepMs to lower the tick rate
+    */
+    void (*onRoomTick)(void* state, ServerTickContext_St* ctx);
 
     /**
         @brief Called when a player disconnects or leaves the room
@@ -159,6 +219,18 @@ typedef struct {
         @param state        Pointer previously returned by createInstance
     */
     void (*destroyInstance)(void* state);
+
+    /**
+        @name Pooled instances (optional)
+        When instanceSize and initInstance are set, the server carves the
+        state from a per-game slab pool and uses these instead of
+        createInstance / destroyInstance.
+        @{
+    */
+    u32  instanceSize;                      ///< Size of the state block
+    void (*initInstance)(void* state);      ///< Initializes a zeroed block in place
+    void (*releaseInstance)(void* state);   ///< Frees what the state owns, not the block itself (may be NULL)
+    /** @} */
 } GameServerInterface_St;
 
 #endif // NETWORK_INTERFACE_H
@@ -30,11 +30,27 @@
 */
 #define MAX_SEQUENCE    65535u  ///< 16-bit sequence number wrap-around value
 #define HISTORY_SIZE    32      ///< Number of previous packets tracked in ack bitfield
-#define MAX_CLIENTS     8       ///< Maximum simultaneous clients per server instance
+#define MAX_CLIENTS     256     ///< Maximum simultaneous clients per server instance (also the network player id range)
+
+#define RUDP_SEND_WINDOW        HISTORY_SIZE    ///< Unacked reliable packets kept per connection
+#define RUDP_DELIVERY_WINDOW    4096            ///< Recent message sequences remembered to drop duplicate resends (multiple of 32)
+#define RUDP_MAX_PACKET_SIZE    2048            ///< Largest datagram (header + payload) that can be tracked for resend
+#define RUDP_MAX_RETRIES        10              ///< Resends before a reliable packet is declared lost
+#define RUDP_INITIAL_RTO_US     250000u         ///< Retransmission timeout before any RTT sample (250 ms)
+#define RUDP_MIN_RTO_US         20000u          ///< Lower RTO clamp (20 ms), keeps LAN jitter from causing spurious resends
+#define RUDP_MAX_RTO_US         2000000u        ///< Upper RTO clamp (2 s), also caps exponential backoff
+#define RUDP_RTO_GRANULARITY_US 10000u          ///< Minimum variance margin added to SRTT (RFC 6298 "G")
+#define RUDP_MAX_BACKOFF_SHIFT  2               ///< Per-packet timeout grows at most to RTO x 4
+
+#define RUDP_ACTION_ACK_ONLY    0x00            ///< Header-only packet carrying acknowledgments, never acked itself
 /** @} */
 
 /**
-    @brief Fixed-size reliable UDP header (exactly 11 bytes on wire: 2+2+4+2+1)
+    @brief Fixed-size reliable UDP header (exactly 13 bytes on wire: 2+2+4+2+1+2)
+
+    A resend goes out under a fresh `sequence`, so the peer's ack window always
+    reaches it; `messageSequence` keeps the sequence of the first send so the
+    peer delivers the message once.
 */
 #if defined(_MSC_VER)
 #pragma pack(push, 1)
@@ -46,27 +62,88 @@ typedef struct __attribute__((packed)) {
     u32 ackBitfield;   ///< Bitfield of the previous 32 packets (1 = received)
     u16 senderId;      ///< Unique sender identifier (assigned by server)
     u8  action;         ///< RUDP control action or game-specific command
+    u16 messageSequence; ///< Sequence of the message's first send (equals `sequence` unless resent)
 } RUDPHeader_St;
 
 #if defined(_MSC_VER)
 #pragma pack(pop)
 #endif
 
+/**
+    @brief Copy of a sent reliable datagram, kept until the peer acknowledges it.
+
+    The copy lives out of line and is sized to the largest datagram the slot
+    has tracked so far; it stays allocated for the next packet of the slot.
+*/
+typedef struct {
+    bool inUse;                         ///< Slot holds an unacked packet
+    u16  sequence;                      ///< Host-order sequence of the latest (re)send
+    u16  messageSequence;               ///< Host-order sequence of the first send
+    u8   retries;                       ///< Resends so far (0 = only the original send)
+    u16  length;                        ///< Bytes used in data
+    u16  capacity;                      ///< Bytes allocated for data
+    u64  firstSentUs;                   ///< Clock value of the original send
+    u64  lastSentUs;                    ///< Clock value of the latest (re)send
+    u8*  data;                          ///< Full datagram, header included (NULL until first used)
+} RUDPSentPacket_St;
+
 /**
     @brief Per-connection reliable UDP state (sender + receiver side)
+
+    The send window holds up to RUDP_SEND_WINDOW unacked reliable packets; a new
+    one arriving when it is full pushes out the oldest, which counts as lost.
+    Only packets registered with rudpTrackReliable() live in the window; unreliable
+    traffic only consumes a sequence number (bare acks do not even do that).
+
+    Each resend takes a fresh sequence number, so however much unreliable traffic
+    went out meanwhile, it lands inside the peer's ack window. The peer tells
+    messages apart by their first sequence (`deliveredHistory`), so a resend of a
+    message already received is acked but not delivered again.
 */
 typedef struct RUDPConnection_St {
     u16 local_sequence;     ///< Next sequence number to send
     u16 remote_sequence;    ///< Highest in-order sequence received from peer
     u32 receive_history;    ///< Bitfield tracking recently received packets
+    u32 deliveredHistory[RUDP_DELIVERY_WINDOW / 32]; ///< Messages delivered, by first sequence modulo RUDP_DELIVERY_WINDOW
+    bool ackPending;        ///< Peer sent something ack-worthy since our last outgoing header
+
+    RUDPSentPacket_St sendWindow[RUDP_SEND_WINDOW]; ///< Unacked reliable packets
+    u32 srttUs;             ///< Smoothed round-trip time (0 until the first sample)
+    u32 rttVarUs;           ///< Round-trip time variation
+    u32 rtoUs;              ///< Current retransmission timeout
+
+    u32 packetsAcked;           ///< Reliable packets retired by an ack
+    u32 packetsRetransmitted;   ///< Resends performed
+    u32 packetsLost;            ///< Reliable packets given up on
 } RUDPConnection_St;
 
+/**
+    @brief Monotonic clock used for RTT and timeouts, in microseconds.
+*/
+typedef u64 (*RUDPClock_Ft)(void);
+
+/**
+    @brief Callback used by rudpResendExpired() to put a datagram back on the wire.
+    @param userData     Opaque pointer given to rudpResendExpired()
+    @param data         Full datagram (header + payload)
+    @param length       Datagram size in bytes
+*/
+typedef void (*RUDPSend_Ft)(void* userData, const u8* data, u16 length);
+
 /**
     @brief Resets connection state to initial values
     @param conn     Connection state to initialize
+    @note A connection that tracked reliable packets must go through
+          rudpReleaseConnection() first, or its resend copies leak.
 */
 void rudpInitConnection(RUDPConnection_St* conn);
 
+/**
+    @brief Frees the resend copies of a connection (pending packets are dropped).
+    @param conn     Connection state, initialized or zeroed
+*/
+void rudpReleaseConnection(RUDPConnection_St* conn);
+
 /**
     @brief Prepares a new RUDP header using current connection state
     @param conn         Active connection state
@@ -81,13 +158,57 @@ void rudpGenerateHeader(
 
 /**
     @brief Processes an incoming RUDP header and updates connection state
+
+    A bare ack (RUDP_ACTION_ACK_ONLY) only retires acknowledged packets: its
+    sequence number is never recorded, so it cannot shadow a lost reliable packet.
+    A resend of a message already delivered is acked, but reported as a duplicate.
+
     @param conn         Connection state to update
     @param in_header    Received packet header (must remain valid)
-    @return             `true` if packet should be processed (new or needed), `false` if duplicate/old
+    @return             `true` if packet should be processed (new or needed) or is a bare ack, `false` if duplicate/old
 */
 bool rudpProcessIncoming(
     RUDPConnection_St*      conn,
     const RUDPHeader_St*    in_header
 );
 
+/**
+    @brief Registers an already-built datagram for retransmission until acked.
+
+    The datagram must start with a header produced by rudpGenerateHeader() on the
+    same connection. Call it for reliable messages only.
+
+    @param[in,out] conn         Connection the datagram is sent on
+    @param[in]     datagram     Full datagram (header + payload)
+    @param[in]     length       Datagram size in bytes
+    @return                     `false` if the datagram is too large to be tracked or out of memory
+*/
+bool rudpTrackReliable(RUDPConnection_St* conn, const u8* datagram, u16 length);
+
+/**
+    @brief Resends every tracked packet whose timeout expired.
+
+    Each resend takes a fresh sequence number, refreshes the piggybacked ack
+    fields, doubles the packet timeout (up to RTO << RUDP_MAX_BACKOFF_SHIFT,
+    never above RUDP_MAX_RTO_US) and gives up after RUDP_MAX_RETRIES, or once
+    the first send is older than the peer's RUDP_DELIVERY_WINDOW.
+
+    @param[in,out] conn         Connection to service
+    @param[in]     send         Called once per datagram to resend
+    @param[in]     userData     Forwarded to send
+    @return                     Number of datagrams resent
+*/
+u32 rudpResendExpired(RUDPConnection_St* conn, RUDPSend_Ft send, void* userData);
+
+/**
+    @brief Number of reliable packets still waiting for an ack.
+*/
+u32 rudpPendingCount(const RUDPConnection_St* conn);
+
+/**
+    @brief Replaces the time source (e.g. a simulated clock in tests).
+    @param clock    New clock, or NULL to restore the default monotonic clock
+*/
+void rudpSetClock(RUDPClock_Ft clock);
+
 #endif // RUDP_CORE_H
\ No newline at end of file
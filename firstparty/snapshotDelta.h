@@ -0,0 +1,124 @@
+/**
+    @file snapshotDelta.h
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Snapshot / delta compression for server -> client state sync
+
+    A stream carries fixed-size snapshots of a game's sync payload. The
+    server keeps the last SNAPSHOT_HISTORY snapshots it sent and, for each
+    client, the newest one that client acknowledged. Each message is the
+    XOR of the new snapshot against that acknowledged baseline, run-length
+    encoded (unchanged bytes XOR to zero and are skipped). When the client
+    has no usable baseline (first sync, baseline dropped from the history,
+    client reports a decode failure), the XOR is taken against an all-zero
+    snapshot instead: that is a keyframe.
+
+    Wire format, after the game TLV header:
+        SnapshotHeader_St (network order), then RLE runs:
+        [u8 zero bytes to skip][u8 literal count][literal XOR bytes]...
+        Bytes after the last run are unchanged.
+
+    Clients acknowledge with the seq of every snapshot they apply (an ack of
+    SNAPSHOT_SEQ_NONE asks for a keyframe). Acks ride on the game's own
+    action codes; this module only provides the bookkeeping.
+*/
+#ifndef SNAPSHOT_DELTA_H
+#define SNAPSHOT_DELTA_H
+
+#include "baseTypes.h"
+
+/**
+    @name Snapshot stream tuning
+    @{
+*/
+#define SNAPSHOT_HISTORY    8       ///< Snapshots kept by each side; a baseline older than this forces a keyframe
+#define SNAPSHOT_SEQ_NONE   0       ///< "No snapshot": keyframe base, or an ack requesting a keyframe
+/** @} */
+
+#pragma pack(push, 1)
+/**
+    @brief Header of one snapshot message (all fields in network byte order).
+*/
+typedef struct {
+    u16 seq;        ///< Sequence of the snapshot carried (never SNAPSHOT_SEQ_NONE)
+    u16 baseSeq;    ///< Baseline the XOR was taken against (SNAPSHOT_SEQ_NONE = keyframe)
+    u16 size;       ///< Decoded snapshot size, must match the receiver's
+} SnapshotHeader_St;
+#pragma pack(pop)
+
+/**
+    @brief Upper bound of an encoded message for a snapshot of `size` bytes.
+*/
+#define SNAPSHOT_MAX_ENCODED(size) (sizeof(SnapshotHeader_St) + (size) + 2 * ((size) / 255 + 1))
+
+/**
+    @brief Ring of recent snapshots, used on both sides of a stream.
+
+    Frames are stored in caller-provided memory (SNAPSHOT_HISTORY * size
+    bytes) so the history can live inside a pooled game state.
+*/
+typedef struct {
+    u16 size;                           ///< Bytes per snapshot
+    u16 lastSeq;                        ///< Newest stored seq (SNAPSHOT_SEQ_NONE when empty)
+    u16 seqs[SNAPSHOT_HISTORY];         ///< Seq held by each frame slot
+    u8* frames;                         ///< SNAPSHOT_HISTORY * size bytes
+} SnapshotHistory_St;
+
+/**
+    @brief Result of snapshotDecode().
+*/
+typedef enum {
+    SNAPSHOT_APPLIED,           ///< `out` holds the new snapshot; acknowledge its seq
+    SNAPSHOT_STALE,             ///< Older than the last applied one; ignore
+    SNAPSHOT_NEED_KEYFRAME      ///< Baseline unknown or message malformed; ack SNAPSHOT_SEQ_NONE
+} SnapshotDecodeResult_Et;
+
+/**
+    @brief Returns true if seq `a` is newer than `b`, accounting for u16 wrap-around.
+*/
+static inline bool snapshotSeqNewer(u16 a, u16 b) {
+    return (s16)(u16)(a - b) > 0;
+}
+
+/**
+    @brief Resets a history over `storage` (SNAPSHOT_HISTORY * size bytes).
+*/
+void snapshotHistoryInit(SnapshotHistory_St* history, void* storage, u16 size);
+
+/**
+    @brief Copies seqs and frames of `src` into `dst`'s own storage (same size required).
+
+    Lets a stream follow its client when the game reorders player slots.
+*/
+void snapshotHistoryCopy(SnapshotHistory_St* dst, const SnapshotHistory_St* src);
+
+/**
+    @brief Server side: stores a new snapshot and returns its seq.
+*/
+u16 snapshotPush(SnapshotHistory_St* history, const void* snapshot);
+
+/**
+    @brief Server side: encodes snapshot `seq` for a client whose last ack is `ackedSeq`.
+
+    Falls back to a keyframe when `ackedSeq` is no longer in the history.
+    @return Bytes written to `out` (0 if `seq` is unknown or `cap` is too small;
+            SNAPSHOT_MAX_ENCODED(size) is always enough).
+*/
+u16 snapshotEncode(const SnapshotHistory_St* history, u16 seq, u16 ackedSeq, void* out, u16 cap);
+
+/**
+    @brief Server side: applies a client ack to its stored `ackedSeq`.
+
+    Out-of-order acks never move the baseline backwards; SNAPSHOT_SEQ_NONE
+    resets it so the next message is a keyframe.
+*/
+void snapshotOnAck(u16* ackedSeq, u16 seq);
+
+/**
+    @brief Client side: decodes one message against the receiver's history.
+    @param[out] out     Receives the full snapshot when SNAPSHOT_APPLIED
+    @param[out] seq     Seq of the message (to acknowledge)
+*/
+SnapshotDecodeResult_Et snapshotDecode(SnapshotHistory_St* history, const void* msg, u16 len, void* out, u16* seq);
+
+#endif // SNAPSHOT_DELTA_H
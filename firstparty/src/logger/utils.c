@@ -82,9 +82,15 @@ const char* getPreciseTimeString(void) {
 }
 
 void getTimeStamp(char *buffer, size_t size) {
+    // Called from every log_* and the server logs from its room workers too: no shared static tm
     time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", tm_info);
+    struct tm tm_info;
+#ifdef _WIN32
+    localtime_s(&tm_info, &now);
+#else
+    localtime_r(&now, &tm_info);
+#endif
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tm_info);
 
     struct timeval tv;
     gettimeofday(&tv, NULL);
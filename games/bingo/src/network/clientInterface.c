@@ -17,6 +17,8 @@
 
 #include "sharedUtils/random.h"
 
+#include "snapshotDelta.h"
+
 /**
     @brief Action codes for network communication.
            Must stay in sync with the server implementation.
@@ -25,7 +27,8 @@ enum {
     ACTION_CODE_BINGO_CHOOSE_CARD = firstAvailableActionCode,
     ACTION_CODE_BINGO_DAUB_SQUARE,
     ACTION_CODE_BINGO_START_GAME,
-    ACTION_CODE_BINGO_SYNC_STATE
+    ACTION_CODE_BINGO_SYNC_STATE,
+    ACTION_CODE_BINGO_SYNC_ACK          ///< Client -> server: u16 seq of the applied snapshot (network order)
 };
 
 #pragma pack(push, 1)
@@ -67,6 +70,9 @@ static bool         assetsLoaded = false;   ///< Whether game-specific assets ar
 static f32          joinRetryTimer = 0.0f;  ///< Timer for retrying to join the game
 static bool         cardsGenerated = false; ///< Whether choice cards have been generated
 
+static SnapshotHistory_St syncHistory;      ///< Received sync payloads (delta baselines)
+static u8 syncFrames[SNAPSHOT_HISTORY][sizeof(BingoSyncPayload_St)]; ///< Storage of syncHistory
+
 /**
     @brief Helper to send a game-specific action to the server.
     @param[in]     action       The action code to send.
@@ -123,6 +129,7 @@ void bingo_init(void) {
     localGame.clientID = -1;
     joinRetryTimer     = 0.0f;
     cardsGenerated     = false;
+    snapshotHistoryInit(&syncHistory, syncFrames, sizeof(BingoSyncPayload_St));
 
     // Ces valeurs sont des constantes de config partagées avec le serveur.
     // Sans elles, bingo_drawUI et inGrace ne fonctionnent pas en mode réseau
@@ -163,18 +170,19 @@ void bingo_onData(s32 playerId, u8 action, const void* data, u16 len) {
         } break;
 
         case ACTION_CODE_BINGO_SYNC_STATE: {
-            if (len < sizeof(BingoSyncPayload_St)) {
-                log_warn(
-                    "Bingo sync payload too small: %u bytes (expected %zu)", 
-                    len, sizeof(BingoSyncPayload_St)
-                );
-
+            BingoSyncPayload_St payload;
+            u16 seq = SNAPSHOT_SEQ_NONE;
+            SnapshotDecodeResult_Et result = snapshotDecode(&syncHistory, data, len, &payload, &seq);
+            if (result == SNAPSHOT_STALE) break;
+
+            // Ack what we applied; an ack of SNAPSHOT_SEQ_NONE asks for a keyframe
+            u16 ackSeq = htons(result == SNAPSHOT_APPLIED ? seq : SNAPSHOT_SEQ_NONE);
+            sendToServer(ACTION_CODE_BINGO_SYNC_ACK, &ackSeq, sizeof(ackSeq));
+            if (result != SNAPSHOT_APPLIED) {
+                log_warn("Bingo sync %u could not be decoded (%u bytes), requesting a keyframe", seq, len);
                 break;
             }
 
-            BingoSyncPayload_St payload;
-            memcpy(&payload, data, sizeof(BingoSyncPayload_St));
-
             // Apply minimal sync payload
             localGame.balls.remainingCount = payload.remainingBalls;
             localGame.currentCall          = payload.currentCall;
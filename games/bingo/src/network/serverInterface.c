@@ -13,6 +13,10 @@
 
 #include "sharedUtils/random.h"
 
+#include "snapshotDelta.h"
+
+#define BINGO_IDLE_SLEEP_MS 1000 ///< Tick interval while no timer is running
+
 /**
     @brief Action codes for network communication.
            Must stay in sync with the client implementation.
@@ -21,7 +25,8 @@ enum {
     ACTION_CODE_BINGO_CHOOSE_CARD = firstAvailableActionCode,
     ACTION_CODE_BINGO_DAUB_SQUARE,
     ACTION_CODE_BINGO_START_GAME,
-    ACTION_CODE_BINGO_SYNC_STATE
+    ACTION_CODE_BINGO_SYNC_STATE,
+    ACTION_CODE_BINGO_SYNC_ACK          ///< Client -> server: u16 seq of the applied snapshot (network order)
 };
 
 #pragma pack(push, 1)
@@ -76,8 +81,10 @@ typedef struct {
     PlayerCard_St       playerCards[MAX_PLAYER];    ///< Per-player cards
     s32                 playerNetworkIds[MAX_PLAYER]; ///< slot -> network playerId mapping
     BingoStatus_Et      status;                     ///< Current phase
-    BroadcastMessage_Ft serverBroadcastCallback;    ///< Broadcast function
     u32                 seed;                       ///< Common seed for card generation
+    SnapshotHistory_St  syncHistory;                ///< Recently sent sync payloads (delta baselines)
+    u16                 syncAcked[MAX_PLAYER];      ///< Newest snapshot acked by each slot
+    u8                  syncFrames[SNAPSHOT_HISTORY][sizeof(BingoSyncPayload_St)]; ///< Storage of syncHistory
 } BingoServerState_St;
 
 /**
@@ -98,13 +105,12 @@ static s32 bingo_getSlot(BingoServerState_St* srv, s32 playerId) {
 }
 
 /**
-    @brief Creates a new server-side instance of the Bingo game.
-    @param[in]     void
-    @return                     Pointer to the new instance state.
+    @brief Initializes a zeroed Bingo server state in place.
+    @param[in,out] state        Zeroed block of sizeof(BingoServerState_St) bytes.
+    @return                     void
 */
-void* bingo_createInstance(void) {
-    BingoServerState_St* srv = calloc(1, sizeof(BingoServerState_St));
-    if (srv == NULL) return NULL;
+void bingo_initInstance(void* state) {
+    BingoServerState_St* srv = (BingoServerState_St*)state;
 
     srv->seed = (u32)time(NULL);
     srand(srv->seed);
@@ -116,6 +122,7 @@ void* bingo_createInstance(void) {
 
     // Initialize network IDs
     for (int i = 0; i < MAX_PLAYER; i++) srv->playerNetworkIds[i] = -1;
+    snapshotHistoryInit(&srv->syncHistory, srv->syncFrames, sizeof(BingoSyncPayload_St));
 
     // Generate 12 preview cards
     uint available[100];
@@ -140,18 +147,51 @@ void* bingo_createInstance(void) {
     game->balls.graceDelay  = 1.0f;
     game->currentCall.timer = game->balls.showDelay;
     game->progress.scene = GAME_SCENE_CARD_CHOICE;
+}
 
+/**
+    @brief Creates a new server-side instance of the Bingo game.
+    @param[in]     void
+    @return                     Pointer to the new instance state.
+*/
+void* bingo_createInstance(void) {
+    BingoServerState_St* srv = calloc(1, sizeof(BingoServerState_St));
+    if (srv != NULL) bingo_initInstance(srv);
     return srv;
 }
 
+/**
+    @brief Sends snapshot `seq` to one slot, as a delta against what that slot acknowledged.
+    @param[in]     srv          Pointer to the server state.
+    @param[in]     slot         Player slot to send to.
+    @param[in]     seq          Snapshot to send (must still be in syncHistory).
+    @param[in]     broadcast    The broadcast function pointer.
+    @return                     void
+*/
+static void bingo_serverSendSync(BingoServerState_St* srv, u32 slot, u16 seq, BroadcastMessage_Ft broadcast) {
+    u8 buf[sizeof(GameTLVHeader_St) + SNAPSHOT_MAX_ENCODED(sizeof(BingoSyncPayload_St))];
+    u16 len = snapshotEncode(&srv->syncHistory, seq, srv->syncAcked[slot], buf + sizeof(GameTLVHeader_St), sizeof(buf) - sizeof(GameTLVHeader_St));
+    if (len == 0) return;
+
+    GameTLVHeader_St tlv = {
+        .gameId = MINI_GAME_ID_BINGO,
+        .action  = ACTION_CODE_BINGO_SYNC_STATE,
+        .length  = htons(len),
+        .isReliable = true
+    };
+    memcpy(buf, &tlv, sizeof(tlv));
+    broadcast(UNICAST, srv->playerNetworkIds[slot], ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv) + len));
+}
+
 /**
     @brief Broadcasts the current game state to all connected clients.
+           The payload is recorded as a new snapshot, and each player gets
+           it delta-encoded against the last snapshot they acknowledged.
     @param[in]     srv          Pointer to the server state.
-    @param[in]     room_id      The room ID to broadcast to.
     @param[in]     broadcast    The broadcast function pointer.
     @return                     void
 */
-static void bingo_serverBroadcastSync(BingoServerState_St* srv, s32 roomId, BroadcastMessage_Ft broadcast) {
+static void bingo_serverBroadcastSync(BingoServerState_St* srv, BroadcastMessage_Ft broadcast) {
     if (!broadcast) return;
 
     BingoGame_St* game = &srv->game;
@@ -169,18 +209,10 @@ static void bingo_serverBroadcastSync(BingoServerState_St* srv, s32 roomId, Broa
         payload.playerNetworkIds[i] = srv->playerNetworkIds[i];
     }
 
-    GameTLVHeader_St tlv = {
-        .gameId = MINI_GAME_ID_BINGO,
-        .action  = ACTION_CODE_BINGO_SYNC_STATE,
-        .length  = htons(sizeof(BingoSyncPayload_St))
-    };
-
-    u8 buf[2048]; // Increased buffer size for larger payload
-    memset(buf, 0, sizeof(buf));
-    memcpy(buf, &tlv, sizeof(tlv));
-    memcpy(buf + sizeof(tlv), &payload, sizeof(payload));
-
-    broadcast(roomId, -1, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv) + sizeof(payload)));
+    u16 seq = snapshotPush(&srv->syncHistory, &payload);
+    for (u32 slot = 0; slot < srv->numPlayers; ++slot) {
+        bingo_serverSendSync(srv, slot, seq, broadcast);
+    }
 }
 
 /**
@@ -206,7 +238,20 @@ void bingo_onAction(void* state, s32 roomId, s32 playerId, u8 action, const void
 
     BingoServerState_St* srv = (BingoServerState_St*)state;
     BingoGame_St* game = &srv->game;
-    srv->serverBroadcastCallback = broadcast;
+
+    // Acks only move the delta baseline; a keyframe request is answered right away
+    if (realAction == ACTION_CODE_BINGO_SYNC_ACK) {
+        s32 slot = bingo_getSlot(srv, playerId);
+        if (slot == -1 || payloadLen < sizeof(u16)) return;
+        u16 netSeq;
+        memcpy(&netSeq, realPayload, sizeof(u16));
+        u16 seq = ntohs(netSeq);
+        snapshotOnAck(&srv->syncAcked[slot], seq);
+        if (seq == SNAPSHOT_SEQ_NONE && srv->syncHistory.lastSeq != SNAPSHOT_SEQ_NONE) {
+            bingo_serverSendSync(srv, (u32)slot, srv->syncHistory.lastSeq, broadcast);
+        }
+        return;
+    }
 
     switch (realAction) {
         case ACTION_CODE_JOIN_GAME: {
@@ -218,6 +263,7 @@ void bingo_onAction(void* state, s32 roomId, s32 playerId, u8 action, const void
 
             u32 slot = srv->numPlayers++;
             srv->playerNetworkIds[slot] = playerId;
+            srv->syncAcked[slot] = SNAPSHOT_SEQ_NONE;
             u32 randomCard = rand() % 12;
 
             memcpy(&srv->playerCards[slot], &game->layout.choiceCards[randomCard].values, sizeof(Card_t));
@@ -226,7 +272,7 @@ void bingo_onAction(void* state, s32 roomId, s32 playerId, u8 action, const void
 
             u8 buf_ack[64];
             memset(buf_ack, 0, sizeof(buf_ack));
-            GameTLVHeader_St tlv_ack = { .gameId = MINI_GAME_ID_BINGO, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)) };
+            GameTLVHeader_St tlv_ack = { .gameId = MINI_GAME_ID_BINGO, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)), .isReliable = true };
             u16 netId = htons((u16)slot);
             memcpy(buf_ack, &tlv_ack, sizeof(tlv_ack));
             memcpy(buf_ack + sizeof(tlv_ack), &netId, sizeof(u16));
@@ -283,21 +329,28 @@ void bingo_onAction(void* state, s32 roomId, s32 playerId, u8 action, const void
         } break;
     }
 
-    bingo_serverBroadcastSync(srv, roomId, broadcast);
+    bingo_serverBroadcastSync(srv, broadcast);
 }
 
 /**
     @brief Updates the server-side game state on each tick.
+
+    Clients run the countdown and call timers locally, so the room only
+    wakes when the launch countdown ends, when the next ball is due, or
+    when a player acts (card choice, marks, sync acks). State is only
+    synced when a tick changed it.
+
     @param[in,out] state        Pointer to the instance state.
+    @param[in,out] ctx          Tick context (elapsed time, room, broadcast, requested sleep).
     @return                     void
 */
-void bingo_onTick(void* state) {
+void bingo_onRoomTick(void* state, ServerTickContext_St* ctx) {
     BingoServerState_St* srv = (BingoServerState_St*)state;
-    if (!srv->serverBroadcastCallback) return;
+    ctx->sleepMs = BINGO_IDLE_SLEEP_MS;
     if (srv->status != BINGO_STATUS_PLAYING && srv->status != BINGO_STATUS_LAUNCHING) return;
 
     BingoGame_St* game = &srv->game;
-    f32 dt = 0.016f; 
+    f32 dt = ctx->dt;
 
     if (srv->status == BINGO_STATUS_LAUNCHING) {
         game->currentCall.timer -= dt;
@@ -305,14 +358,19 @@ void bingo_onTick(void* state) {
             game->currentCall.timer = 0.0f;
             srv->status = BINGO_STATUS_PLAYING;
             game->progress.scene = GAME_SCENE_PLAYING;
+            ctx->sleepMs = 0;
+            bingo_serverBroadcastSync(srv, ctx->broadcast);
+        } else {
+            ctx->sleepMs = (u32)(game->currentCall.timer * 1000.0f) + 1;
         }
-        bingo_serverBroadcastSync(srv, game->roomId, srv->serverBroadcastCallback);
         return;
     }
 
+    bool changed = false;
     game->currentCall.timer += dt;
     if (game->currentCall.timer >= game->balls.choiceDelay) {
         game->currentCall.timer = 0.0f;
+        changed = true;
         if (game->balls.remainingCount > 0) {
             game->currentCall.encodedValue = game->balls.encodedBalls[--game->balls.remainingCount];
             game->currentCall.column = (game->currentCall.encodedValue / 100) - 1;
@@ -337,7 +395,10 @@ void bingo_onTick(void* state) {
         srv->status = BINGO_STATUS_ENDED;
     }
 
-    bingo_serverBroadcastSync(srv, game->roomId, srv->serverBroadcastCallback);
+    if (srv->status == BINGO_STATUS_PLAYING) {
+        ctx->sleepMs = (u32)((game->balls.choiceDelay - game->currentCall.timer) * 1000.0f) + 1;
+    }
+    if (changed || srv->status != BINGO_STATUS_PLAYING) bingo_serverBroadcastSync(srv, ctx->broadcast);
 }
 
 /**
@@ -354,6 +415,7 @@ void bingo_onPlayerLeave(void* state, s32 playerId) {
     for (u32 i = (u32)slot; i < srv->numPlayers - 1; ++i) {
         srv->playerCards[i] = srv->playerCards[i + 1];
         srv->playerNetworkIds[i] = srv->playerNetworkIds[i + 1];
+        srv->syncAcked[i] = srv->syncAcked[i + 1];
     }
     srv->numPlayers--;
     log_info("Player %d left (slot %d vacated)", playerId, slot);
@@ -375,7 +437,9 @@ GameServerInterface_St bingo_serverInterface = {
     .gameName        = "Bingo",
     .createInstance  = bingo_createInstance,
     .onAction        = bingo_onAction,
-    .onTick          = bingo_onTick,
+    .onRoomTick      = bingo_onRoomTick,
     .onPlayerLeave   = bingo_onPlayerLeave,
-    .destroyInstance = bingo_destroyInstance
+    .destroyInstance = bingo_destroyInstance,
+    .instanceSize    = sizeof(BingoServerState_St),
+    .initInstance    = bingo_initInstance
 };
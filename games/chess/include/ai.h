@@ -2,34 +2,95 @@
     @file ai.h
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
-    @brief Chess AI implementation using Minimax and Alpha-Beta pruning.
+    @date 2026-10-17
+    @brief Chess AI: iterative-deepening alpha-beta search with quiescence and move ordering.
 */
 #ifndef CHESS_AI_H
 #define CHESS_AI_H
 
 #include "types.h"
 #include "baseTypes.h"
+#include "position.h"
+#include "transposition.h"
+#include "book.h"
+
+#include <stdatomic.h>
+
+#define CHESS_MAX_PLY 64        ///< Deepest search supported
+#define AI_MAX_THREADS 64       ///< Cap of AiLimits_st.threads
+#define AI_MATE_SCORE 1000000   ///< Beyond any material sum; being mated n plies from the root scores -(AI_MATE_SCORE - n)
 
 /**
     @brief Represents a single chess move with its associated score.
 */
 typedef struct {
-    IVec2_st from;  ///< Starting position
-    IVec2_st to;    ///< Ending position
-    s32 score;      ///< Move score for evaluation
+    IVec2_st from;      ///< Starting position
+    IVec2_st to;        ///< Ending position
+    s32 score;          ///< Move score for evaluation
+    ChessMove_t move;   ///< Packed move, to replay it with boardApplyMove() (MOVE_NONE if no legal move)
 } ChessMove_st;
 
 /**
-    @brief Computes the best move for the current player using Minimax with Alpha-Beta pruning.
+    @brief When ai_searchPosition() stops deepening.
+*/
+typedef struct {
+    u8  depth;                  ///< Deepest iteration, 0 for no depth limit
+    u32 timeMs;                 ///< Thinking time in milliseconds, 0 for no time limit
+    const atomic_bool* stop;    ///< Set by another thread to end the search now (NULL: never)
+    const atomic_bool* ponder;  ///< While set, the clock does not run (NULL: not pondering)
+    u8  threads;                ///< Lazy SMP threads sharing the table, this one included (0 or 1: this thread only)
+    const OpeningBook_st* book; ///< Probed before searching; a book move is played at once (NULL: no book)
+} AiLimits_st;
+
+/**
+    @brief Counters filled by ai_searchPosition().
+*/
+typedef struct {
+    u64 nodes;          ///< Positions visited, quiescence and helper threads included
+    u64 ttProbes;       ///< Table lookups
+    u64 ttHits;         ///< Lookups that found the position
+    u64 ttCutoffs;      ///< Hits deep enough to return without searching
+    u64 tbHits;         ///< Positions scored by the endgame tables
+    u8  depth;          ///< Last iteration searched to the end (0: book or table move, no search)
+} AiStats_st;
+
+/**
+    @brief Computes the best move for the current player by iterative deepening within a time budget.
     @param[in]     board    The current game board.
-    @param[in,out] white    Player structure for White.
-    @param[in,out] black    Player structure for Black.
     @param[in]     player   The player to move (0: White, 1: Black).
-    @param[in]     depth    The search depth.
+    @param[in]     timeMs   Thinking time in milliseconds (at least depth 1 is always searched).
     @return                 The best move found.
 */
-ChessMove_st ai_getBestMove(Board_t board, Player_st* white, Player_st* black, s32 player, u8 depth);
+ChessMove_st ai_getBestMove(Board_t board, s32 player, u32 timeMs);
+
+/**
+    @brief Same search on a bitboard position (side to move = pos->side).
+
+    Re-entrant: the search keeps its state in the arguments and on the
+    stack, so any number of threads may search different positions.
+
+    A position in the book, or covered by the endgame tables once they
+    are built (tablebase.h), is answered at once without searching;
+    inside the search, positions the tables cover are scored exactly.
+    @param[in,out] pos      Position to search, restored on return.
+    @param[in]     limits   Depth and time limits (both 0: search to CHESS_MAX_PLY).
+    @param[in,out] tt       Transposition table to use and fill, NULL to search without one.
+    @param[out]    stats    Search counters, may be NULL.
+    @return                 The best move found, score from White's point of view.
+*/
+ChessMove_st ai_searchPosition(Position_st* pos, const AiLimits_st* limits, TranspositionTable_st* tt, AiStats_st* stats);
+
+/**
+    @brief Clears the transposition table kept across the moves of a game.
+*/
+void ai_clearMemory(void);
+
+/**
+    @brief Evaluates a bitboard position from the perspective of the White player.
+    @param[in]     pos      The position.
+    @return                 Evaluation score (s32).
+*/
+s32 ai_evaluatePosition(const Position_st* pos);
 
 /**
     @brief Evaluates the board from the perspective of the White player.
@@ -0,0 +1,47 @@
+/**
+    @file aiPool.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Background AI searches shared by many games (server-hosted bots).
+
+    A server cannot afford a search thread and a table per room, so the
+    rooms lease a worker (aiWorker.h) from a fixed pool while their bot
+    thinks and hand it back with the move. A room ticks on one thread at
+    a time, so the lease needs no lock on the room side.
+
+    Every game draws its own id. A worker last used by another game
+    forgets its table before the next search, so no room ever sees what
+    another one searched; the worker this game used last is preferred, to
+    keep its table warm across the game's moves. The workers share the
+    opening book (BOOK_PATH), opened with the pool.
+*/
+#ifndef AI_POOL_H
+#define AI_POOL_H
+
+#include "aiWorker.h"
+
+#define AI_POOL_MAX_WORKERS 8   ///< Cap of the pool size (one worker per core below that)
+#define AI_POOL_TT_MB 8         ///< Table size of each pooled worker
+
+/**
+    @brief Draws the id of a new game (never 0).
+*/
+u64 aiPool_newGameId(void);
+
+/**
+    @brief Leases an idle worker to `gameId`, starting the pool on first use. Thread-safe.
+    @return NULL if every worker is leased (try again later)
+*/
+AiWorker_st* aiPool_acquire(u64 gameId);
+
+/**
+    @brief Hands a leased worker back; its job, if any, is dropped.
+*/
+void aiPool_release(AiWorker_st* worker);
+
+/**
+    @brief Number of workers in the pool (0 before the first aiPool_acquire()).
+*/
+u32 aiPool_size(void);
+
+#endif // AI_POOL_H
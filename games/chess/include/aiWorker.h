@@ -0,0 +1,137 @@
+/**
+    @file aiWorker.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Chess AI search on a background thread.
+
+    The UI hands the worker a copy of the position and keeps drawing; it
+    polls every frame for the move. None of these calls block on the
+    search: a search asked to stop unwinds within 1024 nodes (well under
+    a millisecond) on the worker's side.
+
+    The first worker started builds the endgame tables (tablebase.h) on a
+    thread of their own, so neither the UI nor the first search waits for
+    them: until they are ready the search simply finds them not covering
+    the position.
+
+    While the human thinks, the worker can ponder: it guesses the reply
+    from its table and searches the position after it with the clock
+    stopped. If the human plays the guessed move, the next think call
+    keeps that search and starts its clock instead of starting over.
+*/
+#ifndef AI_WORKER_H
+#define AI_WORKER_H
+
+#include "ai.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+    @brief What the worker is doing.
+*/
+typedef enum {
+    AI_WORKER_IDLE,         ///< Nothing to do, or the result was collected
+    AI_WORKER_THINKING,     ///< Searching a move to play
+    AI_WORKER_PONDERING,    ///< Searching during the opponent's turn
+    AI_WORKER_DONE          ///< A move waits in aiWorker_poll()
+} AiWorkerState_et;
+
+/**
+    @brief A search thread and its job slot.
+
+    All fields except the atomics are guarded by `lock`.
+*/
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;            ///< Signals a new job or shutdown to the worker
+    bool running;                   ///< Thread started
+
+    TranspositionTable_st tt;       ///< Kept across the moves of a game
+    u8 threads;                     ///< Lazy SMP threads per search
+    const OpeningBook_st* book;     ///< Book of the next jobs (NULL: none)
+    bool clearTable;                ///< Clear `tt` before the next job
+
+    // Job slot, filled by the UI thread
+    bool hasJob;                    ///< A job waits to be picked up
+    bool quit;
+    Position_st jobPosition;        ///< Copy searched by the worker
+    u32 jobTimeMs;
+    bool jobPonder;                 ///< Guess the reply in jobPosition and search after it, clock stopped
+    u32 jobId;                      ///< Bumped for every job; results of older jobs are dropped
+
+    // Current search
+    atomic_bool stop;               ///< Ends the current search
+    atomic_bool ponder;             ///< Clock stopped while set
+    AiWorkerState_et state;
+    u64 ponderHash;                 ///< Position being pondered, valid while PONDERING
+    bool finished;                  ///< The current job's search returned (a ponder search may end early)
+
+    // Result
+    ChessMove_st result;
+    AiStats_st stats;
+} AiWorker_st;
+
+/**
+    @brief Starts the thread with a table of `ttMegabytes`.
+    @param[in] threads  Search threads per job (AiLimits_st.threads); the worker thread is one of them
+    @return false if the table or the thread could not be created
+*/
+bool aiWorker_start(AiWorker_st* worker, u32 ttMegabytes, u8 threads);
+
+/**
+    @brief Sets the book the next jobs probe first; it must stay open while the worker uses it.
+*/
+void aiWorker_setBook(AiWorker_st* worker, const OpeningBook_st* book);
+
+/**
+    @brief Stops the search, joins the thread and frees the table.
+*/
+void aiWorker_shutdown(AiWorker_st* worker);
+
+/**
+    @brief Searches a move to play in `pos` for `timeMs`.
+
+    Replaces any job in progress. If the worker was pondering this very
+    position, that search is kept and its clock starts now.
+*/
+void aiWorker_think(AiWorker_st* worker, const Position_st* pos, u32 timeMs);
+
+/**
+    @brief Ponders after our move was played in `pos` (the opponent to move).
+
+    The worker guesses the opponent's reply from its table (nothing
+    happens without a guess) and searches the position after it.
+    Replaces any job in progress.
+    @param[in] timeMs  Budget the next think call will give, counted from the moment the guess is confirmed
+*/
+void aiWorker_ponder(AiWorker_st* worker, const Position_st* pos, u32 timeMs);
+
+/**
+    @brief Ends the thinking search now; its best move so far comes out of aiWorker_poll().
+*/
+void aiWorker_moveNow(AiWorker_st* worker);
+
+/**
+    @brief Drops the job in progress; no move will come out of it.
+*/
+void aiWorker_cancel(AiWorker_st* worker);
+
+/**
+    @brief Cancels and forgets the table (new game).
+*/
+void aiWorker_newGame(AiWorker_st* worker);
+
+/**
+    @brief Collects the move of the last think job, once.
+    @return true if `out` was filled
+*/
+bool aiWorker_poll(AiWorker_st* worker, ChessMove_st* out);
+
+/**
+    @brief Current state (for the UI: "thinking...").
+*/
+AiWorkerState_et aiWorker_state(AiWorker_st* worker);
+
+#endif // AI_WORKER_H
@@ -2,7 +2,7 @@
     @file algo.h
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Game logic and algorithms for chess.
 */
 #ifndef ALGO_H
@@ -48,18 +48,20 @@ bool canBePlaced(Board_t board, Piece_st* selectionnedPiece, int col, int row);
 bool isInCheck(Board_t board, Piece_st* selectionnedPiece, int col, int lig, int joueur);
 
 /**
-    @brief Check if the current player is in checkmate.
-    @param[in] board  The game board
-    @return           true if checkmate, false otherwise
+    @brief Check if a player is checkmated (no global state, no sound).
+    @param[in] board   The game board
+    @param[in] player  The player to move (0 for white, 1 for black)
+    @return            true if checkmate, false otherwise
 */
-bool isCheckmate(Board_t board);
+bool isCheckmate(Board_t board, int player);
 
 /**
-    @brief Check if the current player is in stalemate.
-    @param[in] board  The game board
-    @return           true if stalemate, false otherwise
+    @brief Check if a player is stalemated (no global state, no sound).
+    @param[in] board   The game board
+    @param[in] player  The player to move (0 for white, 1 for black)
+    @return            true if stalemate, false otherwise
 */
-bool isStalemate(Board_t board);
+bool isStalemate(Board_t board, int player);
 
 /**
     @brief Check if a square is threatened by opponent pieces.
@@ -0,0 +1,117 @@
+/**
+    @file bitboard.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief 64-bit square sets and precomputed attack tables for chess.
+
+    Squares are numbered a1 = 0 .. h8 = 63 (file + 8 * rank). The UI board
+    uses board[y][x] with y = 0 on Black's back rank, see SQUARE_FROM_XY().
+
+    Slider attacks use fancy magic bitboards, or PEXT when the compiler
+    targets BMI2 (-mbmi2 / -march=native); both index the same tables.
+*/
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "baseTypes.h"
+
+#include <stdbool.h>
+
+/**
+    @brief Set of squares, bit n = square n.
+*/
+typedef u64 Bitboard_t;
+
+#define SQUARE_NONE             64                          ///< "No square" (e.g. no en-passant target)
+#define SQUARE_BB(sq)           ((Bitboard_t)1 << (sq))
+#define SQUARE_FILE(sq)         ((sq) & 7)
+#define SQUARE_RANK(sq)         ((sq) >> 3)
+#define SQUARE_FROM_XY(x, y)    ((7 - (y)) * 8 + (x))       ///< UI board coordinates -> square
+#define SQUARE_X(sq)            SQUARE_FILE(sq)             ///< Square -> UI board column
+#define SQUARE_Y(sq)            (7 - SQUARE_RANK(sq))       ///< Square -> UI board row
+
+#define BB_FILE_A               0x0101010101010101ULL
+#define BB_FILE_H               0x8080808080808080ULL
+#define BB_RANK_1               0x00000000000000FFULL
+#define BB_RANK_2               0x000000000000FF00ULL
+#define BB_RANK_7               0x00FF000000000000ULL
+#define BB_RANK_8               0xFF00000000000000ULL
+
+/**
+    @brief Number of squares in a set.
+*/
+static inline u32 bitboard_count(Bitboard_t bb) {
+    return (u32)__builtin_popcountll(bb);
+}
+
+/**
+    @brief Lowest square of a non-empty set.
+*/
+static inline u32 bitboard_first(Bitboard_t bb) {
+    return (u32)__builtin_ctzll(bb);
+}
+
+/**
+    @brief Removes and returns the lowest square of a non-empty set.
+*/
+static inline u32 bitboard_pop(Bitboard_t* bb) {
+    u32 sq = (u32)__builtin_ctzll(*bb);
+    *bb &= *bb - 1;
+    return sq;
+}
+
+/**
+    @brief Builds the attack tables. Thread-safe, only the first call does the work.
+*/
+void bitboard_init(void);
+
+extern Bitboard_t knightAttacks[64];        ///< Knight jumps from each square
+extern Bitboard_t kingAttacks[64];          ///< King steps from each square
+extern Bitboard_t pawnAttacks[2][64];       ///< Pawn captures, by ColorPiece_et
+
+/**
+    @brief Lookup data of one slider on one square.
+*/
+typedef struct {
+    Bitboard_t  mask;       ///< Relevant blocker squares (board edges excluded)
+    Bitboard_t  magic;      ///< Multiplier hashing the blockers to an index (unused with PEXT)
+    Bitboard_t* attacks;    ///< 1 << bits entries, in the shared attack table
+    u32         shift;      ///< 64 - number of relevant blocker squares
+} SliderMagic_st;
+
+extern SliderMagic_st rookMagics[64];
+extern SliderMagic_st bishopMagics[64];
+
+/**
+    @brief Index of an occupancy in a slider's attack table.
+*/
+static inline u32 bitboard_sliderIndex(const SliderMagic_st* m, Bitboard_t occupied) {
+#ifdef __BMI2__
+    return (u32)__builtin_ia32_pext_di(occupied, m->mask);
+#else
+    return (u32)(((occupied & m->mask) * m->magic) >> m->shift);
+#endif
+}
+
+/**
+    @brief Squares a rook on `sq` attacks given the occupied squares (blockers included).
+*/
+static inline Bitboard_t bitboard_rookAttacks(u32 sq, Bitboard_t occupied) {
+    return rookMagics[sq].attacks[bitboard_sliderIndex(&rookMagics[sq], occupied)];
+}
+
+/**
+    @brief Squares a bishop on `sq` attacks given the occupied squares (blockers included).
+*/
+static inline Bitboard_t bitboard_bishopAttacks(u32 sq, Bitboard_t occupied) {
+    return bishopMagics[sq].attacks[bitboard_sliderIndex(&bishopMagics[sq], occupied)];
+}
+
+/**
+    @brief Squares a queen on `sq` attacks given the occupied squares.
+*/
+static inline Bitboard_t bitboard_queenAttacks(u32 sq, Bitboard_t occupied) {
+    return bitboard_rookAttacks(sq, occupied) | bitboard_bishopAttacks(sq, occupied);
+}
+
+#endif // BITBOARD_H
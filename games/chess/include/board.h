@@ -2,13 +2,14 @@
     @file board.h
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Board position utilities for chess.
 */
 #ifndef BOARD_H
 #define BOARD_H
 
 #include "types.h"
+#include "position.h"
 
 /**
     @brief Get the board position from mouse coordinates.
@@ -16,4 +17,57 @@
 */
 IVec2_st getBoardPosition(void);
 
+/**
+    @brief Builds the bitboard position matching the UI board.
+
+    Castling rights come from the kings and rooks still unmoved on their
+    home squares. The UI model does not record en-passant rights, so the
+    position never has an en-passant square.
+    @param[in]  board  The game board
+    @param[in]  turn   Side to move (0 for white, 1 for black)
+    @param[out] pos    Position to fill
+*/
+void boardToPosition(Board_t board, int turn, Position_st* pos);
+
+/**
+    @brief Legal moves of the position on the UI board.
+*/
+typedef struct {
+    Position_st pos;            ///< Position the list belongs to
+    MoveList_st moves;          ///< Its legal moves
+    PositionStatus_et status;   ///< Ongoing, checkmate or stalemate
+    bool inCheck;               ///< The side to move is in check
+    u64 generations;            ///< Lists generated so far, one per new position
+} BoardMoves_st;
+
+/**
+    @brief Legal moves of the side to move on the UI board.
+
+    The move dots, move validation, check, checkmate and stalemate all
+    read this one list. It is generated again only when the pieces, the
+    side to move or the castling rights differ from the previous call;
+    otherwise the cached list is returned. UI thread only.
+    @param[in] board  The game board
+    @param[in] turn   Side to move (0 for white, 1 for black)
+    @return           The list, valid until the next call
+*/
+const BoardMoves_st* boardLegalMoves(Board_t board, int turn);
+
+/**
+    @brief Legal move of the side to move from `from` to `to`, read from boardLegalMoves().
+    @param[in] promotion  Piece to promote to; PIECE_NAME_NONE picks the queen
+    @return               MOVE_NONE if the move is not legal
+*/
+ChessMove_t boardFindLegalMove(Board_t board, int turn, IVec2_st from, IVec2_st to, PieceName_et promotion);
+
+/**
+    @brief Plays a move of the bitboard model on the UI board.
+
+    Moves the rook when castling, removes the pawn taken en passant,
+    renames a promoted pawn and marks captured pieces as taken.
+    @param[in,out] board  The game board
+    @param[in]     move   A legal move of the position built from `board`
+*/
+void boardApplyMove(Board_t board, ChessMove_t move);
+
 #endif
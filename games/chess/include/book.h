@@ -0,0 +1,83 @@
+/**
+    @file book.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Opening book: Polyglot-layout entries, memory-mapped and binary-searched.
+
+    The file is an array of 16-byte big-endian entries sorted by key, as in
+    the Polyglot format: key (8), move (2), weight (2), learn (4). Moves use
+    the Polyglot encoding: to file, to rank, from file, from rank (3 bits
+    each), promotion piece (3 bits: 1 knight .. 4 queen), and castling is
+    written as the king taking its own rook (e1h1).
+
+    Only the layout is Polyglot's: the key is the engine's own Zobrist key
+    (Position_st.hash), not a Polyglot Random64 key, so Polyglot .bin books
+    cannot be read and these books cannot be read by Polyglot tools. Books
+    are compiled from the opening lines in assets/book/ by book_compile(),
+    with the same hash the probe uses, so they always match.
+*/
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "position.h"
+
+#include <stddef.h>
+
+#define BOOK_ENTRY_SIZE 16                              ///< Bytes per entry
+#define BOOK_MAX_CHOICES 32                             ///< Most moves returned for one position
+#define BOOK_SOURCE_PATH "games/chess/assets/book/openings.txt"
+#define BOOK_PATH "build/cache/chess/openings.bin"      ///< Compiled from BOOK_SOURCE_PATH on first use, out of the source tree
+
+/**
+    @brief A book opened with book_open(); read-only, so any number of threads may probe it.
+*/
+typedef struct {
+    const u8* entries;      ///< count * BOOK_ENTRY_SIZE bytes, sorted by key
+    size_t count;
+    size_t mappedSize;      ///< Bytes mapped (0: nothing to unmap)
+} OpeningBook_st;
+
+/**
+    @brief Maps a compiled book file.
+    @return false if it cannot be read or is not a whole number of entries
+*/
+bool book_open(OpeningBook_st* book, const char* path);
+
+/**
+    @brief Opens `path`, compiling it from `sourcePath` first if it is missing or older.
+
+    Both paths are relative to the directory the game runs from, the
+    repository root, like the game's other assets.
+*/
+bool book_load(OpeningBook_st* book, const char* path, const char* sourcePath);
+
+/**
+    @brief Unmaps the book (an empty book stays valid to probe).
+*/
+void book_close(OpeningBook_st* book);
+
+/**
+    @brief Compiles opening lines into a book file.
+
+    One line per opening, moves in coordinate notation ("e2e4 e7e5 g1f3"),
+    `#` starts a comment. Every position met along a line gets its next
+    move; the weight of a move is the number of lines playing it. The
+    directories leading to `bookPath` are created as needed.
+    @return false if a file cannot be opened or a line has an illegal move (reported on stderr)
+*/
+bool book_compile(const char* sourcePath, const char* bookPath);
+
+/**
+    @brief Legal book moves of a position with their weights, heaviest first.
+    @return Number of moves written (at most `max`)
+*/
+u32 book_probeAll(const OpeningBook_st* book, const Position_st* pos, ChessMove_t moves[], u16 weights[], u32 max);
+
+/**
+    @brief Picks a book move at random, in proportion to the weights.
+    @param[in] roll  Any random number (the caller owns the generator)
+    @return MOVE_NONE if the position is not in the book
+*/
+ChessMove_t book_probe(const OpeningBook_st* book, const Position_st* pos, u32 roll);
+
+#endif // BOOK_H
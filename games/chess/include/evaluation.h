@@ -0,0 +1,48 @@
+/**
+    @file evaluation.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tapered material and piece-square evaluation for chess.
+
+    Every piece is worth a middlegame and an endgame score (material plus
+    a bonus for its square). The position keeps the sum of both
+    (PositionEval_st), updated by make/unmake, so evaluating a leaf only
+    blends the two sums by the amount of material left.
+*/
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "position.h"
+
+#define EVAL_PHASE_MAX 24   ///< Phase of the full set of pieces (knight, bishop 1, rook 2, queen 4)
+
+/**
+    @brief Middlegame and endgame value of a piece on a square, signed for White; filled by evaluation_init().
+*/
+extern s32 evalPieceSquareMg[2][7][64];
+extern s32 evalPieceSquareEg[2][7][64];
+
+/**
+    @brief Phase weight of each piece, indexed by PieceName_et.
+*/
+extern const s32 evalPhaseWeight[7];
+
+/**
+    @brief Builds the piece-square tables. Thread-safe; position_clear() calls it.
+*/
+void evaluation_init(void);
+
+/**
+    @brief Sums of a position computed from scratch (what make/unmake keep up to date).
+*/
+PositionEval_st evaluation_compute(const Position_st* pos);
+
+/**
+    @brief Evaluation from White's point of view: the middlegame and endgame sums blended by phase.
+*/
+static inline s32 evaluation_tapered(const Position_st* pos) {
+    s32 phase = pos->eval.phase < EVAL_PHASE_MAX ? pos->eval.phase : EVAL_PHASE_MAX;
+    return (pos->eval.mg * phase + pos->eval.eg * (EVAL_PHASE_MAX - phase)) / EVAL_PHASE_MAX;
+}
+
+#endif // EVALUATION_H
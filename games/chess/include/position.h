@@ -0,0 +1,249 @@
+/**
+    @file position.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Bitboard chess position, move encoding and move generation.
+
+    This is the model the AI searches: it is self-contained (no globals,
+    no pointers) so it can be copied freely. The UI keeps its own
+    Board_t / Piece_st model; board.h converts between the two.
+*/
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "types.h"
+#include "bitboard.h"
+
+/**
+    @brief Upper bound of legal moves in any position (the record is 218).
+*/
+#define CHESS_MAX_MOVES 256
+
+/**
+    @brief Castling rights bits.
+*/
+typedef enum {
+    CASTLE_WHITE_KING  = 1 << 0,    ///< White O-O
+    CASTLE_WHITE_QUEEN = 1 << 1,    ///< White O-O-O
+    CASTLE_BLACK_KING  = 1 << 2,    ///< Black O-O
+    CASTLE_BLACK_QUEEN = 1 << 3     ///< Black O-O-O
+} CastleRight_et;
+
+/**
+    @brief Kind of move, stored in the top 4 bits of a ChessMove_t.
+*/
+typedef enum {
+    MOVE_FLAG_NORMAL,           ///< Quiet move or plain capture
+    MOVE_FLAG_DOUBLE_PUSH,      ///< Pawn two squares forward (sets the en-passant square)
+    MOVE_FLAG_CASTLE,           ///< King two squares sideways, rook jumps over
+    MOVE_FLAG_EN_PASSANT,       ///< Pawn captures the pawn that just double-pushed
+    MOVE_FLAG_PROMO_PONEY,      ///< Promotion, piece = flag - MOVE_FLAG_PROMO_PONEY (knight, bishop, rook, queen)
+    MOVE_FLAG_PROMO_BISHOP,
+    MOVE_FLAG_PROMO_ROOK,
+    MOVE_FLAG_PROMO_QUEEN
+} MoveFlag_et;
+
+/**
+    @brief A move packed in 16 bits: from (6) | to (6) | MoveFlag_et (4). 0 is "no move".
+*/
+typedef u16 ChessMove_t;
+
+#define MOVE_NONE               ((ChessMove_t)0)
+#define MOVE_MAKE(from, to, flag) ((ChessMove_t)((from) | ((to) << 6) | ((flag) << 12)))
+#define MOVE_FROM(m)            ((u32)(m) & 63)
+#define MOVE_TO(m)              (((u32)(m) >> 6) & 63)
+#define MOVE_FLAG(m)            ((u32)(m) >> 12)
+#define MOVE_IS_PROMOTION(m)    (MOVE_FLAG(m) >= MOVE_FLAG_PROMO_PONEY)
+
+/**
+    @brief Piece on a square: 0 when empty, else (color << 3) | PieceName_et.
+*/
+#define SQUARE_PIECE(color, name)   ((u8)(((color) << 3) | (name)))
+#define SQUARE_PIECE_NAME(piece)    ((PieceName_et)((piece) & 7))
+#define SQUARE_PIECE_COLOR(piece)   ((ColorPiece_et)((piece) >> 3))
+
+/**
+    @brief Material and piece-square sums, White minus Black (see evaluation.h).
+*/
+typedef struct {
+    s32 mg;                     ///< Middlegame score
+    s32 eg;                     ///< Endgame score
+    s32 phase;                  ///< Knights and bishops 1, rooks 2, queens 4: 24 at the start, 0 with pawns only
+} PositionEval_st;
+
+/**
+    @brief Full position.
+*/
+typedef struct {
+    Bitboard_t pieces[2][7];    ///< [color][PieceName_et]; index PIECE_NAME_NONE holds all pieces of that color
+    Bitboard_t occupied;        ///< Both colors
+    u8  squares[64];            ///< SQUARE_PIECE() per square, for O(1) "what is on this square"
+    u8  side;                   ///< Side to move (ColorPiece_et)
+    u8  castling;               ///< CastleRight_et bits
+    u8  epSquare;               ///< En-passant target square, SQUARE_NONE if none (or if no pawn can take)
+    u8  halfmoveClock;          ///< Plies since the last capture or pawn move
+    u16 fullmoveNumber;         ///< Starts at 1, incremented after Black moves
+    u64 hash;                   ///< Zobrist key, kept up to date by make/unmake
+    PositionEval_st eval;       ///< Kept up to date by make/unmake, so leaves evaluate in O(1)
+} Position_st;
+
+/**
+    @brief Whether the game goes on in a position.
+*/
+typedef enum {
+    POSITION_ONGOING,           ///< The side to move has a legal move
+    POSITION_CHECKMATE,         ///< The side to move is in check without a legal move
+    POSITION_STALEMATE          ///< The side to move is not in check and has no legal move
+} PositionStatus_et;
+
+/**
+    @brief What makeMove() overwrote, handed back to unmakeMove().
+*/
+typedef struct {
+    u64 hash;
+    u8  captured;               ///< SQUARE_PIECE() taken (0 if none)
+    u8  castling;
+    u8  epSquare;
+    u8  halfmoveClock;
+} PositionUndo_st;
+
+/**
+    @brief Fixed-capacity move list.
+*/
+typedef struct {
+    ChessMove_t moves[CHESS_MAX_MOVES];
+    u32 count;
+} MoveList_st;
+
+/**
+    @brief Sets up the standard initial position.
+*/
+void position_setStart(Position_st* pos);
+
+/**
+    @brief Standard initial position in Forsyth-Edwards Notation.
+*/
+#define POSITION_START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+/**
+    @brief Sets up a position from Forsyth-Edwards Notation.
+
+    The move counters are optional. Pieces use the English letters
+    (PNBRQK, lowercase for Black).
+    @return false if the string is malformed (the position is then unspecified)
+*/
+bool position_fromFen(Position_st* pos, const char* fen);
+
+/**
+    @brief Writes a move in coordinate notation ("e2e4", "e7e8q").
+    @param[out] out  At least 6 bytes
+*/
+void position_moveToString(ChessMove_t move, char out[6]);
+
+/**
+    @brief Empties the board (White to move, no rights); fill it with position_putPiece().
+*/
+void position_clear(Position_st* pos);
+
+/**
+    @brief Puts a piece on an empty square.
+*/
+void position_putPiece(Position_st* pos, u32 sq, ColorPiece_et color, PieceName_et name);
+
+/**
+    @brief Zobrist key of a position, computed from scratch.
+
+    Pieces, side to move, castling rights and the en-passant file are
+    hashed. Call `pos->hash = position_computeHash(pos)` after editing
+    `side`, `castling` or `epSquare` by hand.
+*/
+u64 position_computeHash(const Position_st* pos);
+
+/**
+    @brief Square of `color`'s king (SQUARE_NONE if it has none).
+*/
+static inline u32 position_kingSquare(const Position_st* pos, u32 color) {
+    Bitboard_t king = pos->pieces[color][PIECE_NAME_KING];
+    return king ? bitboard_first(king) : SQUARE_NONE;
+}
+
+/**
+    @brief Pieces of `byColor` attacking `sq` with the given occupancy.
+*/
+Bitboard_t position_attackersTo(const Position_st* pos, u32 sq, u32 byColor, Bitboard_t occupied);
+
+/**
+    @brief True if `byColor` attacks `sq`.
+*/
+static inline bool position_isSquareAttacked(const Position_st* pos, u32 sq, u32 byColor) {
+    return position_attackersTo(pos, sq, byColor, pos->occupied) != 0;
+}
+
+/**
+    @brief True if the side to move is in check.
+*/
+static inline bool position_inCheck(const Position_st* pos) {
+    u32 king = position_kingSquare(pos, pos->side);
+    return king != SQUARE_NONE && position_isSquareAttacked(pos, king, pos->side ^ 1);
+}
+
+/**
+    @brief Fills `list` with the pseudo-legal moves of the side to move (may leave its king in check).
+
+    Castling is only generated when the king is not in check and does not
+    cross an attacked square; whether it lands in check is left to the
+    legality filter like any other move.
+*/
+void position_generatePseudoLegal(const Position_st* pos, MoveList_st* list);
+
+/**
+    @brief Fills `list` with the pseudo-legal captures, en-passant captures and promotions (quiescence search).
+*/
+void position_generateTactical(const Position_st* pos, MoveList_st* list);
+
+/**
+    @brief Fills `list` with the legal moves of the side to move.
+*/
+void position_generateLegal(const Position_st* pos, MoveList_st* list);
+
+/**
+    @brief True if a pseudo-legal move does not leave the mover's king attacked.
+*/
+bool position_isLegal(const Position_st* pos, ChessMove_t move);
+
+/**
+    @brief Checkmate, stalemate or neither; stops at the first legal move found.
+*/
+PositionStatus_et position_status(const Position_st* pos);
+
+/**
+    @brief Plays a pseudo-legal move.
+    @param[out] undo  State needed by position_unmakeMove()
+*/
+void position_makeMove(Position_st* pos, ChessMove_t move, PositionUndo_st* undo);
+
+/**
+    @brief Takes back the last move played with position_makeMove().
+*/
+void position_unmakeMove(Position_st* pos, ChessMove_t move, const PositionUndo_st* undo);
+
+/**
+    @brief Legal move going from `from` to `to`, MOVE_NONE if there is none.
+    @param[in] promotion  Piece to promote to; PIECE_NAME_NONE picks the queen
+*/
+ChessMove_t position_findMove(const Position_st* pos, u32 from, u32 to, PieceName_et promotion);
+
+/**
+    @brief Same as position_findMove(), in a list of legal moves generated already.
+*/
+ChessMove_t position_findInList(const MoveList_st* list, u32 from, u32 to, PieceName_et promotion);
+
+/**
+    @brief Piece a promotion flag turns the pawn into.
+*/
+static inline PieceName_et position_promotionPiece(ChessMove_t move) {
+    static const PieceName_et promoted[4] = {PIECE_NAME_PONEY, PIECE_NAME_BISHOP, PIECE_NAME_ROOK, PIECE_NAME_QUEEN};
+    return MOVE_IS_PROMOTION(move) ? promoted[MOVE_FLAG(move) - MOVE_FLAG_PROMO_PONEY] : PIECE_NAME_NONE;
+}
+
+#endif // POSITION_H
@@ -0,0 +1,65 @@
+/**
+    @file tablebase.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Endgame tables: perfect play with three pieces or fewer.
+
+    Like Syzygy tables, they answer win, draw or loss for the side to move
+    with no search at all; unlike them, they are not files but built in
+    memory by retrograde analysis (every position, counted back from the
+    mates), and they hold the distance to mate rather than to zeroing the
+    fifty-move counter. That fits the endings the game can reach without
+    downloads: king and queen or king and rook against king (KQK, KRK),
+    plus the dead draws (KK, KNK, KBK).
+
+    Building takes under a tenth of a second; it is optional, and until
+    tablebase_init() has returned every probe says "not covered".
+*/
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "position.h"
+
+#define TABLEBASE_MAX_PIECES 3      ///< Kings included
+
+/**
+    @brief Game value for the side to move.
+*/
+typedef enum {
+    TABLEBASE_LOSS = -1,
+    TABLEBASE_DRAW = 0,
+    TABLEBASE_WIN = 1
+} TablebaseWdl_et;
+
+/**
+    @brief Result of a probe.
+*/
+typedef struct {
+    TablebaseWdl_et wdl;
+    u8 pliesToMate;         ///< With best play on both sides; 0 for a draw or when mated already
+} TablebaseProbe_st;
+
+/**
+    @brief Builds the tables. Thread-safe, only the first call does the work; others wait for it.
+*/
+void tablebase_init(void);
+
+/**
+    @brief True once tablebase_init() has finished.
+*/
+bool tablebase_ready(void);
+
+/**
+    @brief Looks the position up.
+    @return false if the tables are not built, or do not cover this material (or castling rights remain)
+*/
+bool tablebase_probe(const Position_st* pos, TablebaseProbe_st* out);
+
+/**
+    @brief The move keeping the best result: the fastest mate, a draw, or the longest resistance.
+    @param[out] out  Value of the position for the side to move, may be NULL
+    @return MOVE_NONE if the position is not covered or has no legal move
+*/
+ChessMove_t tablebase_bestMove(const Position_st* pos, TablebaseProbe_st* out);
+
+#endif // TABLEBASE_H
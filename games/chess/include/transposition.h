@@ -0,0 +1,110 @@
+/**
+    @file transposition.h
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Transposition table for the chess search.
+
+    Fixed-size table of results keyed by the position's Zobrist hash. The
+    table is split into 64-byte buckets (one cache line) of 4 entries; a
+    position can only live in the bucket its hash selects, so a probe
+    touches a single cache line.
+
+    Each entry stores `key ^ data` next to `data`: an entry torn by two
+    threads writing at once fails the key check instead of returning
+    another position's data, so the table can be shared without locks.
+*/
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include "baseTypes.h"
+#include "position.h"
+
+#define TT_BUCKET_ENTRIES   4
+#define TT_DEFAULT_MB       16      ///< Size of the table kept by a game
+
+/**
+    @brief What a stored score says about the true value.
+*/
+typedef enum {
+    TT_BOUND_NONE,      ///< Empty entry
+    TT_BOUND_EXACT,     ///< Score is exact
+    TT_BOUND_LOWER,     ///< True value >= score (the search failed high)
+    TT_BOUND_UPPER      ///< True value <= score (the search failed low)
+} TTBound_et;
+
+/**
+    @brief One stored result (16 bytes).
+*/
+typedef struct {
+    u64 keyXorData;     ///< hash ^ data
+    u64 data;           ///< score (32) | move (16) | depth (8) | generation (6) | bound (2)
+} TTEntry_st;
+
+/**
+    @brief One cache line of entries.
+*/
+typedef struct {
+    TTEntry_st entries[TT_BUCKET_ENTRIES];
+} TTBucket_st;
+
+/**
+    @brief A transposition table.
+*/
+typedef struct {
+    TTBucket_st* buckets;
+    u64 bucketMask;     ///< Bucket count - 1 (power of two)
+    u8  generation;     ///< Bumped every search so stale entries are replaced first
+} TranspositionTable_st;
+
+/**
+    @brief Decoded entry returned by tt_probe().
+*/
+typedef struct {
+    s32 score;
+    ChessMove_t move;
+    u8 depth;
+    TTBound_et bound;
+} TTHit_st;
+
+/**
+    @brief Allocates a cleared table of at most `megabytes` (rounded down to a power of two of buckets).
+    @return false if the allocation failed
+*/
+bool tt_init(TranspositionTable_st* tt, u32 megabytes);
+
+/**
+    @brief Frees the table memory.
+*/
+void tt_free(TranspositionTable_st* tt);
+
+/**
+    @brief Forgets every entry (new game).
+*/
+void tt_clear(TranspositionTable_st* tt);
+
+/**
+    @brief Marks the start of a new search; entries of older searches become preferred victims.
+*/
+void tt_newSearch(TranspositionTable_st* tt);
+
+/**
+    @brief Looks a position up.
+    @return true and fills `hit` if the position is stored
+*/
+bool tt_probe(const TranspositionTable_st* tt, u64 hash, TTHit_st* hit);
+
+/**
+    @brief Stores a search result.
+
+    An entry of the same position is overwritten unless it is deeper and
+    from the current search; otherwise the victim is the shallowest
+    entry, entries of older searches counting as shallower.
+*/
+void tt_store(TranspositionTable_st* tt, u64 hash, s32 score, ChessMove_t move, u8 depth, TTBound_et bound);
+
+/**
+    @brief Share of the first 1000 entries written by the current search, in permille.
+*/
+u32 tt_hashfull(const TranspositionTable_st* tt);
+
+#endif // TRANSPOSITION_H
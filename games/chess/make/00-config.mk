@@ -21,6 +21,9 @@ else
     $(error Unsupported OS: $(UNAME_S). Supported: Linux, macOS (Darwin), Windows (MinGW/MSYS))
 endif
 
+# run-tests relies on bash (process substitution, $'...' strings)
+SHELL := /bin/bash
+
 # Platform-specific configuration
 include $(MAKEFILE_DIR)make/platform/$(OS).mk
 
@@ -6,6 +6,9 @@ TEST_DIR := tests
 LIB_SOURCES := $(shell find $(SRC_DIR) -name '*.c' ! -name '$(MAIN_NAME).c')
 LIB_OBJECTS := $(LIB_SOURCES:$(SRC_DIR)/%.c=$(OBJ_DIR)/%.o)
 
+# The client glue needs the lobby's socket and RUDP connection: tests link without it
+TEST_LIB_OBJECTS := $(filter-out $(OBJ_DIR)/network/clientInterface.o, $(LIB_OBJECTS))
+
 # Main source/object
 MAIN_SOURCE := $(SRC_DIR)/$(MAIN_NAME).c
 MAIN_OBJECT := $(OBJ_DIR)/$(MAIN_NAME).o
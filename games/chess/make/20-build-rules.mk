@@ -12,7 +12,7 @@ $(OBJ_DIR)/%.o: $(SRC_DIR)/%.c
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $(CFLAGS) $(DEP_FLAGS) -c $< -o $@
 
-$(TEST_BIN_DIR)/% : $(LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
+$(TEST_BIN_DIR)/% : $(TEST_LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
 
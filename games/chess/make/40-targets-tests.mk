@@ -6,6 +6,8 @@ tests: $(TEST_BINS)
 	fi
 
 
+test: run-tests
+
 run-tests: tests
 	@if [ -z "$(TEST_BINS)" ]; then \
 		:; \
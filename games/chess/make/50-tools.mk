@@ -55,6 +55,7 @@ help:
 	@echo "    run-main             Run the main binary (uses Valgrind in valgrind-debug mode)"
 	@echo "    run-gdb              Debug the main binary with gdb"
 	@echo "    run-tests            Build and run all tests, reporting failures at the end"
+	@echo "    test                 Same as run-tests (perft suite + move generator nodes/s)"
 	@echo "    clean                Remove all build artifacts and build folder"
 	@echo "    doxygen              Build documentation"
 	@echo "    clean-docs           Remove all of the generated documentation"
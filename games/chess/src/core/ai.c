@@ -2,296 +2,605 @@
     @file ai.c
     @author Léandre BAUDET
     @date 2026-04-02
-    @date 2026-04-14
-    @brief AI implementation for Chess using minimax with alpha-beta pruning.
+    @date 2026-10-17
+    @brief AI implementation for Chess: iterative-deepening alpha-beta (negamax) with quiescence search.
+
+    The search runs on the bitboard position (position.h): moves come from
+    the pseudo-legal generator and are filtered with position_isLegal()
+    before being made and unmade in place. Results are cached in a
+    transposition table keyed by the position's Zobrist hash. Moves are
+    tried best-first: the table's move, captures by MVV-LVA, killer moves,
+    then the other quiet moves by history score. The opening book and the
+    endgame tables answer the positions they know without a search.
 */
 #include "ai.h"
-#include "algo.h"
-#include <limits.h>
+#include "board.h"
+#include "evaluation.h"
+#include "tablebase.h"
 #include <stdlib.h>
+#include <pthread.h>
 #include <string.h>
+#include <time.h>
 
-#define MATERIAL_PAWN 100
-#define MATERIAL_KNIGHT 320
-#define MATERIAL_BISHOP 330
-#define MATERIAL_ROOK 500
-#define MATERIAL_QUEEN 900
-#define MATERIAL_KING 20000
+#define AI_INFINITY 2000000
 
 /**
-    @brief Positional bonus table for pawns.
+    @brief Evaluate a bitboard position.
+
+    O(1): the position carries its material and piece-square sums
+    (evaluation.h), kept up to date as moves are made and unmade.
+    @param[in] pos The position
+    @return s32 The total heuristic value of the position
 */
-static const s32 pawnTable[8][8] = {
-    { 0,  0,  0,  0,  0,  0,  0,  0},
-    {50, 50, 50, 50, 50, 50, 50, 50},
-    {10, 10, 20, 30, 30, 20, 10, 10},
-    { 5,  5, 10, 25, 25, 10,  5,  5},
-    { 0,  0,  0, 20, 20,  0,  0,  0},
-    { 5, -5,-10,  0,  0,-10, -5,  5},
-    { 5, 10, 10,-20,-20, 10, 10,  5},
-    { 0,  0,  0,  0,  0,  0,  0,  0}
-};
+s32 ai_evaluatePosition(const Position_st* pos) {
+    return evaluation_tapered(pos);
+}
 
 /**
-    @brief Positional bonus table for knights.
+    @brief Evaluate the entire board state.
+    @param[in] board The current chess board
+    @return s32 The total heuristic value of the board
 */
-static const s32 knightTable[8][8] = {
-    {-50,-40,-30,-30,-30,-30,-40,-50},
-    {-40,-20,  0,  0,  0,  0,-20,-40},
-    {-30,  0, 10, 15, 15, 10,  0,-30},
-    {-30,  5, 15, 20, 20, 15,  5,-30},
-    {-30,  0, 15, 20, 20, 15,  0,-30},
-    {-30,  5, 10, 15, 15, 10,  5,-30},
-    {-40,-20,  0,  5,  5,  0,-20,-40},
-    {-50,-40,-30,-30,-30,-30,-40,-50}
-};
+s32 ai_evaluateBoard(Board_t board) {
+    Position_st pos;
+    boardToPosition(board, COLOR_PIECE_WHITE, &pos);
+    return ai_evaluatePosition(&pos);
+}
 
 /**
-    @brief Positional bonus table for bishops.
+    @brief Table kept by ai_getBestMove() for the whole game, and the lock that lends it to one search at a time.
 */
-static const s32 bishopTable[8][8] = {
-    {-20,-10,-10,-10,-10,-10,-10,-20},
-    {-10,  0,  0,  0,  0,  0,  0,-10},
-    {-10,  0,  5, 10, 10,  5,  0,-10},
-    {-10,  5,  5, 10, 10,  5,  5,-10},
-    {-10,  0, 10, 10, 10, 10,  0,-10},
-    {-10, 10, 10, 10, 10, 10, 10,-10},
-    {-10,  5,  0,  0,  0,  0,  5,-10},
-    {-20,-10,-10,-10,-10,-10,-10,-20}
-};
+static TranspositionTable_st gameTable;
+static pthread_mutex_t gameTableLock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
-    @brief Positional bonus table for rooks.
+    @brief Capture ordering rank of each piece, indexed by PieceName_et (pawn < knight < bishop < rook < queen < king).
 */
-static const s32 rookTable[8][8] = {
-    { 0,  0,  0,  0,  0,  0,  0,  0},
-    { 5, 10, 10, 10, 10, 10, 10,  5},
-    {-5,  0,  0,  0,  0,  0,  0, -5},
-    {-5,  0,  0,  0,  0,  0,  0, -5},
-    {-5,  0,  0,  0,  0,  0,  0, -5},
-    {-5,  0,  0,  0,  0,  0,  0, -5},
-    {-5,  0,  0,  0,  0,  0,  0, -5},
-    { 0,  0,  0,  5,  5,  0,  0,  0}
-};
+static const s32 orderRank[7] = {0, 1, 2, 4, 3, 5, 6};
 
 /**
-    @brief Positional bonus table for the queen.
+    @brief State of one search: the position, its limits and the move-ordering memory.
 */
-static const s32 queenTable[8][8] = {
-    {-20,-10,-10, -5, -5,-10,-10,-20},
-    {-10,  0,  0,  0,  0,  0,  0,-10},
-    {-10,  0,  5,  5,  5,  5,  0,-10},
-    { -5,  0,  5,  5,  5,  5,  0, -5},
-    {  0,  0,  5,  5,  5,  5,  0, -5},
-    {-10,  5,  5,  5,  5,  5,  0,-10},
-    {-10,  0,  5,  0,  0,  0,  0,-10},
-    {-20,-10,-10, -5, -5,-10,-10,-20}
-};
+typedef struct {
+    Position_st* pos;
+    TranspositionTable_st* tt;
+    AiStats_st* stats;
+    ChessMove_t killers[CHESS_MAX_PLY][2];  ///< Quiet moves that caused a cutoff at this ply
+    s32 history[2][64][64];                 ///< [side][from][to] cutoff credit of quiet moves
+    const AiLimits_st* limits;
+    u64 startMs;                            ///< When the clock started (search start, or the end of pondering)
+    u64 deadlineMs;                         ///< 0 = no time limit (yet)
+    bool pondering;                         ///< limits->ponder was still set at the last check
+    bool stopped;                           ///< Out of time or stopped: every score on the stack is meaningless
+} SearchContext_st;
+
+static u64 nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
 
 /**
-    @brief Positional bonus table for the king.
+    @brief Starts the clock once pondering is over (the opponent played the expected move).
 */
-static const s32 kingTable[8][8] = {
-    {-30,-40,-40,-50,-50,-40,-40,-30},
-    {-30,-40,-40,-50,-50,-40,-40,-30},
-    {-30,-40,-40,-50,-50,-40,-40,-30},
-    {-30,-40,-40,-50,-50,-40,-40,-30},
-    {-20,-30,-30,-40,-40,-30,-30,-20},
-    {-10,-20,-20,-20,-20,-20,-20,-10},
-    { 20, 20,  0,  0,  0,  0, 20, 20},
-    { 20, 30, 10,  0,  0, 10, 30, 20}
-};
+static void updatePondering(SearchContext_st* ctx) {
+    if (ctx->pondering && !atomic_load_explicit(ctx->limits->ponder, memory_order_acquire)) {
+        ctx->pondering = false;
+        ctx->startMs = nowMs();
+    }
+}
 
 /**
-    @brief Calculate the heuristic value of a single piece based on its type and position.
-    @param[in] p Pointer to the piece structure
-    @param[in] x The x-coordinate of the piece
-    @param[in] y The y-coordinate of the piece
-    @return s32 The calculated value of the piece (positive for white, negative for black)
+    @brief Polls the stop flag, the ponder flag and the clock.
 */
-static s32 getPieceValue(Piece_st* p, s32 x, s32 y) {
-    if (!p) return 0;
-    s32 val = 0;
-    s32 tableX = (x < 0) ? 0 : (x > 7 ? 7 : x);
-    s32 tableY = (p->color == COLOR_PIECE_WHITE) ? (7 - y) : y;
-    tableY = (tableY < 0) ? 0 : (tableY > 7 ? 7 : tableY);
-
-    switch (p->name) {
-        case PIECE_NAME_PAWN:   val = MATERIAL_PAWN + pawnTable[tableY][tableX]; break;
-        case PIECE_NAME_PONEY:  val = MATERIAL_KNIGHT + knightTable[tableY][tableX]; break;
-        case PIECE_NAME_BISHOP: val = MATERIAL_BISHOP + bishopTable[tableY][tableX]; break;
-        case PIECE_NAME_ROOK:   val = MATERIAL_ROOK + rookTable[tableY][tableX]; break;
-        case PIECE_NAME_QUEEN:  val = MATERIAL_QUEEN + queenTable[tableY][tableX]; break;
-        case PIECE_NAME_KING:   val = MATERIAL_KING + kingTable[tableY][tableX]; break;
-        default: break;
+static void checkLimits(SearchContext_st* ctx) {
+    if (ctx->limits->stop && atomic_load_explicit(ctx->limits->stop, memory_order_relaxed)) {
+        ctx->stopped = true;
+        return;
     }
-    return (p->color == COLOR_PIECE_WHITE) ? val : -val;
+    updatePondering(ctx);
+    if (ctx->deadlineMs && nowMs() >= ctx->deadlineMs) ctx->stopped = true;
 }
 
 /**
-    @brief Evaluate the entire board state.
-    @param[in] board The current chess board
-    @return s32 The total heuristic value of the board
+    @brief Counts a node and checks the limits every 1024 of them.
+    @return true if the search must unwind
 */
-s32 ai_evaluateBoard(Board_t board) {
-    s32 total = 0;
-    for (s32 y = 0; y < 8; y++) {
-        for (s32 x = 0; x < 8; x++) {
-            total += getPieceValue(board[y][x], x, y);
+static inline bool visitNode(SearchContext_st* ctx) {
+    if ((++ctx->stats->nodes & 1023) == 0) {
+        checkLimits(ctx);
+        // The deadline is armed after the first iteration, and only once pondering is over
+        if (ctx->deadlineMs == 0 && ctx->stats->depth > 0 && !ctx->pondering && ctx->limits->timeMs) {
+            ctx->deadlineMs = ctx->startMs + ctx->limits->timeMs;
+        }
+    }
+    return ctx->stopped;
+}
+
+/**
+    @brief Static evaluation from the side to move's point of view.
+*/
+static inline s32 evaluateForSide(const Position_st* pos) {
+    s32 eval = ai_evaluatePosition(pos);
+    return pos->side == COLOR_PIECE_WHITE ? eval : -eval;
+}
+
+/**
+    @brief True if `score` is a mate score (either side).
+*/
+static inline bool isMateScore(s32 score) {
+    return score > AI_MATE_SCORE - CHESS_MAX_PLY || score < -AI_MATE_SCORE + CHESS_MAX_PLY;
+}
+
+/**
+    @brief Mate scores count plies from the root; the table stores them from the node so they stay valid elsewhere.
+*/
+static inline s32 scoreToTable(s32 score, u32 ply) {
+    if (!isMateScore(score)) return score;
+    return score > 0 ? score + (s32)ply : score - (s32)ply;
+}
+
+static inline s32 scoreFromTable(s32 score, u32 ply) {
+    if (!isMateScore(score)) return score;
+    return score > 0 ? score - (s32)ply : score + (s32)ply;
+}
+
+/**
+    @brief Search score of a table result `ply` plies from the root (mates beyond CHESS_MAX_PLY are clamped below the mate band).
+*/
+static inline s32 tablebaseScore(const TablebaseProbe_st* tb, u32 ply) {
+    if (tb->wdl == TABLEBASE_DRAW) return 0;
+    u32 matePly = ply + tb->pliesToMate;
+    s32 score = matePly < CHESS_MAX_PLY ? AI_MATE_SCORE - (s32)matePly : AI_MATE_SCORE - CHESS_MAX_PLY;
+    return tb->wdl == TABLEBASE_WIN ? score : -score;
+}
+
+static inline bool isCapture(const Position_st* pos, ChessMove_t move) {
+    return pos->squares[MOVE_TO(move)] != 0 || MOVE_FLAG(move) == MOVE_FLAG_EN_PASSANT;
+}
+
+#define ORDER_HASH_MOVE (1 << 30)
+#define ORDER_CAPTURE   (1 << 28)   ///< + MVV-LVA
+#define ORDER_KILLER    (1 << 27)
+#define HISTORY_MAX     (1 << 24)   ///< History is halved past this so it stays below the killers
+
+/**
+    @brief Ordering score of every move: hash move, captures and queen promotions (most valuable
+    victim, then least valuable attacker), killers, then quiet moves by history.
+*/
+static void scoreMoves(const SearchContext_st* ctx, const MoveList_st* moves, s32 scores[], ChessMove_t hashMove, u32 ply) {
+    const Position_st* pos = ctx->pos;
+    for (u32 i = 0; i < moves->count; i++) {
+        ChessMove_t move = moves->moves[i];
+        u32 from = MOVE_FROM(move), to = MOVE_TO(move);
+
+        if (move == hashMove) {
+            scores[i] = ORDER_HASH_MOVE;
+        } else if (isCapture(pos, move) || MOVE_FLAG(move) == MOVE_FLAG_PROMO_QUEEN) {
+            PieceName_et victim = MOVE_FLAG(move) == MOVE_FLAG_EN_PASSANT ? PIECE_NAME_PAWN : SQUARE_PIECE_NAME(pos->squares[to]);
+            s32 promotion = MOVE_FLAG(move) == MOVE_FLAG_PROMO_QUEEN ? orderRank[PIECE_NAME_QUEEN] : 0;
+            scores[i] = ORDER_CAPTURE + (orderRank[victim] + promotion) * 8 - orderRank[SQUARE_PIECE_NAME(pos->squares[from])];
+        } else if (MOVE_IS_PROMOTION(move)) {
+            scores[i] = -1;     // Under-promotions last
+        } else if (ply < CHESS_MAX_PLY && move == ctx->killers[ply][0]) {
+            scores[i] = ORDER_KILLER + 1;
+        } else if (ply < CHESS_MAX_PLY && move == ctx->killers[ply][1]) {
+            scores[i] = ORDER_KILLER;
+        } else {
+            scores[i] = ctx->history[pos->side][from][to];
         }
     }
-    return total;
 }
 
 /**
-    @brief Simulate a move on the board.
-    @param[in,out] board The game board
-    @param[in]     from  Starting coordinates of the move
-    @param[in]     to    Ending coordinates of the move
-    @return Piece_st* Pointer to the captured piece, if any
+    @brief Swaps the best-scored remaining move into slot `i` (selection sort, one step per move tried).
+*/
+static inline ChessMove_t pickNext(MoveList_st* moves, s32 scores[], u32 i) {
+    u32 best = i;
+    for (u32 j = i + 1; j < moves->count; j++) {
+        if (scores[j] > scores[best]) best = j;
+    }
+    ChessMove_t move = moves->moves[best];
+    s32 score = scores[best];
+    moves->moves[best] = moves->moves[i];
+    scores[best] = scores[i];
+    moves->moves[i] = move;
+    scores[i] = score;
+    return move;
+}
+
+/**
+    @brief Remembers a quiet move that refuted the node.
 */
-static Piece_st* simulateMove(Board_t board, IVec2_st from, IVec2_st to) {
-    Piece_st* moving = board[from.y][from.x];
-    Piece_st* captured = board[to.y][to.x];
-    
-    if (captured) captured->isTaken = true;
-    
-    board[to.y][to.x] = moving;
-    board[from.y][from.x] = NULL;
-    moving->pos = to;
-    
-    return captured;
+static void rewardQuiet(SearchContext_st* ctx, ChessMove_t move, u8 depth, u32 ply) {
+    if (ply < CHESS_MAX_PLY && ctx->killers[ply][0] != move) {
+        ctx->killers[ply][1] = ctx->killers[ply][0];
+        ctx->killers[ply][0] = move;
+    }
+
+    s32* entry = &ctx->history[ctx->pos->side][MOVE_FROM(move)][MOVE_TO(move)];
+    *entry += (s32)depth * depth;
+    if (*entry > HISTORY_MAX) {
+        s32* all = &ctx->history[0][0][0];
+        for (u32 i = 0; i < 2 * 64 * 64; i++) all[i] /= 2;
+    }
 }
 
 /**
-    @brief Undo a previously simulated move.
-    @param[in,out] board    The game board
-    @param[in]     from     Starting coordinates of the move being undone
-    @param[in]     to       Ending coordinates of the move being undone
-    @param[in,out] captured The piece that was captured during the simulated move
+    @brief Quiescence search: only captures and promotions, so leaves are evaluated once the position is quiet.
+
+    The side to move may "stand pat" on the static evaluation instead of
+    capturing. In check there is no standing pat: every evasion is tried.
+    @return Score from the side to move's point of view
 */
-static void undoMove(Board_t board, IVec2_st from, IVec2_st to, Piece_st* captured) {
-    Piece_st* moving = board[to.y][to.x];
-    
-    board[from.y][from.x] = moving;
-    board[to.y][to.x] = captured;
-    moving->pos = from;
-    if (captured) captured->isTaken = false;
+static s32 quiescence(SearchContext_st* ctx, u32 ply, s32 alpha, s32 beta) {
+    Position_st* pos = ctx->pos;
+    if (visitNode(ctx)) return 0;
+    if (ply >= CHESS_MAX_PLY - 1) return evaluateForSide(pos);
+
+    bool inCheck = position_inCheck(pos);
+    s32 best = -AI_INFINITY;
+    if (!inCheck) {
+        best = evaluateForSide(pos);
+        if (best >= beta) return best;
+        if (best > alpha) alpha = best;
+    }
+
+    MoveList_st moves;
+    s32 scores[CHESS_MAX_MOVES];
+    if (inCheck) position_generatePseudoLegal(pos, &moves);
+    else         position_generateTactical(pos, &moves);
+    scoreMoves(ctx, &moves, scores, MOVE_NONE, CHESS_MAX_PLY);
+
+    bool anyLegal = false;
+    for (u32 i = 0; i < moves.count; i++) {
+        ChessMove_t move = pickNext(&moves, scores, i);
+        if (!inCheck && MOVE_IS_PROMOTION(move) && MOVE_FLAG(move) != MOVE_FLAG_PROMO_QUEEN) continue;
+        if (!position_isLegal(pos, move)) continue;
+        anyLegal = true;
+
+        PositionUndo_st undo;
+        position_makeMove(pos, move, &undo);
+        s32 score = -quiescence(ctx, ply + 1, -beta, -alpha);
+        position_unmakeMove(pos, move, &undo);
+        if (ctx->stopped) return 0;
+
+        if (score > best) {
+            best = score;
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+    }
+
+    if (inCheck && !anyLegal) return -AI_MATE_SCORE + (s32)ply;
+    return best;
 }
 
 /**
-    @brief Minimax algorithm with alpha-beta pruning.
-    @param[in,out] board        The game board
-    @param[in]     white        Pointer to the white player structure
-    @param[in]     black        Pointer to the black player structure
-    @param[in]     depth        Current search depth
-    @param[in]     alpha        Alpha value for pruning
-    @param[in]     beta         Beta value for pruning
-    @param[in]     isMaximizing True if the current player is maximizing
-    @return s32 The best evaluated value for the current branch
+    @brief Negamax alpha-beta search.
+    @param[in,out] ctx    Search state; ctx->pos is restored on return
+    @param[in]     depth  Plies left before the quiescence search
+    @param[in]     ply    Distance from the root
+    @param[in]     alpha  Score the side to move is already sure of
+    @param[in]     beta   Score the opponent is already sure of
+    @return Score from the side to move's point of view
 */
-static s32 minimax(Board_t board, Player_st* white, Player_st* black, u8 depth, s32 alpha, s32 beta, bool isMaximizing) {
-    if (depth == 0) return ai_evaluateBoard(board);
-
-    Player_st* currentPlayer = isMaximizing ? white : black;
-    if (!currentPlayer) return 0;
-
-    s32 bestVal = isMaximizing ? -2000000 : 2000000;
-
-    for (s32 i = 0; i < PIECES_PER_PLAYER; i++) {
-        Piece_st* p = currentPlayer->pieces[i];
-        if (!p || p->isTaken) continue;
-
-        IVec2_st from = p->pos;
-        for (s32 ty = 0; ty < 8; ty++) {
-            for (s32 tx = 0; tx < 8; tx++) {
-                if (canBePlaced(board, p, tx, ty)) {
-                    if (!isInCheck(board, p, tx, ty, isMaximizing ? 0 : 1)) {
-                        IVec2_st to = {tx, ty};
-                        Piece_st* captured = simulateMove(board, from, to);
-                        if (!board[to.y][to.x]) { // Safety check if simulateMove failed
-                             undoMove(board, from, to, captured);
-                             continue;
-                        }
-
-                        s32 val = minimax(board, white, black, depth - 1, alpha, beta, !isMaximizing);
-
-                        undoMove(board, from, to, captured);
-
-                        if (isMaximizing) {
-                            if (val > bestVal) bestVal = val;
-                            if (bestVal > alpha) alpha = bestVal;
-                        } else {
-                            if (val < bestVal) bestVal = val;
-                            if (bestVal < beta) beta = bestVal;
-                        }
-                        if (beta <= alpha) return bestVal;
-                    }
+static s32 alphaBeta(SearchContext_st* ctx, u8 depth, u32 ply, s32 alpha, s32 beta) {
+    if (depth == 0 || ply >= CHESS_MAX_PLY - 1) return quiescence(ctx, ply, alpha, beta);
+
+    Position_st* pos = ctx->pos;
+    AiStats_st* stats = ctx->stats;
+    if (visitNode(ctx)) return 0;
+
+    TablebaseProbe_st tb;
+    if (bitboard_count(pos->occupied) <= TABLEBASE_MAX_PIECES && tablebase_probe(pos, &tb)) {
+        stats->tbHits++;
+        return tablebaseScore(&tb, ply);
+    }
+
+    ChessMove_t hashMove = MOVE_NONE;
+    if (ctx->tt) {
+        TTHit_st hit;
+        stats->ttProbes++;
+        if (tt_probe(ctx->tt, pos->hash, &hit)) {
+            stats->ttHits++;
+            hashMove = hit.move;
+            if (hit.depth >= depth) {
+                s32 score = scoreFromTable(hit.score, ply);
+                if (hit.bound == TT_BOUND_EXACT ||
+                    (hit.bound == TT_BOUND_LOWER && score >= beta) ||
+                    (hit.bound == TT_BOUND_UPPER && score <= alpha)) {
+                    stats->ttCutoffs++;
+                    return score;
                 }
             }
         }
     }
-    return bestVal;
+
+    MoveList_st moves;
+    s32 scores[CHESS_MAX_MOVES];
+    position_generatePseudoLegal(pos, &moves);
+    scoreMoves(ctx, &moves, scores, hashMove, ply);
+
+    s32 alphaOrig = alpha;
+    s32 best = -AI_INFINITY;
+    ChessMove_t bestMove = MOVE_NONE;
+
+    for (u32 i = 0; i < moves.count; i++) {
+        ChessMove_t move = pickNext(&moves, scores, i);
+        if (!position_isLegal(pos, move)) continue;
+
+        bool quiet = !isCapture(pos, move) && !MOVE_IS_PROMOTION(move);
+        PositionUndo_st undo;
+        position_makeMove(pos, move, &undo);
+        s32 score = -alphaBeta(ctx, depth - 1, ply + 1, -beta, -alpha);
+        position_unmakeMove(pos, move, &undo);
+        if (ctx->stopped) return 0;
+
+        if (score > best) {
+            best = score;
+            bestMove = move;
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) {
+                if (quiet) rewardQuiet(ctx, move, depth, ply);
+                break;
+            }
+        }
+    }
+
+    if (bestMove == MOVE_NONE) {
+        // Mated (the closer to the root, the worse) or stalemate
+        return position_inCheck(pos) ? -AI_MATE_SCORE + (s32)ply : 0;
+    }
+
+    if (ctx->tt) {
+        TTBound_et bound = best <= alphaOrig ? TT_BOUND_UPPER : best >= beta ? TT_BOUND_LOWER : TT_BOUND_EXACT;
+        tt_store(ctx->tt, pos->hash, scoreToTable(best, ply), bestMove, depth, bound);
+    }
+    return best;
 }
 
 /**
-    @brief Find the best move for a player using minimax.
-    @param[in,out] board  The game board
-    @param[in]     white  Pointer to the white player structure
-    @param[in]     black  Pointer to the black player structure
-    @param[in]     player The current player (0 for white, 1 for black)
-    @param[in]     depth  Search depth
-    @return ChessMove_st The best move found
+    @brief One iteration at the root, best move of the previous one first.
+    @param[in,out] moves      Legal root moves, reordered best first on return
+    @param[out]    bestScore  Score of moves->moves[0] for the side to move
+    @return Number of root moves fully searched (all of them unless time ran out)
+*/
+static u32 searchRoot(SearchContext_st* ctx, MoveList_st* moves, u8 depth, s32* bestScore) {
+    Position_st* pos = ctx->pos;
+    s32 alpha = -AI_INFINITY, beta = AI_INFINITY;
+    u32 bestIndex = 0, searched = 0;
+
+    ctx->stats->nodes++;
+    for (u32 i = 0; i < moves->count; i++) {
+        PositionUndo_st undo;
+        position_makeMove(pos, moves->moves[i], &undo);
+        s32 score = -alphaBeta(ctx, depth - 1, 1, -beta, -alpha);
+        position_unmakeMove(pos, moves->moves[i], &undo);
+        if (ctx->stopped) break;
+
+        searched++;
+        if (score > alpha) {
+            alpha = score;
+            bestIndex = i;
+        }
+    }
+
+    if (searched > 0) {
+        ChessMove_t best = moves->moves[bestIndex];
+        memmove(&moves->moves[1], &moves->moves[0], bestIndex * sizeof(ChessMove_t));
+        moves->moves[0] = best;
+        *bestScore = alpha;
+        if (ctx->tt && !ctx->stopped) tt_store(ctx->tt, pos->hash, scoreToTable(alpha, 0), best, depth, TT_BOUND_EXACT);
+    }
+    return searched;
+}
+
+/**
+    @brief A Lazy SMP helper thread: searches the same root into the shared table until the main search ends.
+*/
+typedef struct {
+    pthread_t thread;
+    Position_st pos;            ///< Private copy of the root
+    MoveList_st moves;          ///< Private copy of the root moves
+    AiLimits_st limits;         ///< No clock; `stop` is raised when the main search returns
+    TranspositionTable_st* tt;
+    AiStats_st stats;
+    u8 firstDepth;              ///< Odd helpers start one ply deeper, so threads spread over two depths
+} SearchHelper_st;
+
+static void* helperMain(void* arg) {
+    SearchHelper_st* helper = arg;
+    SearchContext_st ctx;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.pos = &helper->pos;
+    ctx.tt = helper->tt;
+    ctx.stats = &helper->stats;
+    ctx.limits = &helper->limits;
+    ctx.startMs = nowMs();
+
+    for (u8 depth = helper->firstDepth; depth <= helper->limits.depth; depth++) {
+        s32 score;
+        searchRoot(&ctx, &helper->moves, depth, &score);
+        if (ctx.stopped) break;
+        helper->stats.depth = depth;
+    }
+    return NULL;
+}
+
+/**
+    @brief Starts `count` helpers on copies of the root.
+    @return Number of helpers actually running
+*/
+static u32 startHelpers(SearchHelper_st* helpers, u32 count, const Position_st* pos, const MoveList_st* moves,
+                        u8 maxDepth, TranspositionTable_st* tt, const atomic_bool* halt) {
+    u32 started = 0;
+    for (u32 i = 0; i < count; i++) {
+        SearchHelper_st* helper = &helpers[started];
+        memset(helper, 0, sizeof(*helper));
+        helper->pos = *pos;
+        helper->moves = *moves;
+        helper->limits = (AiLimits_st) {.depth = maxDepth, .timeMs = 0, .stop = halt, .ponder = NULL, .threads = 1};
+        helper->tt = tt;
+        helper->firstDepth = (u8)(1 + ((i + 1) & 1));
+        if (pthread_create(&helper->thread, NULL, helperMain, helper) == 0) started++;
+    }
+    return started;
+}
+
+/**
+    @brief The move to play, with `score` turned to White's point of view.
 */
-ChessMove_st ai_getBestMove(Board_t board, Player_st* white, Player_st* black, s32 player, u8 depth) {
-    ChessMove_st bestMove = {{-1, -1}, {-1, -1}, (player == 0) ? -2000000 : 2000000};
-    bool isMaximizing = (player == 0);
-    s32 alpha = -2000000;
-    s32 beta = 2000000;
-
-    // Hard limit depth to 2 to prevent stack overflow/crash during intensive simulation
-    if (depth > 2) depth = 2;
-
-    Player_st* currentPlayer = isMaximizing ? white : black;
-    if (!currentPlayer) return bestMove;
-
-    for (s32 i = 0; i < PIECES_PER_PLAYER; i++) {
-        Piece_st* p = currentPlayer->pieces[i];
-        if (!p || p->isTaken) continue;
-
-        IVec2_st from = p->pos;
-        for (s32 ty = 0; ty < 8; ty++) {
-            for (s32 tx = 0; tx < 8; tx++) {
-                if (canBePlaced(board, p, tx, ty)) {
-                    if (!isInCheck(board, p, tx, ty, player)) {
-                        IVec2_st to = {tx, ty};
-                        Piece_st* captured = simulateMove(board, from, to);
-                        if (!board[to.y][to.x]) {
-                            undoMove(board, from, to, captured);
-                            continue;
-                        }
-
-                        s32 val = minimax(board, white, black, depth - 1, alpha, beta, !isMaximizing);
-
-                        undoMove(board, from, to, captured);
-
-                        if (isMaximizing) {
-                            if (val > bestMove.score) {
-                                bestMove.score = val;
-                                bestMove.from = from;
-                                bestMove.to = to;
-                            }
-                        } else {
-                            if (val < bestMove.score) {
-                                bestMove.score = val;
-                                bestMove.from = from;
-                                bestMove.to = to;
-                            }
-                        }
-                    }
+static ChessMove_st makeResult(const Position_st* pos, ChessMove_t move, s32 score) {
+    ChessMove_st result;
+    result.move = move;
+    result.score = pos->side == COLOR_PIECE_WHITE ? score : -score;
+    result.from = (IVec2_st) {SQUARE_X(MOVE_FROM(move)), SQUARE_Y(MOVE_FROM(move))};
+    result.to = (IVec2_st) {SQUARE_X(MOVE_TO(move)), SQUARE_Y(MOVE_TO(move))};
+    return result;
+}
+
+/**
+    @brief Find the best move of the side to move in a bitboard position.
+
+    Iterative deepening: depth 1, 2, ... until the depth or time limit, or
+    until limits->stop is set. While limits->ponder is set the clock does
+    not run; it starts when the flag is cleared.
+    Every iteration fills the killers, history and table that order the
+    next one, so reaching depth n this way costs little more than a
+    direct depth-n search. When time runs out mid-iteration, the moves
+    already searched at that depth still count (the previous best is
+    always among them, being searched first).
+
+    With limits->threads > 1 and a table, this is Lazy SMP: helper
+    threads search the same root on their own copies, sharing only the
+    table. Their entries cut and order this thread's search; the move
+    played is always this thread's.
+    @param[in,out] pos    The position, restored on return
+    @param[in]     limits When to stop
+    @param[in,out] tt     Transposition table, may be NULL
+    @param[out]    stats  Search counters, may be NULL
+    @return ChessMove_st The best move found, score from White's point of view
+*/
+ChessMove_st ai_searchPosition(Position_st* pos, const AiLimits_st* limits, TranspositionTable_st* tt, AiStats_st* stats) {
+    ChessMove_st result = {{-1, -1}, {-1, -1}, 0, MOVE_NONE};
+    AiStats_st localStats;
+    SearchContext_st ctx;
+
+    if (!stats) stats = &localStats;
+    memset(stats, 0, sizeof(*stats));
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.pos = pos;
+    ctx.tt = tt;
+    ctx.stats = stats;
+    ctx.limits = limits;
+    ctx.startMs = nowMs();
+    ctx.pondering = limits->ponder && atomic_load_explicit(limits->ponder, memory_order_acquire);
+    u8 maxDepth = (limits->depth == 0 || limits->depth >= CHESS_MAX_PLY) ? CHESS_MAX_PLY - 1 : limits->depth;
+
+    MoveList_st moves;
+    position_generateLegal(pos, &moves);
+    if (moves.count == 0) {
+        result.score = position_inCheck(pos) ? (pos->side == COLOR_PIECE_WHITE ? -AI_MATE_SCORE : AI_MATE_SCORE) : 0;
+        return result;
+    }
+
+    // Book and table moves are played at once
+    TablebaseProbe_st tb;
+    ChessMove_t known = limits->book ? book_probe(limits->book, pos, (u32)(nowMs() ^ pos->hash)) : MOVE_NONE;
+    s32 knownScore = 0;
+    if (known == MOVE_NONE && (known = tablebase_bestMove(pos, &tb)) != MOVE_NONE) {
+        stats->tbHits++;
+        knownScore = tablebaseScore(&tb, 0);
+    }
+    if (known != MOVE_NONE) return makeResult(pos, known, knownScore);
+
+    if (tt) {
+        TTHit_st hit;
+        tt_newSearch(tt);
+        if (tt_probe(tt, pos->hash, &hit)) {
+            for (u32 i = 1; i < moves.count; i++) {
+                if (moves.moves[i] == hit.move) {
+                    moves.moves[i] = moves.moves[0];
+                    moves.moves[0] = hit.move;
                 }
             }
         }
     }
-    return bestMove;
+
+    atomic_bool halt;
+    atomic_init(&halt, false);
+    u32 helperCount = 0;
+    SearchHelper_st* helpers = NULL;
+    if (tt && limits->threads > 1) {
+        u32 wanted = (limits->threads < AI_MAX_THREADS ? limits->threads : AI_MAX_THREADS) - 1;
+        helpers = malloc(wanted * sizeof(*helpers));
+        if (helpers) helperCount = startHelpers(helpers, wanted, pos, &moves, maxDepth, tt, &halt);
+    }
+
+    s32 bestScore = 0;
+    for (u8 depth = 1; depth <= maxDepth; depth++) {
+        s32 score;
+        // Depth 1 runs without a deadline so there is always a move to play
+        u32 searched = searchRoot(&ctx, &moves, depth, &score);
+        if (searched == 0) break;
+
+        bestScore = score;
+        if (ctx.stopped) break;
+        stats->depth = depth;
+
+        // While pondering, keep deepening until the opponent moves or the search is stopped
+        updatePondering(&ctx);
+        if (ctx.pondering) continue;
+
+        // A forced mate will not change, and the next iteration would not finish in the time left
+        if (isMateScore(score) || moves.count == 1) break;
+        if (limits->timeMs && (nowMs() - ctx.startMs) * 2 > limits->timeMs) break;
+    }
+
+    atomic_store_explicit(&halt, true, memory_order_relaxed);
+    for (u32 i = 0; i < helperCount; i++) {
+        pthread_join(helpers[i].thread, NULL);
+        stats->nodes += helpers[i].stats.nodes;
+        stats->ttProbes += helpers[i].stats.ttProbes;
+        stats->ttHits += helpers[i].stats.ttHits;
+        stats->ttCutoffs += helpers[i].stats.ttCutoffs;
+        stats->tbHits += helpers[i].stats.tbHits;
+    }
+    free(helpers);
+
+    return makeResult(pos, moves.moves[0], bestScore);
+}
+
+/**
+    @brief Find the best move for a player within a time budget.
+
+    Searches with the game's transposition table, so positions analysed
+    while thinking about the previous moves are not searched again. A
+    call made while another one holds the table searches without one.
+    @param[in] board  The game board
+    @param[in] player The current player (0 for white, 1 for black)
+    @param[in] timeMs Thinking time in milliseconds
+    @return ChessMove_st The best move found
+*/
+ChessMove_st ai_getBestMove(Board_t board, s32 player, u32 timeMs) {
+    Position_st pos;
+    AiLimits_st limits = {.depth = 0, .timeMs = timeMs > 0 ? timeMs : 1};
+    boardToPosition(board, player, &pos);
+    if (pthread_mutex_trylock(&gameTableLock) != 0) return ai_searchPosition(&pos, &limits, NULL, NULL);
+
+    if (!gameTable.buckets) tt_init(&gameTable, TT_DEFAULT_MB);
+    ChessMove_st best = ai_searchPosition(&pos, &limits, gameTable.buckets ? &gameTable : NULL, NULL);
+    pthread_mutex_unlock(&gameTableLock);
+    return best;
+}
+
+/**
+    @brief Forget what the previous game taught the search.
+*/
+void ai_clearMemory(void) {
+    pthread_mutex_lock(&gameTableLock);
+    tt_clear(&gameTable);
+    pthread_mutex_unlock(&gameTableLock);
 }
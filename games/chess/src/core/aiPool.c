@@ -0,0 +1,82 @@
+/**
+    @file aiPool.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Background AI searches shared by many games (see aiPool.h).
+*/
+#include "aiPool.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+    @brief A pooled worker and its lease.
+*/
+typedef struct {
+    AiWorker_st worker;         ///< First member: a worker pointer is a slot pointer
+    u64 lastGame;               ///< Game whose positions fill the table (0: none)
+    bool leased;
+} AiPoolSlot_st;
+
+static AiPoolSlot_st* slots;
+static u32 slotCount;
+static OpeningBook_st book;             ///< Shared by every worker, open for the life of the process
+static pthread_once_t poolOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_uint_fast64_t nextGameId = 1;
+
+/**
+    @brief Starts one worker per core, up to AI_POOL_MAX_WORKERS; they live as long as the process.
+*/
+static void startPool(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    u32 count = cores < 1 ? 1 : cores > AI_POOL_MAX_WORKERS ? AI_POOL_MAX_WORKERS : (u32)cores;
+
+    slots = calloc(count, sizeof(*slots));
+    if (!slots) return;
+    book_load(&book, BOOK_PATH, BOOK_SOURCE_PATH);   // No book: the bots search from the first move
+    for (u32 i = 0; i < count; i++) {
+        if (!aiWorker_start(&slots[slotCount].worker, AI_POOL_TT_MB, 1)) continue;
+        aiWorker_setBook(&slots[slotCount].worker, &book);
+        slotCount++;
+    }
+}
+
+u64 aiPool_newGameId(void) {
+    return atomic_fetch_add_explicit(&nextGameId, 1, memory_order_relaxed);
+}
+
+AiWorker_st* aiPool_acquire(u64 gameId) {
+    pthread_once(&poolOnce, startPool);
+
+    AiPoolSlot_st* chosen = NULL;
+    pthread_mutex_lock(&poolLock);
+    for (u32 i = 0; i < slotCount; i++) {
+        if (slots[i].leased) continue;
+        if (!chosen || slots[i].lastGame == gameId) chosen = &slots[i];
+        if (chosen->lastGame == gameId) break;
+    }
+    if (chosen) {
+        if (chosen->lastGame != gameId) aiWorker_newGame(&chosen->worker);
+        chosen->lastGame = gameId;
+        chosen->leased = true;
+    }
+    pthread_mutex_unlock(&poolLock);
+    return chosen ? &chosen->worker : NULL;
+}
+
+void aiPool_release(AiWorker_st* worker) {
+    AiPoolSlot_st* slot = (AiPoolSlot_st*)worker;
+    aiWorker_cancel(worker);
+
+    pthread_mutex_lock(&poolLock);
+    slot->leased = false;
+    pthread_mutex_unlock(&poolLock);
+}
+
+u32 aiPool_size(void) {
+    pthread_mutex_lock(&poolLock);
+    u32 count = slotCount;
+    pthread_mutex_unlock(&poolLock);
+    return count;
+}
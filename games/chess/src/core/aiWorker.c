@@ -0,0 +1,211 @@
+/**
+    @file aiWorker.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Chess AI search on a background thread (see aiWorker.h).
+*/
+#include "aiWorker.h"
+#include "tablebase.h"
+
+#include <string.h>
+
+/**
+    @brief Makes the guessed reply of a ponder job.
+    @return false if the table has no legal guess
+*/
+static bool playGuessedReply(AiWorker_st* worker, Position_st* pos) {
+    TTHit_st hit;
+    if (!tt_probe(&worker->tt, pos->hash, &hit) || hit.move == MOVE_NONE) return false;
+
+    ChessMove_t reply = position_findMove(pos, MOVE_FROM(hit.move), MOVE_TO(hit.move), position_promotionPiece(hit.move));
+    if (reply == MOVE_NONE) return false;
+
+    PositionUndo_st undo;
+    position_makeMove(pos, reply, &undo);
+    return true;
+}
+
+static pthread_once_t tablesOnce = PTHREAD_ONCE_INIT;
+
+static void* tablesMain(void* arg) {
+    (void)arg;
+    tablebase_init();
+    return NULL;
+}
+
+/**
+    @brief Builds the endgame tables on a detached thread, off every job's path.
+*/
+static void startTables(void) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, tablesMain, NULL) == 0) pthread_detach(thread);
+}
+
+static void* workerMain(void* arg) {
+    AiWorker_st* worker = arg;
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (!worker->hasJob && !worker->quit) pthread_cond_wait(&worker->wake, &worker->lock);
+        if (worker->quit) break;
+
+        if (worker->clearTable) {
+            tt_clear(&worker->tt);
+            worker->clearTable = false;
+        }
+
+        Position_st pos = worker->jobPosition;
+        AiLimits_st limits = {
+            .depth = 0, .timeMs = worker->jobTimeMs, .stop = &worker->stop, .ponder = &worker->ponder, .threads = worker->threads,
+            .book = worker->book
+        };
+        u32 id = worker->jobId;
+        worker->hasJob = false;
+        worker->finished = false;
+        atomic_store_explicit(&worker->stop, false, memory_order_relaxed);
+
+        if (worker->jobPonder) {
+            if (!playGuessedReply(worker, &pos)) {
+                worker->state = AI_WORKER_IDLE;
+                continue;
+            }
+            worker->ponderHash = pos.hash;
+        }
+        pthread_mutex_unlock(&worker->lock);
+
+        AiStats_st stats;
+        ChessMove_st best = ai_searchPosition(&pos, &limits, &worker->tt, &stats);
+
+        pthread_mutex_lock(&worker->lock);
+        if (id != worker->jobId) continue;     // Replaced or cancelled meanwhile
+
+        worker->result = best;
+        worker->stats = stats;
+        worker->finished = true;
+        if (worker->state == AI_WORKER_THINKING) worker->state = AI_WORKER_DONE;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+bool aiWorker_start(AiWorker_st* worker, u32 ttMegabytes, u8 threads) {
+    memset(worker, 0, sizeof(*worker));
+    if (!tt_init(&worker->tt, ttMegabytes)) return false;
+    worker->threads = threads;
+
+    atomic_init(&worker->stop, false);
+    atomic_init(&worker->ponder, false);
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+
+    if (pthread_create(&worker->thread, NULL, workerMain, worker) != 0) {
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        tt_free(&worker->tt);
+        return false;
+    }
+    worker->running = true;
+    pthread_once(&tablesOnce, startTables);
+    return true;
+}
+
+void aiWorker_setBook(AiWorker_st* worker, const OpeningBook_st* book) {
+    pthread_mutex_lock(&worker->lock);
+    worker->book = book;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void aiWorker_shutdown(AiWorker_st* worker) {
+    if (!worker->running) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->quit = true;
+    atomic_store_explicit(&worker->stop, true, memory_order_relaxed);
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+    tt_free(&worker->tt);
+    worker->running = false;
+}
+
+/**
+    @brief Replaces the job in progress (lock held).
+*/
+static void postJob(AiWorker_st* worker, const Position_st* pos, u32 timeMs, bool ponder) {
+    atomic_store_explicit(&worker->stop, true, memory_order_relaxed);
+    atomic_store_explicit(&worker->ponder, ponder, memory_order_release);
+    worker->jobPosition = *pos;
+    worker->jobTimeMs = timeMs;
+    worker->jobPonder = ponder;
+    worker->jobId++;
+    worker->hasJob = true;
+    worker->finished = false;
+    worker->state = ponder ? AI_WORKER_PONDERING : AI_WORKER_THINKING;
+    pthread_cond_signal(&worker->wake);
+}
+
+void aiWorker_think(AiWorker_st* worker, const Position_st* pos, u32 timeMs) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->state == AI_WORKER_PONDERING && !worker->hasJob && worker->ponderHash == pos->hash) {
+        // Ponder hit: the running search is already on this position, start its clock
+        atomic_store_explicit(&worker->ponder, false, memory_order_release);
+        worker->state = worker->finished ? AI_WORKER_DONE : AI_WORKER_THINKING;
+    } else {
+        postJob(worker, pos, timeMs, false);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void aiWorker_ponder(AiWorker_st* worker, const Position_st* pos, u32 timeMs) {
+    pthread_mutex_lock(&worker->lock);
+    postJob(worker, pos, timeMs, true);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void aiWorker_moveNow(AiWorker_st* worker) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->state == AI_WORKER_THINKING) {
+        // Not picked up yet: search depth 1 only (the deadline is armed right after it)
+        if (worker->hasJob) worker->jobTimeMs = 1;
+        else atomic_store_explicit(&worker->stop, true, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void aiWorker_cancel(AiWorker_st* worker) {
+    pthread_mutex_lock(&worker->lock);
+    atomic_store_explicit(&worker->stop, true, memory_order_relaxed);
+    worker->jobId++;
+    worker->hasJob = false;
+    worker->state = AI_WORKER_IDLE;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void aiWorker_newGame(AiWorker_st* worker) {
+    aiWorker_cancel(worker);
+    pthread_mutex_lock(&worker->lock);
+    worker->clearTable = true;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+bool aiWorker_poll(AiWorker_st* worker, ChessMove_st* out) {
+    bool ready = false;
+    pthread_mutex_lock(&worker->lock);
+    if (worker->state == AI_WORKER_DONE) {
+        *out = worker->result;
+        worker->state = AI_WORKER_IDLE;
+        ready = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return ready;
+}
+
+AiWorkerState_et aiWorker_state(AiWorker_st* worker) {
+    pthread_mutex_lock(&worker->lock);
+    AiWorkerState_et state = worker->state;
+    pthread_mutex_unlock(&worker->lock);
+    return state;
+}
@@ -2,7 +2,7 @@
     @file algo.c
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Game logic and algorithms for Chess.
 */
 #include "algo.h"
@@ -11,7 +11,7 @@
 #include "rendering.h"
 #include "event.h"
 #include "error.h"
-#include "audio.h"
+#include "board.h"
 
 /**
     @brief Select a piece on the board.
@@ -36,11 +36,7 @@ bool movement(Board_t board, Piece_st* selectionnedPiece, IVec2_st boardPos) {
 
     IVec2_st posDeb;
 
-    if (!canBePlaced(board, selectionnedPiece, boardPos.x, boardPos.y)) {
-        return false;
-    }
-
-    if (!isInCheck(board, selectionnedPiece, boardPos.x, boardPos.y, playerTurn)) {
+    if (boardFindLegalMove(board, playerTurn, selectionnedPiece->pos, boardPos, PIECE_NAME_NONE) != MOVE_NONE) {
         selectionnedPiece->canRock = true;
 
         if (selectionnedPiece->name == PIECE_NAME_KING && ((selectionnedPiece->pos.x == 4 && selectionnedPiece->pos.y == 0 && ((boardPos.x == 2 && boardPos.y == 0) || (boardPos.x == 6 && boardPos.y == 0))) || ((selectionnedPiece->pos.x == 4 && selectionnedPiece->pos.y == 7) && ((boardPos.x == 2 && boardPos.y == 7) || (boardPos.x == 6 && boardPos.y == 7))))) {
@@ -313,61 +309,27 @@ bool isInCheck(Board_t board, Piece_st* selectionnedPiece, int targetColumn, int
 }
 
 /**
-    @brief Check if the current player is in checkmate.
-    @param[in,out] board The game board
+    @brief Check if a player is checkmated.
+
+    Read from the legal moves cached for the position (boardLegalMoves()),
+    so it reads no global and has no side effect (the caller plays the
+    sound), and asking every frame costs no move generation.
+    @param[in] board  The game board
+    @param[in] player The player to move (0 for white, 1 for black)
     @return bool True if checkmate, false otherwise
 */
-bool isCheckmate(Board_t board) {
-    Player_st* tempJoueur = !playerTurn ? whitePlayer : blackPlayer;
-
-    if (!isInCheck(board, tempJoueur->pieces[PIECE_ORDER_KING], tempJoueur->pieces[PIECE_ORDER_KING]->pos.x, tempJoueur->pieces[PIECE_ORDER_KING]->pos.y, playerTurn)) {
-        return false;
-    }
-
-    for (int i = 0; i < PIECES_PER_PLAYER; i++) {
-        if (tempJoueur->pieces[i] == NULL || tempJoueur->pieces[i]->isTaken) {
-            continue;
-        }
-
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            for (int k = 0; k < BOARD_SIZE; k++) {
-                if (canBePlaced(board, tempJoueur->pieces[i], k, j))
-                    if (!isInCheck(board, tempJoueur->pieces[i], k, j, playerTurn))
-                        return false;
-            }
-        }
-    }
-    
-    PlaySound(sound_checkMate);
-    return true;
+bool isCheckmate(Board_t board, int player) {
+    return boardLegalMoves(board, player)->status == POSITION_CHECKMATE;
 }
 
 /**
-    @brief Check if the current player is in stalemate.
-    @param[in,out] board The game board
+    @brief Check if a player is stalemated.
+    @param[in] board  The game board
+    @param[in] player The player to move (0 for white, 1 for black)
     @return bool True if stalemate, false otherwise
 */
-bool isStalemate(Board_t board) {
-    Player_st* tempJoueur = !playerTurn ? whitePlayer : blackPlayer;
-    
-    if (isInCheck(board, tempJoueur->pieces[PIECE_ORDER_KING], tempJoueur->pieces[PIECE_ORDER_KING]->pos.x, tempJoueur->pieces[PIECE_ORDER_KING]->pos.y, playerTurn)) {
-        return false;
-    }
-
-    for (int i = 0; i < PIECES_PER_PLAYER; i++) {
-        if (tempJoueur->pieces[i] == NULL || tempJoueur->pieces[i]->isTaken) {
-            continue;
-        }
-        
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            for (int k = 0; k < BOARD_SIZE; k++) {
-                if (canBePlaced(board, tempJoueur->pieces[i], k, j))
-                    if (!isInCheck(board, tempJoueur->pieces[i], k, j, playerTurn))
-                        return false;
-            }
-        }
-    }
-    return true;
+bool isStalemate(Board_t board, int player) {
+    return boardLegalMoves(board, player)->status == POSITION_STALEMATE;
 }
 
 /**
@@ -401,17 +363,24 @@ bool isSquareThreatened(Board_t board, int playerA, int xCase, int yCase) {
 
 /**
     @brief Update the list of possible moves for the currently selected piece.
+
+    Only legal moves are listed, taken from the moves cached for the
+    position; the four promotions to one square show a single dot.
     @param[in] board The game board
 */
 void updatePossibleMoves(Board_t board) {
+    const BoardMoves_st* legal = boardLegalMoves(board, playerTurn);
+    u32 from = SQUARE_FROM_XY(selectionnedPiece->pos.x, selectionnedPiece->pos.y);
+
     nbPositionsPossibles = 0;
 
-    for (int x = 0; x < BOARD_SIZE; x++) {
-        for (int y = 0; y < BOARD_SIZE; y++) {
-            if (canBePlaced(board, selectionnedPiece, x, y)) {
-                positionsPossibles[nbPositionsPossibles++] = (IVec2_st) {x, y};
-            }
+    for (u32 i = 0; i < legal->moves.count; i++) {
+        ChessMove_t move = legal->moves.moves[i];
+
+        if (MOVE_FROM(move) != from || (MOVE_IS_PROMOTION(move) && position_promotionPiece(move) != PIECE_NAME_QUEEN)) {
+            continue;
         }
+        positionsPossibles[nbPositionsPossibles++] = (IVec2_st) {SQUARE_X(MOVE_TO(move)), SQUARE_Y(MOVE_TO(move))};
     }
 }
 
@@ -499,8 +468,6 @@ void applyPredifinedMoves(Board_t board, char *coupPredefinis[], int nCoup) {
     for (int i = 0; i < nCoup; i++) {
         WaitTime(0.5);
 
-        playerTurn = !playerTurn;
-
         posSrc.x = coupPredefinis[i][0] - 'a';
         posSrc.y = BOARD_SIZE - (coupPredefinis[i][1] - '1') - 1;
 
@@ -543,6 +510,9 @@ void applyPredifinedMoves(Board_t board, char *coupPredefinis[], int nCoup) {
             waitingForPromotion = false;
         }
 
+        // The move is checked against the mover's legal moves, so the turn passes after it
+        playerTurn = !playerTurn;
+
         renderFrame(board);
     }
 
@@ -0,0 +1,157 @@
+/**
+    @file bitboard.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Attack table construction for chess (see bitboard.h).
+
+    Magic multipliers are searched once at startup with a fixed-seed
+    generator, so every run builds the same tables (a few milliseconds).
+*/
+#include "bitboard.h"
+
+#include <pthread.h>
+
+#define ROOK_TABLE_SIZE     102400  ///< Sum of 1 << bits over the 64 rook squares
+#define BISHOP_TABLE_SIZE   5248    ///< Sum of 1 << bits over the 64 bishop squares
+
+Bitboard_t knightAttacks[64];
+Bitboard_t kingAttacks[64];
+Bitboard_t pawnAttacks[2][64];
+
+SliderMagic_st rookMagics[64];
+SliderMagic_st bishopMagics[64];
+
+static Bitboard_t rookTable[ROOK_TABLE_SIZE];
+static Bitboard_t bishopTable[BISHOP_TABLE_SIZE];
+
+static pthread_once_t tablesOnce = PTHREAD_ONCE_INIT;
+
+static const s32 rookDirs[4][2]   = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+static const s32 bishopDirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+/**
+    @brief Square at (file, rank) as a set, empty when off the board.
+*/
+static Bitboard_t squareAt(s32 file, s32 rank) {
+    if (file < 0 || file > 7 || rank < 0 || rank > 7) return 0;
+    return SQUARE_BB(rank * 8 + file);
+}
+
+/**
+    @brief Slow ray walk, used only to fill the tables.
+*/
+static Bitboard_t slidingAttacks(u32 sq, Bitboard_t occupied, const s32 dirs[4][2]) {
+    Bitboard_t attacks = 0;
+    for (u32 d = 0; d < 4; d++) {
+        s32 f = (s32)SQUARE_FILE(sq) + dirs[d][0];
+        s32 r = (s32)SQUARE_RANK(sq) + dirs[d][1];
+        for (Bitboard_t bb; (bb = squareAt(f, r)); f += dirs[d][0], r += dirs[d][1]) {
+            attacks |= bb;
+            if (occupied & bb) break;
+        }
+    }
+    return attacks;
+}
+
+/**
+    @brief Squares whose occupancy changes the slider's attacks (the last square of each ray never does).
+*/
+static Bitboard_t relevantMask(u32 sq, const s32 dirs[4][2]) {
+    Bitboard_t mask = 0;
+    for (u32 d = 0; d < 4; d++) {
+        s32 f = (s32)SQUARE_FILE(sq) + dirs[d][0];
+        s32 r = (s32)SQUARE_RANK(sq) + dirs[d][1];
+        while (squareAt(f + dirs[d][0], r + dirs[d][1])) {
+            mask |= squareAt(f, r);
+            f += dirs[d][0];
+            r += dirs[d][1];
+        }
+    }
+    return mask;
+}
+
+static u64 xorshift64(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+    @brief Fills one slider's tables; `table` receives 1 << bits entries per square.
+*/
+static void initSlider(SliderMagic_st magics[64], Bitboard_t* table, const s32 dirs[4][2], u64* seed) {
+    static Bitboard_t occupancies[4096], references[4096];
+    static u32 epoch[4096];
+    static u32 attempt = 0;    // Shared by both sliders so `epoch` never needs clearing
+
+    for (u32 sq = 0; sq < 64; sq++) {
+        SliderMagic_st* m = &magics[sq];
+        m->mask = relevantMask(sq, dirs);
+        u32 bits = bitboard_count(m->mask);
+        u32 size = 1u << bits;
+        m->shift = 64 - bits;
+        m->attacks = table;
+        table += size;
+
+        // Enumerate every subset of the mask (Carry-Rippler)
+        Bitboard_t subset = 0;
+        for (u32 i = 0; i < size; i++) {
+            occupancies[i] = subset;
+            references[i] = slidingAttacks(sq, subset, dirs);
+            subset = (subset - m->mask) & m->mask;
+        }
+
+#ifdef __BMI2__
+        (void)seed; (void)attempt; (void)epoch;
+        m->magic = 0;
+        for (u32 i = 0; i < size; i++) m->attacks[bitboard_sliderIndex(m, occupancies[i])] = references[i];
+#else
+        // Sparse random multipliers until one maps the subsets without destructive collisions
+        for (bool found = false; !found;) {
+            do {
+                m->magic = xorshift64(seed) & xorshift64(seed) & xorshift64(seed);
+            } while (bitboard_count((m->mask * m->magic) >> 56) < 6);
+
+            attempt++;
+            found = true;
+            for (u32 i = 0; i < size; i++) {
+                u32 idx = bitboard_sliderIndex(m, occupancies[i]);
+                if (epoch[idx] != attempt) {
+                    epoch[idx] = attempt;
+                    m->attacks[idx] = references[i];
+                } else if (m->attacks[idx] != references[i]) {
+                    found = false;
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
+
+static void initTables(void) {
+    static const s32 knightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+
+    for (u32 sq = 0; sq < 64; sq++) {
+        s32 f = (s32)SQUARE_FILE(sq), r = (s32)SQUARE_RANK(sq);
+
+        for (u32 i = 0; i < 8; i++) knightAttacks[sq] |= squareAt(f + knightSteps[i][0], r + knightSteps[i][1]);
+        for (s32 df = -1; df <= 1; df++) {
+            for (s32 dr = -1; dr <= 1; dr++) {
+                if (df || dr) kingAttacks[sq] |= squareAt(f + df, r + dr);
+            }
+        }
+        pawnAttacks[0][sq] = squareAt(f - 1, r + 1) | squareAt(f + 1, r + 1);
+        pawnAttacks[1][sq] = squareAt(f - 1, r - 1) | squareAt(f + 1, r - 1);
+    }
+
+    u64 seed = 0x9E3779B97F4A7C15ULL;
+    initSlider(rookMagics, rookTable, rookDirs, &seed);
+    initSlider(bishopMagics, bishopTable, bishopDirs, &seed);
+}
+
+void bitboard_init(void) {
+    pthread_once(&tablesOnce, initTables);
+}
@@ -2,11 +2,19 @@
     @file board.c
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Board position utilities for Chess.
 */
 #include "board.h"
 #include "globals.h"
+#include "utils.h"
+
+#include <string.h>
+
+/**
+    @brief Legal moves of the last position asked for.
+*/
+static BoardMoves_st cachedMoves;
 
 /**
     @brief Get the board position from mouse coordinates.
@@ -17,3 +25,143 @@ IVec2_st getBoardPosition(void) {
 
     return (IVec2_st) {(mouse.x - BOARD_OFFSET) / CELL_PX_SIZE, (mouse.y - BOARD_OFFSET) / CELL_PX_SIZE};
 }
+
+/**
+    @brief True if the piece on (x, y) is an unmoved `name` of `color`.
+*/
+static bool isUnmoved(Board_t board, int x, int y, PieceName_et name, ColorPiece_et color) {
+    Piece_st* p = board[y][x];
+    return p && !p->isTaken && !p->canRock && p->name == name && p->color == color;
+}
+
+/**
+    @brief Castling rights of the UI board: `canRock` is set once a piece has moved.
+*/
+static u8 boardCastling(Board_t board) {
+    u8 castling = 0;
+
+    if (isUnmoved(board, 4, 7, PIECE_NAME_KING, COLOR_PIECE_WHITE)) {
+        if (isUnmoved(board, 7, 7, PIECE_NAME_ROOK, COLOR_PIECE_WHITE)) castling |= CASTLE_WHITE_KING;
+        if (isUnmoved(board, 0, 7, PIECE_NAME_ROOK, COLOR_PIECE_WHITE)) castling |= CASTLE_WHITE_QUEEN;
+    }
+    if (isUnmoved(board, 4, 0, PIECE_NAME_KING, COLOR_PIECE_BLACK)) {
+        if (isUnmoved(board, 7, 0, PIECE_NAME_ROOK, COLOR_PIECE_BLACK)) castling |= CASTLE_BLACK_KING;
+        if (isUnmoved(board, 0, 0, PIECE_NAME_ROOK, COLOR_PIECE_BLACK)) castling |= CASTLE_BLACK_QUEEN;
+    }
+    return castling;
+}
+
+/**
+    @brief Build the bitboard position matching the UI board.
+    @param[in]  board The game board
+    @param[in]  turn  Side to move (0 for white, 1 for black)
+    @param[out] pos   Position to fill
+*/
+void boardToPosition(Board_t board, int turn, Position_st* pos) {
+    position_clear(pos);
+    pos->side = (u8)turn;
+
+    for (int y = 0; y < BOARD_SIZE; y++) {
+        for (int x = 0; x < BOARD_SIZE; x++) {
+            Piece_st* p = board[y][x];
+            if (p && !p->isTaken) position_putPiece(pos, SQUARE_FROM_XY(x, y), p->color, p->name);
+        }
+    }
+
+    pos->castling = boardCastling(board);
+    pos->hash = position_computeHash(pos);
+}
+
+/**
+    @brief Get the legal moves of the side to move, generating them only for a new position.
+    @param[in] board The game board
+    @param[in] turn  Side to move (0 for white, 1 for black)
+    @return const BoardMoves_st* The cached list
+*/
+const BoardMoves_st* boardLegalMoves(Board_t board, int turn) {
+    // Compared straight off the board: a hit builds no position
+    u8 squares[64];
+    for (int y = 0; y < BOARD_SIZE; y++) {
+        for (int x = 0; x < BOARD_SIZE; x++) {
+            Piece_st* p = board[y][x];
+            squares[SQUARE_FROM_XY(x, y)] = p && !p->isTaken ? SQUARE_PIECE(p->color, p->name) : 0;
+        }
+    }
+    bool same = cachedMoves.generations > 0 && cachedMoves.pos.side == (u8)turn && cachedMoves.pos.castling == boardCastling(board) &&
+                memcmp(squares, cachedMoves.pos.squares, sizeof(squares)) == 0;
+    if (same) return &cachedMoves;
+
+    boardToPosition(board, turn, &cachedMoves.pos);
+    position_generateLegal(&cachedMoves.pos, &cachedMoves.moves);
+    cachedMoves.inCheck = position_inCheck(&cachedMoves.pos);
+    cachedMoves.status = cachedMoves.moves.count ? POSITION_ONGOING : cachedMoves.inCheck ? POSITION_CHECKMATE : POSITION_STALEMATE;
+    cachedMoves.generations++;
+    return &cachedMoves;
+}
+
+/**
+    @brief Find a legal move of the side to move in the cached list.
+    @param[in] board     The game board
+    @param[in] turn      Side to move (0 for white, 1 for black)
+    @param[in] from      Square the piece leaves
+    @param[in] to        Square it goes to
+    @param[in] promotion Piece to promote to (PIECE_NAME_NONE: queen)
+    @return ChessMove_t The move, MOVE_NONE if it is not legal
+*/
+ChessMove_t boardFindLegalMove(Board_t board, int turn, IVec2_st from, IVec2_st to, PieceName_et promotion) {
+    if (isOOB(from.x, from.y) || isOOB(to.x, to.y)) return MOVE_NONE;
+
+    const BoardMoves_st* legal = boardLegalMoves(board, turn);
+    return position_findInList(&legal->moves, SQUARE_FROM_XY(from.x, from.y), SQUARE_FROM_XY(to.x, to.y), promotion);
+}
+
+/**
+    @brief Move the piece on `from` to `to`, taking whatever stands there.
+*/
+static void relocate(Board_t board, IVec2_st from, IVec2_st to) {
+    Piece_st* moving = board[from.y][from.x];
+    Piece_st* captured = board[to.y][to.x];
+
+    if (captured) captured->isTaken = true;
+
+    board[to.y][to.x] = moving;
+    board[from.y][from.x] = NULL;
+    moving->pos = to;
+    moving->canRock = true;
+}
+
+/**
+    @brief Play a move of the bitboard model on the UI board.
+    @param[in,out] board The game board
+    @param[in]     move  A legal move of the position built from `board`
+*/
+void boardApplyMove(Board_t board, ChessMove_t move) {
+    IVec2_st from = {SQUARE_X(MOVE_FROM(move)), SQUARE_Y(MOVE_FROM(move))};
+    IVec2_st to = {SQUARE_X(MOVE_TO(move)), SQUARE_Y(MOVE_TO(move))};
+
+    if (!board[from.y][from.x]) return;
+
+    switch (MOVE_FLAG(move)) {
+        case MOVE_FLAG_CASTLE: {
+            int rookX = to.x > from.x ? 7 : 0;
+            relocate(board, (IVec2_st) {rookX, from.y}, (IVec2_st) {to.x > from.x ? 5 : 3, from.y});
+            break;
+        }
+
+        case MOVE_FLAG_EN_PASSANT: {
+            Piece_st* victim = board[from.y][to.x];
+            if (victim) victim->isTaken = true;
+            board[from.y][to.x] = NULL;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    relocate(board, from, to);
+
+    if (MOVE_IS_PROMOTION(move)) {
+        board[to.y][to.x]->name = position_promotionPiece(move);
+    }
+}
@@ -0,0 +1,299 @@
+/**
+    @file book.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Opening book: Polyglot-layout entries, memory-mapped and binary-searched (see book.h).
+*/
+#include "book.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define mkdir(path, mode) _mkdir(path)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define BOOK_LINE_MAX 1024
+
+/**
+    @brief An entry while compiling.
+*/
+typedef struct {
+    u64 key;
+    u16 move;
+    u32 weight;
+} BookEntry_st;
+
+static u64 readBigEndian(const u8* bytes, u32 size) {
+    u64 value = 0;
+    for (u32 i = 0; i < size; i++) value = (value << 8) | bytes[i];
+    return value;
+}
+
+static void writeBigEndian(u8* bytes, u64 value, u32 size) {
+    for (u32 i = size; i-- > 0;) {
+        bytes[i] = (u8)value;
+        value >>= 8;
+    }
+}
+
+/**
+    @brief Polyglot encoding of a move (castling as the king taking its rook).
+*/
+static u16 encodeMove(ChessMove_t move) {
+    static const u16 promotion[7] = {0, 0, 1, 3, 2, 4, 0};     // By PieceName_et: knight 1, bishop 2, rook 3, queen 4
+    u32 from = MOVE_FROM(move), to = MOVE_TO(move);
+    if (MOVE_FLAG(move) == MOVE_FLAG_CASTLE) to = to > from ? to + 1 : to - 2;
+    return (u16)(to | (from << 6) | (promotion[position_promotionPiece(move)] << 12));
+}
+
+/**
+    @brief Legal move of `pos` matching a Polyglot move, MOVE_NONE if none does.
+*/
+static ChessMove_t decodeMove(const Position_st* pos, u16 code) {
+    static const PieceName_et promotion[8] = {
+        PIECE_NAME_NONE, PIECE_NAME_PONEY, PIECE_NAME_BISHOP, PIECE_NAME_ROOK, PIECE_NAME_QUEEN, PIECE_NAME_NONE, PIECE_NAME_NONE, PIECE_NAME_NONE
+    };
+    u32 to = code & 63, from = (code >> 6) & 63;
+    PieceName_et promoted = promotion[(code >> 12) & 7];
+
+    // King onto its own rook: castling
+    u8 mover = pos->squares[from], target = pos->squares[to];
+    if (SQUARE_PIECE_NAME(mover) == PIECE_NAME_KING && target && SQUARE_PIECE_COLOR(target) == SQUARE_PIECE_COLOR(mover)) {
+        to = to > from ? from + 2 : from - 2;
+    }
+    if (code >> 12 && promoted == PIECE_NAME_NONE) return MOVE_NONE;
+    ChessMove_t move = position_findMove(pos, from, to, promoted);
+    // findMove() defaults to a queen; a plain move must not match a promotion and the other way round
+    return move != MOVE_NONE && MOVE_IS_PROMOTION(move) == (promoted != PIECE_NAME_NONE) ? move : MOVE_NONE;
+}
+
+/**
+    @brief Index of the first entry whose key is not below `key`.
+*/
+static size_t lowerBound(const OpeningBook_st* book, u64 key) {
+    size_t low = 0, high = book->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (readBigEndian(book->entries + mid * BOOK_ENTRY_SIZE, 8) < key) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+bool book_open(OpeningBook_st* book, const char* path) {
+    memset(book, 0, sizeof(*book));
+#ifdef _WIN32
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    u8* data = size > 0 && size % BOOK_ENTRY_SIZE == 0 ? malloc((size_t)size) : NULL;
+    bool ok = data && fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!ok) {
+        free(data);
+        return false;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size % BOOK_ENTRY_SIZE != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+#endif
+    book->entries = data;
+    book->count = (size_t)size / BOOK_ENTRY_SIZE;
+    book->mappedSize = (size_t)size;
+    return true;
+}
+
+bool book_load(OpeningBook_st* book, const char* path, const char* sourcePath) {
+    struct stat compiled, source;
+    bool haveSource = stat(sourcePath, &source) == 0;
+    if (stat(path, &compiled) != 0 || (haveSource && source.st_mtime > compiled.st_mtime)) {
+        if (!haveSource || !book_compile(sourcePath, path)) {
+            memset(book, 0, sizeof(*book));
+            return false;
+        }
+    }
+    return book_open(book, path);
+}
+
+void book_close(OpeningBook_st* book) {
+    if (book->mappedSize) {
+#ifdef _WIN32
+        free((void*)book->entries);
+#else
+        munmap((void*)book->entries, book->mappedSize);
+#endif
+    }
+    memset(book, 0, sizeof(*book));
+}
+
+static int compareEntries(const void* a, const void* b) {
+    const BookEntry_st* x = a;
+    const BookEntry_st* y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->weight != y->weight) return x->weight > y->weight ? -1 : 1;   // Heaviest first
+    return (int)x->move - (int)y->move;
+}
+
+static int compareKeyMove(const void* a, const void* b) {
+    const BookEntry_st* x = a;
+    const BookEntry_st* y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return (int)x->move - (int)y->move;
+}
+
+/**
+    @brief Parses a move in coordinate notation ("e2e4", "e7e8q") as a legal move of `pos`.
+*/
+static ChessMove_t parseMove(const Position_st* pos, const char* text, size_t length) {
+    if (length < 4 || length > 5) return MOVE_NONE;
+    if (text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8') return MOVE_NONE;
+    if (text[2] < 'a' || text[2] > 'h' || text[3] < '1' || text[3] > '8') return MOVE_NONE;
+
+    u32 from = (u32)(text[0] - 'a') + (u32)(text[1] - '1') * 8;
+    u32 to = (u32)(text[2] - 'a') + (u32)(text[3] - '1') * 8;
+    PieceName_et promoted = PIECE_NAME_NONE;
+    if (length == 5) {
+        const char* letters = "nbrq";
+        const PieceName_et pieces[4] = {PIECE_NAME_PONEY, PIECE_NAME_BISHOP, PIECE_NAME_ROOK, PIECE_NAME_QUEEN};
+        const char* at = strchr(letters, text[4]);
+        if (!at) return MOVE_NONE;
+        promoted = pieces[at - letters];
+    }
+    ChessMove_t move = position_findMove(pos, from, to, promoted);
+    return move != MOVE_NONE && MOVE_IS_PROMOTION(move) == (promoted != PIECE_NAME_NONE) ? move : MOVE_NONE;
+}
+
+/**
+    @brief Creates the directories leading to `path`, ignoring those that exist.
+*/
+static void makeParentDirs(const char* path) {
+    char dir[BOOK_LINE_MAX];
+    if (strlen(path) >= sizeof(dir)) return;
+    strcpy(dir, path);
+    for (char* slash = strchr(dir + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+        *slash = '/';
+    }
+}
+
+bool book_compile(const char* sourcePath, const char* bookPath) {
+    FILE* source = fopen(sourcePath, "r");
+    if (!source) return false;
+
+    BookEntry_st* entries = NULL;
+    size_t count = 0, capacity = 0;
+    char line[BOOK_LINE_MAX];
+    u32 lineNumber = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), source)) {
+        lineNumber++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        Position_st pos;
+        char* cursor = NULL;
+        position_setStart(&pos);
+        for (char* word = strtok_r(line, " \t\r\n", &cursor); word; word = strtok_r(NULL, " \t\r\n", &cursor)) {
+            ChessMove_t move = parseMove(&pos, word, strlen(word));
+            if (move == MOVE_NONE) {
+                fprintf(stderr, "%s:%u: illegal move '%s'\n", sourcePath, lineNumber, word);
+                ok = false;
+                break;
+            }
+            if (count == capacity) {
+                capacity = capacity ? capacity * 2 : 256;
+                BookEntry_st* grown = realloc(entries, capacity * sizeof(*entries));
+                if (!grown) {
+                    ok = false;
+                    break;
+                }
+                entries = grown;
+            }
+            entries[count++] = (BookEntry_st) {pos.hash, encodeMove(move), 1};
+
+            PositionUndo_st undo;
+            position_makeMove(&pos, move, &undo);
+        }
+    }
+    fclose(source);
+
+    // Lines sharing a move add up their weights
+    size_t merged = 0;
+    if (ok && count) {
+        qsort(entries, count, sizeof(*entries), compareKeyMove);
+        for (size_t i = 1; i < count; i++) {
+            if (entries[i].key == entries[merged].key && entries[i].move == entries[merged].move) entries[merged].weight++;
+            else entries[++merged] = entries[i];
+        }
+        merged++;
+        qsort(entries, merged, sizeof(*entries), compareEntries);
+    }
+
+    if (ok) makeParentDirs(bookPath);
+    FILE* out = ok ? fopen(bookPath, "wb") : NULL;
+    if (out) {
+        for (size_t i = 0; i < merged && ok; i++) {
+            u8 bytes[BOOK_ENTRY_SIZE] = {0};
+            writeBigEndian(bytes, entries[i].key, 8);
+            writeBigEndian(bytes + 8, entries[i].move, 2);
+            writeBigEndian(bytes + 10, entries[i].weight < 0xFFFF ? entries[i].weight : 0xFFFF, 2);
+            ok = fwrite(bytes, 1, sizeof(bytes), out) == sizeof(bytes);
+        }
+        ok = fclose(out) == 0 && ok;
+    }
+    free(entries);
+    return ok && out != NULL;
+}
+
+u32 book_probeAll(const OpeningBook_st* book, const Position_st* pos, ChessMove_t moves[], u16 weights[], u32 max) {
+    u32 found = 0;
+    for (size_t i = lowerBound(book, pos->hash); i < book->count && found < max; i++) {
+        const u8* entry = book->entries + i * BOOK_ENTRY_SIZE;
+        if (readBigEndian(entry, 8) != pos->hash) break;
+
+        ChessMove_t move = decodeMove(pos, (u16)readBigEndian(entry + 8, 2));
+        if (move == MOVE_NONE) continue;    // Key collision, or a book made for another position
+        moves[found] = move;
+        weights[found] = (u16)readBigEndian(entry + 10, 2);
+        found++;
+    }
+    return found;
+}
+
+ChessMove_t book_probe(const OpeningBook_st* book, const Position_st* pos, u32 roll) {
+    ChessMove_t moves[BOOK_MAX_CHOICES];
+    u16 weights[BOOK_MAX_CHOICES];
+    u32 count = book_probeAll(book, pos, moves, weights, BOOK_MAX_CHOICES);
+
+    u32 total = 0;
+    for (u32 i = 0; i < count; i++) total += weights[i];
+    if (total == 0) return count ? moves[0] : MOVE_NONE;
+
+    roll %= total;
+    for (u32 i = 0; i < count; i++) {
+        if (roll < weights[i]) return moves[i];
+        roll -= weights[i];
+    }
+    return moves[0];
+}
@@ -0,0 +1,178 @@
+/**
+    @file evaluation.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tapered piece-square tables (see evaluation.h).
+
+    Tables are drawn from White's side, 8th rank first; Black reads them
+    mirrored. Pawns and the king get a separate endgame table, the other
+    pieces use the same bonus in both phases.
+*/
+#include "evaluation.h"
+
+#include <pthread.h>
+
+s32 evalPieceSquareMg[2][7][64];
+s32 evalPieceSquareEg[2][7][64];
+
+const s32 evalPhaseWeight[7] = {0, 0, 1, 2, 1, 4, 0};
+
+static pthread_once_t tablesOnce = PTHREAD_ONCE_INIT;
+
+/**
+    @brief Material value of each piece in the middlegame and the endgame, indexed by PieceName_et.
+*/
+static const s32 materialMg[7] = {0, 100, 320, 500, 330, 900, 0};
+static const s32 materialEg[7] = {0, 120, 300, 530, 330, 950, 0};
+
+/**
+    @brief Positional bonus table for pawns (middlegame).
+*/
+static const s32 pawnTableMg[8][8] = {
+    { 0,  0,  0,  0,  0,  0,  0,  0},
+    {50, 50, 50, 50, 50, 50, 50, 50},
+    {10, 10, 20, 30, 30, 20, 10, 10},
+    { 5,  5, 10, 25, 25, 10,  5,  5},
+    { 0,  0,  0, 20, 20,  0,  0,  0},
+    { 5, -5,-10,  0,  0,-10, -5,  5},
+    { 5, 10, 10,-20,-20, 10, 10,  5},
+    { 0,  0,  0,  0,  0,  0,  0,  0}
+};
+
+/**
+    @brief Positional bonus table for knights.
+*/
+static const s32 knightTable[8][8] = {
+    {-50,-40,-30,-30,-30,-30,-40,-50},
+    {-40,-20,  0,  0,  0,  0,-20,-40},
+    {-30,  0, 10, 15, 15, 10,  0,-30},
+    {-30,  5, 15, 20, 20, 15,  5,-30},
+    {-30,  0, 15, 20, 20, 15,  0,-30},
+    {-30,  5, 10, 15, 15, 10,  5,-30},
+    {-40,-20,  0,  5,  5,  0,-20,-40},
+    {-50,-40,-30,-30,-30,-30,-40,-50}
+};
+
+/**
+    @brief Positional bonus table for bishops.
+*/
+static const s32 bishopTable[8][8] = {
+    {-20,-10,-10,-10,-10,-10,-10,-20},
+    {-10,  0,  0,  0,  0,  0,  0,-10},
+    {-10,  0,  5, 10, 10,  5,  0,-10},
+    {-10,  5,  5, 10, 10,  5,  5,-10},
+    {-10,  0, 10, 10, 10, 10,  0,-10},
+    {-10, 10, 10, 10, 10, 10, 10,-10},
+    {-10,  5,  0,  0,  0,  0,  5,-10},
+    {-20,-10,-10,-10,-10,-10,-10,-20}
+};
+
+/**
+    @brief Positional bonus table for rooks.
+*/
+static const s32 rookTable[8][8] = {
+    { 0,  0,  0,  0,  0,  0,  0,  0},
+    { 5, 10, 10, 10, 10, 10, 10,  5},
+    {-5,  0,  0,  0,  0,  0,  0, -5},
+    {-5,  0,  0,  0,  0,  0,  0, -5},
+    {-5,  0,  0,  0,  0,  0,  0, -5},
+    {-5,  0,  0,  0,  0,  0,  0, -5},
+    {-5,  0,  0,  0,  0,  0,  0, -5},
+    { 0,  0,  0,  5,  5,  0,  0,  0}
+};
+
+/**
+    @brief Positional bonus table for the queen.
+*/
+static const s32 queenTable[8][8] = {
+    {-20,-10,-10, -5, -5,-10,-10,-20},
+    {-10,  0,  0,  0,  0,  0,  0,-10},
+    {-10,  0,  5,  5,  5,  5,  0,-10},
+    { -5,  0,  5,  5,  5,  5,  0, -5},
+    {  0,  0,  5,  5,  5,  5,  0, -5},
+    {-10,  5,  5,  5,  5,  5,  0,-10},
+    {-10,  0,  5,  0,  0,  0,  0,-10},
+    {-20,-10,-10, -5, -5,-10,-10,-20}
+};
+
+/**
+    @brief Positional bonus table for the king (middlegame: stay sheltered).
+*/
+static const s32 kingTableMg[8][8] = {
+    {-30,-40,-40,-50,-50,-40,-40,-30},
+    {-30,-40,-40,-50,-50,-40,-40,-30},
+    {-30,-40,-40,-50,-50,-40,-40,-30},
+    {-30,-40,-40,-50,-50,-40,-40,-30},
+    {-20,-30,-30,-40,-40,-30,-30,-20},
+    {-10,-20,-20,-20,-20,-20,-20,-10},
+    { 20, 20,  0,  0,  0,  0, 20, 20},
+    { 20, 30, 10,  0,  0, 10, 30, 20}
+};
+
+/**
+    @brief Positional bonus table for pawns (endgame: push them).
+*/
+static const s32 pawnTableEg[8][8] = {
+    { 0,  0,  0,  0,  0,  0,  0,  0},
+    {80, 80, 80, 80, 80, 80, 80, 80},
+    {50, 50, 50, 50, 50, 50, 50, 50},
+    {30, 30, 30, 30, 30, 30, 30, 30},
+    {15, 15, 15, 15, 15, 15, 15, 15},
+    { 5,  5,  5,  5,  5,  5,  5,  5},
+    { 0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0}
+};
+
+/**
+    @brief Positional bonus table for the king (endgame: come to the center).
+*/
+static const s32 kingTableEg[8][8] = {
+    {-50,-40,-30,-20,-20,-30,-40,-50},
+    {-30,-20,-10,  0,  0,-10,-20,-30},
+    {-30,-10, 20, 30, 30, 20,-10,-30},
+    {-30,-10, 30, 40, 40, 30,-10,-30},
+    {-30,-10, 30, 40, 40, 30,-10,-30},
+    {-30,-10, 20, 30, 30, 20,-10,-30},
+    {-30,-30,  0,  0,  0,  0,-30,-30},
+    {-50,-30,-30,-30,-30,-30,-30,-50}
+};
+
+/**
+    @brief Positional table of each piece per phase, indexed by PieceName_et.
+*/
+static const s32 (*const tablesMg[7])[8] = {
+    NULL, pawnTableMg, knightTable, rookTable, bishopTable, queenTable, kingTableMg
+};
+static const s32 (*const tablesEg[7])[8] = {
+    NULL, pawnTableEg, knightTable, rookTable, bishopTable, queenTable, kingTableEg
+};
+
+static void initTables(void) {
+    for (u32 color = 0; color < 2; color++) {
+        s32 sign = color == COLOR_PIECE_WHITE ? 1 : -1;
+        for (u32 name = PIECE_NAME_PAWN; name <= PIECE_NAME_KING; name++) {
+            for (u32 sq = 0; sq < 64; sq++) {
+                u32 row = color == COLOR_PIECE_WHITE ? 7 - SQUARE_RANK(sq) : SQUARE_RANK(sq);
+                u32 file = SQUARE_FILE(sq);
+                evalPieceSquareMg[color][name][sq] = sign * (materialMg[name] + tablesMg[name][row][file]);
+                evalPieceSquareEg[color][name][sq] = sign * (materialEg[name] + tablesEg[name][row][file]);
+            }
+        }
+    }
+}
+
+void evaluation_init(void) {
+    pthread_once(&tablesOnce, initTables);
+}
+
+PositionEval_st evaluation_compute(const Position_st* pos) {
+    PositionEval_st eval = {0, 0, 0};
+    for (u32 sq = 0; sq < 64; sq++) {
+        u8 piece = pos->squares[sq];
+        if (!piece) continue;
+        eval.mg += evalPieceSquareMg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+        eval.eg += evalPieceSquareEg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+        eval.phase += evalPhaseWeight[SQUARE_PIECE_NAME(piece)];
+    }
+    return eval;
+}
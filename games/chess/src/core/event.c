@@ -2,7 +2,7 @@
     @file event.c
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Event handling for Chess.
 */
 #include "event.h"
@@ -31,14 +31,12 @@ void handleEvents(Board_t board) {
         
         if (waitingForPromotion) {
             if (promotionChoice(board)) {
-                if (isCheckmate(board)) {
+                if (isCheckmate(board, playerTurn)) {
                     finished = true;
+                    PlaySound(sound_checkMate);
                 } 
                 else {
-                    Player_st* adversary = (playerTurn == COLOR_PIECE_WHITE) ? blackPlayer : whitePlayer;
-                    Piece_st* king = adversary->pieces[PIECE_ORDER_KING];
-
-                    if (isInCheck(board, king, king->pos.x, king->pos.y, playerTurn)) {
+                    if (boardLegalMoves(board, playerTurn)->inCheck) {
                         PlaySound(sound_check);
                     } 
                     else {
@@ -66,14 +64,13 @@ void handleEvents(Board_t board) {
             playerTurn = !playerTurn;
 
 
-            if (isCheckmate(board)) {
-                finished = true; 
+            if (isCheckmate(board, playerTurn)) {
+                finished = true;
+                PlaySound(sound_checkMate);
             }
             else {
-                Player_st* currentPlayer = (playerTurn == COLOR_PIECE_WHITE) ? whitePlayer : blackPlayer;
-                Piece_st* king = currentPlayer->pieces[PIECE_ORDER_KING];
-
-                if (isInCheck(board, king, king->pos.x, king->pos.y, playerTurn)) {
+                // Same cached list as isCheckmate() above: no second generation
+                if (boardLegalMoves(board, playerTurn)->inCheck) {
                     PlaySound(sound_check);
                 }
                 else {
@@ -0,0 +1,505 @@
+/**
+    @file position.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Bitboard position: setup, make/unmake and move generation (see position.h).
+*/
+#include "position.h"
+#include "evaluation.h"
+
+#include <pthread.h>
+
+#define SQ_A1 0
+#define SQ_E1 4
+#define SQ_H1 7
+#define SQ_A8 56
+#define SQ_E8 60
+#define SQ_H8 63
+
+static u64 zobristPieces[2][7][64];
+static u64 zobristCastling[16];
+static u64 zobristEpFile[8];
+static u64 zobristSide;
+static pthread_once_t zobristOnce = PTHREAD_ONCE_INIT;
+
+static void initZobrist(void) {
+    u64 state = 0x2545F4914F6CDD1DULL;
+    #define NEXT_KEY() (state ^= state << 13, state ^= state >> 7, state ^= state << 17, state)
+
+    for (u32 c = 0; c < 2; c++) {
+        for (u32 p = 0; p < 7; p++) {
+            for (u32 sq = 0; sq < 64; sq++) zobristPieces[c][p][sq] = NEXT_KEY();
+        }
+    }
+    for (u32 i = 0; i < 16; i++) zobristCastling[i] = NEXT_KEY();
+    for (u32 i = 0; i < 8; i++) zobristEpFile[i] = NEXT_KEY();
+    zobristSide = NEXT_KEY();
+
+    #undef NEXT_KEY
+}
+
+/**
+    @brief Castling rights kept when a move touches `sq` (king and rook home squares clear theirs).
+*/
+static inline u8 castleRightsKept(u32 sq) {
+    switch (sq) {
+        case SQ_E1: return (u8)~(CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN);
+        case SQ_H1: return (u8)~CASTLE_WHITE_KING;
+        case SQ_A1: return (u8)~CASTLE_WHITE_QUEEN;
+        case SQ_E8: return (u8)~(CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN);
+        case SQ_H8: return (u8)~CASTLE_BLACK_KING;
+        case SQ_A8: return (u8)~CASTLE_BLACK_QUEEN;
+        default:    return 0xFF;
+    }
+}
+
+static inline void addPiece(Position_st* pos, u32 sq, u8 piece) {
+    Bitboard_t bb = SQUARE_BB(sq);
+    pos->hash ^= zobristPieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.mg += evalPieceSquareMg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.eg += evalPieceSquareEg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.phase += evalPhaseWeight[SQUARE_PIECE_NAME(piece)];
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)] |= bb;
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][PIECE_NAME_NONE] |= bb;
+    pos->occupied |= bb;
+    pos->squares[sq] = piece;
+}
+
+static inline void removePiece(Position_st* pos, u32 sq) {
+    u8 piece = pos->squares[sq];
+    Bitboard_t bb = SQUARE_BB(sq);
+    pos->hash ^= zobristPieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.mg -= evalPieceSquareMg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.eg -= evalPieceSquareEg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    pos->eval.phase -= evalPhaseWeight[SQUARE_PIECE_NAME(piece)];
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)] &= ~bb;
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][PIECE_NAME_NONE] &= ~bb;
+    pos->occupied &= ~bb;
+    pos->squares[sq] = 0;
+}
+
+static inline void movePiece(Position_st* pos, u32 from, u32 to) {
+    u8 piece = pos->squares[from];
+    Bitboard_t bb = SQUARE_BB(from) | SQUARE_BB(to);
+    pos->hash ^= zobristPieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][from]
+               ^ zobristPieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][to];
+    pos->eval.mg += evalPieceSquareMg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][to]
+                  - evalPieceSquareMg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][from];
+    pos->eval.eg += evalPieceSquareEg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][to]
+                  - evalPieceSquareEg[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][from];
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)] ^= bb;
+    pos->pieces[SQUARE_PIECE_COLOR(piece)][PIECE_NAME_NONE] ^= bb;
+    pos->occupied ^= bb;
+    pos->squares[to] = piece;
+    pos->squares[from] = 0;
+}
+
+void position_clear(Position_st* pos) {
+    bitboard_init();
+    evaluation_init();
+    pthread_once(&zobristOnce, initZobrist);
+
+    memset(pos, 0, sizeof(*pos));
+    pos->side = COLOR_PIECE_WHITE;
+    pos->epSquare = SQUARE_NONE;
+    pos->fullmoveNumber = 1;
+}
+
+void position_putPiece(Position_st* pos, u32 sq, ColorPiece_et color, PieceName_et name) {
+    addPiece(pos, sq, SQUARE_PIECE(color, name));
+}
+
+u64 position_computeHash(const Position_st* pos) {
+    u64 hash = 0;
+    for (u32 sq = 0; sq < 64; sq++) {
+        u8 piece = pos->squares[sq];
+        if (piece) hash ^= zobristPieces[SQUARE_PIECE_COLOR(piece)][SQUARE_PIECE_NAME(piece)][sq];
+    }
+    hash ^= zobristCastling[pos->castling & 0xF];
+    if (pos->epSquare != SQUARE_NONE) hash ^= zobristEpFile[SQUARE_FILE(pos->epSquare)];
+    if (pos->side == COLOR_PIECE_BLACK) hash ^= zobristSide;
+    return hash;
+}
+
+/**
+    @brief True if a pawn of the side to move could capture on `epSquare`.
+
+    The target is only kept when it matters, so transpositions that differ
+    by a useless en-passant square share their hash.
+*/
+static bool epCapturable(const Position_st* pos, u32 epSquare) {
+    return (pawnAttacks[pos->side ^ 1][epSquare] & pos->pieces[pos->side][PIECE_NAME_PAWN]) != 0;
+}
+
+void position_setStart(Position_st* pos) {
+    static const PieceName_et backRank[8] = {
+        PIECE_NAME_ROOK, PIECE_NAME_PONEY, PIECE_NAME_BISHOP, PIECE_NAME_QUEEN,
+        PIECE_NAME_KING, PIECE_NAME_BISHOP, PIECE_NAME_PONEY, PIECE_NAME_ROOK
+    };
+
+    position_clear(pos);
+    for (u32 file = 0; file < 8; file++) {
+        addPiece(pos, file,      SQUARE_PIECE(COLOR_PIECE_WHITE, backRank[file]));
+        addPiece(pos, 8 + file,  SQUARE_PIECE(COLOR_PIECE_WHITE, PIECE_NAME_PAWN));
+        addPiece(pos, 48 + file, SQUARE_PIECE(COLOR_PIECE_BLACK, PIECE_NAME_PAWN));
+        addPiece(pos, 56 + file, SQUARE_PIECE(COLOR_PIECE_BLACK, backRank[file]));
+    }
+    pos->castling = CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN | CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN;
+    pos->hash = position_computeHash(pos);
+}
+
+bool position_fromFen(Position_st* pos, const char* fen) {
+    static const char pieceLetters[] = " pnrbqk";   // Indexed by PieceName_et
+
+    position_clear(pos);
+
+    s32 rank = 7, file = 0;
+    const char* c = fen;
+    for (; *c && *c != ' '; c++) {
+        if (*c == '/') {
+            if (file != 8 || --rank < 0) return false;
+            file = 0;
+        } else if (*c >= '1' && *c <= '8') {
+            file += *c - '0';
+        } else {
+            const char* letter = strchr(pieceLetters + 1, *c | 0x20);
+            if (!letter || file > 7) return false;
+            ColorPiece_et color = (*c & 0x20) ? COLOR_PIECE_BLACK : COLOR_PIECE_WHITE;
+            addPiece(pos, (u32)(rank * 8 + file), SQUARE_PIECE(color, (PieceName_et)(letter - pieceLetters)));
+            file++;
+        }
+        if (file > 8) return false;
+    }
+    if (rank != 0 || file != 8 || *c++ != ' ') return false;
+
+    if (*c != 'w' && *c != 'b') return false;
+    pos->side = *c++ == 'w' ? COLOR_PIECE_WHITE : COLOR_PIECE_BLACK;
+    if (*c++ != ' ') return false;
+
+    for (; *c && *c != ' '; c++) {
+        switch (*c) {
+            case 'K': pos->castling |= CASTLE_WHITE_KING; break;
+            case 'Q': pos->castling |= CASTLE_WHITE_QUEEN; break;
+            case 'k': pos->castling |= CASTLE_BLACK_KING; break;
+            case 'q': pos->castling |= CASTLE_BLACK_QUEEN; break;
+            case '-': break;
+            default:  return false;
+        }
+    }
+    if (*c++ != ' ') return false;
+
+    if (*c == '-') {
+        c++;
+    } else {
+        if (c[0] < 'a' || c[0] > 'h' || c[1] < '1' || c[1] > '8') return false;
+        pos->epSquare = (u8)((c[1] - '1') * 8 + (c[0] - 'a'));
+        if (!epCapturable(pos, pos->epSquare)) pos->epSquare = SQUARE_NONE;
+        c += 2;
+    }
+
+    int halfmove = 0, fullmove = 1;
+    if (*c == ' ' && sscanf(c, " %d %d", &halfmove, &fullmove) < 1) return false;
+    pos->halfmoveClock = (u8)halfmove;
+    pos->fullmoveNumber = (u16)(fullmove > 0 ? fullmove : 1);
+    pos->hash = position_computeHash(pos);
+    return true;
+}
+
+void position_moveToString(ChessMove_t move, char out[6]) {
+    static const char promoLetters[] = "nbrq";
+    u32 from = MOVE_FROM(move), to = MOVE_TO(move);
+
+    out[0] = (char)('a' + SQUARE_FILE(from));
+    out[1] = (char)('1' + SQUARE_RANK(from));
+    out[2] = (char)('a' + SQUARE_FILE(to));
+    out[3] = (char)('1' + SQUARE_RANK(to));
+    out[4] = MOVE_IS_PROMOTION(move) ? promoLetters[MOVE_FLAG(move) - MOVE_FLAG_PROMO_PONEY] : '\0';
+    out[5] = '\0';
+}
+
+Bitboard_t position_attackersTo(const Position_st* pos, u32 sq, u32 byColor, Bitboard_t occupied) {
+    const Bitboard_t* p = pos->pieces[byColor];
+    Bitboard_t diagonal = p[PIECE_NAME_BISHOP] | p[PIECE_NAME_QUEEN];
+    Bitboard_t straight = p[PIECE_NAME_ROOK] | p[PIECE_NAME_QUEEN];
+
+    return (pawnAttacks[byColor ^ 1][sq] & p[PIECE_NAME_PAWN])
+         | (knightAttacks[sq] & p[PIECE_NAME_PONEY])
+         | (kingAttacks[sq] & p[PIECE_NAME_KING])
+         | (diagonal ? bitboard_bishopAttacks(sq, occupied) & diagonal : 0)
+         | (straight ? bitboard_rookAttacks(sq, occupied) & straight : 0);
+}
+
+static inline void pushMove(MoveList_st* list, u32 from, u32 to, u32 flag) {
+    list->moves[list->count++] = MOVE_MAKE(from, to, flag);
+}
+
+static void pushPromotions(MoveList_st* list, u32 from, u32 to) {
+    for (u32 flag = MOVE_FLAG_PROMO_QUEEN; flag >= MOVE_FLAG_PROMO_PONEY; flag--) pushMove(list, from, to, flag);
+}
+
+/**
+    @brief Pawn moves, generated set-wise: one shift per direction for all pawns at once.
+    @param[in] tacticalOnly  Only captures and promotions
+*/
+static void generatePawnMoves(const Position_st* pos, MoveList_st* list, bool tacticalOnly) {
+    u32 us = pos->side;
+    Bitboard_t pawns = pos->pieces[us][PIECE_NAME_PAWN];
+    Bitboard_t enemies = pos->pieces[us ^ 1][PIECE_NAME_NONE];
+    Bitboard_t empty = ~pos->occupied;
+    Bitboard_t promoRank = us == COLOR_PIECE_WHITE ? BB_RANK_8 : BB_RANK_1;
+    s32 forward = us == COLOR_PIECE_WHITE ? 8 : -8;
+
+    Bitboard_t single, twice, left, right;
+    if (us == COLOR_PIECE_WHITE) {
+        single = (pawns << 8) & empty;
+        twice  = ((single & (BB_RANK_2 << 8)) << 8) & empty;
+        left   = ((pawns & ~BB_FILE_A) << 7) & enemies;
+        right  = ((pawns & ~BB_FILE_H) << 9) & enemies;
+    } else {
+        single = (pawns >> 8) & empty;
+        twice  = ((single & (BB_RANK_7 >> 8)) >> 8) & empty;
+        left   = ((pawns & ~BB_FILE_A) >> 9) & enemies;
+        right  = ((pawns & ~BB_FILE_H) >> 7) & enemies;
+    }
+    if (tacticalOnly) {
+        single &= promoRank;
+        twice = 0;
+    }
+    s32 leftDelta  = us == COLOR_PIECE_WHITE ? 7 : -9;
+    s32 rightDelta = us == COLOR_PIECE_WHITE ? 9 : -7;
+
+    for (Bitboard_t bb = single; bb;) {
+        u32 to = bitboard_pop(&bb);
+        u32 from = (u32)((s32)to - forward);
+        if (SQUARE_BB(to) & promoRank) pushPromotions(list, from, to);
+        else pushMove(list, from, to, MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = twice; bb;) {
+        u32 to = bitboard_pop(&bb);
+        pushMove(list, (u32)((s32)to - 2 * forward), to, MOVE_FLAG_DOUBLE_PUSH);
+    }
+    for (Bitboard_t bb = left; bb;) {
+        u32 to = bitboard_pop(&bb);
+        u32 from = (u32)((s32)to - leftDelta);
+        if (SQUARE_BB(to) & promoRank) pushPromotions(list, from, to);
+        else pushMove(list, from, to, MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = right; bb;) {
+        u32 to = bitboard_pop(&bb);
+        u32 from = (u32)((s32)to - rightDelta);
+        if (SQUARE_BB(to) & promoRank) pushPromotions(list, from, to);
+        else pushMove(list, from, to, MOVE_FLAG_NORMAL);
+    }
+
+    if (pos->epSquare != SQUARE_NONE) {
+        // Our pawns that attack the target are the squares an enemy pawn there would attack
+        for (Bitboard_t bb = pawnAttacks[us ^ 1][pos->epSquare] & pawns; bb;) {
+            pushMove(list, bitboard_pop(&bb), pos->epSquare, MOVE_FLAG_EN_PASSANT);
+        }
+    }
+}
+
+static void generateCastles(const Position_st* pos, MoveList_st* list) {
+    u32 us = pos->side, them = us ^ 1;
+    u8 rights = pos->castling & (us == COLOR_PIECE_WHITE ? (CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN) : (CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN));
+    if (!rights) return;
+
+    u32 base = us == COLOR_PIECE_WHITE ? 0 : 56;
+    u32 king = base + 4;
+    if (pos->squares[king] != SQUARE_PIECE(us, PIECE_NAME_KING) || position_isSquareAttacked(pos, king, them)) return;
+
+    u8 kingSide = us == COLOR_PIECE_WHITE ? CASTLE_WHITE_KING : CASTLE_BLACK_KING;
+    if ((rights & kingSide)
+        && pos->squares[base + 7] == SQUARE_PIECE(us, PIECE_NAME_ROOK)
+        && !(pos->occupied & (SQUARE_BB(base + 5) | SQUARE_BB(base + 6)))
+        && !position_isSquareAttacked(pos, base + 5, them)) {
+        pushMove(list, king, base + 6, MOVE_FLAG_CASTLE);
+    }
+    if ((rights & ~kingSide)
+        && pos->squares[base] == SQUARE_PIECE(us, PIECE_NAME_ROOK)
+        && !(pos->occupied & (SQUARE_BB(base + 1) | SQUARE_BB(base + 2) | SQUARE_BB(base + 3)))
+        && !position_isSquareAttacked(pos, base + 3, them)) {
+        pushMove(list, king, base + 2, MOVE_FLAG_CASTLE);
+    }
+}
+
+/**
+    @brief Pseudo-legal moves; with `tacticalOnly`, only those that capture or promote.
+*/
+static void generateMoves(const Position_st* pos, MoveList_st* list, bool tacticalOnly) {
+    u32 us = pos->side;
+    const Bitboard_t* own = pos->pieces[us];
+    Bitboard_t targets = tacticalOnly ? pos->pieces[us ^ 1][PIECE_NAME_NONE] : ~own[PIECE_NAME_NONE];
+    Bitboard_t occupied = pos->occupied;
+
+    list->count = 0;
+    generatePawnMoves(pos, list, tacticalOnly);
+
+    for (Bitboard_t bb = own[PIECE_NAME_PONEY]; bb;) {
+        u32 from = bitboard_pop(&bb);
+        for (Bitboard_t to = knightAttacks[from] & targets; to;) pushMove(list, from, bitboard_pop(&to), MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = own[PIECE_NAME_BISHOP]; bb;) {
+        u32 from = bitboard_pop(&bb);
+        for (Bitboard_t to = bitboard_bishopAttacks(from, occupied) & targets; to;) pushMove(list, from, bitboard_pop(&to), MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = own[PIECE_NAME_ROOK]; bb;) {
+        u32 from = bitboard_pop(&bb);
+        for (Bitboard_t to = bitboard_rookAttacks(from, occupied) & targets; to;) pushMove(list, from, bitboard_pop(&to), MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = own[PIECE_NAME_QUEEN]; bb;) {
+        u32 from = bitboard_pop(&bb);
+        for (Bitboard_t to = bitboard_queenAttacks(from, occupied) & targets; to;) pushMove(list, from, bitboard_pop(&to), MOVE_FLAG_NORMAL);
+    }
+    for (Bitboard_t bb = own[PIECE_NAME_KING]; bb;) {
+        u32 from = bitboard_pop(&bb);
+        for (Bitboard_t to = kingAttacks[from] & targets; to;) pushMove(list, from, bitboard_pop(&to), MOVE_FLAG_NORMAL);
+    }
+
+    if (!tacticalOnly) generateCastles(pos, list);
+}
+
+void position_generatePseudoLegal(const Position_st* pos, MoveList_st* list) {
+    generateMoves(pos, list, false);
+}
+
+void position_generateTactical(const Position_st* pos, MoveList_st* list) {
+    generateMoves(pos, list, true);
+}
+
+bool position_isLegal(const Position_st* pos, ChessMove_t move) {
+    u32 us = pos->side, them = us ^ 1;
+    u32 from = MOVE_FROM(move), to = MOVE_TO(move);
+    u32 king = position_kingSquare(pos, us);
+    if (king == SQUARE_NONE) return true;
+
+    // Replay the move on the occupancy only; captured pieces stop attacking
+    Bitboard_t occupied = (pos->occupied & ~SQUARE_BB(from)) | SQUARE_BB(to);
+    Bitboard_t removed = SQUARE_BB(to);
+    if (MOVE_FLAG(move) == MOVE_FLAG_EN_PASSANT) {
+        u32 victim = us == COLOR_PIECE_WHITE ? to - 8 : to + 8;
+        occupied &= ~SQUARE_BB(victim);
+        removed |= SQUARE_BB(victim);
+    }
+    if (from == king) king = to;
+
+    return (position_attackersTo(pos, king, them, occupied) & ~removed) == 0;
+}
+
+PositionStatus_et position_status(const Position_st* pos) {
+    MoveList_st pseudo;
+    position_generatePseudoLegal(pos, &pseudo);
+
+    for (u32 i = 0; i < pseudo.count; i++) {
+        if (position_isLegal(pos, pseudo.moves[i])) return POSITION_ONGOING;
+    }
+    return position_inCheck(pos) ? POSITION_CHECKMATE : POSITION_STALEMATE;
+}
+
+void position_generateLegal(const Position_st* pos, MoveList_st* list) {
+    MoveList_st pseudo;
+    position_generatePseudoLegal(pos, &pseudo);
+
+    list->count = 0;
+    for (u32 i = 0; i < pseudo.count; i++) {
+        if (position_isLegal(pos, pseudo.moves[i])) list->moves[list->count++] = pseudo.moves[i];
+    }
+}
+
+void position_makeMove(Position_st* pos, ChessMove_t move, PositionUndo_st* undo) {
+    u32 us = pos->side;
+    u32 from = MOVE_FROM(move), to = MOVE_TO(move), flag = MOVE_FLAG(move);
+    u8 piece = pos->squares[from];
+
+    undo->hash = pos->hash;
+    undo->captured = pos->squares[to];
+    undo->castling = pos->castling;
+    undo->epSquare = pos->epSquare;
+    undo->halfmoveClock = pos->halfmoveClock;
+
+    pos->halfmoveClock++;
+    if (pos->epSquare != SQUARE_NONE) {
+        pos->hash ^= zobristEpFile[SQUARE_FILE(pos->epSquare)];
+        pos->epSquare = SQUARE_NONE;
+    }
+
+    if (flag == MOVE_FLAG_EN_PASSANT) {
+        u32 victim = us == COLOR_PIECE_WHITE ? to - 8 : to + 8;
+        undo->captured = pos->squares[victim];
+        removePiece(pos, victim);
+    } else if (undo->captured) {
+        removePiece(pos, to);
+    }
+    if (undo->captured || SQUARE_PIECE_NAME(piece) == PIECE_NAME_PAWN) pos->halfmoveClock = 0;
+
+    movePiece(pos, from, to);
+
+    if (flag == MOVE_FLAG_DOUBLE_PUSH) {
+        u32 target = (from + to) / 2;
+        if (pawnAttacks[us][target] & pos->pieces[us ^ 1][PIECE_NAME_PAWN]) {
+            pos->epSquare = (u8)target;
+            pos->hash ^= zobristEpFile[SQUARE_FILE(target)];
+        }
+    } else if (flag == MOVE_FLAG_CASTLE) {
+        if (to > from) movePiece(pos, to + 1, to - 1);
+        else           movePiece(pos, to - 2, to + 1);
+    } else if (flag >= MOVE_FLAG_PROMO_PONEY) {
+        removePiece(pos, to);
+        addPiece(pos, to, SQUARE_PIECE(us, position_promotionPiece(move)));
+    }
+
+    u8 castling = pos->castling & castleRightsKept(from) & castleRightsKept(to);
+    if (castling != pos->castling) {
+        pos->hash ^= zobristCastling[pos->castling] ^ zobristCastling[castling];
+        pos->castling = castling;
+    }
+    if (us == COLOR_PIECE_BLACK) pos->fullmoveNumber++;
+    pos->side = (u8)(us ^ 1);
+    pos->hash ^= zobristSide;
+}
+
+void position_unmakeMove(Position_st* pos, ChessMove_t move, const PositionUndo_st* undo) {
+    u32 us = pos->side ^ 1;
+    u32 from = MOVE_FROM(move), to = MOVE_TO(move), flag = MOVE_FLAG(move);
+
+    pos->side = (u8)us;
+    if (us == COLOR_PIECE_BLACK) pos->fullmoveNumber--;
+
+    if (flag >= MOVE_FLAG_PROMO_PONEY) {
+        removePiece(pos, to);
+        addPiece(pos, to, SQUARE_PIECE(us, PIECE_NAME_PAWN));
+    } else if (flag == MOVE_FLAG_CASTLE) {
+        if (to > from) movePiece(pos, to - 1, to + 1);
+        else           movePiece(pos, to + 1, to - 2);
+    }
+
+    movePiece(pos, to, from);
+
+    if (flag == MOVE_FLAG_EN_PASSANT) {
+        addPiece(pos, us == COLOR_PIECE_WHITE ? to - 8 : to + 8, undo->captured);
+    } else if (undo->captured) {
+        addPiece(pos, to, undo->captured);
+    }
+
+    pos->castling = undo->castling;
+    pos->epSquare = undo->epSquare;
+    pos->halfmoveClock = undo->halfmoveClock;
+    pos->hash = undo->hash;
+}
+
+ChessMove_t position_findMove(const Position_st* pos, u32 from, u32 to, PieceName_et promotion) {
+    MoveList_st list;
+    position_generateLegal(pos, &list);
+    return position_findInList(&list, from, to, promotion);
+}
+
+ChessMove_t position_findInList(const MoveList_st* list, u32 from, u32 to, PieceName_et promotion) {
+    for (u32 i = 0; i < list->count; i++) {
+        ChessMove_t m = list->moves[i];
+        if (MOVE_FROM(m) != from || MOVE_TO(m) != to) continue;
+        if (!MOVE_IS_PROMOTION(m)) return m;
+        // A promotion without an explicit choice is a queen, like the UI default
+        if (position_promotionPiece(m) == (promotion == PIECE_NAME_NONE ? PIECE_NAME_QUEEN : promotion)) return m;
+    }
+    return MOVE_NONE;
+}
@@ -0,0 +1,219 @@
+/**
+    @file tablebase.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Endgame tables built by retrograde analysis (see tablebase.h).
+
+    A table covers the strong side's king and piece against the lone king,
+    with the strong side normalized to White. Each entry holds 0 (draw) or
+    1 + the plies to mate: a win when White is to move, a loss when Black is.
+
+    The build counts back from the mates. A position of Black's where every
+    move walks into a won position is lost; a position of White's with one
+    move into a lost position is won. Each step only visits the predecessors
+    of the positions found at the previous step, so every position is
+    touched a handful of times.
+*/
+#include "tablebase.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define TB_SQUARES 64
+#define TB_POSITIONS (2 * TB_SQUARES * TB_SQUARES * TB_SQUARES)
+#define TB_INDEX(stm, wk, bk, piece) (((((stm) * TB_SQUARES + (wk)) * TB_SQUARES + (bk)) * TB_SQUARES) + (piece))
+#define TB_ESCAPES 0xFF     ///< Degree of a Black position that can take the piece: never lost
+
+/**
+    @brief Tables by strong piece: queen, rook.
+*/
+static u8 tables[2][TB_POSITIONS];
+static pthread_once_t buildOnce = PTHREAD_ONCE_INIT;
+static atomic_bool built;
+
+static inline Bitboard_t pieceAttacks(PieceName_et name, u32 sq, Bitboard_t occupied) {
+    return name == PIECE_NAME_QUEEN ? bitboard_queenAttacks(sq, occupied) : bitboard_rookAttacks(sq, occupied);
+}
+
+static inline bool distinctSquares(u32 wk, u32 bk, u32 piece) {
+    return wk != bk && wk != piece && bk != piece;
+}
+
+/**
+    @brief White to move: the kings apart and Black not in check.
+*/
+static inline bool legalWhiteToMove(PieceName_et name, u32 wk, u32 bk, u32 piece) {
+    return distinctSquares(wk, bk, piece) && !(kingAttacks[wk] & SQUARE_BB(bk)) &&
+           !(pieceAttacks(name, piece, SQUARE_BB(wk) | SQUARE_BB(bk)) & SQUARE_BB(bk));
+}
+
+static inline bool legalBlackToMove(u32 wk, u32 bk, u32 piece) {
+    return distinctSquares(wk, bk, piece) && !(kingAttacks[wk] & SQUARE_BB(bk));
+}
+
+/**
+    @brief Fills one table.
+    @param[out] values  TB_POSITIONS entries
+*/
+static void buildTable(PieceName_et name, u8* values) {
+    u8* degree = malloc(TB_SQUARES * TB_SQUARES * TB_SQUARES);
+    u32* lost = malloc(TB_SQUARES * TB_SQUARES * TB_SQUARES * sizeof(u32));
+    u32* won = malloc(TB_SQUARES * TB_SQUARES * TB_SQUARES * sizeof(u32));
+    if (!degree || !lost || !won) {
+        free(degree);
+        free(lost);
+        free(won);
+        return;
+    }
+
+    // Black to move: count the moves, find the mates
+    u32 lostCount = 0;
+    for (u32 wk = 0; wk < TB_SQUARES; wk++) {
+        for (u32 bk = 0; bk < TB_SQUARES; bk++) {
+            for (u32 piece = 0; piece < TB_SQUARES; piece++) {
+                u32 i = TB_INDEX(0, wk, bk, piece);
+                degree[i] = 0;
+                if (!legalBlackToMove(wk, bk, piece)) continue;
+
+                // The piece attacks through the square the king leaves
+                Bitboard_t guarded = kingAttacks[wk] | pieceAttacks(name, piece, SQUARE_BB(wk) | SQUARE_BB(piece));
+                Bitboard_t moves = kingAttacks[bk] & ~guarded & ~SQUARE_BB(wk);
+                bool inCheck = pieceAttacks(name, piece, SQUARE_BB(wk) | SQUARE_BB(bk)) & SQUARE_BB(bk);
+
+                if (moves & SQUARE_BB(piece)) degree[i] = TB_ESCAPES;
+                else degree[i] = (u8)bitboard_count(moves);
+                if (!moves && inCheck) {
+                    values[TB_INDEX(1, wk, bk, piece)] = 1;
+                    lost[lostCount++] = i;
+                }
+            }
+        }
+    }
+
+    for (u8 plies = 0; lostCount > 0 && plies < 253; plies += 2) {
+        // White moves into a lost position of Black's: won
+        u32 wonCount = 0;
+        for (u32 n = 0; n < lostCount; n++) {
+            u32 i = lost[n];
+            u32 wk = i / (TB_SQUARES * TB_SQUARES), bk = (i / TB_SQUARES) % TB_SQUARES, piece = i % TB_SQUARES;
+            Bitboard_t occupied = SQUARE_BB(wk) | SQUARE_BB(bk) | SQUARE_BB(piece);
+
+            Bitboard_t from = pieceAttacks(name, piece, occupied) & ~occupied;
+            while (from) {
+                u32 sq = bitboard_pop(&from);
+                u32 j = TB_INDEX(0, wk, bk, sq);
+                if (values[j] == 0 && legalWhiteToMove(name, wk, bk, sq)) {
+                    values[j] = plies + 2;
+                    won[wonCount++] = j;
+                }
+            }
+            from = kingAttacks[wk] & ~occupied & ~kingAttacks[bk];
+            while (from) {
+                u32 sq = bitboard_pop(&from);
+                u32 j = TB_INDEX(0, sq, bk, piece);
+                if (values[j] == 0 && legalWhiteToMove(name, sq, bk, piece)) {
+                    values[j] = plies + 2;
+                    won[wonCount++] = j;
+                }
+            }
+        }
+
+        // Black's last move that did not walk into a won position is gone
+        lostCount = 0;
+        for (u32 n = 0; n < wonCount; n++) {
+            u32 i = won[n];
+            u32 wk = i / (TB_SQUARES * TB_SQUARES), bk = (i / TB_SQUARES) % TB_SQUARES, piece = i % TB_SQUARES;
+            Bitboard_t from = kingAttacks[bk] & ~SQUARE_BB(wk) & ~SQUARE_BB(piece) & ~kingAttacks[wk];
+            while (from) {
+                u32 sq = bitboard_pop(&from);
+                u32 j = TB_INDEX(0, wk, sq, piece);
+                if (degree[j] == TB_ESCAPES || degree[j] == 0) continue;
+                if (--degree[j] == 0 && values[j + TB_INDEX(1, 0, 0, 0)] == 0) {
+                    values[j + TB_INDEX(1, 0, 0, 0)] = plies + 3;
+                    lost[lostCount++] = j;
+                }
+            }
+        }
+    }
+
+    free(degree);
+    free(lost);
+    free(won);
+}
+
+static void buildTables(void) {
+    bitboard_init();
+    buildTable(PIECE_NAME_QUEEN, tables[0]);
+    buildTable(PIECE_NAME_ROOK, tables[1]);
+    atomic_store_explicit(&built, true, memory_order_release);
+}
+
+void tablebase_init(void) {
+    pthread_once(&buildOnce, buildTables);
+}
+
+bool tablebase_ready(void) {
+    return atomic_load_explicit(&built, memory_order_acquire);
+}
+
+bool tablebase_probe(const Position_st* pos, TablebaseProbe_st* out) {
+    Bitboard_t kings = pos->pieces[COLOR_PIECE_WHITE][PIECE_NAME_KING] | pos->pieces[COLOR_PIECE_BLACK][PIECE_NAME_KING];
+    Bitboard_t others = pos->occupied & ~kings;
+    if (bitboard_count(others) > TABLEBASE_MAX_PIECES - 2 || bitboard_count(kings) != 2 || pos->castling) return false;
+    if (!tablebase_ready()) return false;
+
+    out->wdl = TABLEBASE_DRAW;
+    out->pliesToMate = 0;
+    if (!others) return true;
+
+    u32 sq = bitboard_first(others);
+    u8 piece = pos->squares[sq];
+    PieceName_et name = SQUARE_PIECE_NAME(piece);
+    if (name == PIECE_NAME_PONEY || name == PIECE_NAME_BISHOP) return true;     // Cannot mate
+    if (name != PIECE_NAME_QUEEN && name != PIECE_NAME_ROOK) return false;
+
+    // Normalize the strong side to White by flipping the board
+    u32 strong = SQUARE_PIECE_COLOR(piece);
+    u32 flip = strong == COLOR_PIECE_WHITE ? 0 : 56;
+    u32 wk = position_kingSquare(pos, strong) ^ flip, bk = position_kingSquare(pos, strong ^ 1) ^ flip;
+    u32 stm = pos->side == strong ? 0 : 1;
+
+    u8 value = tables[name == PIECE_NAME_QUEEN ? 0 : 1][TB_INDEX(stm, wk, bk, sq ^ flip)];
+    if (value) {
+        out->wdl = stm == 0 ? TABLEBASE_WIN : TABLEBASE_LOSS;
+        out->pliesToMate = value - 1;
+    }
+    return true;
+}
+
+ChessMove_t tablebase_bestMove(const Position_st* pos, TablebaseProbe_st* out) {
+    TablebaseProbe_st root;
+    if (!tablebase_probe(pos, &root)) return MOVE_NONE;
+
+    MoveList_st moves;
+    position_generateLegal(pos, &moves);
+
+    ChessMove_t best = MOVE_NONE;
+    s32 bestRank = 0;
+    TablebaseProbe_st bestResult = root;
+    for (u32 i = 0; i < moves.count; i++) {
+        Position_st next = *pos;
+        PositionUndo_st undo;
+        TablebaseProbe_st reply;
+        position_makeMove(&next, moves.moves[i], &undo);
+        if (!tablebase_probe(&next, &reply)) continue;
+
+        // Win soonest, else draw, else lose as late as possible
+        TablebaseWdl_et wdl = (TablebaseWdl_et)-reply.wdl;
+        s32 rank = wdl == TABLEBASE_WIN ? 1000 - reply.pliesToMate : wdl == TABLEBASE_LOSS ? -1000 + reply.pliesToMate : 0;
+        if (best == MOVE_NONE || rank > bestRank) {
+            best = moves.moves[i];
+            bestRank = rank;
+            bestResult.wdl = wdl;
+            bestResult.pliesToMate = wdl == TABLEBASE_DRAW ? 0 : reply.pliesToMate + 1;
+        }
+    }
+    if (out) *out = bestResult;
+    return best;
+}
@@ -0,0 +1,114 @@
+/**
+    @file transposition.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Bucketed transposition table (see transposition.h).
+*/
+#include "transposition.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TT_BUCKET_BYTES 64
+
+#define DATA_SCORE(d)       ((s32)(u32)(d))
+#define DATA_MOVE(d)        ((ChessMove_t)((d) >> 32))
+#define DATA_DEPTH(d)       ((u8)((d) >> 48))
+#define DATA_GENERATION(d)  ((u8)((d) >> 58))
+#define DATA_BOUND(d)       ((TTBound_et)(((d) >> 56) & 3))
+
+static u64 packData(s32 score, ChessMove_t move, u8 depth, u8 generation, TTBound_et bound) {
+    return (u64)(u32)score | ((u64)move << 32) | ((u64)depth << 48) | ((u64)bound << 56) | ((u64)(generation & 63) << 58);
+}
+
+static inline TTBucket_st* bucketOf(const TranspositionTable_st* tt, u64 hash) {
+    return &tt->buckets[hash & tt->bucketMask];
+}
+
+bool tt_init(TranspositionTable_st* tt, u32 megabytes) {
+    u64 count = ((u64)megabytes << 20) / sizeof(TTBucket_st);
+    if (count == 0) count = 1;
+    while (count & (count - 1)) count &= count - 1;     // Round down to a power of two
+
+    tt->buckets = aligned_alloc(TT_BUCKET_BYTES, count * sizeof(TTBucket_st));
+    if (!tt->buckets) {
+        tt->bucketMask = 0;
+        return false;
+    }
+    tt->bucketMask = count - 1;
+    tt_clear(tt);
+    return true;
+}
+
+void tt_free(TranspositionTable_st* tt) {
+    free(tt->buckets);
+    tt->buckets = NULL;
+    tt->bucketMask = 0;
+}
+
+void tt_clear(TranspositionTable_st* tt) {
+    if (tt->buckets) memset(tt->buckets, 0, (tt->bucketMask + 1) * sizeof(TTBucket_st));
+    tt->generation = 0;
+}
+
+void tt_newSearch(TranspositionTable_st* tt) {
+    tt->generation = (tt->generation + 1) & 63;
+}
+
+bool tt_probe(const TranspositionTable_st* tt, u64 hash, TTHit_st* hit) {
+    const TTBucket_st* bucket = bucketOf(tt, hash);
+    for (u32 i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        u64 data = bucket->entries[i].data;
+        if ((bucket->entries[i].keyXorData ^ data) != hash || DATA_BOUND(data) == TT_BOUND_NONE) continue;
+
+        hit->score = DATA_SCORE(data);
+        hit->move = DATA_MOVE(data);
+        hit->depth = DATA_DEPTH(data);
+        hit->bound = DATA_BOUND(data);
+        return true;
+    }
+    return false;
+}
+
+void tt_store(TranspositionTable_st* tt, u64 hash, s32 score, ChessMove_t move, u8 depth, TTBound_et bound) {
+    TTBucket_st* bucket = bucketOf(tt, hash);
+    TTEntry_st* victim = NULL;
+    s32 victimWorth = 0;
+
+    for (u32 i = 0; i < TT_BUCKET_ENTRIES; i++) {
+        TTEntry_st* e = &bucket->entries[i];
+        u64 data = e->data;
+
+        if ((e->keyXorData ^ data) == hash) {
+            // Same position: keep a deeper result of this search, but never lose its move
+            if (DATA_GENERATION(data) == tt->generation && DATA_DEPTH(data) > depth && bound != TT_BOUND_EXACT) return;
+            if (move == MOVE_NONE) move = DATA_MOVE(data);
+            victim = e;
+            break;
+        }
+
+        // Entries of older searches count 8 plies shallower per generation
+        s32 age = (tt->generation - DATA_GENERATION(data)) & 63;
+        s32 worth = DATA_BOUND(data) == TT_BOUND_NONE ? -1000 : (s32)DATA_DEPTH(data) - 8 * age;
+        if (!victim || worth < victimWorth) {
+            victim = e;
+            victimWorth = worth;
+        }
+    }
+
+    u64 data = packData(score, move, depth, tt->generation, bound);
+    victim->data = data;
+    victim->keyXorData = hash ^ data;
+}
+
+u32 tt_hashfull(const TranspositionTable_st* tt) {
+    u64 buckets = tt->bucketMask + 1 < 250 ? tt->bucketMask + 1 : 250;
+    u32 used = 0;
+    for (u64 b = 0; b < buckets; b++) {
+        for (u32 i = 0; i < TT_BUCKET_ENTRIES; i++) {
+            u64 data = tt->buckets[b].entries[i].data;
+            if (DATA_BOUND(data) != TT_BOUND_NONE && DATA_GENERATION(data) == tt->generation) used++;
+        }
+    }
+    return (u32)(used * 1000 / (buckets * TT_BUCKET_ENTRIES));
+}
@@ -2,7 +2,7 @@
     @file clientInterface.c
     @author i-Charlys
     @date 2026-04-02
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Client-side network interface for Chess.
 */
 
@@ -12,7 +12,9 @@
 #include "game.h"
 #include "event.h"
 #include "rendering.h"
+#include "board.h"
 #include "ai.h"
+#include "aiWorker.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -51,6 +53,26 @@ static s32 selected_bot_level = 0;
 */
 static s32 my_id_internal = -1;
 
+/**
+    @brief Lazy SMP threads of the bot's search (the host also runs the game and the network).
+*/
+#define BOT_SEARCH_THREADS 2
+
+/**
+    @brief Background search played by the host for the bot, so the window never freezes while it thinks.
+*/
+static AiWorker_st bot_worker;
+
+/**
+    @brief The bot's search for the current turn was started.
+*/
+static bool bot_thinking = false;
+
+/**
+    @brief Opening book of the offline bot (empty if it could not be loaded).
+*/
+static OpeningBook_st bot_book;
+
 #pragma pack(push, 1)
 /**
     @brief Network payload for a chess move.
@@ -64,6 +86,44 @@ typedef struct {
 
 extern void chess_initAudio(void);
 
+/**
+    @brief Piece a ChessMovePayload_St promotion code stands for.
+*/
+static PieceName_et promotionFromCode(u8 code) {
+    static const PieceName_et pieces[5] = {PIECE_NAME_NONE, PIECE_NAME_QUEEN, PIECE_NAME_ROOK, PIECE_NAME_BISHOP, PIECE_NAME_PONEY};
+    return code < 5 ? pieces[code] : PIECE_NAME_NONE;
+}
+
+/**
+    @brief ChessMovePayload_St promotion code of a piece (0 if it is not a promotion piece).
+*/
+static u8 promotionToCode(PieceName_et name) {
+    switch (name) {
+        case PIECE_NAME_QUEEN:  return 1;
+        case PIECE_NAME_ROOK:   return 2;
+        case PIECE_NAME_BISHOP: return 3;
+        case PIECE_NAME_PONEY:  return 4;
+        default:                return 0;
+    }
+}
+
+/**
+    @brief Play a received move on the local board, through the bitboard rules.
+    @param[in] move The move payload
+    @return bool True if the move was legal and played
+*/
+static bool applyNetworkMove(const ChessMovePayload_St* move) {
+    if (move->from_x >= BOARD_SIZE || move->from_y >= BOARD_SIZE || move->to_x >= BOARD_SIZE || move->to_y >= BOARD_SIZE) return false;
+
+    IVec2_st from = {move->from_x, move->from_y}, to = {move->to_x, move->to_y};
+    ChessMove_t legal = boardFindLegalMove(current_board, playerTurn, from, to, promotionFromCode(move->promotion));
+    if (legal == MOVE_NONE) return false;
+
+    boardApplyMove(current_board, legal);
+    playerTurn = !playerTurn;
+    return true;
+}
+
 /**
     @brief Initialize the chess client module.
 */
@@ -73,6 +133,12 @@ void chess_init(void) {
     initPlayers();
     initBoard(current_board);
     resetGame();
+    if (!bot_worker.running && aiWorker_start(&bot_worker, TT_DEFAULT_MB, BOT_SEARCH_THREADS)) {
+        if (book_load(&bot_book, BOOK_PATH, BOOK_SOURCE_PATH)) aiWorker_setBook(&bot_worker, &bot_book);
+    } else if (bot_worker.running) {
+        aiWorker_newGame(&bot_worker);
+    }
+    bot_thinking = false;
     if (moveMade == NULL) {
         moveMade = calloc(12, sizeof(char));
     }
@@ -125,16 +191,8 @@ void chess_onData(s32 player_id, u8 action, const void* data, u16 len) {
         if (len >= sizeof(ChessMovePayload_St)) {
             ChessMovePayload_St move;
             memcpy(&move, data, sizeof(ChessMovePayload_St));
-            // Apply move to local board
-            Piece_st* p = current_board[move.from_y][move.from_x];
-            if (p) {
-                Piece_st* captured = current_board[move.to_y][move.to_x];
-                if (captured) captured->isTaken = true;
-                current_board[move.to_y][move.to_x] = p;
-                current_board[move.from_y][move.from_x] = NULL;
-                p->pos.x = move.to_x;
-                p->pos.y = move.to_y;
-                playerTurn = !playerTurn;
+            if (!applyNetworkMove(&move)) {
+                printf("[CHESS] Ignoring illegal move %d,%d -> %d,%d\n", move.from_x, move.from_y, move.to_x, move.to_y);
             }
         }
     }
@@ -179,7 +237,7 @@ void chess_update(float dt) {
             
             if (IsKeyPressed(KEY_ENTER)) {
                 printf("[CHESS] Host sending START_GAME...\n");
-                GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_START_GAME, .length = htons(sizeof(s32)) };
+                GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_START_GAME, .length = htons(sizeof(s32)), .isReliable = true };
                 RUDPHeader_St h;
                 rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
                 h.senderId = htons((u16)(my_id_internal != -1 ? my_id_internal : 0));
@@ -203,7 +261,10 @@ void chess_update(float dt) {
                     .to_x = (u8)previousMoveCell[1].x, .to_y = (u8)previousMoveCell[1].y,
                     .promotion = 0
                 };
-                GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_CHESS_MOVE, .length = htons(sizeof(payload)) };
+                // A pawn reaching the last rank has already been renamed by promotionChoice()
+                Piece_st* moved = current_board[payload.to_y][payload.to_x];
+                if (moved && (payload.to_y == 0 || payload.to_y == BOARD_SIZE - 1)) payload.promotion = promotionToCode(moved->name);
+                GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_CHESS_MOVE, .length = htons(sizeof(payload)), .isReliable = true };
                 RUDPHeader_St h;
                 rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
                 h.senderId = htons((u16)(my_id_internal != -1 ? my_id_internal : 0));
@@ -214,48 +275,71 @@ void chess_update(float dt) {
                 memcpy(ptr, &tlv, sizeof(tlv)); ptr += sizeof(tlv);
                 memcpy(ptr, &payload, sizeof(payload)); ptr += sizeof(payload);
                 send(networkSocket, buf, (size_t)(ptr - buf), 0);
+                rudpTrackReliable(&serverConnection, buf, (u16)(ptr - buf));
                 saveMove = false;
             }
-        } else if (my_id_internal == 0 && selected_bot_level > 0) {
-            // Host plays for the bot
+        } else if (my_id_internal == 0 && selected_bot_level > 0 && networkSocket < 0) {
+            // Offline, the host plays for the bot (a server plays it in its room and sends its moves);
+            // the search runs on bot_worker and is polled every frame
             static f32 bot_delay = 0;
+            static const u32 botThinkMs[4] = {0, 100, 500, 1500};
+            u32 thinkMs = botThinkMs[selected_bot_level < 4 ? selected_bot_level : 3];
+            Position_st pos;
+            ChessMove_st best = {{-1, -1}, {-1, -1}, 0, MOVE_NONE};
+            bool ready = false;
+
+            if (!bot_thinking) {
+                boardToPosition(current_board, playerTurn, &pos);
+                if (bot_worker.running) aiWorker_think(&bot_worker, &pos, thinkMs);
+                bot_thinking = true;
+                bot_delay = 0;
+            }
             bot_delay += dt;
-            if (bot_delay >= 1.0f && whitePlayer != NULL && blackPlayer != NULL) {
-                u8 depth = (u8)((selected_bot_level == 1) ? 2 : (selected_bot_level == 2 ? 3 : 3)); // Max depth 3
-                ChessMove_st best = ai_getBestMove(current_board, whitePlayer, blackPlayer, playerTurn, depth);
-                if (best.from.x != -1) {
+            if (IsKeyPressed(KEY_SPACE) && bot_worker.running) aiWorker_moveNow(&bot_worker);
+
+            // The move is shown one second after the turn started at the earliest
+            if (bot_delay >= 1.0f) {
+                if (!bot_worker.running) {
+                    best = ai_getBestMove(current_board, playerTurn, thinkMs);
+                    ready = true;
+                } else {
+                    ready = aiWorker_poll(&bot_worker, &best);
+                }
+            }
+
+            if (ready) {
+                bot_thinking = false;
+                if (best.move != MOVE_NONE) {
                     ChessMovePayload_St payload = {
                         .from_x = (u8)best.from.x, .from_y = (u8)best.from.y,
                         .to_x = (u8)best.to.x, .to_y = (u8)best.to.y,
-                        .promotion = 0
+                        .promotion = promotionToCode(position_promotionPiece(best.move))
                     };
-                    
+
                     // Apply locally
-                    Piece_st* p = current_board[payload.from_y][payload.from_x];
-                    if (p) {
-                        Piece_st* captured = current_board[payload.to_y][payload.to_x];
-                        if (captured) captured->isTaken = true;
-                        current_board[payload.to_y][payload.to_x] = p;
-                        current_board[payload.from_y][payload.from_x] = NULL;
-                        p->pos.x = payload.to_x;
-                        p->pos.y = payload.to_y;
-                        playerTurn = !playerTurn;
-                        
-                        // Broadcast to others
-                        GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_CHESS_MOVE, .length = htons(sizeof(payload)) };
-                        RUDPHeader_St h;
-                        rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
-                        h.senderId = htons((u16)(my_id_internal != -1 ? my_id_internal : 0));
-                        u8 buf[128];
-                        memset(buf, 0, sizeof(buf));
-                        u8* ptr = buf;
-                        memcpy(ptr, &h, sizeof(h)); ptr += sizeof(h);
-                        memcpy(ptr, &tlv, sizeof(tlv)); ptr += sizeof(tlv);
-                        memcpy(ptr, &payload, sizeof(payload)); ptr += sizeof(payload);
-                        send(networkSocket, buf, (size_t)(ptr - buf), 0);
+                    boardApplyMove(current_board, best.move);
+                    playerTurn = !playerTurn;
+
+                    // The hard bot thinks on the human's time too, assuming the reply its search expects
+                    if (bot_worker.running && selected_bot_level >= 3) {
+                        boardToPosition(current_board, playerTurn, &pos);
+                        aiWorker_ponder(&bot_worker, &pos, thinkMs);
                     }
+
+                    // Broadcast to others
+                    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_CHESS_MOVE, .length = htons(sizeof(payload)), .isReliable = true };
+                    RUDPHeader_St h;
+                    rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
+                    h.senderId = htons((u16)(my_id_internal != -1 ? my_id_internal : 0));
+                    u8 buf[128];
+                    memset(buf, 0, sizeof(buf));
+                    u8* ptr = buf;
+                    memcpy(ptr, &h, sizeof(h)); ptr += sizeof(h);
+                    memcpy(ptr, &tlv, sizeof(tlv)); ptr += sizeof(tlv);
+                    memcpy(ptr, &payload, sizeof(payload)); ptr += sizeof(payload);
+                    send(networkSocket, buf, (size_t)(ptr - buf), 0);
+                    rudpTrackReliable(&serverConnection, buf, (u16)(ptr - buf));
                 }
-                bot_delay = 0;
             }
         }
     }
@@ -291,6 +375,15 @@ void chess_draw(void) {
     DrawText("ESC pour quitter", GetScreenWidth() - 150, 10, 15, DARKGRAY);
 }
 
+/**
+    @brief Stop the bot's search thread when leaving the game.
+*/
+void chess_destroy(void) {
+    aiWorker_shutdown(&bot_worker);
+    book_close(&bot_book);
+    bot_thinking = false;
+}
+
 /**
     @brief Chess client module interface definition.
 */
@@ -300,5 +393,6 @@ GameClientInterface_St chess_clientInterface = {
     .init = chess_init,
     .onData = chess_onData,
     .update = chess_update,
-    .draw = chess_draw
+    .draw = chess_draw,
+    .destroy = chess_destroy
 };
\ No newline at end of file
@@ -2,15 +2,30 @@
     @file serverInterface.c
     @author i-Charlys
     @date 2026-04-02
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Server-side implementation of the chess game.
+
+    The room holds the authoritative position: a move is relayed only if
+    it comes from the player to move and is legal there. When the host
+    starts a game against the bot, the room plays Black itself; the
+    search runs on a worker leased from the shared pool (aiPool.h) and
+    the room tick only polls it, so a thinking bot never holds the tick
+    of its room, or of the rooms sharing its server worker.
 */
 #include "chessAPI.h"
+#include "aiPool.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <arpa/inet.h>
 
+#define CHESS_IDLE_SLEEP_MS 1000    ///< Tick interval while no bot has to play; moves are driven by actions
+#define CHESS_BOT_POLL_MS 10        ///< Tick interval while the bot thinks or waits for a free worker
+#define CHESS_BOT_MIN_DELAY_MS 1000 ///< Milliseconds before a bot move is played, however fast it was found
+#define CHESS_NO_PLAYER -1          ///< Empty seat
+#define CHESS_BOT_PLAYER -2         ///< Seat played by the room
 #pragma pack(push, 1)
 /**
     @brief Struct representing a chess move payload for networking.
@@ -26,24 +41,99 @@ typedef struct {
     @brief State of a chess server instance.
 */
 typedef struct {
+    int players[2];             ///< IDs of white and black players (CHESS_NO_PLAYER, CHESS_BOT_PLAYER)
+    int numPlayers;             ///< Human players seated
+    bool started;               ///< START_GAME received; moves are refused before
+    Position_st position;       ///< Authoritative game; the side to move is whose turn it is
+    PositionStatus_et status;   ///< Checkmate or stalemate ends the game
+    s32 botLevel;               ///< 0: two humans, 1 to 3: the room plays Black
+    u64 gameId;                 ///< Pool key of the current game
+    AiWorker_st* bot;           ///< Worker leased while the bot thinks, NULL otherwise
+    u64 botTurnStartMs;         ///< Monotonic time of the move that started the bot's turn
+} ChessServerState;
+
 /**
-    @brief Creates a new chess game instance.
-    @return Pointer to the allocated server state.
+    @brief Thinking time of the bot by level, the same as the client's.
 */
-int players[2]; // IDs of white and black players
-    int numPlayers;
-    int turn; // 0 or 1
-    // Board state could be here too if we wanted authoritative server
-} ChessServerState;
+static const u32 botThinkMs[4] = {0, 100, 500, 1500};
+
+/**
+    @brief Piece a ChessMovePayload_St promotion code stands for.
+*/
+static PieceName_et promotionFromCode(u8 code) {
+    static const PieceName_et pieces[5] = {PIECE_NAME_NONE, PIECE_NAME_QUEEN, PIECE_NAME_ROOK, PIECE_NAME_BISHOP, PIECE_NAME_PONEY};
+    return code < 5 ? pieces[code] : PIECE_NAME_NONE;
+}
+
+/**
+    @brief ChessMovePayload_St promotion code of a piece (0 if it is not a promotion piece).
+*/
+static u8 promotionToCode(PieceName_et name) {
+    switch (name) {
+        case PIECE_NAME_QUEEN:  return 1;
+        case PIECE_NAME_ROOK:   return 2;
+        case PIECE_NAME_BISHOP: return 3;
+        case PIECE_NAME_PONEY:  return 4;
+        default:                return 0;
+    }
+}
+
+/**
+    @brief Hands the bot's worker back to the pool, dropping its search.
+*/
+static void releaseBot(ChessServerState* cs) {
+    if (!cs->bot) return;
+    aiPool_release(cs->bot);
+    cs->bot = NULL;
+}
+
+/**
+    @brief True if the game goes on and the room has to play the side to move.
+*/
+static bool botToMove(const ChessServerState* cs) {
+    return cs->started && cs->status == POSITION_ONGOING && cs->players[cs->position.side] == CHESS_BOT_PLAYER;
+}
+
+/**
+    @brief Monotonic clock in milliseconds, unaffected by the room's sleep between ticks.
+*/
+static u64 nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000 + (u64)ts.tv_nsec / 1000000;
+}
+
+/**
+    @brief Plays a legal move on the authoritative position and updates the game status.
+*/
+static void playMove(ChessServerState* cs, ChessMove_t move) {
+    PositionUndo_st undo;
+    position_makeMove(&cs->position, move, &undo);
+    cs->status = position_status(&cs->position);
+    cs->botTurnStartMs = nowMs();
+}
+
+/**
+    @brief Initializes a zeroed chess server state in place.
+    @param[in,out] state Zeroed block of sizeof(ChessServerState) bytes
+*/
+void chess_initInstance(void *state) {
+    ChessServerState* cs = (ChessServerState*)state;
+    cs->players[0] = CHESS_NO_PLAYER;
+    cs->players[1] = CHESS_NO_PLAYER;
+    cs->numPlayers = 0;
+    cs->started = false;
+    position_setStart(&cs->position);
+    cs->status = POSITION_ONGOING;
+    cs->botLevel = 0;
+    cs->gameId = 0;
+    cs->bot = NULL;
+    cs->botTurnStartMs = 0;
+}
 
 void* chess_createInstance(void) {
     ChessServerState* cs = calloc(1, sizeof(ChessServerState));
-    if (cs) {
-        cs->players[0] = -1;
-        cs->players[1] = -1;
-        cs->numPlayers = 0;
-        cs->turn = 0;
-    }
+    if (cs) chess_initInstance(cs);
     return cs;
 }
 
@@ -66,17 +156,16 @@ void chess_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
     
     ChessServerState* cs = (ChessServerState*)state;
     u8 realAction = tlv->action;
-    void* realPayload = (u8*)payload + sizeof(GameTLVHeader_St);
-    (void)realPayload;
+    const void* realPayload = (const u8*)payload + sizeof(GameTLVHeader_St);
 
     if (realAction == ACTION_CODE_JOIN_GAME) {
         int internalId = -1;
         // Assign white then black
-        if (cs->players[0] == -1) {
+        if (cs->players[0] == CHESS_NO_PLAYER) {
             cs->players[0] = playerId;
             internalId = 0;
             cs->numPlayers++;
-        } else if (cs->players[1] == -1 && cs->players[0] != playerId) {
+        } else if (cs->players[1] == CHESS_NO_PLAYER && cs->players[0] != playerId) {
             cs->players[1] = playerId;
             internalId = 1;
             cs->numPlayers++;
@@ -85,7 +174,7 @@ void chess_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
         if (internalId != -1) {
             u8 bufAck[64];
             memset(bufAck, 0, sizeof(bufAck));
-            GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)) };
+            GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)), .isReliable = true };
             u16 netInternalId = htons((u16)internalId);
             memcpy(bufAck, &tlvAck, sizeof(tlvAck));
             memcpy(bufAck + sizeof(tlvAck), &netInternalId, sizeof(u16));
@@ -93,36 +182,128 @@ void chess_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
         }
     }
     else if (realAction == ACTION_CODE_START_GAME) {
+        if (playerId != cs->players[0]) return;     // Only the host starts
+
+        s32 level = 0;
+        if (len >= sizeof(GameTLVHeader_St) + sizeof(s32)) {
+            s32 netLevel;
+            memcpy(&netLevel, realPayload, sizeof(s32));
+            level = (s32)ntohl((u32)netLevel);
+        }
+        releaseBot(cs);
+        position_setStart(&cs->position);
+        cs->status = POSITION_ONGOING;
+        cs->started = true;
+        cs->botLevel = level > 0 && level < 4 ? level : 0;
+        cs->gameId = aiPool_newGameId();
+        cs->botTurnStartMs = nowMs();
+        if (cs->botLevel > 0) {
+            // The bot takes Black; a human seated there only watches
+            if (cs->players[1] >= 0) cs->numPlayers--;
+            cs->players[1] = CHESS_BOT_PLAYER;
+        } else if (cs->players[1] == CHESS_BOT_PLAYER) {
+            cs->players[1] = CHESS_NO_PLAYER;
+        }
+
         // Broadcast game start to everyone else
         broadcast(roomId, playerId, ACTION_CODE_GAME_DATA, payload, len);
         // Also send back to host so they start the game too
         broadcast(UNICAST, playerId, ACTION_CODE_GAME_DATA, payload, len);
     }
     else if (realAction == ACTION_CODE_CHESS_MOVE) {
-        // Broadcast move to all (including sender for simplicity or excluding)
-        // In our case, we broadcast to everyone so the other player sees it.
+        if (len < sizeof(GameTLVHeader_St) + sizeof(ChessMovePayload_St)) return;
+        if (!cs->started || cs->status != POSITION_ONGOING || cs->players[cs->position.side] != playerId) {
+            printf("[CHESS] Room %d: move from player %d out of turn, dropped\n", (int)roomId, (int)playerId);
+            return;
+        }
+
+        ChessMovePayload_St move;
+        memcpy(&move, realPayload, sizeof(move));
+        ChessMove_t legal = MOVE_NONE;
+        if (move.from_x < BOARD_SIZE && move.from_y < BOARD_SIZE && move.to_x < BOARD_SIZE && move.to_y < BOARD_SIZE) {
+            legal = position_findMove(&cs->position, SQUARE_FROM_XY(move.from_x, move.from_y), SQUARE_FROM_XY(move.to_x, move.to_y),
+                                      promotionFromCode(move.promotion));
+        }
+        if (legal == MOVE_NONE) {
+            printf("[CHESS] Room %d: illegal move %d,%d -> %d,%d from player %d, dropped\n",
+                   (int)roomId, move.from_x, move.from_y, move.to_x, move.to_y, (int)playerId);
+            return;
+        }
+
+        playMove(cs, legal);
+        // The sender already played it; the others see it
         broadcast(roomId, playerId, ACTION_CODE_GAME_DATA, payload, len);
-        cs->turn = !cs->turn;
     }
 }
 
 /**
-    @brief Called on every server tick for the chess game.
+    @brief Called on server ticks for the chess game.
+           Between human moves the room sleeps; on the bot's turn it starts
+           the search on a pooled worker, then polls it until the move comes.
     @param[in,out] state Pointer to the chess server state
+    @param[in,out] ctx   Tick context
 */
+void chess_onRoomTick(void* state, ServerTickContext_St* ctx) {
+    ChessServerState* cs = (ChessServerState*)state;
+    if (!botToMove(cs)) {
+        releaseBot(cs);
+        ctx->sleepMs = CHESS_IDLE_SLEEP_MS;
+        return;
+    }
+
+    if (!cs->bot) {
+        cs->bot = aiPool_acquire(cs->gameId);
+        if (!cs->bot) {
+            ctx->sleepMs = CHESS_BOT_POLL_MS;
+            return;
+        }
+        aiWorker_think(cs->bot, &cs->position, botThinkMs[cs->botLevel]);
+    }
+
+    // The move is played one second after the turn started at the earliest. The
+    // tick's dt would also count the idle sleep before the human moved
+    ChessMove_st best;
+    if (nowMs() - cs->botTurnStartMs < CHESS_BOT_MIN_DELAY_MS || !aiWorker_poll(cs->bot, &best)) {
+        ctx->sleepMs = CHESS_BOT_POLL_MS;
+        return;
+    }
+    releaseBot(cs);
+    if (best.move == MOVE_NONE) return;
+
+    ChessMovePayload_St payload = {
+        .from_x = (u8)SQUARE_X(MOVE_FROM(best.move)), .from_y = (u8)SQUARE_Y(MOVE_FROM(best.move)),
+        .to_x = (u8)SQUARE_X(MOVE_TO(best.move)), .to_y = (u8)SQUARE_Y(MOVE_TO(best.move)),
+        .promotion = promotionToCode(position_promotionPiece(best.move))
+    };
+    playMove(cs, best.move);
+
+    u8 buf[sizeof(GameTLVHeader_St) + sizeof(ChessMovePayload_St)];
+    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = ACTION_CODE_CHESS_MOVE, .length = htons(sizeof(payload)), .isReliable = true };
+    memcpy(buf, &tlv, sizeof(tlv));
+    memcpy(buf + sizeof(tlv), &payload, sizeof(payload));
+    ctx->broadcast(ctx->roomId, -1, ACTION_CODE_GAME_DATA, buf, sizeof(buf));
+    ctx->sleepMs = CHESS_IDLE_SLEEP_MS;
+}
+
 /**
     @brief Handles player disconnection from the chess game.
     @param[in,out] state     Pointer to the chess server state
     @param[in]     player_id ID of the player who left
 */
-void chess_onTick(void* state) {
-    (void)state;
-}
-
 void chess_onPlayerLeave(void* state, s32 playerId) {
     ChessServerState* cs = (ChessServerState*)state;
-    if (cs->players[0] == playerId) { cs->players[0] = -1; cs->numPlayers--; }
-    if (cs->players[1] == playerId) { cs->players[1] = -1; cs->numPlayers--; }
+    if (cs->players[0] == playerId) { cs->players[0] = CHESS_NO_PLAYER; cs->numPlayers--; }
+    if (cs->players[1] == playerId) { cs->players[1] = CHESS_NO_PLAYER; cs->numPlayers--; }
+    // Nobody left to play against the bot
+    if (cs->numPlayers == 0) releaseBot(cs);
+}
+
+/**
+    @brief Hands back the bot's worker, but not the instance itself.
+    @param[in,out] state Pointer to the chess server state
+*/
+void chess_releaseInstance(void *state) {
+    releaseBot((ChessServerState*)state);
 }
 
 /**
@@ -130,6 +311,7 @@ void chess_onPlayerLeave(void* state, s32 playerId) {
     @param[in,out] state Pointer to the chess server state to be destroyed
 */
 void chess_destroyInstance(void *state) {
+    chess_releaseInstance(state);
     free(state);
 }
 
@@ -140,7 +322,10 @@ GameServerInterface_St chess_serverInterface = {
     .gameName = "chess",
     .createInstance = chess_createInstance,
     .onAction = chess_onAction,
-    .onTick = chess_onTick,
+    .onRoomTick = chess_onRoomTick,
     .onPlayerLeave = chess_onPlayerLeave,
-    .destroyInstance = chess_destroyInstance
+    .destroyInstance = chess_destroyInstance,
+    .instanceSize = sizeof(ChessServerState),
+    .initInstance = chess_initInstance,
+    .releaseInstance = chess_releaseInstance
 };
@@ -2,7 +2,7 @@
     @file rendering.c
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Rendering functions for chess.
 */
 #include "rendering.h"
@@ -140,34 +140,33 @@ void drawPositionsPossibles(Board_t board) {
 
     Piece_st* pieceTemp = NULL;
 
+    // The list holds legal moves only (see updatePossibleMoves())
     for (int i = 0; i < nbPositionsPossibles; i++) {
         pos = positionsPossibles[i];
-        
-        if (!isInCheck(board, selectionnedPiece, pos.x, pos.y, playerTurn)) {
-            int x = BOARD_OFFSET + pos.x * CELL_PX_SIZE;
-            int y = BOARD_OFFSET + pos.y * CELL_PX_SIZE;
-            
-            pieceTemp = board[pos.y][pos.x];
-
-            Texture2D* texture = pieceTemp ? &circleTexture : &dotTexture;
-            
-            Rectangle src = {
-                0, 0,
-                (float)texture->width,
-                (float)texture->height
-            };
-
-            Rectangle dst = {
-                x,
-                y,
-                CELL_PX_SIZE,
-                CELL_PX_SIZE
-            };
-
-            Vector2 origin = {0, 0};
-
-            DrawTexturePro(*texture, src, dst, origin, 0.0f, WHITE);
-        }
+
+        int x = BOARD_OFFSET + pos.x * CELL_PX_SIZE;
+        int y = BOARD_OFFSET + pos.y * CELL_PX_SIZE;
+
+        pieceTemp = board[pos.y][pos.x];
+
+        Texture2D* texture = pieceTemp ? &circleTexture : &dotTexture;
+
+        Rectangle src = {
+            0, 0,
+            (float)texture->width,
+            (float)texture->height
+        };
+
+        Rectangle dst = {
+            x,
+            y,
+            CELL_PX_SIZE,
+            CELL_PX_SIZE
+        };
+
+        Vector2 origin = {0, 0};
+
+        DrawTexturePro(*texture, src, dst, origin, 0.0f, WHITE);
     }
 }
 
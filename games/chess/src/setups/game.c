@@ -2,7 +2,7 @@
     @file game.c
     @author Léandre BAUDET
     @date 2024-01-01
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Game initialization and management functions for Echecs.
 */
 #include "game.h"
@@ -240,12 +240,13 @@ void gameLoop(Board_t board, char *predifinedMoves[], int nbMoves) {
             saveMove = false;
         }
 
-        if (!finished && (patFinished = isStalemate(board))) {
+        if (!finished && (patFinished = isStalemate(board, playerTurn))) {
             finished = true;
             printMovesMade();
         }
-        else if (!finished && isCheckmate(board)) {
+        else if (!finished && isCheckmate(board, playerTurn)) {
             finished = true;
+            PlaySound(sound_checkMate);
             printMovesMade();
         }
 
@@ -1,15 +0,0 @@
-/**
-    @file TODO.c
-    @author Léandre BAUDET
-    @date 2026-01-07
-    @date 2026-04-14
-    @brief Placeholder file indicating that unit/integration tests are not yet implemented.
-*/
-#error "Tests not implemented yet - see tests/TODO.c"
-
-#include "baseTypes.h"
-
-s32 main(void) {
-
-    return 0;
-}
\ No newline at end of file
@@ -0,0 +1,200 @@
+/**
+    @file test_aiWorker.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tests for the background AI search: polling, move now, cancel and pondering.
+
+    The UI thread is played by the test: it polls the way a frame loop
+    would, and every call it makes must return at once.
+*/
+#include "aiWorker.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+#define THINK_MS 200
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static void sleepMs(u32 ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+/**
+    @brief Polls like a 1 kHz frame loop until the move comes or `timeoutMs` passes.
+    @param[out] slowestPoll  Longest single aiWorker_poll() call, in seconds
+*/
+static bool waitMove(AiWorker_st* worker, ChessMove_st* out, u32 timeoutMs, f64* slowestPoll) {
+    f64 end = nowSeconds() + timeoutMs / 1000.0;
+    *slowestPoll = 0.0;
+    while (nowSeconds() < end) {
+        f64 start = nowSeconds();
+        bool ready = aiWorker_poll(worker, out);
+        f64 took = nowSeconds() - start;
+        if (took > *slowestPoll) *slowestPoll = took;
+        if (ready) return true;
+        sleepMs(1);
+    }
+    return false;
+}
+
+static bool isLegal(const Position_st* pos, ChessMove_t move) {
+    return move != MOVE_NONE && position_findMove(pos, MOVE_FROM(move), MOVE_TO(move), position_promotionPiece(move)) == move;
+}
+
+/**
+ * Test that a think job delivers a legal move within its budget without blocking the poller.
+ */
+void test_think() {
+    AiWorker_st worker;
+    Position_st pos;
+    ChessMove_st best;
+    f64 slowest;
+    assert(aiWorker_start(&worker, 16, 1));
+    position_setStart(&pos);
+
+    f64 start = nowSeconds();
+    aiWorker_think(&worker, &pos, THINK_MS);
+    assert(aiWorker_state(&worker) == AI_WORKER_THINKING);
+    assert(waitMove(&worker, &best, THINK_MS + 500, &slowest));
+    f64 elapsed = nowSeconds() - start;
+
+    printf("  think: move in %.0f ms (depth %u), slowest poll %.1f us\n", elapsed * 1000.0, worker.stats.depth, slowest * 1e6);
+    assert(isLegal(&pos, best.move));
+    assert(elapsed * 1000.0 < THINK_MS + 100);
+    assert(slowest < 0.001);
+    assert(aiWorker_state(&worker) == AI_WORKER_IDLE);
+    assert(!aiWorker_poll(&worker, &best));
+
+    aiWorker_shutdown(&worker);
+    printf("test_think passed\n");
+}
+
+/**
+ * Test that "move now" ends a long search at once with its best move so far.
+ */
+void test_move_now() {
+    AiWorker_st worker;
+    Position_st pos;
+    ChessMove_st best;
+    f64 slowest;
+    assert(aiWorker_start(&worker, 16, 1));
+    position_setStart(&pos);
+
+    aiWorker_think(&worker, &pos, 60000);
+    sleepMs(50);
+    f64 start = nowSeconds();
+    aiWorker_moveNow(&worker);
+    assert(waitMove(&worker, &best, 1000, &slowest));
+    f64 elapsed = nowSeconds() - start;
+
+    printf("  move now: move %.1f ms after the request (depth %u)\n", elapsed * 1000.0, worker.stats.depth);
+    assert(isLegal(&pos, best.move));
+    assert(elapsed < 0.05);
+
+    aiWorker_shutdown(&worker);
+    printf("test_move_now passed\n");
+}
+
+/**
+ * Test that a cancelled job never delivers, and that a new job replaces a running one.
+ */
+void test_cancel_and_replace() {
+    AiWorker_st worker;
+    Position_st start, other;
+    ChessMove_st best;
+    f64 slowest;
+    assert(aiWorker_start(&worker, 16, 1));
+    position_setStart(&start);
+    assert(position_fromFen(&other, "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1"));
+
+    aiWorker_think(&worker, &start, 60000);
+    sleepMs(20);
+    aiWorker_cancel(&worker);
+    assert(aiWorker_state(&worker) == AI_WORKER_IDLE);
+    assert(!waitMove(&worker, &best, 100, &slowest));
+
+    // The second job must answer for its own position, not the replaced one
+    aiWorker_think(&worker, &start, 60000);
+    sleepMs(20);
+    aiWorker_think(&worker, &other, THINK_MS);
+    assert(waitMove(&worker, &best, THINK_MS + 500, &slowest));
+    assert(isLegal(&other, best.move));
+
+    aiWorker_shutdown(&worker);
+    printf("test_cancel_and_replace passed\n");
+}
+
+/**
+ * Test pondering: the clock stands still until the guessed reply is played, then the search
+ * carries on from where it is; any other reply starts a fresh search.
+ */
+void test_ponder() {
+    AiWorker_st worker;
+    Position_st pos;
+    ChessMove_st best;
+    f64 slowest;
+    PositionUndo_st undo;
+    assert(aiWorker_start(&worker, 16, 1));
+    position_setStart(&pos);
+
+    aiWorker_think(&worker, &pos, THINK_MS);
+    assert(waitMove(&worker, &best, THINK_MS + 500, &slowest));
+    position_makeMove(&pos, best.move, &undo);
+
+    aiWorker_ponder(&worker, &pos, THINK_MS);
+    sleepMs(THINK_MS * 2);
+    assert(aiWorker_state(&worker) == AI_WORKER_PONDERING);
+
+    // Find the reply the worker guessed
+    pthread_mutex_lock(&worker.lock);
+    u64 ponderHash = worker.ponderHash;
+    pthread_mutex_unlock(&worker.lock);
+    MoveList_st replies;
+    ChessMove_t guessed = MOVE_NONE;
+    position_generateLegal(&pos, &replies);
+    for (u32 i = 0; i < replies.count && guessed == MOVE_NONE; i++) {
+        Position_st next = pos;
+        position_makeMove(&next, replies.moves[i], &undo);
+        if (next.hash == ponderHash) guessed = replies.moves[i];
+    }
+    assert(guessed != MOVE_NONE);
+
+    Position_st hit = pos, miss = pos;
+    position_makeMove(&hit, guessed, &undo);
+    position_makeMove(&miss, replies.moves[0] == guessed ? replies.moves[1] : replies.moves[0], &undo);
+
+    f64 start = nowSeconds();
+    aiWorker_think(&worker, &hit, THINK_MS);
+    assert(waitMove(&worker, &best, THINK_MS + 500, &slowest));
+    f64 elapsed = nowSeconds() - start;
+    u8 hitDepth = worker.stats.depth;
+    printf("  ponder hit: move in %.0f ms, depth %u\n", elapsed * 1000.0, hitDepth);
+    assert(isLegal(&hit, best.move));
+    assert(elapsed * 1000.0 < THINK_MS + 100);
+
+    aiWorker_ponder(&worker, &pos, THINK_MS);
+    sleepMs(50);
+    aiWorker_think(&worker, &miss, THINK_MS);
+    assert(waitMove(&worker, &best, THINK_MS + 500, &slowest));
+    printf("  ponder miss: depth %u\n", worker.stats.depth);
+    assert(isLegal(&miss, best.move));
+
+    aiWorker_shutdown(&worker);
+    printf("test_ponder passed\n");
+}
+
+int main() {
+    test_think();
+    test_move_now();
+    test_cancel_and_replace();
+    test_ponder();
+    printf("All AI worker tests passed!\n");
+    return 0;
+}
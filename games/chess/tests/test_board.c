@@ -0,0 +1,153 @@
+/**
+    @file test_board.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tests for the legal moves cached for the UI board: reuse, invalidation, dots and game end.
+
+    The UI asks for the legal moves many times per position (the dots of
+    the selected piece, the move played, check, checkmate and stalemate
+    every frame); the list must be generated once per position.
+*/
+#include "algo.h"
+#include "board.h"
+#include "game.h"
+#include "globals.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 100000
+
+static Board_t board;
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static void freePlayers(void) {
+    freePlayer(blackPlayer);
+    freePlayer(whitePlayer);
+    blackPlayer = whitePlayer = NULL;
+}
+
+static void resetBoard(void) {
+    freePlayers();
+    assert(initPlayers() == 0);
+    initBoard(board);
+    playerTurn = COLOR_PIECE_WHITE;
+}
+
+/**
+ * Play "e2e4"-style moves on the UI board, through the cached list.
+ */
+static void play(const char* const moves[], u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        IVec2_st from = {moves[i][0] - 'a', BOARD_SIZE - 1 - (moves[i][1] - '1')};
+        IVec2_st to = {moves[i][2] - 'a', BOARD_SIZE - 1 - (moves[i][3] - '1')};
+        ChessMove_t move = boardFindLegalMove(board, playerTurn, from, to, PIECE_NAME_NONE);
+        assert(move != MOVE_NONE);
+        boardApplyMove(board, move);
+        playerTurn = !playerTurn;
+    }
+}
+
+/**
+ * Test that every question about one position reads the same list.
+ */
+void test_reuse() {
+    resetBoard();
+    const BoardMoves_st* legal = boardLegalMoves(board, playerTurn);
+    u64 generations = legal->generations;
+    assert(legal->moves.count == 20 && legal->status == POSITION_ONGOING && !legal->inCheck);
+
+    assert(!isCheckmate(board, playerTurn) && !isStalemate(board, playerTurn));
+    selectPiece(board, (IVec2_st) {1, 7});
+    assert(nbPositionsPossibles == 2);
+    assert(boardFindLegalMove(board, playerTurn, (IVec2_st) {1, 7}, (IVec2_st) {2, 5}, PIECE_NAME_NONE) != MOVE_NONE);
+    assert(boardFindLegalMove(board, playerTurn, (IVec2_st) {1, 7}, (IVec2_st) {3, 6}, PIECE_NAME_NONE) == MOVE_NONE);
+    assert(boardLegalMoves(board, playerTurn) == legal && legal->generations == generations);
+
+    // What the game loop asks every frame
+    f64 start = nowSeconds();
+    for (u32 i = 0; i < FRAMES; i++) {
+        assert(!isStalemate(board, playerTurn) && !isCheckmate(board, playerTurn));
+    }
+    f64 cached = nowSeconds() - start;
+    assert(legal->generations == generations);
+
+    Position_st pos;
+    start = nowSeconds();
+    for (u32 i = 0; i < FRAMES; i++) {
+        boardToPosition(board, playerTurn, &pos);
+        assert(position_status(&pos) == POSITION_ONGOING);
+        boardToPosition(board, playerTurn, &pos);
+        assert(position_status(&pos) == POSITION_ONGOING);
+    }
+    f64 uncached = nowSeconds() - start;
+    printf("  per frame: %.0f ns cached, %.0f ns building and generating twice\n", cached * 1e9 / FRAMES, uncached * 1e9 / FRAMES);
+    selectionnedPiece = NULL;
+    printf("test_reuse passed\n");
+}
+
+/**
+ * Test that the list follows the moves, the side to move and the castling rights.
+ */
+void test_invalidation() {
+    resetBoard();
+    u64 generations = boardLegalMoves(board, playerTurn)->generations;
+
+    const char* const opening[] = {"e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "g8f6"};
+    play(opening, 6);
+    const BoardMoves_st* legal = boardLegalMoves(board, playerTurn);
+    assert(legal->generations > generations);
+    assert(position_findInList(&legal->moves, 4, 6, PIECE_NAME_NONE) != MOVE_NONE);     // O-O
+
+    // Same pieces, other side to move
+    generations = legal->generations;
+    assert(boardLegalMoves(board, !playerTurn)->generations == generations + 1);
+    assert(boardLegalMoves(board, playerTurn)->generations == generations + 2);
+
+    // The king walks there and back: same squares, no castling any more
+    const char* const kingWalk[] = {"e1e2", "h7h6", "e2e1", "h6h5"};
+    play(kingWalk, 4);
+    legal = boardLegalMoves(board, playerTurn);
+    assert(position_findInList(&legal->moves, 4, 6, PIECE_NAME_NONE) == MOVE_NONE);
+    printf("test_invalidation passed\n");
+}
+
+/**
+ * Test the dots under check, and the end of the game.
+ */
+void test_dots_and_end() {
+    resetBoard();
+
+    // In check from the bishop: c2 may only block, d4 has no move
+    const char* const check[] = {"d2d4", "e7e6", "a2a3", "f8b4"};
+    play(check, 4);
+    selectPiece(board, (IVec2_st) {2, 6});      // c2
+    assert(nbPositionsPossibles == 1 && positionsPossibles[0].x == 2 && positionsPossibles[0].y == 5);
+    selectPiece(board, (IVec2_st) {3, 4});      // d4
+    assert(nbPositionsPossibles == 0);
+    selectionnedPiece = NULL;
+
+    // Fool's mate
+    resetBoard();
+    const char* const foolsMate[] = {"f2f3", "e7e5", "g2g4", "d8h4"};
+    play(foolsMate, 4);
+    const BoardMoves_st* legal = boardLegalMoves(board, playerTurn);
+    assert(legal->moves.count == 0 && legal->inCheck);
+    assert(isCheckmate(board, playerTurn) && !isStalemate(board, playerTurn));
+    printf("test_dots_and_end passed\n");
+}
+
+int main() {
+    test_reuse();
+    test_invalidation();
+    test_dots_and_end();
+    freePlayers();
+    printf("All board tests passed!\n");
+    return 0;
+}
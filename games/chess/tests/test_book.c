@@ -0,0 +1,193 @@
+/**
+    @file test_book.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tests for the opening book: compiling the game's lines, probing, and the search answering from it.
+
+    The test is run from the game directory, so the lines are read from
+    assets/book and compiled to a temporary file. The last test moves to
+    the repository root to load the book the way the game does.
+*/
+#include "ai.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TEST_SOURCE_PATH "assets/book/openings.txt"
+#define TEST_BOOK_PATH "/tmp/chess_test_openings.bin"
+#define PROBES 1000000
+#define REPO_ROOT "../.."
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static void playMoves(Position_st* pos, const char* const moves[][2], u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        u32 from = (u32)(moves[i][0][0] - 'a') + (u32)(moves[i][0][1] - '1') * 8;
+        u32 to = (u32)(moves[i][1][0] - 'a') + (u32)(moves[i][1][1] - '1') * 8;
+        ChessMove_t move = position_findMove(pos, from, to, PIECE_NAME_NONE);
+        PositionUndo_st undo;
+        assert(move != MOVE_NONE);
+        position_makeMove(pos, move, &undo);
+    }
+}
+
+/**
+ * Test that the lines compile, sorted by key with the heaviest move first.
+ */
+void test_compile() {
+    OpeningBook_st book;
+    assert(book_compile(TEST_SOURCE_PATH, TEST_BOOK_PATH));
+    assert(book_open(&book, TEST_BOOK_PATH));
+    assert(book.count > 100);
+
+    u64 previousKey = 0;
+    u16 previousWeight = 0xFFFF;
+    for (size_t i = 0; i < book.count; i++) {
+        const u8* entry = book.entries + i * BOOK_ENTRY_SIZE;
+        u64 key = 0;
+        for (u32 b = 0; b < 8; b++) key = (key << 8) | entry[b];
+        u16 weight = (u16)((entry[10] << 8) | entry[11]);
+        assert(weight > 0);
+        if (key == previousKey) assert(weight <= previousWeight);
+        else assert(key > previousKey);
+        previousKey = key;
+        previousWeight = weight;
+    }
+    printf("  %zu entries\n", book.count);
+    book_close(&book);
+    printf("test_compile passed\n");
+}
+
+/**
+ * Test the moves found for the start position and a few openings.
+ */
+void test_probe() {
+    OpeningBook_st book;
+    Position_st pos;
+    ChessMove_t moves[BOOK_MAX_CHOICES];
+    u16 weights[BOOK_MAX_CHOICES];
+    assert(book_open(&book, TEST_BOOK_PATH));
+
+    // Start: 1.e4 is the heaviest choice, every choice is legal
+    position_setStart(&pos);
+    u32 count = book_probeAll(&book, &pos, moves, weights, BOOK_MAX_CHOICES);
+    assert(count >= 4);
+    assert(moves[0] == position_findMove(&pos, 12, 28, PIECE_NAME_NONE));
+    for (u32 i = 1; i < count; i++) assert(weights[i] <= weights[0]);
+    for (u32 i = 0; i < count; i++) assert(position_isLegal(&pos, moves[i]));
+
+    // Every roll lands on a book move
+    for (u32 roll = 0; roll < 64; roll++) {
+        ChessMove_t move = book_probe(&book, &pos, roll);
+        bool found = false;
+        for (u32 i = 0; i < count; i++) found |= moves[i] == move;
+        assert(found);
+    }
+
+    // Castling is stored as the king taking its rook and read back as castling
+    const char* const ruyLopez[][2] = {
+        {"e2", "e4"}, {"e7", "e5"}, {"g1", "f3"}, {"b8", "c6"}, {"f1", "b5"}, {"a7", "a6"}, {"b5", "a4"}, {"g8", "f6"}
+    };
+    playMoves(&pos, ruyLopez, 8);
+    count = book_probeAll(&book, &pos, moves, weights, BOOK_MAX_CHOICES);
+    assert(count == 1);
+    assert(MOVE_FLAG(moves[0]) == MOVE_FLAG_CASTLE && MOVE_FROM(moves[0]) == 4 && MOVE_TO(moves[0]) == 6);
+
+    // Out of book
+    const char* const offBook[][2] = {{"h2", "h4"}, {"a7", "a5"}};
+    position_setStart(&pos);
+    playMoves(&pos, offBook, 2);
+    assert(book_probe(&book, &pos, 0) == MOVE_NONE);
+
+    // Probing costs a binary search over the mapped file
+    position_setStart(&pos);
+    f64 start = nowSeconds();
+    u32 hits = 0;
+    for (u32 i = 0; i < PROBES; i++) hits += book_probe(&book, &pos, i) != MOVE_NONE;
+    f64 seconds = nowSeconds() - start;
+    assert(hits == PROBES);
+    printf("  %.0f ns per probe\n", seconds * 1e9 / PROBES);
+
+    book_close(&book);
+    printf("test_probe passed\n");
+}
+
+/**
+ * Test that the search plays book moves at once and searches once out of book.
+ */
+void test_search_book() {
+    OpeningBook_st book;
+    Position_st pos;
+    AiStats_st stats;
+    assert(book_open(&book, TEST_BOOK_PATH));
+
+    position_setStart(&pos);
+    AiLimits_st limits = {.depth = 6, .timeMs = 0, .book = &book};
+    f64 start = nowSeconds();
+    ChessMove_st best = ai_searchPosition(&pos, &limits, NULL, &stats);
+    f64 seconds = nowSeconds() - start;
+    assert(stats.depth == 0 && stats.nodes == 0);
+    assert(book_probeAll(&book, &pos, (ChessMove_t[BOOK_MAX_CHOICES]) {0}, (u16[BOOK_MAX_CHOICES]) {0}, BOOK_MAX_CHOICES) > 0);
+    assert(position_isLegal(&pos, best.move));
+    printf("  book move in %.1f us\n", seconds * 1e6);
+
+    const char* const offBook[][2] = {{"h2", "h4"}, {"a7", "a5"}};
+    playMoves(&pos, offBook, 2);
+    limits.depth = 3;
+    best = ai_searchPosition(&pos, &limits, NULL, &stats);
+    assert(stats.depth == 3 && stats.nodes > 0);
+    assert(position_isLegal(&pos, best.move));
+
+    // A missing book is reported, and the search does without
+    OpeningBook_st missing;
+    assert(!book_load(&missing, "/tmp/chess_test_missing.bin", "/tmp/chess_test_missing.txt"));
+    assert(missing.count == 0);
+
+    book_close(&book);
+    remove(TEST_BOOK_PATH);
+    printf("test_search_book passed\n");
+}
+
+/**
+ * Test that the game's own paths load the book from the repository root, compiling it
+ * into the cache directory rather than next to its source.
+ */
+void test_default_paths() {
+    OpeningBook_st book;
+    Position_st pos;
+    char gameDir[4096];
+    assert(getcwd(gameDir, sizeof(gameDir)));
+    assert(chdir(REPO_ROOT) == 0);
+
+    remove(BOOK_PATH);
+    assert(book_load(&book, BOOK_PATH, BOOK_SOURCE_PATH));
+    assert(book.count > 100);
+    position_setStart(&pos);
+    assert(book_probe(&book, &pos, 0) != MOVE_NONE);
+    book_close(&book);
+
+    // Up to date: opened as it is
+    assert(book_load(&book, BOOK_PATH, BOOK_SOURCE_PATH));
+    assert(book.count > 100);
+    book_close(&book);
+    assert(access("games/chess/assets/book/openings.bin", F_OK) != 0);
+
+    assert(chdir(gameDir) == 0);
+    printf("test_default_paths passed\n");
+}
+
+int main() {
+    test_compile();
+    test_probe();
+    test_search_book();
+    test_default_paths();
+    printf("All book tests passed!\n");
+    return 0;
+}
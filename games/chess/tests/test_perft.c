@@ -0,0 +1,165 @@
+/**
+    @file test_perft.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Perft suite for the chess move generator, with a nodes-per-second benchmark.
+
+    Counts the leaves of the legal move tree of well-known positions and
+    compares them with the published values; any bug in move generation,
+    make or unmake shows up as a wrong count. On a mismatch the per-move
+    breakdown ("divide") is printed to compare with another engine.
+
+    Usage: test_perft [1]   (1 = one ply deeper everywhere, a longer soak)
+*/
+#include "position.h"
+#include "evaluation.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+    @brief A position with its reference leaf count.
+*/
+typedef struct {
+    const char* name;
+    const char* fen;
+    u32 depth;
+    u64 nodes;              ///< At `depth`
+    u64 deeperNodes;        ///< At `depth` + 1, used by the extra-depth run (0 = unknown)
+} PerftCase_st;
+
+static const PerftCase_st perftCases[] = {
+    {"startpos",  POSITION_START_FEN,                                                           5, 4865609ULL,  119060324ULL},
+    {"kiwipete",  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",       4, 4085603ULL,  193690690ULL},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",                                  5, 674624ULL,   11030083ULL},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",           4, 422333ULL,   15833292ULL},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",                  4, 2103487ULL,  89941194ULL},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",   4, 3894594ULL,  164075551ULL},
+};
+
+static u64 perft(Position_st* pos, u32 depth) {
+    if (depth == 2) {
+        PositionEval_st eval = evaluation_compute(pos);
+        assert(pos->hash == position_computeHash(pos));
+        assert(memcmp(&pos->eval, &eval, sizeof(eval)) == 0);
+    }
+    MoveList_st moves;
+    position_generateLegal(pos, &moves);
+    if (depth == 1) return moves.count;
+
+    u64 nodes = 0;
+    for (u32 i = 0; i < moves.count; i++) {
+        PositionUndo_st undo;
+        position_makeMove(pos, moves.moves[i], &undo);
+        nodes += perft(pos, depth - 1);
+        position_unmakeMove(pos, moves.moves[i], &undo);
+    }
+    return nodes;
+}
+
+static void divide(Position_st* pos, u32 depth) {
+    MoveList_st moves;
+    position_generateLegal(pos, &moves);
+    for (u32 i = 0; i < moves.count; i++) {
+        char name[6];
+        PositionUndo_st undo;
+        position_moveToString(moves.moves[i], name);
+        position_makeMove(pos, moves.moves[i], &undo);
+        printf("    %-5s %llu\n", name, (unsigned long long)(depth > 1 ? perft(pos, depth - 1) : 1));
+        position_unmakeMove(pos, moves.moves[i], &undo);
+    }
+}
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Test that make/unmake restores the exact position and keeps the hash and evaluation sums right, over every move of every case.
+ */
+void test_make_unmake_roundtrip() {
+    for (size_t c = 0; c < sizeof(perftCases) / sizeof(perftCases[0]); c++) {
+        Position_st pos, saved;
+        assert(position_fromFen(&pos, perftCases[c].fen));
+        saved = pos;
+
+        MoveList_st moves;
+        position_generatePseudoLegal(&pos, &moves);
+        for (u32 i = 0; i < moves.count; i++) {
+            PositionUndo_st undo;
+            position_makeMove(&pos, moves.moves[i], &undo);
+            PositionEval_st eval = evaluation_compute(&pos);
+            assert(pos.hash == position_computeHash(&pos));
+            assert(memcmp(&pos.eval, &eval, sizeof(eval)) == 0);
+            position_unmakeMove(&pos, moves.moves[i], &undo);
+            assert(memcmp(&pos, &saved, sizeof(pos)) == 0);
+        }
+    }
+    printf("test_make_unmake_roundtrip passed\n");
+}
+
+/**
+ * Test the FEN parser on the start position and on malformed input.
+ */
+void test_fen() {
+    Position_st fromFen, start;
+    assert(position_fromFen(&fromFen, POSITION_START_FEN));
+    position_setStart(&start);
+    assert(memcmp(&fromFen, &start, sizeof(start)) == 0);
+
+    assert(!position_fromFen(&fromFen, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"));
+    assert(!position_fromFen(&fromFen, "rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    assert(!position_fromFen(&fromFen, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1"));
+    assert(position_fromFen(&fromFen, "4k3/8/8/3pP3/8/8/8/4K3 w - d6"));
+    assert(fromFen.epSquare == 43);
+    printf("test_fen passed\n");
+}
+
+/**
+ * Test leaf counts against the reference values and report the generator speed.
+ */
+void test_perft(u32 extraDepth) {
+    u64 totalNodes = 0;
+    f64 totalSeconds = 0.0;
+
+    for (size_t c = 0; c < sizeof(perftCases) / sizeof(perftCases[0]); c++) {
+        const PerftCase_st* pc = &perftCases[c];
+        u32 depth = pc->depth + (extraDepth > 0 && pc->deeperNodes ? 1 : 0);
+        u64 expected = depth > pc->depth ? pc->deeperNodes : pc->nodes;
+
+        Position_st pos;
+        assert(position_fromFen(&pos, pc->fen));
+
+        f64 start = nowSeconds();
+        u64 nodes = perft(&pos, depth);
+        f64 elapsed = nowSeconds() - start;
+
+        printf("  %-10s depth %u: %11llu nodes in %6.3f s (%5.1f Mnps)\n",
+               pc->name, depth, (unsigned long long)nodes, elapsed, elapsed > 0 ? (f64)nodes / elapsed / 1e6 : 0.0);
+        if (nodes != expected) {
+            printf("  expected %llu, divide:\n", (unsigned long long)expected);
+            divide(&pos, depth);
+        }
+        assert(nodes == expected);
+
+        totalNodes += nodes;
+        totalSeconds += elapsed;
+    }
+
+    printf("  total %llu nodes, %.1f Mnps\n", (unsigned long long)totalNodes, totalSeconds > 0 ? (f64)totalNodes / totalSeconds / 1e6 : 0.0);
+    printf("test_perft passed\n");
+}
+
+int main(int argc, char* argv[]) {
+    u32 extraDepth = argc > 1 ? (u32)atoi(argv[1]) : 0;
+
+    test_fen();
+    test_make_unmake_roundtrip();
+    test_perft(extraDepth);
+    printf("All perft tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,271 @@
+/**
+    @file test_search.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Search benchmark: what the transposition table saves, and the time-limited search.
+
+    Every position is searched to the same depth without and with a
+    table; the table must cut the node count. A short game then shows the
+    table carried across moves: the reply is searched once with the table
+    of the previous move and once with an empty one. Finally the searches
+    under a time budget report the depth they reach and must return in
+    time.
+*/
+#include "ai.h"
+#include "evaluation.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SEARCH_DEPTH 7
+#define SEARCH_BUDGET_MS 200
+
+static const char* searchFens[] = {
+    POSITION_START_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+};
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static ChessMove_st timedSearch(Position_st* pos, u8 depth, TranspositionTable_st* tt, AiStats_st* stats, f64* seconds) {
+    AiLimits_st limits = {.depth = depth, .timeMs = 0};
+    f64 start = nowSeconds();
+    ChessMove_st best = ai_searchPosition(pos, &limits, tt, stats);
+    *seconds = nowSeconds() - start;
+    return best;
+}
+
+/**
+ * Test that the table saves nodes, and report its hit rate.
+ */
+void test_tt_node_reduction() {
+    TranspositionTable_st tt;
+    assert(tt_init(&tt, TT_DEFAULT_MB));
+    u64 totalPlain = 0, totalTable = 0;
+
+    for (size_t c = 0; c < sizeof(searchFens) / sizeof(searchFens[0]); c++) {
+        Position_st pos, saved;
+        AiStats_st plain, table;
+        f64 plainSeconds, tableSeconds;
+        assert(position_fromFen(&pos, searchFens[c]));
+        saved = pos;
+
+        timedSearch(&pos, SEARCH_DEPTH, NULL, &plain, &plainSeconds);
+        tt_clear(&tt);
+        ChessMove_st b = timedSearch(&pos, SEARCH_DEPTH, &tt, &table, &tableSeconds);
+        assert(memcmp(&pos, &saved, sizeof(pos)) == 0);
+
+        char name[6];
+        position_moveToString(b.move, name);
+        printf("  #%zu %-5s score %6d | plain %9llu nodes %6.3f s | tt %9llu nodes %6.3f s, hits %5.1f%%, cutoffs %5.1f%%, -%4.1f%% nodes\n",
+               c, name, b.score,
+               (unsigned long long)plain.nodes, plainSeconds,
+               (unsigned long long)table.nodes, tableSeconds,
+               table.ttProbes ? 100.0 * (f64)table.ttHits / (f64)table.ttProbes : 0.0,
+               table.ttProbes ? 100.0 * (f64)table.ttCutoffs / (f64)table.ttProbes : 0.0,
+               100.0 - 100.0 * (f64)table.nodes / (f64)plain.nodes);
+
+        assert(position_findMove(&pos, MOVE_FROM(b.move), MOVE_TO(b.move), position_promotionPiece(b.move)) == b.move);
+        totalPlain += plain.nodes;
+        totalTable += table.nodes;
+    }
+
+    printf("  total: %llu -> %llu nodes (-%.1f%%)\n", (unsigned long long)totalPlain, (unsigned long long)totalTable,
+           100.0 - 100.0 * (f64)totalTable / (f64)totalPlain);
+    assert(totalTable < totalPlain);
+    tt_free(&tt);
+    printf("test_tt_node_reduction passed\n");
+}
+
+/**
+ * Test that a table kept from the previous move makes the next search cheaper.
+ */
+void test_tt_reuse_across_moves() {
+    TranspositionTable_st tt;
+    AiStats_st warm, cold;
+    f64 warmSeconds, coldSeconds;
+    Position_st pos;
+    assert(tt_init(&tt, TT_DEFAULT_MB));
+    position_setStart(&pos);
+
+    // White thinks, plays, Black answers what White expected: White's next search starts from a warm table
+    PositionUndo_st undo;
+    TTHit_st expected;
+    AiLimits_st limits = {.depth = SEARCH_DEPTH, .timeMs = 0};
+    ChessMove_st first = ai_searchPosition(&pos, &limits, &tt, NULL);
+    position_makeMove(&pos, first.move, &undo);
+    assert(tt_probe(&tt, pos.hash, &expected) && expected.move != MOVE_NONE);
+    position_makeMove(&pos, expected.move, &undo);
+
+    ChessMove_st w = timedSearch(&pos, SEARCH_DEPTH, &tt, &warm, &warmSeconds);
+    tt_clear(&tt);
+    ChessMove_st c = timedSearch(&pos, SEARCH_DEPTH, &tt, &cold, &coldSeconds);
+
+    printf("  next move: cold table %llu nodes %.3f s, warm table %llu nodes %.3f s (-%.1f%%)\n",
+           (unsigned long long)cold.nodes, coldSeconds, (unsigned long long)warm.nodes, warmSeconds,
+           100.0 - 100.0 * (f64)warm.nodes / (f64)cold.nodes);
+    assert(w.move != MOVE_NONE && c.move != MOVE_NONE);
+    assert(warm.nodes < cold.nodes);
+    tt_free(&tt);
+    printf("test_tt_reuse_across_moves passed\n");
+}
+
+/**
+ * Test that mate scores survive the table (mate in one, same score at every depth).
+ */
+void test_tt_mate_scores() {
+    TranspositionTable_st tt;
+    Position_st pos;
+    assert(tt_init(&tt, 1));
+    assert(position_fromFen(&pos, "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1"));
+
+    for (u8 depth = 1; depth <= 5; depth++) {
+        AiLimits_st limits = {.depth = depth, .timeMs = 0};
+        ChessMove_st best = ai_searchPosition(&pos, &limits, &tt, NULL);
+        char name[6];
+        position_moveToString(best.move, name);
+        assert(strcmp(name, "d1d8") == 0);
+        assert(best.score == AI_MATE_SCORE - 1);
+    }
+    tt_free(&tt);
+    printf("test_tt_mate_scores passed\n");
+}
+
+/**
+ * Test that the incremental evaluation is symmetric and report what it saves over a full scan.
+ */
+void test_evaluation() {
+    Position_st pos, mirrored;
+    position_setStart(&pos);
+    assert(ai_evaluatePosition(&pos) == 0);
+
+    // Same position with the colors swapped and the board flipped
+    assert(position_fromFen(&pos, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+    assert(position_fromFen(&mirrored, "r3k2r/pppbbppp/2n2q1P/1P2p3/3pn3/BN2PNP1/P1PPQPB1/R3K2R b KQkq - 0 1"));
+    assert(ai_evaluatePosition(&pos) == -ai_evaluatePosition(&mirrored));
+    assert(pos.eval.phase == EVAL_PHASE_MAX);
+
+    const u32 rounds = 1000000;
+    volatile s32 sink = 0;
+    f64 start = nowSeconds();
+    for (u32 i = 0; i < rounds; i++) sink += evaluation_tapered(&pos);
+    f64 incremental = nowSeconds() - start;
+    start = nowSeconds();
+    for (u32 i = 0; i < rounds; i++) sink += evaluation_compute(&pos).mg;
+    f64 fullScan = nowSeconds() - start;
+    (void)sink;
+
+    printf("  evaluation: %.1f ns incremental, %.1f ns full scan\n", incremental * 1e9 / rounds, fullScan * 1e9 / rounds);
+    printf("test_evaluation passed\n");
+}
+
+/**
+ * Test that the quiescence search sees through captures: the defended pawn is not taken, the hanging queen is.
+ */
+void test_quiescence() {
+    Position_st pos;
+    AiLimits_st limits = {.depth = 1, .timeMs = 0};
+    char name[6];
+
+    // Qxd5 wins a pawn at depth 1 without quiescence, but ...exd5 takes the queen back
+    assert(position_fromFen(&pos, "4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1"));
+    ChessMove_st best = ai_searchPosition(&pos, &limits, NULL, NULL);
+    position_moveToString(best.move, name);
+    assert(strcmp(name, "d1d5") != 0);
+
+    assert(position_fromFen(&pos, "4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1"));
+    best = ai_searchPosition(&pos, &limits, NULL, NULL);
+    position_moveToString(best.move, name);
+    assert(strcmp(name, "d1d5") == 0);
+    printf("test_quiescence passed\n");
+}
+
+/**
+ * Test that a time-limited search returns within its budget, and report the depth it reaches.
+ */
+void test_time_budget() {
+    TranspositionTable_st tt;
+    assert(tt_init(&tt, TT_DEFAULT_MB));
+
+    for (size_t c = 0; c < sizeof(searchFens) / sizeof(searchFens[0]); c++) {
+        Position_st pos;
+        AiStats_st stats;
+        AiLimits_st limits = {.depth = 0, .timeMs = SEARCH_BUDGET_MS};
+        assert(position_fromFen(&pos, searchFens[c]));
+        tt_clear(&tt);
+
+        f64 start = nowSeconds();
+        ChessMove_st best = ai_searchPosition(&pos, &limits, &tt, &stats);
+        f64 elapsed = nowSeconds() - start;
+
+        char name[6];
+        position_moveToString(best.move, name);
+        printf("  #%zu %-5s depth %2u in %4.0f ms, %8llu nodes (%.2f Mnps)\n",
+               c, name, stats.depth, elapsed * 1000.0, (unsigned long long)stats.nodes, (f64)stats.nodes / elapsed / 1e6);
+        assert(best.move != MOVE_NONE);
+        assert(elapsed * 1000.0 < SEARCH_BUDGET_MS + 50);
+    }
+    tt_free(&tt);
+    printf("test_time_budget passed\n");
+}
+
+/**
+ * Test Lazy SMP: every thread count finds a legal move, and report the time-to-depth scaling.
+ */
+void test_smp_scaling() {
+    static const u8 threadCounts[] = {1, 2, 4, 8};
+    static const u8 depths[] = {9, 7, 8, 7};
+    f64 baseline = 0.0;
+    TranspositionTable_st tt;
+    assert(tt_init(&tt, 64));
+
+    printf("  %ld cores online\n", sysconf(_SC_NPROCESSORS_ONLN));
+    for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+        f64 seconds = 0.0;
+        u64 nodes = 0;
+
+        for (size_t c = 0; c < 4; c++) {
+            Position_st pos;
+            AiStats_st stats;
+            AiLimits_st limits = {.depth = depths[c], .timeMs = 0, .threads = threadCounts[t]};
+            assert(position_fromFen(&pos, searchFens[c]));
+            tt_clear(&tt);
+
+            f64 start = nowSeconds();
+            ChessMove_st best = ai_searchPosition(&pos, &limits, &tt, &stats);
+            seconds += nowSeconds() - start;
+            nodes += stats.nodes;
+            assert(position_findMove(&pos, MOVE_FROM(best.move), MOVE_TO(best.move), position_promotionPiece(best.move)) == best.move);
+        }
+
+        if (t == 0) baseline = seconds;
+        f64 speedup = baseline / seconds;
+        printf("  %u thread%s: %6.3f s to depth, %9llu nodes (%5.2f Mnps), speedup %.2fx, efficiency %3.0f%%\n",
+               threadCounts[t], threadCounts[t] > 1 ? "s" : " ", seconds, (unsigned long long)nodes, (f64)nodes / seconds / 1e6,
+               speedup, 100.0 * speedup / threadCounts[t]);
+    }
+    tt_free(&tt);
+    printf("test_smp_scaling passed\n");
+}
+
+int main() {
+    test_evaluation();
+    test_tt_mate_scores();
+    test_quiescence();
+    test_tt_node_reduction();
+    test_tt_reuse_across_moves();
+    test_time_budget();
+    test_smp_scaling();
+    printf("All search tests passed!\n");
+    return 0;
+}
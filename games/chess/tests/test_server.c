@@ -0,0 +1,264 @@
+/**
+    @file test_server.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tests for the authoritative chess room: game status, move validation and server-hosted bots.
+
+    The server is played by the test: it calls the room module the way
+    the network layer does and records what the room broadcasts.
+*/
+#include "chessAPI.h"
+#include "aiPool.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+
+#define ROOMS 4
+#define HOST_ID 3
+#define GUEST_ID 5
+
+extern GameServerInterface_St chess_serverInterface;
+
+#pragma pack(push, 1)
+/**
+    @brief Network payload for a chess move, as the client and the room define it.
+*/
+typedef struct {
+    u8 from_x, from_y;
+    u8 to_x, to_y;
+    u8 promotion;
+} ChessMovePayload_St;
+#pragma pack(pop)
+
+/**
+    @brief Last message the room broadcast.
+*/
+static struct {
+    u32 count;
+    s32 roomId;
+    s32 excludeId;
+    u8 data[64];
+    u16 len;
+} sent;
+
+static void recordBroadcast(s32 roomId, s32 excludeId, u8 action, const void* payload, u16 len) {
+    assert(action == ACTION_CODE_GAME_DATA);
+    sent.count++;
+    sent.roomId = roomId;
+    sent.excludeId = excludeId;
+    sent.len = len < sizeof(sent.data) ? len : sizeof(sent.data);
+    memcpy(sent.data, payload, sent.len);
+}
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static void sendAction(void* room, s32 roomId, s32 playerId, u8 action, const void* body, u16 bodyLen) {
+    u8 buf[64];
+    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_CHESS, .action = action, .length = htons(bodyLen), .isReliable = true };
+    memcpy(buf, &tlv, sizeof(tlv));
+    if (bodyLen) memcpy(buf + sizeof(tlv), body, bodyLen);
+    chess_serverInterface.onAction(room, roomId, playerId, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv) + bodyLen), recordBroadcast);
+}
+
+static void startGame(void* room, s32 roomId, s32 botLevel) {
+    sendAction(room, roomId, HOST_ID, ACTION_CODE_JOIN_GAME, NULL, 0);
+    sendAction(room, roomId, GUEST_ID, ACTION_CODE_JOIN_GAME, NULL, 0);
+    s32 netLevel = (s32)htonl((u32)botLevel);
+    sendAction(room, roomId, HOST_ID, ACTION_CODE_START_GAME, &netLevel, sizeof(netLevel));
+}
+
+/**
+    @brief Sends `uci` ("e2e4") from `playerId`.
+    @return true if the room relayed it
+*/
+static bool sendMove(void* room, s32 roomId, s32 playerId, const char* uci) {
+    ChessMovePayload_St move = {
+        .from_x = (u8)(uci[0] - 'a'), .from_y = (u8)(7 - (uci[1] - '1')),
+        .to_x = (u8)(uci[2] - 'a'), .to_y = (u8)(7 - (uci[3] - '1')),
+        .promotion = 0
+    };
+    u32 before = sent.count;
+    sendAction(room, roomId, playerId, ACTION_CODE_CHESS_MOVE, &move, sizeof(move));
+    return sent.count != before;
+}
+
+/**
+    @brief Plays the move of the last broadcast on `pos`.
+    @return false if it is not legal there
+*/
+static bool playBroadcastMove(Position_st* pos) {
+    ChessMovePayload_St move;
+    if (sent.len < sizeof(GameTLVHeader_St) + sizeof(move)) return false;
+    memcpy(&move, sent.data + sizeof(GameTLVHeader_St), sizeof(move));
+
+    static const PieceName_et promotions[5] = {PIECE_NAME_NONE, PIECE_NAME_QUEEN, PIECE_NAME_ROOK, PIECE_NAME_BISHOP, PIECE_NAME_PONEY};
+    ChessMove_t legal = position_findMove(pos, SQUARE_FROM_XY(move.from_x, move.from_y), SQUARE_FROM_XY(move.to_x, move.to_y),
+                                          promotions[move.promotion < 5 ? move.promotion : 0]);
+    if (legal == MOVE_NONE) return false;
+    PositionUndo_st undo;
+    position_makeMove(pos, legal, &undo);
+    return true;
+}
+
+/**
+ * Test checkmate and stalemate detection on the bitboard position.
+ */
+void test_status() {
+    Position_st pos;
+    position_setStart(&pos);
+    assert(position_status(&pos) == POSITION_ONGOING);
+
+    // Fool's mate
+    assert(position_fromFen(&pos, "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3"));
+    assert(position_status(&pos) == POSITION_CHECKMATE);
+
+    assert(position_fromFen(&pos, "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"));
+    assert(position_status(&pos) == POSITION_STALEMATE);
+
+    // In check, but the king can step aside
+    assert(position_fromFen(&pos, "4k3/8/8/8/8/8/4R3/4K3 b - - 0 1"));
+    assert(position_status(&pos) == POSITION_ONGOING);
+    printf("test_status passed\n");
+}
+
+/**
+ * Test that the room relays legal moves of the player to move only, and stops at checkmate.
+ */
+void test_move_validation() {
+    static u8 room[4096];
+    assert(chess_serverInterface.instanceSize <= sizeof(room));
+    memset(room, 0, sizeof(room));
+    chess_serverInterface.initInstance(room);
+
+    assert(!sendMove(room, 0, HOST_ID, "e2e4"));      // Not started yet
+    startGame(room, 0, 0);
+
+    assert(!sendMove(room, 0, GUEST_ID, "e7e5"));     // Black out of turn
+    assert(!sendMove(room, 0, HOST_ID, "e2e5"));      // Illegal
+    assert(!sendMove(room, 0, HOST_ID, "e7e5"));      // Not White's piece
+    assert(sendMove(room, 0, HOST_ID, "f2f3"));
+    assert(sent.roomId == 0 && sent.excludeId == HOST_ID);
+    assert(!sendMove(room, 0, HOST_ID, "g2g4"));      // Twice in a row
+
+    assert(sendMove(room, 0, GUEST_ID, "e7e5"));
+    assert(sendMove(room, 0, HOST_ID, "g2g4"));
+    assert(sendMove(room, 0, GUEST_ID, "d8h4"));      // Mate
+    assert(!sendMove(room, 0, HOST_ID, "a2a3"));      // The game is over
+
+    chess_serverInterface.releaseInstance(room);
+    printf("test_move_validation passed\n");
+}
+
+/**
+ * Test bots hosted by several rooms at once: every room gets a legal reply to its own
+ * opening, and no tick waits for a search.
+ */
+void test_bot_rooms() {
+    static const char* openings[ROOMS] = {"e2e4", "d2d4", "g1f3", "b2b3"};
+    static u8 rooms[ROOMS][4096];
+    Position_st mirrors[ROOMS];
+    bool answered[ROOMS] = {false};
+    u32 remaining = ROOMS;
+    f64 slowestTick = 0.0;
+
+    // The pool starts on first use (threads and tables); time that apart from the ticks
+    f64 poolStart = nowSeconds();
+    aiPool_release(aiPool_acquire(aiPool_newGameId()));
+    printf("  pool of %u workers started in %.1f ms\n", aiPool_size(), (nowSeconds() - poolStart) * 1000.0);
+
+    for (s32 r = 0; r < ROOMS; r++) {
+        memset(rooms[r], 0, sizeof(rooms[r]));
+        chess_serverInterface.initInstance(rooms[r]);
+        startGame(rooms[r], r, 1);
+        position_setStart(&mirrors[r]);
+        assert(sendMove(rooms[r], r, HOST_ID, openings[r]));
+        assert(playBroadcastMove(&mirrors[r]));
+        assert(!sendMove(rooms[r], r, GUEST_ID, "e7e5"));  // The bot's seat
+    }
+
+    f64 start = nowSeconds(), last = start;
+    while (remaining > 0) {
+        assert(nowSeconds() - start < 10.0);
+        f64 now = nowSeconds();
+        for (s32 r = 0; r < ROOMS; r++) {
+            u32 before = sent.count;
+            ServerTickContext_St ctx = { .dt = (f32)(now - last), .roomId = r, .broadcast = recordBroadcast, .sleepMs = 0 };
+            f64 tickStart = nowSeconds();
+            chess_serverInterface.onRoomTick(rooms[r], &ctx);
+            f64 took = nowSeconds() - tickStart;
+            if (took > slowestTick) slowestTick = took;
+
+            if (sent.count != before) {
+                assert(!answered[r]);
+                assert(sent.roomId == r && sent.excludeId == -1);
+                assert(playBroadcastMove(&mirrors[r]));
+                assert(mirrors[r].side == COLOR_PIECE_WHITE);
+                answered[r] = true;
+                remaining--;
+            }
+        }
+        last = now;
+        struct timespec ts = {0, 5 * 1000000L};
+        nanosleep(&ts, NULL);
+    }
+    f64 elapsed = nowSeconds() - start;
+    printf("  %d bot rooms answered in %.2f s, slowest tick %.1f us\n", ROOMS, elapsed, slowestTick * 1e6);
+    assert(slowestTick < 0.005);
+
+    // Each room goes on from its own position
+    assert(sendMove(rooms[0], 0, HOST_ID, "d2d4"));
+    assert(playBroadcastMove(&mirrors[0]));
+
+    for (s32 r = 0; r < ROOMS; r++) chess_serverInterface.releaseInstance(rooms[r]);
+    printf("test_bot_rooms passed\n");
+}
+
+/**
+ * Test that the bot waits its minimum delay from the human's move, even when the first
+ * tick after it reports the whole idle sleep that came before as dt.
+ */
+void test_bot_delay() {
+    static u8 room[4096];
+    Position_st mirror;
+    memset(room, 0, sizeof(room));
+    chess_serverInterface.initInstance(room);
+    startGame(room, 0, 1);
+    position_setStart(&mirror);
+
+    f64 moved = nowSeconds();
+    assert(sendMove(room, 0, HOST_ID, "e2e4"));
+    assert(playBroadcastMove(&mirror));
+
+    u32 before = sent.count;
+    while (sent.count == before) {
+        assert(nowSeconds() - moved < 10.0);
+        // The room slept a full idle interval before this move
+        ServerTickContext_St ctx = { .dt = 1.0f, .roomId = 0, .broadcast = recordBroadcast, .sleepMs = 0 };
+        chess_serverInterface.onRoomTick(room, &ctx);
+        struct timespec ts = {0, 5 * 1000000L};
+        nanosleep(&ts, NULL);
+    }
+    f64 waited = nowSeconds() - moved;
+    printf("  bot answered %.2f s after the move\n", waited);
+    assert(waited >= 1.0);
+    assert(playBroadcastMove(&mirror));
+
+    chess_serverInterface.releaseInstance(room);
+    printf("test_bot_delay passed\n");
+}
+
+int main() {
+    test_status();
+    test_move_validation();
+    test_bot_rooms();
+    test_bot_delay();
+    printf("All server tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,154 @@
+/**
+    @file test_tablebase.c
+    @author Léandre BAUDET
+    @date 2026-10-17
+    @brief Tests for the endgame tables: known values, the longest mates, and perfect play to mate.
+
+    The longest wins are known: king and queen mate in 10 moves (19 plies)
+    and king and rook in 16 (31 plies) from the worst White-to-move
+    position. The tables must find exactly these.
+*/
+#include "ai.h"
+#include "tablebase.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+#define KQK_LONGEST_PLIES 19
+#define KRK_LONGEST_PLIES 31
+
+static f64 nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+}
+
+static TablebaseProbe_st probeFen(const char* fen) {
+    Position_st pos;
+    TablebaseProbe_st tb;
+    assert(position_fromFen(&pos, fen));
+    assert(tablebase_probe(&pos, &tb));
+    return tb;
+}
+
+/**
+ * Longest win of White to move with king and `name` against the king.
+ * @param[out] longest  One position reaching it
+ */
+static u32 longestWin(PieceName_et name, Position_st* longest) {
+    u32 most = 0;
+    for (u32 wk = 0; wk < 64; wk++) {
+        for (u32 bk = 0; bk < 64; bk++) {
+            for (u32 piece = 0; piece < 64; piece++) {
+                if (wk == bk || wk == piece || bk == piece) continue;
+                Position_st pos;
+                TablebaseProbe_st tb;
+                position_clear(&pos);
+                position_putPiece(&pos, wk, COLOR_PIECE_WHITE, PIECE_NAME_KING);
+                position_putPiece(&pos, bk, COLOR_PIECE_BLACK, PIECE_NAME_KING);
+                position_putPiece(&pos, piece, COLOR_PIECE_WHITE, name);
+                if (position_isSquareAttacked(&pos, bk, COLOR_PIECE_WHITE)) continue;
+                if (position_isSquareAttacked(&pos, wk, COLOR_PIECE_BLACK)) continue;
+
+                assert(tablebase_probe(&pos, &tb));
+                if (tb.wdl == TABLEBASE_WIN && tb.pliesToMate > most) {
+                    most = tb.pliesToMate;
+                    *longest = pos;
+                }
+            }
+        }
+    }
+    return most;
+}
+
+/**
+ * Test that nothing is covered before the build, and time the build.
+ */
+void test_build() {
+    Position_st pos;
+    TablebaseProbe_st tb;
+    assert(position_fromFen(&pos, "8/8/8/4k3/8/8/8/4K2Q w - - 0 1"));
+    assert(!tablebase_ready() && !tablebase_probe(&pos, &tb));
+
+    f64 start = nowSeconds();
+    tablebase_init();
+    printf("  built in %.1f ms\n", (nowSeconds() - start) * 1e3);
+    assert(tablebase_ready() && tablebase_probe(&pos, &tb));
+    printf("test_build passed\n");
+}
+
+/**
+ * Test known positions: mates, stalemate, a hanging rook, dead draws and uncovered material.
+ */
+void test_known_positions() {
+    TablebaseProbe_st tb = probeFen("7k/8/6K1/8/8/8/8/1Q6 w - - 0 1");
+    assert(tb.wdl == TABLEBASE_WIN && tb.pliesToMate == 1);
+
+    // The same with the colors swapped and the board flipped
+    tb = probeFen("1q6/8/8/8/8/6k1/8/7K b - - 0 1");
+    assert(tb.wdl == TABLEBASE_WIN && tb.pliesToMate == 1);
+
+    // Mated already, and the side to move losing
+    tb = probeFen("Q6k/8/6K1/8/8/8/8/8 b - - 0 1");
+    assert(tb.wdl == TABLEBASE_LOSS && tb.pliesToMate == 0);
+    tb = probeFen("7k/8/5K2/8/8/8/8/Q7 b - - 0 1");
+    assert(tb.wdl == TABLEBASE_LOSS && tb.pliesToMate > 0);
+
+    // Stalemate, and a rook the king takes
+    tb = probeFen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+    assert(tb.wdl == TABLEBASE_DRAW);
+    tb = probeFen("k7/1R6/8/8/8/8/8/7K b - - 0 1");
+    assert(tb.wdl == TABLEBASE_DRAW);
+
+    // No mating material
+    assert(probeFen("8/8/3k4/8/8/3K4/8/8 w - - 0 1").wdl == TABLEBASE_DRAW);
+    assert(probeFen("8/8/3k4/8/8/3K4/3N4/8 w - - 0 1").wdl == TABLEBASE_DRAW);
+    assert(probeFen("8/8/3k4/3b4/8/3K4/8/8 b - - 0 1").wdl == TABLEBASE_DRAW);
+
+    // Not covered: pawns, four pieces, castling rights
+    Position_st pos;
+    assert(position_fromFen(&pos, "8/8/3k4/8/8/3K4/3P4/8 w - - 0 1") && !tablebase_probe(&pos, &tb));
+    assert(position_fromFen(&pos, "8/8/3k4/3r4/8/3K4/3Q4/8 w - - 0 1") && !tablebase_probe(&pos, &tb));
+    assert(position_fromFen(&pos, "4k3/8/8/8/8/8/8/R3K3 w Q - 0 1") && !tablebase_probe(&pos, &tb));
+    printf("test_known_positions passed\n");
+}
+
+/**
+ * Test the longest mates, then play the longest rook ending to mate with the table's moves.
+ */
+void test_longest_mates() {
+    Position_st pos;
+    u32 kqk = longestWin(PIECE_NAME_QUEEN, &pos);
+    u32 krk = longestWin(PIECE_NAME_ROOK, &pos);
+    printf("  KQK %u plies, KRK %u plies\n", kqk, krk);
+    assert(kqk == KQK_LONGEST_PLIES);
+    assert(krk == KRK_LONGEST_PLIES);
+
+    // Each move keeps the result one ply closer; the last one mates
+    for (u32 left = krk; left > 0; left--) {
+        TablebaseProbe_st tb;
+        PositionUndo_st undo;
+        ChessMove_t move = tablebase_bestMove(&pos, &tb);
+        assert(move != MOVE_NONE && tb.pliesToMate == left);
+        position_makeMove(&pos, move, &undo);
+    }
+    assert(position_status(&pos) == POSITION_CHECKMATE);
+
+    // The search answers from the table without searching
+    AiStats_st stats;
+    AiLimits_st limits = {.depth = 8, .timeMs = 0};
+    assert(position_fromFen(&pos, "7k/8/6K1/8/8/8/8/1Q6 w - - 0 1"));
+    ChessMove_st best = ai_searchPosition(&pos, &limits, NULL, &stats);
+    assert(stats.tbHits == 1 && stats.nodes == 0);
+    assert(best.score == AI_MATE_SCORE - 1);
+    printf("test_longest_mates passed\n");
+}
+
+int main() {
+    test_build();
+    test_known_positions();
+    test_longest_mates();
+    printf("All tablebase tests passed!\n");
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include "networkInterface.h"
 #include "logger.h"
 #include "APIs/generalAPI.h"
+#include "snapshotDelta.h"
 
 /**
     @brief Action codes for King-for-Four specific network messages.
@@ -26,6 +27,7 @@ enum {
     ACTION_CODE_KFF_DRAW_CARD,                            ///< Draw a card from the deck
     ACTION_CODE_KFF_SYNC_HAND,                            ///< Synchronize the player's hand
     ACTION_CODE_KFF_SET_PLAYER_COUNT,                     ///< Set the number of players (host only)
+    ACTION_CODE_KFF_SYNC_ACK,                             ///< Client acks a sync snapshot (u16 seq, network order)
 };
 
 #pragma pack(push, 1)
@@ -52,6 +54,15 @@ typedef struct {
     int cardIndex;
     int chosenColor;
 } ActionPlayPayload_St;
+
+/**
+    @brief Per-player sync snapshot: the public state plus the player's own hand.
+*/
+typedef struct {
+    GameSyncPayload_St sync;
+    u8 handSize;
+    u8 hand[MAX_UNO_CARDS];             ///< Cards packed as (color << 4) | value
+} KingSnapshot_St;
 #pragma pack(pop)
 static KingForFourGameState_St kingForFour_localState;
 static GameAssets_St assets;
@@ -71,6 +82,9 @@ static bool isChoosingColor = false;
 static int pendingCardIndex = -1;
 static bool showInfo_window = false;
 
+static SnapshotHistory_St syncHistory;
+static u8 syncFrames[SNAPSHOT_HISTORY][sizeof(KingSnapshot_St)];
+
 static void send_toServer(u8 action, void* data, u16 len) {
     GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = action, .length = htons(len) };
     RUDPHeader_St h; rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
@@ -100,6 +114,7 @@ void kingForFour_init(void) {
     isChoosingColor = false;
     pendingCardIndex = -1;
     showInfo_window = false;
+    snapshotHistoryInit(&syncHistory, syncFrames, sizeof(KingSnapshot_St));
 }
 
 static int selectedPlayers = 4;
@@ -128,9 +143,16 @@ void kingForFour_onData(s32 playerId, u8 action, const void* data, u16 len) {
             log_info("[KING] Mon ID interne: %d", myInternalId);
         }
     } else if (action == ACTION_CODE_SYNC_GAME) {
-        if (len >= (u16) sizeof(GameSyncPayload_St)) {
-            GameSyncPayload_St sync;
-            memcpy(&sync, data, sizeof(GameSyncPayload_St));
+        KingSnapshot_St snap;
+        u16 seq = SNAPSHOT_SEQ_NONE;
+        SnapshotDecodeResult_Et result = snapshotDecode(&syncHistory, data, len, &snap, &seq);
+        if (result != SNAPSHOT_STALE) {
+            // Ack what we applied; an ack of SNAPSHOT_SEQ_NONE asks for a keyframe
+            u16 ackSeq = htons(result == SNAPSHOT_APPLIED ? seq : SNAPSHOT_SEQ_NONE);
+            send_toServer(ACTION_CODE_KFF_SYNC_ACK, &ackSeq, sizeof(ackSeq));
+        }
+        if (result == SNAPSHOT_APPLIED) {
+            GameSyncPayload_St sync = snap.sync;
 
             selectedPlayers = sync.requestedPlayers;
 
@@ -165,14 +187,13 @@ void kingForFour_onData(s32 playerId, u8 action, const void* data, u16 len) {
                     if (sync.handSizes[i] == 0) winnerId = i;
                 }
             }
-        }
-    } else if (action == ACTION_CODE_KFF_SYNC_HAND) {
-        int count = len / sizeof(Card_St);
-        if (myInternalId >= 0 && myInternalId < 4) {
-            kingForFour_clearDeck(&kingForFour_localState.players[myInternalId].hand);
-            for (int i = 0; i < count; i++) {
-                Card_St c; memcpy(&c, (u8*)data + (i * sizeof(Card_St)), sizeof(Card_St));
-                kingForFour_pushCard(&kingForFour_localState.players[myInternalId].hand, c);
+
+            if (myInternalId >= 0 && myInternalId < 4) {
+                kingForFour_clearDeck(&kingForFour_localState.players[myInternalId].hand);
+                for (int i = 0; i < snap.handSize && i < MAX_UNO_CARDS; i++) {
+                    Card_St c = { .color = (CardColor_Et)(snap.hand[i] >> 4), .value = (CardValue_Et)(snap.hand[i] & 0x0F) };
+                    kingForFour_pushCard(&kingForFour_localState.players[myInternalId].hand, c);
+                }
             }
         }
     }
@@ -14,12 +14,15 @@
 #include "networkInterface.h"
 
 #include "sharedUtils/random.h"
+#include "snapshotDelta.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <arpa/inet.h>
 
+#define KING_IDLE_SLEEP_MS 1000 ///< Tick interval while no bot has to play
+
 /**
     @brief Action codes for King-for-Four specific network messages.
 */
@@ -28,6 +31,7 @@ enum {
     ACTION_CODE_KFF_DRAW_CARD,                            ///< Draw a card from the deck
     ACTION_CODE_KFF_SYNC_HAND,                            ///< Synchronize the player's hand
     ACTION_CODE_KFF_SET_PLAYER_COUNT,                     ///< Set the number of players (host only)
+    ACTION_CODE_KFF_SYNC_ACK,                             ///< Client acks a sync snapshot (u16 seq, network order)
 };
 
 #pragma pack(push, 1)
@@ -54,6 +58,16 @@ typedef struct {
     int cardIndex;
     int chosenColor;
 } ActionPlayPayload_St;
+
+/**
+    @brief Per-player sync snapshot: the public state plus the player's own hand.
+           Sent delta-compressed with ACTION_CODE_SYNC_GAME (see snapshotDelta.h).
+*/
+typedef struct {
+    GameSyncPayload sync;               ///< Public game state
+    u8 handSize;                        ///< Cards in hand
+    u8 hand[MAX_UNO_CARDS];             ///< Cards packed as (color << 4) | value
+} KingSnapshot_St;
 #pragma pack(pop)
 
 /**
@@ -74,34 +88,71 @@ KingForFourGameState_St state;
     int lastPlayerId;
     int lastAction;
     BroadcastMessage_Ft broadcast; 
+    SnapshotHistory_St syncHistory[4];  ///< Sync snapshots sent to each player slot
+    u16 syncAcked[4];                   ///< Newest snapshot acked by each player slot
+    u8 syncFrames[4][SNAPSHOT_HISTORY][sizeof(KingSnapshot_St)]; ///< Storage of syncHistory
 } KingServerState;
 
 
+/**
+    @brief Initializes a zeroed server state in place (deals a fresh shuffled deck).
+
+    @param[in,out] state Zeroed block of sizeof(KingServerState) bytes.
+*/
+void king_initInstance(void *state) {
+    KingServerState* ks = (KingServerState*)state;
+    kingForFour_initGameLogic(&ks->state);
+    kingForFour_initUnoDeck(&ks->state.drawPile);
+    kingForFour_shuffleDeck(&ks->state.drawPile);
+    ks->status = 0; // WAITING
+    ks->requestedPlayers = 4;
+    ks->botTimer = 0;
+    ks->botTargetTime = 1.0f + randfloat() * 2.0f; 
+    ks->lastPlayerId = -1;
+    ks->lastAction = -1;
+    ks->broadcast = NULL;
+    for (int i = 0; i < 4; i++) {
+        snapshotHistoryInit(&ks->syncHistory[i], ks->syncFrames[i], sizeof(KingSnapshot_St));
+        ks->syncAcked[i] = SNAPSHOT_SEQ_NONE;
+    }
+}
+
 void* king_createInstance(void) {
     KingServerState* ks = calloc(1, sizeof(KingServerState));
-    if (ks) {
-        kingForFour_initGameLogic(&ks->state);
-        kingForFour_initUnoDeck(&ks->state.drawPile);
-        kingForFour_shuffleDeck(&ks->state.drawPile);
-        ks->status = 0; // WAITING
-        ks->requestedPlayers = 4;
-        ks->botTimer = 0;
-        ks->botTargetTime = 1.0f + randfloat() * 2.0f; 
-        ks->lastPlayerId = -1;
-        ks->lastAction = -1;
-        ks->broadcast = NULL;
-    }
+    if (ks) king_initInstance(ks);
     return ks;
 }
 
+/**
+    @brief Sends one player's snapshot, delta-encoded against the last one they acknowledged.
+
+    @param[in,out] ks        Pointer to the server state.
+    @param[in]     slot      Player slot (human) to send to.
+    @param[in]     broadcast The broadcast function to use.
+*/
+static void send_snapshot(KingServerState* ks, int slot, BroadcastMessage_Ft broadcast) {
+    SnapshotHistory_St* history = &ks->syncHistory[slot];
+    if (history->lastSeq == SNAPSHOT_SEQ_NONE) return;
+
+    u8 buf[sizeof(GameTLVHeader_St) + SNAPSHOT_MAX_ENCODED(sizeof(KingSnapshot_St))];
+    u16 len = snapshotEncode(history, history->lastSeq, ks->syncAcked[slot], buf + sizeof(GameTLVHeader_St), sizeof(buf) - sizeof(GameTLVHeader_St));
+    if (len == 0) return;
+
+    GameTLVHeader_St tlv_sync = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = ACTION_CODE_SYNC_GAME, .length = htons(len), .isReliable = true };
+    memcpy(buf, &tlv_sync, sizeof(tlv_sync));
+    broadcast(UNICAST, ks->state.players[slot].id, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv_sync) + len));
+}
+
 /**
     @brief Broadcasts the current game state to all players in a room.
 
+    Each human player gets the public state and their own hand as one
+    snapshot, sent as a delta against the last snapshot they acknowledged.
+
     @param[in,out] ks        Pointer to the server state.
-    @param[in]     room_id   The ID of the room to sync.
     @param[in]     broadcast The broadcast function to use.
 */
-static void broadcast_sync(KingServerState* ks, s32 roomId, BroadcastMessage_Ft broadcast) {
+static void broadcast_sync(KingServerState* ks, BroadcastMessage_Ft broadcast) {
     if (!broadcast) return;
     KingForFourGameState_St* g = &ks->state;
     Card_St topCard = {CARD_BLACK, ZERO};
@@ -109,45 +160,34 @@ static void broadcast_sync(KingServerState* ks, s32 roomId, BroadcastMessage_Ft
         topCard = g->discardPile.cards[g->discardPile.size - 1];
     }
 
-    GameSyncPayload sync;
-    sync.currentPlayer = g->currentPlayer;
-    sync.activeColor = g->activeColor;
-    sync.topCard = topCard;
-    sync.status = ks->status;
-    sync.hostId = (g->numPlayers > 0) ? g->players[0].id : -1;
-    sync.lastPlayerId = ks->lastPlayerId;
-    sync.lastAction = ks->lastAction;
-    sync.numPlayers = g->numPlayers;
-    sync.requestedPlayers = ks->requestedPlayers;
+    KingSnapshot_St snap;
+    memset(&snap, 0, sizeof(snap));
+    GameSyncPayload* sync = &snap.sync;
+    sync->currentPlayer = g->currentPlayer;
+    sync->activeColor = g->activeColor;
+    sync->topCard = topCard;
+    sync->status = ks->status;
+    sync->hostId = (g->numPlayers > 0) ? g->players[0].id : -1;
+    sync->lastPlayerId = ks->lastPlayerId;
+    sync->lastAction = ks->lastAction;
+    sync->numPlayers = g->numPlayers;
+    sync->requestedPlayers = ks->requestedPlayers;
     for (int i = 0; i < 4; i++) {
-        sync.hand_sizes[i] = (i < g->numPlayers) ? g->players[i].hand.size : 0;
+        sync->hand_sizes[i] = (i < g->numPlayers) ? g->players[i].hand.size : 0;
     }
 
-    u8 buf[2048];
-    memset(buf, 0, sizeof(buf));
-    GameTLVHeader_St tlv_sync = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = ACTION_CODE_SYNC_GAME, .length = htons(sizeof(GameSyncPayload)) };
-    memcpy(buf, &tlv_sync, sizeof(tlv_sync));
-    memcpy(buf + sizeof(tlv_sync), &sync, sizeof(sync));
-    broadcast(roomId, -1, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv_sync) + sizeof(sync)));
-    
     for (int i = 0; i < g->numPlayers; i++) {
-        if (g->players[i].id < 0) continue; // Skip bots for hand sync
-        int targetPlayerId = g->players[i].id;
-        int handCount = g->players[i].hand.size;
-        if (handCount <= 0) continue;
-        
-        Card_St* cards = malloc((size_t)handCount * sizeof(Card_St));
-        if (!cards) continue;
-        for (int j = 0; j < handCount; j++) {
-            cards[j] = g->players[i].hand.cards[j];
+        if (g->players[i].id < 0) continue; // Bots have no client
+
+        Deck_St* hand = &g->players[i].hand;
+        snap.handSize = (u8)hand->size;
+        memset(snap.hand, 0, sizeof(snap.hand));
+        for (int j = 0; j < hand->size; j++) {
+            snap.hand[j] = (u8)((hand->cards[j].color << 4) | hand->cards[j].value);
         }
-        
-        GameTLVHeader_St tlv_hand = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = ACTION_CODE_KFF_SYNC_HAND, .length = htons((u16)(handCount * sizeof(Card_St))) };
-        memset(buf, 0, sizeof(buf));
-        memcpy(buf, &tlv_hand, sizeof(tlv_hand));
-        memcpy(buf + sizeof(tlv_hand), cards, (size_t)handCount * sizeof(Card_St));
-        broadcast(UNICAST, targetPlayerId, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv_hand) + handCount * sizeof(Card_St)));
-        free(cards);
+
+        snapshotPush(&ks->syncHistory[i], &snap);
+        send_snapshot(ks, i, broadcast);
     }
 }
 
@@ -177,9 +217,21 @@ void king_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
         }
     }
 
+    // Sync acks only move the delta baseline; a keyframe request is answered right away
+    if (realAction == ACTION_CODE_KFF_SYNC_ACK) {
+        if (internalId == -1 || payloadLen < sizeof(u16)) return;
+        u16 netSeq;
+        memcpy(&netSeq, realPayload, sizeof(u16));
+        u16 seq = ntohs(netSeq);
+        snapshotOnAck(&ks->syncAcked[internalId], seq);
+        if (seq == SNAPSHOT_SEQ_NONE) send_snapshot(ks, internalId, broadcast);
+        return;
+    }
+
     if (internalId == -1 && ks->status == 0 && g->numPlayers < 4) {
         internalId = g->numPlayers++;
         kingForFour_initPlayer(&g->players[internalId], playerId, "Joueur");
+        ks->syncAcked[internalId] = SNAPSHOT_SEQ_NONE;
         printf("[KING] Nouveau joueur enregistré: %d (Slot %d)\n", playerId, internalId);
     }
 
@@ -187,7 +239,7 @@ void king_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
         if (realAction == ACTION_CODE_JOIN_GAME) {
             u8 bufAck[64];
             memset(bufAck, 0, sizeof(bufAck));
-            GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)) };
+            GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_KING_FOR_FOUR, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)), .isReliable = true };
             u16 netId = htons((u16)internalId);
             memcpy(bufAck, &tlvAck, sizeof(tlvAck));
             memcpy(bufAck + sizeof(tlvAck), &netId, sizeof(u16));
@@ -208,7 +260,7 @@ void king_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
             kingForFour_distributeCards(g);
             ks->status = 1; 
             printf("[KING] Partie démarrée avec %d joueurs.\n", g->numPlayers);
-            broadcast_sync(ks, roomId, broadcast);
+            broadcast_sync(ks, broadcast);
             return; 
         }
         else if (realAction == ACTION_CODE_KFF_SET_PLAYER_COUNT && internalId == 0 && ks->status == 0) {
@@ -264,16 +316,21 @@ void king_onAction(void *state, s32 roomId, s32 playerId, u8 action, const void
         }
     }
 
-    broadcast_sync(ks, roomId, broadcast);
+    broadcast_sync(ks, broadcast);
 }
 
 /**
     @brief Updates the game state periodically (handles bot logic).
 
+    Human turns only advance through actions, so the room sleeps until the
+    next action or until the current bot is due to play.
+
     @param[in,out] state Pointer to the KingServerState_St instance.
+    @param[in,out] ctx   Tick context (elapsed time, room, broadcast, requested sleep).
 */
-void king_onTick(void* state) {
+void king_onRoomTick(void* state, ServerTickContext_St* ctx) {
     KingServerState* ks = (KingServerState*)state;
+    ctx->sleepMs = KING_IDLE_SLEEP_MS;
     if (ks->status != 1) return; // Only if playing
 
     // Check if humans are still present
@@ -287,8 +344,10 @@ void king_onTick(void* state) {
     int cp = g->currentPlayer;
 
     if (g->players[cp].id < 0) { // C'est un bot
-        ks->botTimer += 0.016f; // Simulated delta
-        if (ks->botTimer > ks->botTargetTime) { 
+        ks->botTimer += ctx->dt;
+        if (ks->botTimer <= ks->botTargetTime) {
+            ctx->sleepMs = (u32)((ks->botTargetTime - ks->botTimer) * 1000.0f) + 1;
+        } else {
             ks->botTimer = 0;
             ks->botTargetTime = 1.0f + randfloat() * 1.5f; 
             
@@ -332,7 +391,8 @@ void king_onTick(void* state) {
                 ks->lastAction = 1; 
                 g->currentPlayer = (g->currentPlayer + g->gameDirection + g->numPlayers) % g->numPlayers;
             }
-            broadcast_sync(ks, ks->roomId, ks->broadcast);
+            broadcast_sync(ks, ctx->broadcast);
+            ctx->sleepMs = 0; // Next player may be a bot as well
         }
     }
 }
@@ -357,33 +417,50 @@ void king_onPlayerLeave(void* state, s32 playerId) {
             strncpy(g->players[internalId].name, "Bot (ex-humain)", sizeof(g->players[internalId].name) - 1);
             g->players[internalId].name[sizeof(g->players[internalId].name) - 1] = '\0';
         } else {
-            for (int i = internalId; i < g->numPlayers - 1; i++) g->players[i] = g->players[i+1];
+            for (int i = internalId; i < g->numPlayers - 1; i++) {
+                g->players[i] = g->players[i+1];
+                // The sync stream follows its client to the new slot
+                snapshotHistoryCopy(&ks->syncHistory[i], &ks->syncHistory[i+1]);
+                ks->syncAcked[i] = ks->syncAcked[i+1];
+            }
             g->numPlayers--;
         }
-        if (ks->broadcast) broadcast_sync(ks, ks->roomId, ks->broadcast);
+        if (ks->broadcast) broadcast_sync(ks, ks->broadcast);
     }
 }
 
 /**
-    @brief Destroys a game instance and frees memory.
+    @brief Frees the decks owned by a game instance, but not the instance itself.
 
-    @param[in,out] state Pointer to the KingServerState_St instance to destroy.
+    @param[in,out] state Pointer to the KingServerState_St instance to clean up.
 */
-void king_destroyInstance(void *state) {
+void king_releaseInstance(void *state) {
     KingServerState* ks = (KingServerState*)state;
     for (int i = 0; i < ks->state.numPlayers; i++) {
         kingForFour_clearDeck(&ks->state.players[i].hand);
     }
     kingForFour_clearDeck(&ks->state.drawPile);
     kingForFour_clearDeck(&ks->state.discardPile);
-    free(ks);
+}
+
+/**
+    @brief Destroys a game instance and frees memory.
+
+    @param[in,out] state Pointer to the KingServerState_St instance to destroy.
+*/
+void king_destroyInstance(void *state) {
+    king_releaseInstance(state);
+    free(state);
 }
 
 GameServerInterface_St kingForFour_serverInterface = {
     .gameName          = "King for Four",
     .createInstance    = king_createInstance,
     .onAction          = king_onAction,
-    .onTick            = king_onTick, 
+    .onRoomTick        = king_onRoomTick,
     .onPlayerLeave     = king_onPlayerLeave,
-    .destroyInstance   = king_destroyInstance
+    .destroyInstance   = king_destroyInstance,
+    .instanceSize      = sizeof(KingServerState),
+    .initInstance      = king_initInstance,
+    .releaseInstance   = king_releaseInstance
 };
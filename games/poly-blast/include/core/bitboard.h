@@ -0,0 +1,69 @@
+/**
+    @file bitboard.h
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Board as a 64-bit occupancy mask, for the placement searches.
+
+    Bit `y * BOARD_WIDTH + x` is set when the cell (x, y) is taken
+    (hitsLeft != 0). The blocks stay the state the game draws and saves;
+    the searches read the mask once and work on it alone: a placement test
+    is one AND, a full line a mask compare, and a board copy a u64.
+
+    Every block is removed by its first clear (see polyBlast_clearBoard()),
+    so the mask is the whole state the searches need.
+*/
+#ifndef CORE_BITBOARD_H
+#define CORE_BITBOARD_H
+
+#include "utils/userTypes.h"
+
+#if BOARD_WIDTH != 8 || BOARD_HEIGHT != 8
+#error "Board masks hold an 8x8 board in a u64"
+#endif
+
+#define BOARD_MASK_ROW      0x00000000000000FFull   ///< Cells of the top row.
+#define BOARD_MASK_COLUMN   0x0101010101010101ull   ///< Cells of the left column.
+
+/**
+    @brief Builds the occupancy mask of the board.
+
+    @param[in]     board        Pointer to the board.
+    @return                     Mask of the cells with hitsLeft != 0.
+*/
+u64 polyBlast_getBoardMask(const Board_St* const board);
+
+/**
+    @brief Builds the mask of a prefab anchored at the top-left cell of the board.
+
+    @param[in]     prefab       Pointer to the prefab.
+    @return                     Mask of the cells the prefab covers at (0, 0).
+*/
+u64 polyBlast_getPrefabMask(const Prefab_St* const prefab);
+
+/**
+    @brief Lists every in-bound placement of a prefab, in row-major anchor order.
+
+    @param[in]     prefab       Pointer to the prefab.
+    @param[out]    placements   The placement masks and their anchors.
+*/
+void polyBlast_getPlacementMasks(const Prefab_St* const prefab, PlacementMasks_St* const placements);
+
+/**
+    @brief Finds the full rows and columns of a board mask.
+
+    @param[in]     boardMask    Occupancy mask of the board.
+    @param[out]    fullRows     Bit r set when row r is full (may be NULL).
+    @param[out]    fullColumns  Bit c set when column c is full (may be NULL).
+    @return                     Mask of the cells the full lines cover, i.e. the cells to clear.
+*/
+u64 polyBlast_getFullLinesMask(const u64 boardMask, u8* const fullRows, u8* const fullColumns);
+
+/**
+    @brief Counts the cells set in a mask.
+
+    @param[in]     mask         Any board mask.
+    @return                     Number of bits set.
+*/
+u8 polyBlast_countCells(u64 mask);
+
+#endif // CORE_BITBOARD_H
@@ -2,7 +2,7 @@
     @file game.h
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Score management and high-level game logic functions.
 */
 #ifndef CORE_GAME_GAME_H
@@ -11,30 +11,19 @@
 #include "utils/userTypes.h"
 
 /**
-    @brief Creates a deep copy of a PrefabManager_St.
-
-    A plain `memcpy` is insufficient because each `bags[i]` contains a heap-allocated
-    `items` array. This function copies the struct and then re-creates every bag
-    with its indices.
-
-    @param[in]     manager      Source manager to copy.
-    @return                     Independent deep copy of the prefab manager.
-*/
-PrefabManager_St polyBlast_deepcopyPrefabManager(const PrefabManager_St* const manager);
-
-/**
-    @brief Determines whether the current three slots can all be placed on the
+    @brief Determines whether the shapes left in the slots can all be placed on the
            board in at least one ordering.
 
-    Tries all 6 permutations of placement order. Uses an arena snapshot/rewind
-    so the temporary `emptyCells` vector does not leak.
+    Runs the placement search of solver.h in solvability mode: every order
+    and every placement, clears included, with a bounded number of states.
+    A search that runs out of states does not end the game.
 
-    @param[in]     board        Current board state.
-    @param[in]     slots        The three active prefab slots.
-    @return                     true if game over (no legal way to place all three shapes).
+    @param[in]     board        Pointer to the board.
+    @param[in]     slots        The three active prefab slots (placed ones are skipped).
+    @return                     true if game over (no legal way to place the shapes left).
     @return                     false if at least one ordering works.
 */
-bool polyBlast_testGameOver(Board_St board, const ShapeSlots_t slots);
+bool polyBlast_testGameOver(const Board_St* const board, const ShapeSlots_t slots);
 
 /**
     @brief Builds the score and streak text strings based on the current game state.
@@ -43,6 +32,16 @@ bool polyBlast_testGameOver(Board_St board, const ShapeSlots_t slots);
 */
 void polyBlast_buildScoreRelatedTexts(ScoringState_St* const scoringState);
 
+/**
+    @brief Computes the score of clearing some lines at once.
+
+    SCORE_PER_LINE_CLEAR per line, times 1.0 + 0.5 × (lines - 1) when ≥ 2 lines.
+
+    @param[in]     linesCleared Number of rows and columns cleared together.
+    @return                     Score of the clear, before the streak multiplier.
+*/
+f32 polyBlast_getLineClearScore(const u8 linesCleared);
+
 /**
     @brief Calculates the score of the move and updates the streak.
 
@@ -2,7 +2,7 @@
     @file placement.h
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Shape placement and simulation logic.
 */
 #ifndef CORE_PLACEMENT_H
@@ -32,26 +32,47 @@ void polyBlast_placeShape(const Shape_St* const shape, const u8Vector2 pos, Boar
 /**
     @brief Recursively checks if all shapes in slots can be placed in a specific order.
 
-    @param[in,out] board        Pointer to the board (simulated state).
+    Reads the board mask and the placement masks once, then searches on masks
+    (see polyBlast_canPlaceAllOnMask()).
+
+    @param[in]     board        Pointer to the board.
     @param[in]     slots        The three active prefab slots.
     @param[in]     order        Array of indices representing placement order.
     @param[in]     idx          Current index in the order array.
     @return                     true if all remaining shapes can be placed.
 */
-bool polyBlast_canPlaceAll(Board_St* board, const ShapeSlots_t slots, const u8 order[3], u8 idx);
+bool polyBlast_canPlaceAll(const Board_St* const board, const ShapeSlots_t slots, const u8 order[3], u8 idx);
+
+/**
+    @brief Recursively checks, on a board mask, if all shapes in slots can be placed in a specific order.
+
+    Each placement is tested with one AND, and the full lines it completes
+    are cleared from the mask before the next shape is tried.
+
+    @param[in]     boardMask    Occupancy mask of the board (see bitboard.h).
+    @param[in]     slots        The three active prefab slots (placed ones are skipped).
+    @param[in]     placements   Placement masks of each slot, from polyBlast_getPlacementMasks().
+    @param[in]     order        Array of indices representing placement order.
+    @param[in]     idx          Current index in the order array.
+    @return                     true if all remaining shapes can be placed.
+*/
+bool polyBlast_canPlaceAllOnMask(const u64 boardMask, const ShapeSlots_t slots, const PlacementMasks_St placements[3], const u8 order[3], u8 idx);
 
 /**
-    @brief Runs a brute-force simulation to pick the "best" set of three prefabs
-           for the next turn based on simulated score after placement and clears.
+    @brief Picks the set of three prefabs for the next turn: the best-scoring one
+           among those that can surely all be placed.
 
-    Performs up to 8 full simulation attempts:
-      - Each attempt draws a fresh shuffled set of slots into a temporary game copy.
-      - For each of the 6 placement permutations, simulates placing all three shapes
-        while tracking the produced score.
-      - Remembers the prefab combination that produced the highest recorded score.
+    Candidates: the slots just dealt, then PLACEMENT_SEARCH_CANDIDATES - 1 sets
+    drawn with the size weights from what the bags still hold (the bags are
+    left untouched). Each distinct
+    set goes through the exhaustive search of solver.h, scored on the best
+    placement of its three shapes in any order, plus a bonus per streak level
+    left. When no set fits, the weights lean towards smaller shapes and a
+    new round is drawn, up to PLACEMENT_SEARCH_ROUNDS rounds. The slots keep
+    their position and color, only their prefabs change.
 
     @param[in,out] game         Game state whose slots will be replaced by the best
-                                simulated set.
+                                set found. Left as dealt when no set fits.
 */
 void polyBlast_placementSimulation(PolyBlastGame_St* const game);
 
@@ -0,0 +1,40 @@
+/**
+    @file solver.h
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Exhaustive placement search: can these shapes still all be placed, and how well?
+
+    The search works on board masks (bitboard.h). A state is the board, the
+    shapes left and the streak; its value is the best score reachable from
+    it, with the same rules as polyBlast_manageScoreAndStreak() and a bonus
+    per streak level left at the end. States are memoized, so orders that
+    reach the same board are searched once. Identical shapes are
+    interchangeable, so only the first one of them is expanded.
+
+    The time is bounded in states expanded. After `scoreNodes` states the
+    search stops maximizing and takes the first solution it finds. After
+    PLACEMENT_SEARCH_MAX_NODES states it gives up undecided. "Solvable" and
+    "unsolvable" are always exact.
+
+    Dealing (polyBlast_placementSimulation()) and the game-over test
+    (polyBlast_testGameOver()) both run this search.
+*/
+#ifndef CORE_SOLVER_H
+#define CORE_SOLVER_H
+
+#include "utils/userTypes.h"
+
+/**
+    @brief Searches every order and placement of the given shapes on a board.
+
+    @param[in]     boardMask    Occupancy mask of the board.
+    @param[in]     prefabs      Shapes to place, NULL for a slot already placed.
+    @param[in]     streakCount  Current streak.
+    @param[in]     streakGrace  Placements left before the streak resets.
+    @param[in]     scoreNodes   States searched for the best score, 0 to only decide solvability.
+    @return                     The verdict, the best score found and the states expanded.
+*/
+PlacementSolution_St polyBlast_solvePlacements(const u64 boardMask, const Prefab_St* const prefabs[3],
+                                               const u8 streakCount, const u8 streakGrace, const u32 scoreNodes);
+
+#endif // CORE_SOLVER_H
@@ -2,7 +2,7 @@
     @file configs.h
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Core configuration constants for the game.
 */
 #ifndef CONFIGS_H
@@ -61,4 +61,11 @@
 #define BOARD_WIDTH  8              ///< Number of columns in the grid.
 #define BOARD_HEIGHT 8              ///< Number of rows in the grid.
 
+#define PLACEMENT_SEARCH_CANDIDATES  16         ///< Triples searched per dealing round.
+#define PLACEMENT_SEARCH_ROUNDS      4          ///< Dealing rounds before the dealt triple is kept as is.
+#define PLACEMENT_SEARCH_SCORE_NODES 256        ///< States searched for the best score of a triple, then any solution will do.
+#define PLACEMENT_SEARCH_MAX_NODES   16384      ///< States after which a search gives up undecided.
+#define PLACEMENT_SEARCH_MEMO_SIZE   (1 << 14)  ///< Entries of the search memo (power of 2).
+#define PLACEMENT_SEARCH_STREAK_BONUS 1000      ///< Search value of each streak level left after a triple.
+
 #endif // CONFIGS_H
\ No newline at end of file
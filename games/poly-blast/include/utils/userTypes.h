@@ -2,7 +2,7 @@
     @file userTypes.h
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Core type definitions used throughout the game.
 */
 #ifndef USER_TYPES_H
@@ -199,6 +199,38 @@ typedef struct {
 */
 typeDA(u8Vector2, AnchorVec_St);
 
+/**
+    @brief Every in-bound placement of a prefab, as board masks.
+
+    Bit `y * BOARD_WIDTH + x` of a board mask stands for the cell (x, y).
+    A placement fits on a board when `(masks[i] & boardMask) == 0`.
+    Built once per prefab by polyBlast_getPlacementMasks(), so the searches
+    test a placement with a single AND instead of walking the blocks.
+*/
+typedef struct {
+    u64 masks[BOARD_WIDTH * BOARD_HEIGHT];          ///< Cells covered by each placement.
+    u8Vector2 anchors[BOARD_WIDTH * BOARD_HEIGHT];  ///< Top-left board position of each placement.
+    u8 count;                                       ///< Number of placements.
+} PlacementMasks_St;
+
+/**
+    @brief Outcome of a placement search.
+*/
+typedef enum {
+    PLACEMENT_SOLVABLE,         ///< Every remaining shape can be placed, in some order.
+    PLACEMENT_UNSOLVABLE,       ///< No order and no placement fits them all.
+    PLACEMENT_UNDECIDED         ///< The search ran out of nodes before knowing.
+} PlacementVerdict_Et;
+
+/**
+    @brief Result of polyBlast_solvePlacements().
+*/
+typedef struct {
+    PlacementVerdict_Et verdict;    ///< Whether the shapes can all be placed.
+    u32 bestScore;                  ///< Best search value of a full placement (solvable only).
+    u32 nodes;                      ///< Search states expanded.
+} PlacementSolution_St;
+
 /**
     @brief Possible scene states for the application.
 */
@@ -148,11 +148,11 @@ endif
 
 # Combine with base
 CFLAGS += $(BASE_CFLAGS)
-LDFLAGS += $(BASE_LDFLAGS)
+LDFLAGS += $(EXTRA_LDFLAGS)
 
 # Allow extras from command line
 CFLAGS += $(EXTRA_CFLAGS)
-LDFLAGS += $(EXTRA_LDFLAGS)
+LDFLAGS += $(BASE_LDFLAGS)
 
 MAIN_NAME ?= main
 LIB_NAME := polyblast
@@ -1,5 +1,5 @@
 # Prevent make from deleting intermediate object files
-.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS)
+.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS) $(DEALER_OBJECT)
 
 # Rules
 $(BIN): $(LIB_OBJECTS) $(MAIN_OBJECT)
@@ -10,10 +10,17 @@ $(OBJ_DIR)/%.o: $(SRC_DIR)/%.c
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $(CFLAGS) $(DEP_FLAGS) -c $< -o $@
 
-$(TEST_BIN_DIR)/% : $(LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
+$(TEST_BIN_DIR)/% : $(TEST_LIB_OBJECTS) $(OBJ_DIR)/tests/%.o | $(FIRSTPARTY_LIB)
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
 
+$(DEALER_BIN): $(TEST_LIB_OBJECTS) $(DEALER_OBJECT) | $(FIRSTPARTY_LIB)
+	$(SILENT_PREFIX)mkdir -p $(@D)
+	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
+
+$(FIRSTPARTY_LIB):
+	$(SILENT_PREFIX)$(MAKE) -C ../../firstparty static-lib MODE=$(MODE)
+
 $(OBJ_DIR)/tests/%.o: $(TEST_DIR)/%.c
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $(CFLAGS) -Isrc $(DEP_FLAGS) -c $< -o $@
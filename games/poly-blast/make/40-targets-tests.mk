@@ -5,6 +5,11 @@ tests: $(TEST_BINS)
 		echo "Test binaries built: $(notdir $(TEST_BINS))"; \
 	fi
 
+dealer: $(DEALER_BIN)
+
+run-dealer: dealer
+	$(SILENT_PREFIX)./$(DEALER_BIN) $(DEALER_ARGS)
+
 
 run-tests: tests
 	@if [ -z "$(TEST_BINS)" ]; then \
@@ -21,7 +21,7 @@ ifeq ($(NO_DEPENDENCY_TRACKING),1)
 else
 	DEP_FLAGS := -MMD -MP
 	# All dependency files
-	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d)
+	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d) $(DEALER_OBJECT:.o=.d)
 endif
 
 ifneq ($(NO_DEPENDENCY_TRACKING),1)
@@ -53,6 +53,8 @@ help:
 	@echo "    run-main             Run the main binary (uses Valgrind in valgrind-debug mode)"
 	@echo "    run-gdb              Debug the main binary with gdb"
 	@echo "    run-tests            Build and run all tests, reporting failures at the end"
+	@echo "    dealer               Build the dealing latency benchmark (build/bin/dealer)"
+	@echo "    run-dealer           Time the dealing and game-over search on dense boards (DEALER_ARGS=\"--deals=2000 ...\")"
 	@echo "    clean                Remove all build artifacts and build folder"
 	@echo "    doxygen              Build documentation"
 	@echo "    clean-docs           Remove all of the generated documentation"
@@ -72,6 +74,7 @@ help:
 	@echo "    NO_DEPENDENCY_TRACKING=1    Disable automatic dependency tracking (.d files)"
 	@echo "    EXTRA_CFLAGS=\"<str>\"        Add custom compiler flags"
 	@echo "    EXTRA_LDFLAGS=\"<str>\"       Add custom linker flags"
+	@echo "    DEALER_ARGS=\"<str>\"         Options for run-dealer (see build/bin/dealer --help)"
 	@echo ""
 	@echo "Portability Notes:"
 	@echo "    run-tests uses stdbuf (from GNU coreutils) if available for reliable output on crashes;"
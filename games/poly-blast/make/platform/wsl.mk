@@ -12,6 +12,8 @@ BASE_CFLAGS := \
 # Linker base
 BASE_LDFLAGS := \
 	-L$(RAYLIB_LIB_DIR) \
+	-L../../firstparty/build/lib \
+	-lfirstparty \
 	-l:libraylib.a \
 	-lGL \
 	-lm \
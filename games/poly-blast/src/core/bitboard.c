@@ -0,0 +1,123 @@
+/**
+    @file bitboard.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Board occupancy mask implementation.
+*/
+#include "core/bitboard.h"
+
+#include "sharedUtils/debug.h"
+
+/**
+    @brief Builds the occupancy mask of the board.
+
+    @param[in]     board        Pointer to the board.
+    @return                     Mask of the cells with hitsLeft != 0.
+*/
+u64 polyBlast_getBoardMask(const Board_St* const board) {
+    if (board == NULL) {
+        log_warn("Received NULL pointer");
+        return 0;
+    }
+
+    u64 mask = 0;
+    for (u8 y = 0; y < BOARD_HEIGHT; ++y) {
+        for (u8 x = 0; x < BOARD_WIDTH; ++x) {
+            mask |= (u64) (board->blocks[y][x].hitsLeft != 0) << (y * BOARD_WIDTH + x);
+        }
+    }
+
+    return mask;
+}
+
+/**
+    @brief Builds the mask of a prefab anchored at the top-left cell of the board.
+
+    @param[in]     prefab       Pointer to the prefab.
+    @return                     Mask of the cells the prefab covers at (0, 0).
+*/
+u64 polyBlast_getPrefabMask(const Prefab_St* const prefab) {
+    u64 mask = 0;
+    for (u8 i = 0; i < prefab->blockCount; ++i) {
+        mask |= 1ull << (prefab->offsets[i].y * BOARD_WIDTH + prefab->offsets[i].x);
+    }
+
+    return mask;
+}
+
+/**
+    @brief Lists every in-bound placement of a prefab.
+
+    The extent is read from the offsets rather than width/height, so the
+    base prefabs work before their bounding box is computed.
+
+    @param[in]     prefab       Pointer to the prefab.
+    @param[out]    placements   The placement masks and their anchors.
+*/
+void polyBlast_getPlacementMasks(const Prefab_St* const prefab, PlacementMasks_St* const placements) {
+    placements->count = 0;
+    if (prefab == NULL || prefab->blockCount == 0) return;
+
+    u8 maxX = 0, maxY = 0;
+    for (u8 i = 0; i < prefab->blockCount; ++i) {
+        if (prefab->offsets[i].x > maxX) maxX = prefab->offsets[i].x;
+        if (prefab->offsets[i].y > maxY) maxY = prefab->offsets[i].y;
+    }
+
+    if (maxX >= BOARD_WIDTH || maxY >= BOARD_HEIGHT) return;
+
+    const u64 mask = polyBlast_getPrefabMask(prefab);
+    for (u8 y = 0; y + maxY < BOARD_HEIGHT; ++y) {
+        for (u8 x = 0; x + maxX < BOARD_WIDTH; ++x) {
+            placements->masks[placements->count] = mask << (y * BOARD_WIDTH + x);
+            placements->anchors[placements->count] = (u8Vector2) {x, y};
+            placements->count++;
+        }
+    }
+}
+
+/**
+    @brief Finds the full rows and columns of a board mask.
+
+    A row is folded onto its first bit (bit 8r ends up as the AND of the
+    row), a column onto the top row (bit c as the AND of the column).
+
+    @param[in]     boardMask    Occupancy mask of the board.
+    @param[out]    fullRows     Bit r set when row r is full (may be NULL).
+    @param[out]    fullColumns  Bit c set when column c is full (may be NULL).
+    @return                     Mask of the cells to clear.
+*/
+u64 polyBlast_getFullLinesMask(const u64 boardMask, u8* const fullRows, u8* const fullColumns) {
+    u64 rows = boardMask;
+    rows &= rows >> 4;
+    rows &= rows >> 2;
+    rows &= rows >> 1;
+    rows &= BOARD_MASK_COLUMN;
+
+    u64 columns = boardMask;
+    columns &= columns >> 32;
+    columns &= columns >> 16;
+    columns &= columns >> 8;
+    columns &= BOARD_MASK_ROW;
+
+    // Gathers bit 8r into bit 56 + r, the products never overlap
+    if (fullRows != NULL) *fullRows = (u8) ((rows * 0x0102040810204080ull) >> 56);
+    if (fullColumns != NULL) *fullColumns = (u8) columns;
+
+    return rows * BOARD_MASK_ROW | columns * BOARD_MASK_COLUMN;
+}
+
+/**
+    @brief Counts the cells set in a mask.
+
+    Plain SWAR count: without -mpopcnt, __builtin_popcountll is a libgcc call.
+
+    @param[in]     mask         Any board mask.
+    @return                     Number of bits set.
+*/
+u8 polyBlast_countCells(u64 mask) {
+    mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+    mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (u8) ((mask * 0x0101010101010101ull) >> 56);
+}
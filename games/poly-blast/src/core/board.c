@@ -2,10 +2,11 @@
     @file board.c
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Board clearing logic implementation.
 */
 #include "core/board.h"
+#include "core/bitboard.h"
 
 #include "utils/globals.h"
 
@@ -23,44 +24,6 @@ bool polyBlast_isInBound(const s8Vector2 pos, const Board_St* const board) {
         && (0 <= pos.y) && (pos.y < board->height);
 }
 
-/**
-    @brief Checks if a specific row on the board is completely filled.
-
-    @param[in]     board        Pointer to the board.
-    @param[in]     row          Row index to check.
-    @return                     true if the row is full, false otherwise.
-*/
-static bool isRowFull(const Board_St* const board, const u8 row) {
-    if (board == NULL) {
-        log_warn("Received NULL pointer");
-        return false;
-    }
-    
-    for (u8 col = 0; col < board->width; ++col) {
-        if (board->blocks[row][col].hitsLeft == 0) return false;
-    }
-    return true;
-}
-
-/**
-    @brief Checks if a specific column on the board is completely filled.
-
-    @param[in]     board        Pointer to the board.
-    @param[in]     col          Column index to check.
-    @return                     true if the column is full, false otherwise.
-*/
-static bool isColumnFull(const Board_St* const board, const u8 col) {
-    if (board == NULL) {
-        log_warn("Received NULL pointer");
-        return false;
-    }
-    
-    for (u8 row = 0; row < board->width; ++row) {
-        if (board->blocks[row][col].hitsLeft == 0) return false;
-    }
-    return true;
-}
-
 /**
     @brief Clears all blocks in a specific row.
 
@@ -106,12 +69,15 @@ void polyBlast_updateBoardClearing(Board_St* const board) {
         return;
     }
     
+    u8 fullRows, fullColumns;
+    polyBlast_getFullLinesMask(polyBlast_getBoardMask(board), &fullRows, &fullColumns);
+
     for (u8 row = 0; row < board->height; ++row) {
-        board->rowsToClear[row] = isRowFull(board, row);
+        board->rowsToClear[row] = (fullRows >> row) & 1;
     }
 
     for (u8 col = 0; col < board->width; ++col) {
-        board->columnsToClear[col] = isColumnFull(board, col);
+        board->columnsToClear[col] = (fullColumns >> col) & 1;
     }
 }
 
@@ -171,16 +137,7 @@ u32 polyBlast_getEmptyCellCount(const Board_St* const board) {
         return 0;
     }
 
-    u32 empty_cells = 0;
-    for (u32 y = 0; y < board->height; y++) {
-        for (u32 x = 0; x < board->width; x++) {
-            if (board->blocks[y][x].hitsLeft == 0) {
-                empty_cells++;
-            }
-        }
-    }
-
-    return empty_cells;
+    return board->width * board->height - polyBlast_countCells(polyBlast_getBoardMask(board));
 }
 
 /**
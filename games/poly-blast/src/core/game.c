@@ -2,45 +2,18 @@
     @file game.c
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Score management functions implementation.
 */
 #include "core/game.h"
 #include "core/board.h"
+#include "core/bitboard.h"
 #include "core/placement.h"
+#include "core/solver.h"
 
 #include "sharedUtils/container.h"
 #include "sharedUtils/mathUtils.h"
 
-#define da_copy(da, copy)  \
-    do {                   \
-        (copy)->count = 0; \
-        da_append_many(    \
-            (copy),        \
-            (da)->items,   \
-            (da)->count    \
-        );                 \
-    } while (0)
-
-/**
-    @brief Creates a deep copy of a PrefabManager_St.
-
-    @param[in]     manager      Source manager to copy.
-    @return                     Independent deep copy of the prefab manager.
-*/
-PrefabManager_St polyBlast_deepcopyPrefabManager(const PrefabManager_St* const manager) {
-    PrefabManager_St copy = {0};
-    memcpy(&copy.sizeWeights, &manager->sizeWeights, sizeof(SizeWeight_St));
-
-    for (u8 i = 0; i < MAX_SHAPE_SIZE; i++) {
-        copy.bags[i].count = 0;
-        if (manager->bags[i].count == 0) continue;
-        da_append_many(&copy.bags[i], manager->bags[i].items, manager->bags[i].count);
-    }
-
-    return copy;
-}
-
 /**
     @brief Finds all valid anchor positions where a shape can be placed on the board.
 
@@ -53,15 +26,13 @@ AnchorVec_St polyBlast_getAnchorCandidates(const Board_St* const board, const Sh
 
     if (board == NULL || shape == NULL || shape->prefab == NULL) return anchors;
 
-    const u8 maxY = board->height - shape->prefab->height;
-    const u8 maxX = board->width - shape->prefab->width;
+    const u64 boardMask = polyBlast_getBoardMask(board);
+    PlacementMasks_St placements;
+    polyBlast_getPlacementMasks(shape->prefab, &placements);
 
-    for (u8 y = 0; y <= maxY; ++y) {
-        for (u8 x = 0; x <= maxX; ++x) {
-            u8Vector2 anchor = {x, y};
-            if (polyBlast_isShapePlaceable(shape, castTo(s8Vector2) &anchor, board)) {
-                da_append(&anchors, anchor);
-            }
+    for (u8 i = 0; i < placements.count; ++i) {
+        if ((placements.masks[i] & boardMask) == 0) {
+            da_append(&anchors, placements.anchors[i]);
         }
     }
 
@@ -69,29 +40,22 @@ AnchorVec_St polyBlast_getAnchorCandidates(const Board_St* const board, const Sh
 }
 
 /**
-    @brief Tests if any of the shapes in the slots can be placed on the board.
+    @brief Tests if the shapes left in the slots can still all be placed on the board.
 
-    @param[in]     board        Current board state (copied by value for simulation).
+    @param[in]     board        Pointer to the board.
     @param[in]     slots        The three active prefab slots.
-    @return                     true if no shapes can be placed (Game Over), false otherwise.
+    @return                     true if no order and no placement fits them all (Game Over), false otherwise.
 */
-bool polyBlast_testGameOver(Board_St board, const ShapeSlots_t slots) {
-    static const u8 permutations[6][3] = {
-        {0, 1, 2}, {0, 2, 1},
-        {1, 0, 2}, {1, 2, 0},
-        {2, 0, 1}, {2, 1, 0}
-    };
-
-    bool allPlaced = true;
-    Board_St simBoard = board;
-
-    for (u8 p = 0; p < 6; p++) {
-        allPlaced = polyBlast_canPlaceAll(&simBoard, slots, permutations[p], 0);
-
-        if (allPlaced) break;
+bool polyBlast_testGameOver(const Board_St* const board, const ShapeSlots_t slots) {
+    const Prefab_St* prefabs[3];
+    for (u8 i = 0; i < 3; ++i) {
+        prefabs[i] = slots[i].placed ? NULL : slots[i].prefab;
     }
 
-    return !allPlaced;
+    PlacementSolution_St solution = polyBlast_solvePlacements(polyBlast_getBoardMask(board), prefabs, 0, 0, 0);
+
+    // An undecided search never ends the game
+    return solution.verdict == PLACEMENT_UNSOLVABLE;
 }
 
 /**
@@ -108,12 +72,23 @@ void polyBlast_buildScoreRelatedTexts(ScoringState_St* const scoringState) {
 }
 
 /**
-    @brief Computes score increment from the latest placement.
+    @brief Computes the score of clearing some lines at once.
 
     Scoring rules (as currently implemented):
       - Base: SCORE_PER_LINE_CLEAR per cleared line (row or column)
       - Multiplier: 1.0 + 0.5 × (number of lines cleared - 1) when ≥ 2 lines
 
+    @param[in]     linesCleared Number of rows and columns cleared together.
+    @return                     Score of the clear, before the streak multiplier.
+*/
+f32 polyBlast_getLineClearScore(const u8 linesCleared) {
+    f32 multiBonus = linesCleared > 1 ? 1.0f + 0.5f * (linesCleared - 1) : 1.0f;
+    return linesCleared * SCORE_PER_LINE_CLEAR * multiBonus;
+}
+
+/**
+    @brief Computes score increment from the latest placement.
+
     @param[in]     board        Board after placement but before clearBoard() is called.
     @return                     Score to add from line clears only.
 */
@@ -127,8 +102,7 @@ static f32 calculateBoardClearingScore(const Board_St* const board) {
         linesCleared += board->columnsToClear[col];
     }
 
-    f32 multiBonus = linesCleared > 1 ? 1.0f + 0.5f * (linesCleared - 1) : 1.0f;
-    return linesCleared * SCORE_PER_LINE_CLEAR * multiBonus;
+    return polyBlast_getLineClearScore(linesCleared);
 }
 
 /**
@@ -2,14 +2,16 @@
     @file placement.c
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Shape placement and simulation logic implementation.
 */
 #include "core/placement.h"
 #include "core/prefab.h"
 #include "core/shape.h"
 #include "core/board.h"
+#include "core/bitboard.h"
 #include "core/game.h"
+#include "core/solver.h"
 
 #include "utils/globals.h"
 
@@ -63,171 +65,142 @@ void polyBlast_placeShape(const Shape_St* const shape, const u8Vector2 pos, Boar
 }
 
 /**
-    @brief Gets a random valid position for a shape on the board.
+    @brief Recursively checks if all shapes in slots can be placed in a specific order.
+
+    Reads the board mask and the placement masks once, then searches on masks.
 
     @param[in]     board        Pointer to the board.
-    @param[in]     shape        Pointer to the shape.
-    @param[out]    outPosition  The selected valid position.
-    @return                     true if a position was found, false otherwise.
+    @param[in]     slots        The three active prefab slots.
+    @param[in]     order        Array of indices representing placement order.
+    @param[in]     idx          Current index in the order array.
+    @return                     true if all remaining shapes can be placed, false otherwise.
 */
-bool polyBlast_getRandomValidPosition(const Board_St* const board, const Shape_St* const shape, u8Vector2* const outPosition) {
-    bool success = false;
-
-    Arena* prev = contextArena;
-    contextArena = &tempArena;
-    Arena_Mark save = arena_snapshot(contextArena); {
-        AnchorVec_St candidates = polyBlast_getAnchorCandidates(board, shape);
-        
-        if (candidates.count > 0) {
-            da_shuffleT(u8Vector2, &candidates, rand);
-            *outPosition = candidates.items[0];
-            success = true;
-        }
-    } arena_rewind(contextArena, save);
-
-    contextArena = prev;
+bool polyBlast_canPlaceAll(const Board_St* const board, const ShapeSlots_t slots, const u8 order[3], u8 idx) {
+    PlacementMasks_St placements[3];
+    for (u8 i = 0; i < 3; ++i) {
+        polyBlast_getPlacementMasks(slots[i].prefab, &placements[i]);
+    }
 
-    return success;
+    return polyBlast_canPlaceAllOnMask(polyBlast_getBoardMask(board), slots, placements, order, idx);
 }
 
 /**
-    @brief Attempts to place a shape greedily on the board.
+    @brief Recursively checks, on a board mask, if all shapes in slots can be placed in a specific order.
 
-    @param[in,out] board        Pointer to the board.
-    @param[in]     shape        Pointer to the shape.
-    @param[in,out] scoring      Optional scoring state to update.
-    @return                     true if successfully placed, false otherwise.
+    @param[in]     boardMask    Occupancy mask of the board.
+    @param[in]     slots        The three active prefab slots.
+    @param[in]     placements   Placement masks of each slot.
+    @param[in]     order        Array of indices representing placement order.
+    @param[in]     idx          Current index in the order array.
+    @return                     true if all remaining shapes can be placed, false otherwise.
 */
-static bool tryGreedyPlaceShape(Board_St* const board, const Shape_St* const shape, ScoringState_St* const scoring) {
-    u8Vector2 pos;
-    if (!polyBlast_getRandomValidPosition(board, shape, &pos)) return false;
+bool polyBlast_canPlaceAllOnMask(const u64 boardMask, const ShapeSlots_t slots, const PlacementMasks_St placements[3], const u8 order[3], u8 idx) {
+    if (idx == 3) return true;
 
-    polyBlast_placeShape(shape, pos, board);
+    if (slots[order[idx]].placed) return polyBlast_canPlaceAllOnMask(boardMask, slots, placements, order, idx+1);
 
-    if (polyBlast_checkBoardForClearing(board)) {
-        polyBlast_clearBoard(board);
-    }
+    const PlacementMasks_St* shapePlacements = &placements[order[idx]];
 
-    if (scoring != NULL) {
-        polyBlast_manageScoreAndStreak(scoring, board, shape->prefab->blockCount);
+    for (u8 i = 0; i < shapePlacements->count; ++i) {
+        if (shapePlacements->masks[i] & boardMask) continue;
+
+        // A board is a u64: nothing to copy nor to backtrack when the attempt fails
+        u64 simBoard = boardMask | shapePlacements->masks[i];
+        simBoard &= ~polyBlast_getFullLinesMask(simBoard, NULL, NULL);
+
+        if (polyBlast_canPlaceAllOnMask(simBoard, slots, placements, order, idx+1)) return true;
     }
 
-    return true;
+    return false;
 }
 
 /**
-    @brief Attempts to place the three slots onto a board copy greedily.
+    @brief Draws a prefab with the size weights from the live bags, leaving them untouched.
 
-    @param[in,out] board        Board copy mutated by placements and clears.
-    @param[in]     slots        The three active prefab slots.
-    @param[in]     order        Permutation of {0,1,2} defining placement order.
-    @param[in,out] scoring      Optional scoring state updated after each placement.
-    @return                     true if all three shapes were placed, false otherwise.
+    Same weighted pick as the slots get from the bags, over the indices the
+    bags still hold: prefabs dealt since the last refill stay out. Nothing is
+    consumed, so the manager does not have to be copied.
+
+    @param[in]     manager      Game's prefabs manager.
+    @return                     A prefab of polyBlast_prefabsBag still in its bag.
 */
-static bool greedyPlaceAll(Board_St* const board, const ShapeSlots_t slots, const u8 order[3], ScoringState_St* const scoring) {
-    for (u8 i = 0; i < 3; ++i) {
-        const Shape_St* shape = &slots[order[i]];
-        if (shape->placed) continue;
-        if (!tryGreedyPlaceShape(board, shape, scoring)) return false;
+static const Prefab_St* drawPrefab(const PrefabManager_St* const manager) {
+    for (;;) {
+        f32 prob = randfloat();
+        f32 weightedSum = 0.0f;
+        u8 sizeIdx;
+        for (sizeIdx = 0; sizeIdx < MAX_SHAPE_SIZE - 1; ++sizeIdx) {
+            weightedSum += manager->sizeWeights.runTimeWeights[sizeIdx];
+            if (prob <= weightedSum) break;
+        }
+
+        const PrefabIndexBagVec_St* bag = &manager->bags[sizeIdx];
+        if (bag->count > 0) return &polyBlast_prefabsBag.items[bag->items[rand() % bag->count]];
     }
-    
-    return true;
 }
 
 /**
-    @brief Recursively checks if all shapes in slots can be placed in a specific order.
+    @brief Sorts a triple so that the same set of prefabs is always written the same way.
 
-    @param[in,out] board        Pointer to the board (simulated state).
-    @param[in]     slots        The three active prefab slots.
-    @param[in]     order        Array of indices representing placement order.
-    @param[in]     idx          Current index in the order array.
-    @return                     true if all remaining shapes can be placed, false otherwise.
+    @param[in,out] prefabs      The triple.
 */
-bool polyBlast_canPlaceAll(Board_St* board, const ShapeSlots_t slots, const u8 order[3], u8 idx) {
-    if (idx == 3) return true;
-
-    const Shape_St* shape = &slots[order[idx]];
-    if (shape->placed) return polyBlast_canPlaceAll(board, slots, order, idx+1);
-
-    AnchorVec_St anchors = polyBlast_getAnchorCandidates(board, shape);
-
-    // try every valid possible origin in shuffle order for more fairness of odd
-    da_foreach(u8Vector2, anchor, &anchors) {
-        Board_St simBoard = *board; // Avoid the need to backtrack when the attempt fails
-        
-        polyBlast_placeShape(shape, *anchor, &simBoard);
-        if (polyBlast_checkBoardForClearing(&simBoard)) polyBlast_clearBoard(&simBoard);
-
-        if (polyBlast_canPlaceAll(&simBoard, slots, order, idx+1)) return true;
+static void sortTriple(const Prefab_St* prefabs[3]) {
+    for (u8 i = 1; i < 3; ++i) {
+        for (u8 j = i; j > 0 && prefabs[j] < prefabs[j - 1]; --j) {
+            const Prefab_St* swap = prefabs[j];
+            prefabs[j] = prefabs[j - 1];
+            prefabs[j - 1] = swap;
+        }
     }
-
-    return false;
 }
 
 /**
-    @brief Runs a brute-force simulation to pick the "best" set of three prefabs.
+    @brief Picks the best set of three prefabs for the next turn, among those that surely fit.
 
     @param[in,out] game         Pointer to the current game state.
 */
 void polyBlast_placementSimulation(PolyBlastGame_St* const game) {
-    f32 bestAttemptScore = 0;
+    const u64 boardMask = polyBlast_getBoardMask(&game->board);
+    const Prefab_St* candidates[PLACEMENT_SEARCH_CANDIDATES][3];
     const Prefab_St* selectedPrefabs[3] = {0};
     bool success = false;
+    u32 bestScore = 0;
+
+    for (u8 round = 0; round < PLACEMENT_SEARCH_ROUNDS && !success; ++round) {
+        for (u8 c = 0; c < PLACEMENT_SEARCH_CANDIDATES; ++c) {
+            // The dealt slots are the first candidate, the draws follow
+            for (u8 i = 0; i < 3; ++i) {
+                candidates[c][i] = round == 0 && c == 0
+                                 ? game->prefabManager.slots[i].prefab
+                                 : drawPrefab(&game->prefabManager);
+            }
 
-    // Set up `contextArena` to safely reset it, using `arena_reset`,
-    // deallocate everything that was allocated using `context_alloc`
-    contextArena = &tempArena;
-
-    PolyBlastGame_St algoGame = *game;
-
-    // Need specialized function because of `bags`,
-    // because the vectors contain allocated array `items`
-    // that can't be simply copied with a single memcpy of the whole bag
-    algoGame.prefabManager = polyBlast_deepcopyPrefabManager(&game->prefabManager);
-
-    static const u8 permutations[6][3] = {
-        {0, 1, 2}, {0, 2, 1},
-        {1, 0, 2}, {1, 2, 0},
-        {2, 0, 1}, {2, 1, 0}
-    };
-
-    for (u8 attempt = 0; attempt < 100; ++attempt) {
-        polyBlast_shuffleSlots(&algoGame.prefabManager);
-
-        for (u8 p = 0; p < 6; ++p) {
-            ScoringState_St scoring = {
-                .streakCount = algoGame.scoring.streakCount,
-                .streakGrace = algoGame.scoring.streakGrace,
-                .score = 0
-            };
-
-            Board_St attemptBoard = algoGame.board; // only swallow copy is needed
-
-            if (greedyPlaceAll(&attemptBoard, algoGame.prefabManager.slots, permutations[p], &scoring)) {
-                success = true;
-                f32 recordedScore = scoring.score + scoring.streakCount * 1000;
-                // log_debug("Recorded score: %f", recordedScore);
-                
-                if (bestAttemptScore < recordedScore) {
-                    bestAttemptScore = recordedScore;
-
-                    for (u8 i = 0; i < 3; ++i) {
-                        selectedPrefabs[i] = algoGame.prefabManager.slots[permutations[p][i]].prefab;
-                    }
-                }
+            // The search tries every order: a set drawn twice is searched once
+            sortTriple(candidates[c]);
+            bool drawnBefore = false;
+            for (u8 k = 0; k < c && !drawnBefore; ++k) {
+                drawnBefore = !memcmp(candidates[k], candidates[c], sizeof(candidates[c]));
             }
+            if (drawnBefore) continue;
+
+            PlacementSolution_St solution = polyBlast_solvePlacements(
+                boardMask, candidates[c],
+                game->scoring.streakCount, game->scoring.streakGrace,
+                PLACEMENT_SEARCH_SCORE_NODES
+            );
+
+            if (solution.verdict != PLACEMENT_SOLVABLE) continue;
+            if (success && solution.bestScore <= bestScore) continue;
+
+            success = true;
+            bestScore = solution.bestScore;
+            memcpy(selectedPrefabs, candidates[c], sizeof(selectedPrefabs));
         }
 
-        if (!success) {
-            if (attempt > 0 && attempt % 25 == 0) {
-                polyBlast_adjustSizeWeights(game, 0);
-            }
-        } 
+        // Nothing fits: lean towards smaller shapes for the next round
+        if (!success) polyBlast_adjustSizeWeights(game, 0);
     }
 
-    arena_reset(&tempArena);
-    contextArena = &globalArena;
-
     if (success) {
         shuffleArrayT(const Prefab_St *, selectedPrefabs, 3, rand);
         for (u8 i = 0; i < 3; ++i) {
@@ -0,0 +1,226 @@
+/**
+    @file solver.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Exhaustive placement search implementation.
+*/
+#include "core/solver.h"
+#include "core/bitboard.h"
+#include "core/game.h"
+
+#define VALUE_UNSOLVABLE (-1)
+#define VALUE_UNDECIDED  (-2)
+
+/**
+    @brief A searched state and its value.
+*/
+typedef struct {
+    u64 board;                  ///< Board mask of the state.
+    u32 stamp;                  ///< Search the entry belongs to.
+    s32 value;                  ///< Best value, or VALUE_UNSOLVABLE.
+    u8 remaining;               ///< Canonical set of the shapes left.
+    u8 streakCount;             ///< Streak of the state.
+    u8 streakGrace;             ///< Streak grace of the state.
+    bool exact;                 ///< false when the value is only the first solution found.
+} MemoEntry_St;
+
+/**
+    @brief The shapes of one search and its node count.
+*/
+typedef struct {
+    PlacementMasks_St placements[3];    ///< Placement masks of each shape.
+    u8 blockCounts[3];                  ///< Block count of each shape, for the score.
+    u8 twins[3];                        ///< Lowest slot holding the same shape.
+    u32 nodes;                          ///< States expanded so far.
+    u32 scoreNodes;                     ///< States searched for the best score.
+} Search_St;
+
+/**
+    @brief Value of a state and whether it is the best one or only a solution.
+*/
+typedef struct {
+    s32 value;
+    bool exact;
+} Outcome_St;
+
+static MemoEntry_St memo[PLACEMENT_SEARCH_MEMO_SIZE];
+static u32 memoStamp = 0;
+
+/**
+    @brief Renames the shapes left so that identical shapes always fill their lowest slots.
+
+    With two identical shapes, "first one left" and "second one left" are
+    the same state, and share a memo entry.
+
+    @param[in]     search       The search.
+    @param[in]     remaining    Set of the shapes left (bit i for slot i).
+    @return                     The canonical set.
+*/
+static u8 canonicalRemaining(const Search_St* const search, const u8 remaining) {
+    u8 canonical = 0;
+
+    for (u8 i = 0; i < 3; ++i) {
+        if (!(remaining & (1u << i))) continue;
+
+        u8 slot = search->twins[i];
+        while ((canonical & (1u << slot)) || search->twins[slot] != search->twins[i]) slot++;
+        canonical |= 1u << slot;
+    }
+
+    return canonical;
+}
+
+static MemoEntry_St* memoEntry(const u64 board, const u8 remaining, const u8 streakCount, const u8 streakGrace) {
+    u64 hash = board ^ ((u64) remaining << 56 | (u64) streakCount << 48 | (u64) streakGrace << 40);
+    hash *= 0x9E3779B97F4A7C15ull;
+    return &memo[(hash >> 32) & (PLACEMENT_SEARCH_MEMO_SIZE - 1)];
+}
+
+/**
+    @brief Best value reachable from a state, depth-first.
+
+    @param[in,out] search       The search.
+    @param[in]     board        Board mask, full lines already cleared.
+    @param[in]     remaining    Canonical set of the shapes left, not empty.
+    @param[in]     streakCount  Streak of the state.
+    @param[in]     streakGrace  Streak grace of the state.
+    @return                     The value, VALUE_UNSOLVABLE or VALUE_UNDECIDED.
+*/
+static Outcome_St searchState(Search_St* const search, const u64 board, const u8 remaining, const u8 streakCount, const u8 streakGrace) {
+    MemoEntry_St* entry = memoEntry(board, remaining, streakCount, streakGrace);
+    if (entry->stamp == memoStamp && entry->board == board && entry->remaining == remaining
+     && entry->streakCount == streakCount && entry->streakGrace == streakGrace) {
+        // A solution found in a hurry is not the best one, unless the search is in a hurry too
+        if (entry->exact || entry->value == VALUE_UNSOLVABLE || search->nodes >= search->scoreNodes) {
+            return (Outcome_St) {entry->value, entry->exact};
+        }
+    }
+
+    if (search->nodes >= PLACEMENT_SEARCH_MAX_NODES) return (Outcome_St) {VALUE_UNDECIDED, false};
+    search->nodes++;
+
+    Outcome_St best = {VALUE_UNSOLVABLE, true};
+    bool undecided = false;
+    bool settled = false;
+
+    for (u8 i = 0; i < 3 && !settled; ++i) {
+        if (!(remaining & (1u << i))) continue;
+
+        // Identical shapes fill their lowest slots first: only that one is expanded
+        if (search->twins[i] != i && (remaining & (1u << search->twins[i]))) continue;
+
+        const PlacementMasks_St* placements = &search->placements[i];
+        const u8 rest = canonicalRemaining(search, remaining & ~(1u << i));
+
+        for (u8 p = 0; p < placements->count && !settled; ++p) {
+            if (placements->masks[p] & board) continue;
+
+            const u64 placed = board | placements->masks[p];
+            u8 fullRows, fullColumns;
+            const u64 cleared = polyBlast_getFullLinesMask(placed, &fullRows, &fullColumns);
+            const u8 linesCleared = polyBlast_countCells(fullRows) + polyBlast_countCells(fullColumns);
+
+            // Same streak rules as polyBlast_manageScoreAndStreak()
+            u8 nextStreakCount = streakCount;
+            u8 nextStreakGrace = streakGrace;
+            s32 gain = search->blockCounts[i] * SCORE_PER_UNIT_PLACED;
+
+            if (linesCleared > 0) {
+                nextStreakCount++;
+                nextStreakGrace = (nextStreakCount + 1) / 2;
+                gain += (s32) (polyBlast_getLineClearScore(linesCleared) * nextStreakCount);
+            } else if (nextStreakGrace > 0 && --nextStreakGrace == 0) {
+                nextStreakCount = 0;
+            }
+
+            Outcome_St child = rest == 0
+                ? (Outcome_St) {nextStreakCount * PLACEMENT_SEARCH_STREAK_BONUS, true}
+                : searchState(search, placed & ~cleared, rest, nextStreakCount, nextStreakGrace);
+
+            if (child.value == VALUE_UNDECIDED) {
+                undecided = true;
+                continue;
+            }
+
+            if (child.value == VALUE_UNSOLVABLE) continue;
+
+            if (gain + child.value > best.value) best.value = gain + child.value;
+            best.exact &= child.exact;
+
+            // Out of score budget: this solution will do
+            if (search->nodes >= search->scoreNodes) {
+                best.exact = false;
+                settled = true;
+            }
+        }
+    }
+
+    if (undecided) {
+        if (best.value == VALUE_UNSOLVABLE) return (Outcome_St) {VALUE_UNDECIDED, false};
+        best.exact = false;
+    }
+
+    *entry = (MemoEntry_St) {
+        .board = board, .stamp = memoStamp, .value = best.value,
+        .remaining = remaining, .streakCount = streakCount, .streakGrace = streakGrace,
+        .exact = best.exact
+    };
+
+    return best;
+}
+
+/**
+    @brief Searches every order and placement of the given shapes on a board.
+
+    @param[in]     boardMask    Occupancy mask of the board.
+    @param[in]     prefabs      Shapes to place, NULL for a slot already placed.
+    @param[in]     streakCount  Current streak.
+    @param[in]     streakGrace  Placements left before the streak resets.
+    @param[in]     scoreNodes   States searched for the best score, 0 to only decide solvability.
+    @return                     The verdict, the best score found and the states expanded.
+*/
+PlacementSolution_St polyBlast_solvePlacements(const u64 boardMask, const Prefab_St* const prefabs[3],
+                                               const u8 streakCount, const u8 streakGrace, const u32 scoreNodes) {
+    Search_St search = { .scoreNodes = scoreNodes };
+    u64 shapeMasks[3] = {0};
+    u8 remaining = 0;
+
+    for (u8 i = 0; i < 3; ++i) {
+        search.twins[i] = i;
+        if (prefabs[i] == NULL) continue;
+
+        polyBlast_getPlacementMasks(prefabs[i], &search.placements[i]);
+        search.blockCounts[i] = prefabs[i]->blockCount;
+        shapeMasks[i] = polyBlast_getPrefabMask(prefabs[i]);
+        remaining |= 1u << i;
+
+        for (u8 j = 0; j < i; ++j) {
+            if (prefabs[j] != NULL && shapeMasks[j] == shapeMasks[i] && search.blockCounts[j] == search.blockCounts[i]) {
+                search.twins[i] = search.twins[j];
+                break;
+            }
+        }
+    }
+
+    if (remaining == 0) return (PlacementSolution_St) {.verdict = PLACEMENT_SOLVABLE};
+
+    // New stamp: the entries of the previous searches are stale
+    if (++memoStamp == 0) {
+        memset(memo, 0, sizeof(memo));
+        memoStamp = 1;
+    }
+
+    Outcome_St outcome = searchState(&search, boardMask, canonicalRemaining(&search, remaining), streakCount, streakGrace);
+
+    PlacementSolution_St solution = { .nodes = search.nodes };
+    if (outcome.value == VALUE_UNDECIDED) {
+        solution.verdict = PLACEMENT_UNDECIDED;
+    } else if (outcome.value == VALUE_UNSOLVABLE) {
+        solution.verdict = PLACEMENT_UNSOLVABLE;
+    } else {
+        solution.verdict = PLACEMENT_SOLVABLE;
+        solution.bestScore = (u32) outcome.value;
+    }
+
+    return solution;
+}
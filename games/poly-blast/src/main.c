@@ -2,7 +2,7 @@
     @file main.c
     @author Fshimi-Hawlk
     @date 2026-01-07
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Program entry point and main loop.
 */
 #include "core/shape.h"
@@ -62,7 +62,7 @@ int main(void) {
                 prevScore = polyBlast_game.scoring.score;
             }
 
-            if (polyBlast_testGameOver(polyBlast_game.board, polyBlast_game.prefabManager.slots)) {
+            if (polyBlast_testGameOver(&polyBlast_game.board, polyBlast_game.prefabManager.slots)) {
                 PlaySound(sound_gameOver);
                 polyBlast_game.gameOver = true;
 
@@ -78,7 +78,7 @@ void polyBlast_update(f32 dt) {
             polyBlast_game.scoring.prevScore = polyBlast_game.scoring.score;
         }
 
-        if (polyBlast_testGameOver(polyBlast_game.board, polyBlast_game.prefabManager.slots)) {
+        if (polyBlast_testGameOver(&polyBlast_game.board, polyBlast_game.prefabManager.slots)) {
             PlaySound(sound_gameOver);
             polyBlast_game.gameOver = true;
 
@@ -0,0 +1,148 @@
+/**
+    @file dealer.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Dealing latency on dense boards, the benchmark of the placement search.
+
+    For each density, deals --deals times on random boards filled to that
+    density (full lines cleared, as in a game): the slots are shuffled,
+    then polyBlast_placementSimulation() picks the set that surely fits,
+    then polyBlast_testGameOver() checks it like the game loop does every
+    frame. The boards come from their own generator, so a seed fills the
+    same boards whatever the dealing code draws: two builds compare on the
+    same positions.
+
+    Reported per density:
+        - dealing latency, mean and worst, in microseconds
+        - game-over test latency, mean and worst, in microseconds
+        - deals left without a set that fits (game over right away)
+
+    Not part of run-tests. Build and run it with `make dealer` /
+    `make run-dealer DEALER_ARGS="..."` from games/poly-blast.
+*/
+#include "core/board.h"
+#include "core/game.h"
+#include "core/placement.h"
+#include "core/shape.h"
+#include "setups/game.h"
+#include "setups/shape.h"
+
+#include "utils/globals.h"
+
+#include <time.h>
+
+typedef struct {
+    int deals;          ///< Deals per density.
+    int density;        ///< Percent of the cells filled, 0 for the 40..80 sweep.
+    u32 seed;           ///< Seed of the boards and of the draws.
+} DealerConfig_St;
+
+static bool parseArgs(int argc, char* argv[], DealerConfig_St* cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if      (strncmp(a, "--deals=", 8) == 0)           cfg->deals = atoi(a + 8);
+        else if (strncmp(a, "--density=", 10) == 0)        cfg->density = atoi(a + 10);
+        else if (strncmp(a, "--seed=", 7) == 0)            cfg->seed = (u32)strtoul(a + 7, NULL, 10);
+        else return false;
+    }
+    if (cfg->deals < 1) cfg->deals = 1;
+    return cfg->density >= 0 && cfg->density <= 100;
+}
+
+static void printUsage(const char* self, const DealerConfig_St* cfg) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --deals=N            deals per density (default %d)\n"
+        "  --density=P          percent of the cells filled, 0 = 40 to 80 by 10 (default %d)\n"
+        "  --seed=N             seed of the boards and of the draws (default %u)\n",
+        self, cfg->deals, cfg->density, cfg->seed);
+}
+
+/* xorshift32: the boards do not depend on how many times the dealing calls rand() */
+static u32 nextRandom(u32* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void fillBoard(Board_St* board, const int density, u32* state) {
+    for (u8 r = 0; r < board->height; ++r) {
+        for (u8 c = 0; c < board->width; ++c) {
+            board->blocks[r][c].hitsLeft = (int)(nextRandom(state) % 100) < density;
+        }
+    }
+
+    polyBlast_updateBoardClearing(board);
+    polyBlast_clearBoard(board);
+}
+
+static double elapsedMicroseconds(const clock_t start) {
+    return (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+}
+
+static void benchDensity(PolyBlastGame_St* game, const SizeWeight_St* weights, const DealerConfig_St* cfg, const int density) {
+    u32 boardState = cfg->seed * 2654435761u + (u32)density;
+    if (boardState == 0) boardState = 1;
+    srand(cfg->seed + (u32)density);
+
+    double dealTotal = 0.0, dealWorst = 0.0;
+    double testTotal = 0.0, testWorst = 0.0;
+    int stuck = 0;
+
+    for (int n = 0; n < cfg->deals; ++n) {
+        fillBoard(&game->board, density, &boardState);
+        game->prefabManager.sizeWeights = *weights;
+
+        clock_t start = clock();
+        polyBlast_shuffleSlots(&game->prefabManager);
+        polyBlast_placementSimulation(game);
+        double deal = elapsedMicroseconds(start);
+
+        start = clock();
+        bool gameOver = polyBlast_testGameOver(&game->board, game->prefabManager.slots);
+        double test = elapsedMicroseconds(start);
+
+        dealTotal += deal;
+        testTotal += test;
+        if (deal > dealWorst) dealWorst = deal;
+        if (test > testWorst) testWorst = test;
+        stuck += gameOver;
+    }
+
+    printf("[DEALER] %3d%% filled: deal %8.1f us mean %9.1f us worst | game over test %7.1f us mean %8.1f us worst | %5.1f%% stuck\n",
+           density, dealTotal / cfg->deals, dealWorst, testTotal / cfg->deals, testWorst, 100.0 * stuck / cfg->deals);
+}
+
+int main(int argc, char* argv[]) {
+    DealerConfig_St cfg = {.deals = 2000, .density = 0, .seed = 1};
+    if (!parseArgs(argc, argv, &cfg)) {
+        cfg = (DealerConfig_St) {.deals = 2000, .density = 0, .seed = 1};
+        printUsage(argv[0], &cfg);
+        return 2;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    srand(cfg.seed);
+
+    PolyBlastGame_St game = {0};
+    game.board.width = game.board.height = BOARD_WIDTH;
+    polyBlast_initBoard(&game.board);
+    polyBlast_initPrefabsAndVariants(&polyBlast_prefabsBag, GAME_PREFAB_VARIANT_DEFAULT);
+    polyBlast_initPrefabManager(&game.prefabManager);
+    const SizeWeight_St weights = game.prefabManager.sizeWeights;
+
+    printf("[DEALER] %d deals per density, seed %u\n", cfg.deals, cfg.seed);
+    if (cfg.density > 0) {
+        benchDensity(&game, &weights, &cfg, cfg.density);
+    } else {
+        for (int density = 40; density <= 80; density += 10) {
+            benchDensity(&game, &weights, &cfg, density);
+        }
+    }
+
+    arena_free(&tempArena);
+    arena_free(&globalArena);
+
+    return 0;
+}
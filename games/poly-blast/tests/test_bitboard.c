@@ -0,0 +1,166 @@
+/**
+    @file test_bitboard.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Unit tests for the board occupancy mask and the placement masks.
+
+    Every mask result is checked against the block-walking rules it replaces.
+*/
+
+#include "core/bitboard.h"
+#include "core/board.h"
+#include "core/game.h"
+#include "core/placement.h"
+#include "setups/game.h"
+#include "setups/shape.h"
+
+#include "utils/globals.h"
+
+#include <assert.h>
+
+static Board_St makeBoard(void) {
+    Board_St board = {.width = BOARD_WIDTH, .height = BOARD_HEIGHT};
+    polyBlast_initBoard(&board);
+    return board;
+}
+
+/* Fills cells at random, about `percent` out of 100, some as non-rendered blocks */
+static void fillRandomly(Board_St* const board, const u8 percent) {
+    for (u8 r = 0; r < board->height; ++r) {
+        for (u8 c = 0; c < board->width; ++c) {
+            board->blocks[r][c].hitsLeft = rand() % 100 < percent ? (rand() % 8 == 0 ? -1 : 1) : 0;
+        }
+    }
+}
+
+static void test_board_mask(void) {
+    Board_St board = makeBoard();
+    assert(polyBlast_getBoardMask(&board) == 0);
+    assert(polyBlast_getEmptyCellCount(&board) == 64);
+
+    board.blocks[0][0].hitsLeft = 1;
+    board.blocks[2][5].hitsLeft = -1;   // Not rendered, still not empty
+    board.blocks[7][7].hitsLeft = 3;
+    assert(polyBlast_getBoardMask(&board) == ((1ull << 0) | (1ull << (2 * 8 + 5)) | (1ull << 63)));
+    assert(polyBlast_getEmptyCellCount(&board) == 61);
+    log_info("OK - board mask");
+}
+
+static void test_full_lines_mask(void) {
+    // Every set of full rows, then of full columns
+    for (u32 lines = 0; lines < 256; ++lines) {
+        u64 rowsMask = 0, columnsMask = 0;
+        for (u8 i = 0; i < 8; ++i) {
+            if (lines & (1u << i)) {
+                rowsMask |= BOARD_MASK_ROW << (i * 8);
+                columnsMask |= BOARD_MASK_COLUMN << i;
+            }
+        }
+
+        u8 fullRows, fullColumns;
+        assert(polyBlast_getFullLinesMask(rowsMask, &fullRows, &fullColumns) == rowsMask);
+        assert(fullRows == lines && fullColumns == (lines == 255 ? 255 : 0));
+
+        assert(polyBlast_getFullLinesMask(columnsMask, &fullRows, &fullColumns) == columnsMask);
+        assert(fullColumns == lines && fullRows == (lines == 255 ? 255 : 0));
+    }
+
+    // Random boards against the block walk
+    Board_St board = makeBoard();
+    for (u32 n = 0; n < 2000; ++n) {
+        fillRandomly(&board, 70 + n % 30);
+        polyBlast_updateBoardClearing(&board);
+
+        u64 expected = 0;
+        for (u8 r = 0; r < 8; ++r) {
+            bool full = true;
+            for (u8 c = 0; c < 8; ++c) full &= board.blocks[r][c].hitsLeft != 0;
+            assert(board.rowsToClear[r] == full);
+            if (full) expected |= BOARD_MASK_ROW << (r * 8);
+        }
+
+        for (u8 c = 0; c < 8; ++c) {
+            bool full = true;
+            for (u8 r = 0; r < 8; ++r) full &= board.blocks[r][c].hitsLeft != 0;
+            assert(board.columnsToClear[c] == full);
+            if (full) expected |= BOARD_MASK_COLUMN << c;
+        }
+
+        assert(polyBlast_getFullLinesMask(polyBlast_getBoardMask(&board), NULL, NULL) == expected);
+    }
+    log_info("OK - full lines mask");
+}
+
+static void test_placement_masks(void) {
+    Board_St board = makeBoard();
+
+    for (u32 n = 0; n < 200; ++n) {
+        fillRandomly(&board, n % 100);
+        const u64 boardMask = polyBlast_getBoardMask(&board);
+
+        for (u32 p = 0; p < polyBlast_prefabsBag.count; ++p) {
+            const Prefab_St* prefab = &polyBlast_prefabsBag.items[p];
+            const Shape_St shape = {.prefab = prefab};
+
+            PlacementMasks_St placements;
+            polyBlast_getPlacementMasks(prefab, &placements);
+            assert(placements.count == (BOARD_WIDTH - prefab->width + 1) * (BOARD_HEIGHT - prefab->height + 1));
+
+            for (u8 i = 0; i < placements.count; ++i) {
+                s8Vector2 anchor = {placements.anchors[i].x, placements.anchors[i].y};
+                u64 cells = 0;
+                for (u8 b = 0; b < prefab->blockCount; ++b) {
+                    cells |= 1ull << ((anchor.y + prefab->offsets[b].y) * 8 + anchor.x + prefab->offsets[b].x);
+                }
+
+                assert(placements.masks[i] == cells);
+                assert(((placements.masks[i] & boardMask) == 0) == polyBlast_isShapePlaceable(&shape, anchor, &board));
+            }
+        }
+    }
+    log_info("OK - placement masks");
+}
+
+static void test_can_place_all(void) {
+    static const u8 order[3] = {0, 1, 2};
+    Board_St board = makeBoard();
+
+    Shape_St shapes[3] = {
+        {.prefab = &polyBlast_prefabsBag.items[0]},
+        {.prefab = &polyBlast_prefabsBag.items[0]},
+        {.prefab = &polyBlast_prefabsBag.items[1]}
+    };
+
+    assert(polyBlast_canPlaceAll(&board, shapes, order, 0));
+    assert(!polyBlast_testGameOver(&board, shapes));
+
+    // One free cell: the first 1x1 fits, the second only because the first one clears its row and column
+    fillRandomly(&board, 100);
+    board.blocks[3][4].hitsLeft = 0;
+    shapes[2].placed = true;
+    assert(polyBlast_canPlaceAll(&board, shapes, order, 0));
+
+    // Nothing fits a full board
+    board.blocks[3][4].hitsLeft = 1;
+    assert(!polyBlast_canPlaceAll(&board, shapes, order, 0));
+    assert(polyBlast_testGameOver(&board, shapes));
+    log_info("OK - canPlaceAll on masks");
+}
+
+int main(void) {
+    SetTraceLogLevel(LOG_WARNING);
+    srand(42);
+
+    polyBlast_initPrefabsAndVariants(&polyBlast_prefabsBag, GAME_PREFAB_VARIANT_COMPLETE);
+
+    test_board_mask();
+    test_full_lines_mask();
+    test_placement_masks();
+    test_can_place_all();
+
+    arena_free(&tempArena);
+    arena_free(&globalArena);
+
+    log_info("Bitboard tests passed");
+    return 0;
+}
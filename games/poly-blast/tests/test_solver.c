@@ -0,0 +1,223 @@
+/**
+    @file test_solver.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Unit tests for the placement search, against a brute force on the real board.
+
+    The brute force plays every order and every placement with the game's own
+    functions (placeShape, clearBoard, manageScoreAndStreak), so it checks the
+    search's verdict and its scoring rules at once.
+*/
+
+#include "core/bitboard.h"
+#include "core/board.h"
+#include "core/game.h"
+#include "core/placement.h"
+#include "core/shape.h"
+#include "core/solver.h"
+#include "setups/game.h"
+#include "setups/shape.h"
+
+#include "utils/globals.h"
+
+#include <assert.h>
+
+static Board_St makeBoard(void) {
+    Board_St board = {.width = BOARD_WIDTH, .height = BOARD_HEIGHT};
+    polyBlast_initBoard(&board);
+    return board;
+}
+
+/* Fills about `percent` out of 100 cells, without full lines left */
+static void fillRandomly(Board_St* const board, const u8 percent) {
+    for (u8 r = 0; r < board->height; ++r) {
+        for (u8 c = 0; c < board->width; ++c) {
+            board->blocks[r][c].hitsLeft = rand() % 100 < percent;
+        }
+    }
+
+    polyBlast_updateBoardClearing(board);
+    polyBlast_clearBoard(board);
+}
+
+/* Best search value of the shapes left, -1 when they cannot all be placed */
+static s64 bruteForce(const Board_St* const board, const Shape_St shapes[3], const u8 remaining, const ScoringState_St scoring) {
+    if (remaining == 0) return (s64) scoring.score + scoring.streakCount * PLACEMENT_SEARCH_STREAK_BONUS;
+
+    s64 best = -1;
+    for (u8 i = 0; i < 3; ++i) {
+        if (!(remaining & (1u << i))) continue;
+
+        for (s8 y = 0; y < BOARD_HEIGHT; ++y) {
+            for (s8 x = 0; x < BOARD_WIDTH; ++x) {
+                if (!polyBlast_isShapePlaceable(&shapes[i], (s8Vector2) {x, y}, board)) continue;
+
+                Board_St next = *board;
+                ScoringState_St nextScoring = scoring;
+                polyBlast_placeShape(&shapes[i], (u8Vector2) {x, y}, &next);
+                if (polyBlast_checkBoardForClearing(&next)) polyBlast_clearBoard(&next);
+                polyBlast_manageScoreAndStreak(&nextScoring, &next, shapes[i].prefab->blockCount);
+
+                s64 value = bruteForce(&next, shapes, remaining & ~(1u << i), nextScoring);
+                if (value > best) best = value;
+            }
+        }
+    }
+
+    return best;
+}
+
+static void drawShapes(Shape_St shapes[3], const Prefab_St* prefabs[3], const bool twins) {
+    for (u8 i = 0; i < 3; ++i) {
+        u32 index = rand() % polyBlast_prefabsBag.count;
+        if (twins && i == 2) index = shapes[0].prefab - polyBlast_prefabsBag.items;
+
+        shapes[i] = (Shape_St) {.prefab = &polyBlast_prefabsBag.items[index], .id = i};
+        prefabs[i] = shapes[i].prefab;
+    }
+}
+
+static void test_against_brute_force(void) {
+    Board_St board = makeBoard();
+    u32 solvable = 0, unsolvable = 0;
+
+    for (u32 n = 0; n < 300; ++n) {
+        fillRandomly(&board, 55 + n % 20);
+
+        Shape_St shapes[3];
+        const Prefab_St* prefabs[3];
+        drawShapes(shapes, prefabs, n % 3 == 0);
+
+        ScoringState_St scoring = {.streakCount = n % 4, .streakGrace = n % 3};
+        s64 expected = bruteForce(&board, shapes, 0x7, (ScoringState_St) {.streakCount = scoring.streakCount, .streakGrace = scoring.streakGrace});
+
+        u64 boardMask = polyBlast_getBoardMask(&board);
+        PlacementSolution_St best = polyBlast_solvePlacements(boardMask, prefabs, scoring.streakCount, scoring.streakGrace, PLACEMENT_SEARCH_MAX_NODES);
+        PlacementSolution_St any = polyBlast_solvePlacements(boardMask, prefabs, 0, 0, 0);
+
+        assert(best.verdict != PLACEMENT_UNDECIDED && any.verdict == best.verdict);
+        assert((best.verdict == PLACEMENT_SOLVABLE) == (expected >= 0));
+        assert(polyBlast_testGameOver(&board, shapes) == (expected < 0));
+
+        if (expected >= 0) {
+            assert(best.bestScore == expected);
+            assert(any.bestScore <= expected);
+            solvable++;
+        } else {
+            unsolvable++;
+        }
+    }
+
+    assert(solvable > 0 && unsolvable > 0);
+    log_info("OK - %u solvable and %u unsolvable triples match the brute force", solvable, unsolvable);
+}
+
+static const Prefab_St* findPrefab(const u8 width, const u8 height, const u8 blockCount) {
+    for (u32 p = 0; p < polyBlast_prefabsBag.count; ++p) {
+        const Prefab_St* prefab = &polyBlast_prefabsBag.items[p];
+        if (prefab->width == width && prefab->height == height && prefab->blockCount == blockCount) return prefab;
+    }
+
+    assert(false && "No such prefab");
+    return NULL;
+}
+
+static void test_placed_slots_skipped(void) {
+    // Checkerboard: every line has free cells, no 2x2 square is free
+    Board_St board = makeBoard();
+    for (u8 r = 0; r < 8; ++r) for (u8 c = 0; c < 8; ++c) board.blocks[r][c].hitsLeft = (r + c) % 2 == 0;
+
+    const Prefab_St* single = findPrefab(1, 1, 1);
+    Shape_St shapes[3] = {
+        {.prefab = single},
+        {.prefab = single},
+        {.prefab = findPrefab(2, 2, 4)}
+    };
+    assert(polyBlast_testGameOver(&board, shapes));
+
+    shapes[2].placed = true;
+    assert(!polyBlast_testGameOver(&board, shapes));
+
+    shapes[0].placed = shapes[1].placed = true;
+    assert(!polyBlast_testGameOver(&board, shapes));
+
+    shapes[2].placed = false;
+    assert(polyBlast_testGameOver(&board, shapes));
+    log_info("OK - placed slots are skipped");
+}
+
+static void test_dealing(void) {
+    PolyBlastGame_St game = {0};
+    game.board.width = game.board.height = BOARD_WIDTH;
+    polyBlast_initBoard(&game.board);
+    polyBlast_initPrefabManager(&game.prefabManager);
+
+    for (u32 n = 0; n < 100; ++n) {
+        fillRandomly(&game.board, n % 70);
+        polyBlast_shuffleSlots(&game.prefabManager);
+
+        const Prefab_St* dealt[3];
+        for (u8 i = 0; i < 3; ++i) dealt[i] = game.prefabManager.slots[i].prefab;
+        bool dealtFits = polyBlast_solvePlacements(polyBlast_getBoardMask(&game.board), dealt, 0, 0, 0).verdict == PLACEMENT_SOLVABLE;
+
+        polyBlast_placementSimulation(&game);
+
+        // The dealt set fits: whatever replaces it fits too
+        if (dealtFits) assert(!polyBlast_testGameOver(&game.board, game.prefabManager.slots));
+
+        for (u8 i = 0; i < 3; ++i) {
+            assert(game.prefabManager.slots[i].id == i && !game.prefabManager.slots[i].placed);
+        }
+    }
+    log_info("OK - dealt sets always fit when one could");
+}
+
+static void test_dealing_from_bags(void) {
+    PolyBlastGame_St game = {0};
+    game.board.width = game.board.height = BOARD_WIDTH;
+    polyBlast_initBoard(&game.board);
+    polyBlast_initPrefabManager(&game.prefabManager);
+
+    // Free 2x2 squares and two lone cells: no 3x3 fits, dominoes do either way
+    for (u8 r = 0; r < 8; ++r) {
+        for (u8 c = 0; c < 8; ++c) {
+            bool free = (r % 3 < 2 && c % 3 < 2) || (r == 2 && c == 2) || (r == 5 && c == 5);
+            game.board.blocks[r][c].hitsLeft = !free;
+        }
+    }
+
+    // Every bag spent but the dominoes', down to the vertical one
+    const Prefab_St* vertical = findPrefab(1, 2, 2);
+    for (u8 s = 0; s < MAX_SHAPE_SIZE; ++s) game.prefabManager.bags[s].count = 0;
+    game.prefabManager.bags[1].items[0] = vertical - polyBlast_prefabsBag.items;
+    game.prefabManager.bags[1].count = 1;
+
+    for (u32 n = 0; n < 50; ++n) {
+        const Prefab_St* square = findPrefab(3, 3, 9);
+        for (u8 i = 0; i < 3; ++i) game.prefabManager.slots[i] = (Shape_St) {.prefab = square, .id = i};
+
+        polyBlast_placementSimulation(&game);
+
+        for (u8 i = 0; i < 3; ++i) assert(game.prefabManager.slots[i].prefab == vertical);
+        assert(game.prefabManager.bags[1].count == 1);
+    }
+    log_info("OK - draws come from what the bags still hold");
+}
+
+int main(void) {
+    SetTraceLogLevel(LOG_WARNING);
+    srand(42);
+
+    polyBlast_initPrefabsAndVariants(&polyBlast_prefabsBag, GAME_PREFAB_VARIANT_DEFAULT);
+
+    test_against_brute_force();
+    test_placed_slots_skipped();
+    test_dealing();
+    test_dealing_from_bags();
+
+    arena_free(&tempArena);
+    arena_free(&globalArena);
+
+    log_info("Solver tests passed");
+    return 0;
+}
@@ -2,7 +2,7 @@
     @file algo.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief AI algorithms for Tetris move optimization and board evaluation.
 */
 
@@ -30,6 +30,33 @@ void tetrominoFall_copyBoard(Board_t src, Board_t dest);
 */
 int tetrominoFall_evaluateBoard(Board_t board);
 
+/**
+    @brief Same as tetrominoFall_evaluateBoard(), on the occupancy bitboard.
+
+    @param[in] bits  The occupancy to evaluate.
+    @return          The calculated score for the board state.
+*/
+int tetrominoFall_evaluateBitboard(const BitBoard_St* bits);
+
+/**
+    @brief Weighted sum of the board features, the weights given by the caller.
+
+    @param[in] bits          The occupancy to evaluate.
+    @param[in] linesCleared  Lines already cleared on the way to this board, weighed with the full lines left.
+    @param[in] weights       Weight of each feature.
+    @return                  The score, higher is better.
+*/
+float tetrominoFall_evaluateWeighted(const BitBoard_St* bits, int linesCleared, const AiWeights_St* weights);
+
+/**
+    @brief Number of boards evaluated since the start, by either evaluation.
+
+    The headless simulation reports it: the cost of the AI is mostly there.
+
+    @return  The count.
+*/
+u64 tetrominoFall_evaluationCount(void);
+
 /**
     @brief Simulates dropping a piece in a specific column.
 
@@ -43,7 +70,9 @@ int tetrominoFall_simulateDrop(Board_t board, BoardShape_St piece, int col);
 /**
     @brief Finds the best move for the current and next shape.
 
-    Uses a look-ahead of one piece to evaluate all possible rotations and columns.
+    Plans both pieces with tetrominoFall_planMove(), the default weights and
+    a beam of AI_BEAM_WIDTH boards: the next shape lands on the board left
+    by the current one, full lines cleared.
 
     @param[in] board      The current board state.
     @param[in] shape      The current shape to place.
@@ -0,0 +1,107 @@
+/**
+    @file bitboard.h
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Occupancy bitboard of the Tetris board, for the AI.
+
+    The Color grid stays the rendering model; the AI reads a BitBoard_St
+    built from it once per decision. Every query is a few bit operations
+    on row words: collision is an AND of the shape masks shifted to the
+    column, a full line is a compare with BOARD_FULL_ROW, and the column
+    heights and holes come from one pass down the rows.
+*/
+
+#ifndef CORE_BITBOARD_H
+#define CORE_BITBOARD_H
+
+#include "utils/types.h"
+
+/**
+    @brief Board features the evaluation weighs.
+*/
+typedef struct {
+    int holes;              // Empty cells below the top block of their column
+    int aggregateHeight;    // Sum of the column heights
+    int bumpiness;          // Sum of the height differences of neighbouring columns
+    int maxHeight;
+    int completeLines;
+    int rowTransitions;     // Filled/empty changes along the rows, the walls counting as filled
+    int columnTransitions;  // Filled/empty changes down the columns, the floor counting as filled
+} BoardFeatures_St;
+
+/**
+    @brief Builds the occupancy bitboard of a Color board.
+
+    @param[in]  board  The board to read.
+    @param[out] bits   The occupancy.
+*/
+void tetrominoFall_bitboardFromBoard(Board_t board, BitBoard_St* bits);
+
+/**
+    @brief Builds the row masks of a shape in its current rotation.
+
+    @param[in]  boardShape  The shape (its position is ignored).
+    @param[out] mask        The masks and bounding box.
+*/
+void tetrominoFall_shapeMaskFrom(const BoardShape_St* boardShape, ShapeMask_St* mask);
+
+/**
+    @brief Checks whether a shape box at (left, top) hits a block, a wall or the floor.
+
+    Rows above the board never collide, like tetrominoFall_isCollidingAt().
+
+    @param[in] bits  The occupancy.
+    @param[in] mask  The shape.
+    @param[in] left  Column of the box's left edge.
+    @param[in] top   Row of the box's top edge (may be negative).
+    @return          True on collision.
+*/
+static inline bool tetrominoFall_bitboardCollides(const BitBoard_St* bits, const ShapeMask_St* mask, int left, int top) {
+    if (left < 0 || left + mask->width > BOARD_WIDTH || top + mask->height > BOARD_HEIGHT) return true;
+
+    for (int i = 0; i < mask->height; i++) {
+        int y = top + i;
+        if (y >= 0 && (bits->rows[y] & (BitRow_t)(mask->rows[i] << left))) return true;
+    }
+
+    return false;
+}
+
+/**
+    @brief Drops a shape box straight down from `top` in a column.
+
+    @param[in] bits  The occupancy.
+    @param[in] mask  The shape.
+    @param[in] left  Column of the box's left edge.
+    @param[in] top   Row the drop starts from.
+    @return          Row of the box's top edge once landed, or `top` - 1 if it collides at once.
+*/
+int tetrominoFall_bitboardDrop(const BitBoard_St* bits, const ShapeMask_St* mask, int left, int top);
+
+/**
+    @brief Sets the cells of a shape box at (left, top); rows above the board are dropped.
+
+    @param[in,out] bits  The occupancy.
+    @param[in]     mask  The shape.
+    @param[in]     left  Column of the box's left edge.
+    @param[in]     top   Row of the box's top edge.
+*/
+void tetrominoFall_bitboardPlace(BitBoard_St* bits, const ShapeMask_St* mask, int left, int top);
+
+/**
+    @brief Removes the full lines, shifting the rows above down.
+
+    @param[in,out] bits  The occupancy.
+    @return              Number of lines cleared.
+*/
+int tetrominoFall_bitboardClearLines(BitBoard_St* bits);
+
+/**
+    @brief Computes the evaluation features in one pass down the rows.
+
+    @param[in]  bits      The occupancy.
+    @param[out] features  The features.
+*/
+void tetrominoFall_bitboardFeatures(const BitBoard_St* bits, BoardFeatures_St* features);
+
+#endif // CORE_BITBOARD_H
@@ -2,7 +2,7 @@
     @file game.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Game logic and movement functions for Tetris.
 */
 
@@ -19,8 +19,23 @@
     @param[in,out] speed        The current game speed/timing state.
     @param[in,out] boardShape   The shape to move.
     @param[in]     targetMove   The target position and rotation.
+    @param[in]     dt           Delta time between frames.
 */
-void tetrominoFall_automaticMovementTo(Speed_St* speed, BoardShape_St* boardShape, MoveAlgoResult_St targetMove);
+void tetrominoFall_automaticMovementTo(Speed_St* speed, BoardShape_St* boardShape, MoveAlgoResult_St targetMove, float dt);
+
+/**
+    @brief Applies the rules once the piece has moved for this frame.
+
+    A piece that went through the floor or a block is put back one row up
+    and locked, and the next one is dealt; then the full lines are cleared,
+    the score updated, and the drop sped up every 10 lines. Nothing else
+    happens while the piece falls. Needs no window:
+    the game and the headless simulation (simulation.h) share it.
+
+    @param[in,out] game  The game state.
+    @return              Whether the piece is still falling, locked, or locked with no room left.
+*/
+GameStep_Et tetrominoFall_settleShape(TetrominoFallGame_St* game);
 
 /**
     @brief Handles manual player movement based on input.
@@ -0,0 +1,41 @@
+/**
+    @file planner.h
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Beam-search planner placing the current piece with the preview pieces in mind.
+
+    The planner drops the pieces one after the other on occupancy bitboards.
+    After each piece it keeps the `beamWidth` best boards, scored by an
+    AiWeights_St, and expands only those with the next piece; the move
+    played is the first placement of the best board after the last piece.
+
+    Work is shared where the result is the same:
+        - the rotations of a piece with the same cells (O: 1, I/S/Z: 2) are
+          tried once,
+        - boards reached twice after the same pieces (the same placements in
+          another order, or different placements filling the same cells) are
+          kept and evaluated once.
+*/
+
+#ifndef CORE_PLANNER_H
+#define CORE_PLANNER_H
+
+#include "utils/types.h"
+
+/**
+    @brief Plans the placement of pieces[0], looking at the previews after it.
+
+    Each piece is dropped straight down from row 0, as tetrominoFall_findBestMove()
+    does. A preview piece that cannot spawn at its position ends that line
+    of play; full lines are cleared after every piece.
+
+    @param[in] bits    The occupancy, without the current piece.
+    @param[in] pieces  The current piece then the previews, each in the rotation it spawns with.
+    @param[in] count   Number of pieces (1 to PLANNER_MAX_PIECES).
+    @param[in] config  Weights and beam width.
+    @return            Position and rotation (the `rotation` field once turned) of the current
+                       piece, or a rotation of -1 when it has nowhere to land.
+*/
+MoveAlgoResult_St tetrominoFall_planMove(const BitBoard_St* bits, const BoardShape_St pieces[], int count, const PlannerConfig_St* config);
+
+#endif // CORE_PLANNER_H
@@ -2,7 +2,7 @@
     @file shape.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Core logic for tetromino shapes and their transformations.
 */
 #ifndef CORE_SHAPE_H
@@ -53,6 +53,22 @@
 */
 void tetrominoFall_randomShape(BoardShape_St* boardShape);
 
+/**
+    @brief Seeds a piece generator.
+
+    @param[out]    generator    The generator.
+    @param[in]     seed         Any value; equal seeds deal equal pieces.
+*/
+void tetrominoFall_seedShapes(PieceGenerator_St* generator, u32 seed);
+
+/**
+    @brief Deals the next piece of a generator, unrotated at its spawn position.
+
+    @param[in,out] generator    The generator.
+    @param[out]    boardShape   The shape to initialize.
+*/
+void tetrominoFall_nextShape(PieceGenerator_St* generator, BoardShape_St* boardShape);
+
 /**
     @brief Rotates the given shape clockwise.
 
@@ -0,0 +1,72 @@
+/**
+    @file simulation.h
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Headless AI games: seeded pieces, a fixed frame time, no window.
+
+    A simulated game runs the same rules as the windowed one: the AI steers
+    the piece with tetrominoFall_automaticMovementTo() and
+    tetrominoFall_settleShape() locks it, clears the lines and deals the
+    next piece. The frame time is a constant instead of raylib's clock and
+    the pieces come from a seeded PieceGenerator_St, so a seed always plays
+    the same game. That makes the totals comparable from one build to the
+    next: it is the regression benchmark of the AI and board code
+    (`make run-simulator`).
+*/
+
+#ifndef CORE_SIMULATION_H
+#define CORE_SIMULATION_H
+
+#include "utils/types.h"
+
+/**
+    @brief Settings of a batch of simulated games.
+*/
+typedef struct {
+    u32 seed;                       // Game g is dealt from seed + g
+    int games;
+    int maxPieces;                  // Pieces per game at most, 0: until the top-out
+    float step;                     // Fixed frame time, in seconds
+    float dropDuration;             // Seconds per row of the AI-driven piece
+    PlannerConfig_St planner;       // Plans the current and next pieces
+} SimulationConfig_St;
+
+/**
+    @brief Totals of a batch of simulated games.
+*/
+typedef struct {
+    u64 games;
+    u64 pieces;                     // Pieces locked
+    u64 lines;
+    u64 score;
+    u64 frames;                     // Fixed steps run
+    u64 evaluations;                // Boards the AI evaluated
+    double cpuSeconds;
+} SimulationStats_St;
+
+/**
+    @brief Default settings: 60 frames per second, the AI dropping a row every frame.
+
+    @param[out] config  The settings.
+*/
+void tetrominoFall_defaultSimulation(SimulationConfig_St* config);
+
+/**
+    @brief Plays one game from a fresh board until the top-out or config->maxPieces.
+
+    @param[out]    game    The game state, left as the game ended.
+    @param[in]     config  The settings.
+    @param[in]     seed    Seed of the pieces.
+    @param[in,out] stats   Totals the game is added to (cpuSeconds untouched).
+*/
+void tetrominoFall_simulateGame(TetrominoFallGame_St* game, const SimulationConfig_St* config, u32 seed, SimulationStats_St* stats);
+
+/**
+    @brief Plays config->games games and totals them, CPU time included.
+
+    @param[in]  config  The settings.
+    @param[out] stats   The totals.
+*/
+void tetrominoFall_simulate(const SimulationConfig_St* config, SimulationStats_St* stats);
+
+#endif // CORE_SIMULATION_H
@@ -2,7 +2,7 @@
     @file configs.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Configuration constants for the Tetromino Fall game.
 */
 #ifndef UTILS_CONFIGS_H
@@ -21,6 +21,11 @@
 
 #define BOARD_WIDTH 10                  ///< Tetris board width in cells.
 #define BOARD_HEIGHT 20                 ///< Tetris board height in cells.
+#define BOARD_FULL_ROW ((1u << BOARD_WIDTH) - 1)    ///< Occupancy bits of a full line.
+
+#define PLANNER_MAX_PIECES 8            ///< Pieces the planner looks at: the current one and the previews.
+#define PLANNER_MAX_BEAM 256            ///< Cap of the planner beam width.
+#define AI_BEAM_WIDTH 16                ///< Beam width of the in-game AI.
 
 #define CELL_SIZE 25                    ///< Size of each cell in pixels.
 
@@ -2,7 +2,7 @@
     @file globals.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief External global variables for the Tetromino Fall game.
 */
 #ifndef UTILS_GLOBALS_H
@@ -15,4 +15,6 @@ extern InputRepeat_St inputRepeat;      ///< Global state for input key repetiti
 extern Color tetraminosColors[];        ///< Predefined colors for each tetromino shape.
 extern Tetromino_t tetraminosShapes[];    ///< Predefined shapes for each tetromino type.
 
+extern const AiWeights_St defaultAiWeights; ///< Weights of the in-game AI (see `make tuner`).
+
 #endif
@@ -2,7 +2,7 @@
     @file types.h
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Type definitions for the Tetromino Fall game, including shapes, board, and game state structures.
 */
 #ifndef UTILS_TYPES_H
@@ -21,6 +21,62 @@ typedef iVector2 Tetromino_t[4];
 typedef Color Board_t[BOARD_HEIGHT][BOARD_WIDTH];
 
 
+/**
+    @brief Occupancy of one board row: bit x is set when column x is filled.
+*/
+typedef u16 BitRow_t;
+
+/**
+    @brief Occupancy-only copy of the board, one word per row (row 0 at the top).
+
+    The AI works on this instead of the Color grid: a collision is an AND
+    per row, a full line a compare, and a copy is 40 bytes.
+*/
+typedef struct {
+    BitRow_t rows[BOARD_HEIGHT];
+} BitBoard_St;
+
+/**
+    @brief Cells of one rotation of a tetromino, as row masks of its bounding box.
+
+    Shifting the masks left by a column index places the box there.
+*/
+typedef struct {
+    BitRow_t rows[4];               // Row masks, top row first, bit 0 = left column of the box
+    int width;
+    int height;
+    iVector2 pivot;                 // Piece position relative to the box's top-left cell
+} ShapeMask_St;
+
+/**
+    @brief Board features the AI weighs, as indices into AiWeights_St.
+*/
+typedef enum {
+    AI_FEATURE_HOLES,
+    AI_FEATURE_AGGREGATE_HEIGHT,
+    AI_FEATURE_BUMPINESS,
+    AI_FEATURE_MAX_HEIGHT,
+    AI_FEATURE_LINES,               // Lines cleared on the way, plus the full lines left
+    AI_FEATURE_ROW_TRANSITIONS,
+    AI_FEATURE_COLUMN_TRANSITIONS,
+    AI_FEATURE_COUNT
+} AiFeature_Et;
+
+/**
+    @brief Weight of each board feature in the AI evaluation; a score is their weighted sum.
+*/
+typedef struct {
+    float weights[AI_FEATURE_COUNT];
+} AiWeights_St;
+
+/**
+    @brief Settings of the beam-search planner.
+*/
+typedef struct {
+    const AiWeights_St* weights;    // NULL: defaultAiWeights
+    int beamWidth;                  // Boards kept after each piece, at most PLANNER_MAX_BEAM
+} PlannerConfig_St;
+
 /**
     @brief Identifiers for each of the seven standard tetromino shapes.
 */
@@ -74,6 +130,22 @@ typedef struct {
     int rotation;
 } MoveAlgoResult_St;
 
+/**
+    @brief Seeded source of the pieces: the same seed deals the same pieces.
+*/
+typedef struct {
+    u32 state;
+} PieceGenerator_St;
+
+/**
+    @brief What one game step did to the falling piece.
+*/
+typedef enum {
+    GAME_STEP_FALLING,              // Still falling
+    GAME_STEP_LOCKED,               // Locked in the board, the next piece is out
+    GAME_STEP_OVER                  // Locked, and the next piece has no room
+} GameStep_Et;
+
 /**
     @brief Concrete Tetromino Fall game state
 */
@@ -82,6 +154,7 @@ typedef struct {
 
     BoardShape_St boardShape;       // Current falling piece
     BoardShape_St nextBoardShape;   // Preview of next piece
+    PieceGenerator_St generator;    // Deals the pieces
 
     Speed_St speed;                 // Controls automatic drop timing
 
@@ -1,19 +1,31 @@
 # Dirs
 SRC_DIR := src
 TEST_DIR := tests
+BENCH_DIR := $(TEST_DIR)/bench
 
 # Library/shared sources/objects (recursive, excluding main.c)
 LIB_SOURCES := $(shell find $(SRC_DIR) -name '*.c' ! -name '$(MAIN_NAME).c')
 LIB_OBJECTS := $(LIB_SOURCES:$(SRC_DIR)/%.c=$(OBJ_DIR)/%.o)
 
+# The client glue needs the lobby's params menu: tests link without it
+TEST_LIB_OBJECTS := $(filter-out $(OBJ_DIR)/network/clientInterface.o, $(LIB_OBJECTS))
+
 # Main source/object
 MAIN_SOURCE := $(SRC_DIR)/$(MAIN_NAME).c
 MAIN_OBJECT := $(OBJ_DIR)/$(MAIN_NAME).o
 
-# Test sources/objects/bins (recursive)
-TEST_SOURCES := $(shell find $(TEST_DIR) -name '*.c')
+# Test sources/objects/bins (recursive, benchmarks excluded: they run for minutes)
+TEST_SOURCES := $(shell find $(TEST_DIR) -name '*.c' ! -path '$(BENCH_DIR)/*')
 TEST_OBJECTS := $(TEST_SOURCES:$(TEST_DIR)/%.c=$(OBJ_DIR)/tests/%.o)
 TEST_BINS := $(TEST_SOURCES:$(TEST_DIR)/%.c=$(TEST_BIN_DIR)/%$(EXE_EXT))
 
+# Weight tuner (tests/bench/tuner.c)
+TUNER_OBJECT := $(OBJ_DIR)/tests/bench/tuner.o
+TUNER_BIN := $(BUILD_DIR)/bin/tuner$(EXE_EXT)
+
+# Headless AI games (tests/bench/simulator.c)
+SIMULATOR_OBJECT := $(OBJ_DIR)/tests/bench/simulator.o
+SIMULATOR_BIN := $(BUILD_DIR)/bin/simulator$(EXE_EXT)
+
 # All deps
-DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d)
+DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d) $(TUNER_OBJECT:.o=.d) $(SIMULATOR_OBJECT:.o=.d)
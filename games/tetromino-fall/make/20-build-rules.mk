@@ -1,5 +1,5 @@
 # Prevent make from deleting intermediate object files
-.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS)
+.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS) $(TUNER_OBJECT) $(SIMULATOR_OBJECT)
 
 # Rules
 $(BIN): $(LIB_OBJECTS) $(MAIN_OBJECT)
@@ -10,7 +10,15 @@ $(OBJ_DIR)/%.o: $(SRC_DIR)/%.c
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $(CFLAGS) $(DEP_FLAGS) -c $< -o $@
 
-$(TEST_BIN_DIR)/% : $(LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
+$(TEST_BIN_DIR)/% : $(TEST_LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
+	$(SILENT_PREFIX)mkdir -p $(@D)
+	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
+
+$(TUNER_BIN): $(TEST_LIB_OBJECTS) $(TUNER_OBJECT)
+	$(SILENT_PREFIX)mkdir -p $(@D)
+	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
+
+$(SIMULATOR_BIN): $(TEST_LIB_OBJECTS) $(SIMULATOR_OBJECT)
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
 
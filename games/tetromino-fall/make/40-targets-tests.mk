@@ -6,6 +6,16 @@ tests: $(TEST_BINS)
 	fi
 
 
+tuner: $(TUNER_BIN)
+
+run-tuner: tuner
+	$(SILENT_PREFIX)./$(TUNER_BIN) $(TUNER_ARGS)
+
+simulator: $(SIMULATOR_BIN)
+
+run-simulator: simulator
+	$(SILENT_PREFIX)./$(SIMULATOR_BIN) $(SIMULATOR_ARGS)
+
 run-tests: tests
 	@if [ -z "$(TEST_BINS)" ]; then \
 		:; \
@@ -21,7 +21,7 @@ ifeq ($(NO_DEPENDENCY_TRACKING),1)
 else
 	DEP_FLAGS := -MMD -MP
 	# All dependency files
-	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d)
+	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d) $(TUNER_OBJECT:.o=.d) $(SIMULATOR_OBJECT:.o=.d)
 endif
 
 ifneq ($(NO_DEPENDENCY_TRACKING),1)
@@ -53,6 +53,10 @@ help:
 	@echo "    run-main             Run the main binary (uses Valgrind in valgrind-debug mode)"
 	@echo "    run-gdb              Debug the main binary with gdb"
 	@echo "    run-tests            Build and run all tests, reporting failures at the end"
+	@echo "    tuner                Build the self-play weight tuner (build/bin/tuner)"
+	@echo "    run-tuner            Tune the AI weights by self-play (TUNER_ARGS=\"--generations=40 ...\")"
+	@echo "    simulator            Build the headless AI benchmark (build/bin/simulator)"
+	@echo "    run-simulator        Play seeded AI games without a window (SIMULATOR_ARGS=\"--games=1000 ...\")"
 	@echo "    clean                Remove all build artifacts and build folder"
 	@echo "    doxygen              Build documentation"
 	@echo "    clean-docs           Remove all of the generated documentation"
@@ -72,6 +76,8 @@ help:
 	@echo "    NO_DEPENDENCY_TRACKING=1    Disable automatic dependency tracking (.d files)"
 	@echo "    EXTRA_CFLAGS=\"<str>\"        Add custom compiler flags"
 	@echo "    EXTRA_LDFLAGS=\"<str>\"       Add custom linker flags"
+	@echo "    TUNER_ARGS=\"<str>\"          Options for run-tuner (see build/bin/tuner --help)"
+	@echo "    SIMULATOR_ARGS=\"<str>\"      Options for run-simulator (see build/bin/simulator --help)"
 	@echo ""
 	@echo "Portability Notes:"
 	@echo "    run-tests uses stdbuf (from GNU coreutils) if available for reliable output on crashes;"
@@ -0,0 +1,134 @@
+/**
+    @file bitboard.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Implementation of the occupancy bitboard used by the AI.
+*/
+
+#include "core/bitboard.h"
+
+/**
+    @brief Set bits of a row word (SWAR).
+
+    popcountRow() is a libgcc call without -mpopcnt, which the
+    portable build does not enable; this stays inline.
+*/
+static inline int popcountRow(u32 row) {
+    row = row - ((row >> 1) & 0x5555u);
+    row = (row & 0x3333u) + ((row >> 2) & 0x3333u);
+    row = (row + (row >> 4)) & 0x0F0Fu;
+    return (int)((row + (row >> 8)) & 0x1Fu);
+}
+
+void tetrominoFall_bitboardFromBoard(Board_t board, BitBoard_St* bits) {
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        BitRow_t row = 0;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            if (!ColorIsEqual(board[y][x], BOARD_BACKGROUND_COLOR))
+                row |= (BitRow_t)(1u << x);
+        }
+        bits->rows[y] = row;
+    }
+}
+
+void tetrominoFall_shapeMaskFrom(const BoardShape_St* boardShape, ShapeMask_St* mask) {
+    int minX = boardShape->shape[0].x, maxX = minX;
+    int minY = boardShape->shape[0].y, maxY = minY;
+
+    for (int i = 1; i < 4; i++) {
+        minX = boardShape->shape[i].x < minX ? boardShape->shape[i].x : minX;
+        maxX = boardShape->shape[i].x > maxX ? boardShape->shape[i].x : maxX;
+        minY = boardShape->shape[i].y < minY ? boardShape->shape[i].y : minY;
+        maxY = boardShape->shape[i].y > maxY ? boardShape->shape[i].y : maxY;
+    }
+
+    memset(mask, 0, sizeof(*mask));
+    mask->width = maxX - minX + 1;
+    mask->height = maxY - minY + 1;
+    mask->pivot = (iVector2){ -minX, -minY };
+
+    for (int i = 0; i < 4; i++)
+        mask->rows[boardShape->shape[i].y - minY] |= (BitRow_t)(1u << (boardShape->shape[i].x - minX));
+}
+
+int tetrominoFall_bitboardDrop(const BitBoard_St* bits, const ShapeMask_St* mask, int left, int top) {
+    if (tetrominoFall_bitboardCollides(bits, mask, left, top)) return top - 1;
+
+    // Nothing to hit above the stack: start the fall right over it
+    int surface = 0;
+    while (surface < BOARD_HEIGHT && !bits->rows[surface])
+        surface++;
+    if (surface - mask->height > top)
+        top = surface - mask->height;
+
+    while (!tetrominoFall_bitboardCollides(bits, mask, left, top + 1))
+        top++;
+
+    return top;
+}
+
+void tetrominoFall_bitboardPlace(BitBoard_St* bits, const ShapeMask_St* mask, int left, int top) {
+    for (int i = 0; i < mask->height; i++) {
+        int y = top + i;
+        if (y >= 0 && y < BOARD_HEIGHT)
+            bits->rows[y] |= (BitRow_t)(mask->rows[i] << left);
+    }
+}
+
+int tetrominoFall_bitboardClearLines(BitBoard_St* bits) {
+    int write = BOARD_HEIGHT - 1;
+
+    // Compact the rows that are not full towards the floor
+    for (int y = BOARD_HEIGHT - 1; y >= 0; y--) {
+        if (bits->rows[y] != BOARD_FULL_ROW)
+            bits->rows[write--] = bits->rows[y];
+    }
+
+    int cleared = write + 1;
+    for (; write >= 0; write--)
+        bits->rows[write] = 0;
+
+    return cleared;
+}
+
+void tetrominoFall_bitboardFeatures(const BitBoard_St* bits, BoardFeatures_St* features) {
+    int heights[BOARD_WIDTH] = {0};
+    BitRow_t seen = 0;      // Columns with a block above the current row
+
+    memset(features, 0, sizeof(*features));
+
+    // The empty rows above the stack only add their two wall transitions, and one over the top row
+    int surface = 0;
+    while (surface < BOARD_HEIGHT && !bits->rows[surface])
+        surface++;
+    features->rowTransitions = 2 * surface;
+    if (surface > 0)
+        features->columnTransitions = popcountRow(surface < BOARD_HEIGHT ? bits->rows[surface] : BOARD_FULL_ROW);
+
+    for (int y = surface; y < BOARD_HEIGHT; y++) {
+        BitRow_t row = bits->rows[y];
+        BitRow_t tops = row & (BitRow_t)~seen;
+
+        features->holes += popcountRow(seen & (BitRow_t)~row);
+        features->completeLines += row == BOARD_FULL_ROW;
+
+        // Bit x + 1 of the shifted row is cell x, bit 0 the left wall and bit BOARD_WIDTH of `walled` the right one
+        u32 walled = row | (1u << BOARD_WIDTH);
+        features->rowTransitions += popcountRow((walled ^ ((walled << 1) | 1u)) & ((1u << (BOARD_WIDTH + 1)) - 1));
+        BitRow_t below = y + 1 < BOARD_HEIGHT ? bits->rows[y + 1] : BOARD_FULL_ROW;
+        features->columnTransitions += popcountRow(row ^ below);
+
+        if (tops) {
+            if (!seen) features->maxHeight = BOARD_HEIGHT - y;
+            features->aggregateHeight += popcountRow(tops) * (BOARD_HEIGHT - y);
+            while (tops) {
+                heights[__builtin_ctz(tops)] = BOARD_HEIGHT - y;
+                tops &= (BitRow_t)(tops - 1);
+            }
+            seen |= row;
+        }
+    }
+
+    for (int x = 0; x < BOARD_WIDTH - 1; x++)
+        features->bumpiness += abs(heights[x] - heights[x + 1]);
+}
@@ -2,7 +2,7 @@
     @file game.c
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Implementation of game logic and movement for Tetris.
 */
 
@@ -12,8 +12,10 @@
 
 #include "utils/globals.h"
 
-void tetrominoFall_automaticMovementTo(Speed_St* speed, BoardShape_St* boardShape, MoveAlgoResult_St targetMove) {
-    speed->t += GetFrameTime();
+static const int SCORE_TABLE[5] = { 0, 40, 100, 300, 1200 };
+
+void tetrominoFall_automaticMovementTo(Speed_St* speed, BoardShape_St* boardShape, MoveAlgoResult_St targetMove, float dt) {
+    speed->t += dt;
     speed->tDrop = fminf(speed->t / speed->duration, 1.0f);
     if (speed->tDrop < 1) return;
 
@@ -29,6 +31,39 @@ void tetrominoFall_automaticMovementTo(Speed_St* speed, BoardShape_St* boardShap
         tetrominoFall_rotationCW(boardShape);
 }
 
+GameStep_Et tetrominoFall_settleShape(TetrominoFallGame_St* game) {
+    GameStep_Et step = GAME_STEP_FALLING;
+
+    if (tetrominoFall_isOOB(game->boardShape) || tetrominoFall_isColliding(game->board, game->boardShape)) {
+        game->boardShape.position.y--;
+        tetrominoFall_putShapeInBoard(game->board, game->boardShape);
+
+        game->boardShape = game->nextBoardShape;
+        tetrominoFall_nextShape(&game->generator, &game->nextBoardShape);
+
+        step = tetrominoFall_isColliding(game->board, game->boardShape) ? GAME_STEP_OVER : GAME_STEP_LOCKED;
+    }
+
+    // Only a lock fills cells: no line to look for while the piece falls
+    if (step == GAME_STEP_FALLING) return step;
+
+    int clearedCount = 0;
+    tetrominoFall_handleLineClears(game->board, game->clearedLines, &clearedCount);
+
+    game->clearedLineAmount += clearedCount;
+    game->difficultyMultiplier = (int) fminf(29, game->clearedLineAmount / 10.0f);
+
+    if (clearedCount > 0 && clearedCount <= 4) {
+        game->score += SCORE_TABLE[clearedCount] * (game->difficultyMultiplier + 1);
+    }
+
+    if (clearedCount > 0 && game->clearedLineAmount % 10 == 0) {
+        game->speed.duration = fmaxf(0.3f, 1.0f - 0.025f * game->difficultyMultiplier);
+    }
+
+    return step;
+}
+
 void tetrominoFall_mouvement(Board_t board, BoardShape_St* boardShape, float dt) {
     // LEFT
     if (IsKeyDown(KEY_LEFT)) {
@@ -0,0 +1,174 @@
+/**
+    @file planner.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Implementation of the beam-search planner.
+*/
+
+#include "core/planner.h"
+#include "core/algo.h"
+#include "core/bitboard.h"
+#include "core/shape.h"
+#include "utils/globals.h"
+
+/**
+    @brief The rotations of a piece that fill different cells.
+*/
+typedef struct {
+    ShapeMask_St masks[4];
+    int rotations[4];               // `rotation` field of the shape once turned to each mask
+    int count;
+} PieceRotations_St;
+
+/**
+    @brief A board of the beam, with the first move that led to it.
+*/
+typedef struct {
+    BitBoard_St bits;
+    float score;
+    int lines;                      // Lines cleared since the root
+    int order;                      // Creation order, breaks score ties
+    MoveAlgoResult_St first;
+} PlanNode_St;
+
+/**
+    @brief Lists the rotations of a shape, skipping those with the same cells as an earlier one.
+*/
+static void distinctRotations(BoardShape_St shape, PieceRotations_St* out) {
+    out->count = 0;
+
+    for (int rot = 0; rot < 4; ++rot) {
+        ShapeMask_St mask;
+        tetrominoFall_shapeMaskFrom(&shape, &mask);
+
+        bool seen = false;
+        for (int i = 0; i < out->count && !seen; i++) {
+            const ShapeMask_St* other = &out->masks[i];
+            seen = other->width == mask.width && other->height == mask.height
+                && !memcmp(other->rows, mask.rows, sizeof(mask.rows));
+        }
+
+        if (!seen) {
+            out->masks[out->count] = mask;
+            out->rotations[out->count] = shape.rotation;
+            out->count++;
+        }
+
+        tetrominoFall_rotationCW(&shape);
+    }
+}
+
+static u64 hashBoard(const BitBoard_St* bits) {
+    u64 words[sizeof(BitBoard_St) / sizeof(u64)];
+    memcpy(words, bits, sizeof(words));
+
+    u64 hash = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < sizeof(words) / sizeof(u64); i++) {
+        hash ^= words[i];
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
+
+static int compareNodes(const void* a, const void* b) {
+    const PlanNode_St* left = a;
+    const PlanNode_St* right = b;
+
+    if (left->score != right->score) return left->score > right->score ? -1 : 1;
+    return left->order - right->order;
+}
+
+MoveAlgoResult_St tetrominoFall_planMove(const BitBoard_St* bits, const BoardShape_St pieces[], int count, const PlannerConfig_St* config) {
+    MoveAlgoResult_St result = { .position = {-1, -1}, .rotation = -1 };
+    if (count < 1) return result;
+    if (count > PLANNER_MAX_PIECES) count = PLANNER_MAX_PIECES;
+
+    const AiWeights_St* weights = config->weights ? config->weights : &defaultAiWeights;
+    int beamWidth = config->beamWidth < 1 ? 1 : config->beamWidth > PLANNER_MAX_BEAM ? PLANNER_MAX_BEAM : config->beamWidth;
+
+    PieceRotations_St rotations[PLANNER_MAX_PIECES];
+    for (int i = 0; i < count; i++)
+        distinctRotations(pieces[i], &rotations[i]);
+
+    // Children of a whole beam, and the table finding a board among them (power of 2, at most half full)
+    int maxChildren = beamWidth * 4 * BOARD_WIDTH;
+    int tableSize = 1;
+    while (tableSize < 2 * maxChildren) tableSize <<= 1;
+
+    PlanNode_St* beam = malloc(sizeof(*beam) * beamWidth);
+    PlanNode_St* children = malloc(sizeof(*children) * maxChildren);
+    u32* table = malloc(sizeof(*table) * tableSize);
+    if (!beam || !children || !table) {
+        free(beam);
+        free(children);
+        free(table);
+        return result;
+    }
+
+    beam[0] = (PlanNode_St){ .bits = *bits, .first = result };
+    int beamCount = 1;
+
+    for (int depth = 0; depth < count; depth++) {
+        const PieceRotations_St* piece = &rotations[depth];
+        iVector2 spawn = pieces[depth].position;
+        int childCount = 0;
+        memset(table, 0, sizeof(*table) * tableSize);
+
+        for (int n = 0; n < beamCount; n++) {
+            const PlanNode_St* node = &beam[n];
+
+            // The current piece is already on the board; the next ones must fit where they appear
+            if (depth > 0 && tetrominoFall_bitboardCollides(&node->bits, &piece->masks[0],
+                    spawn.x - piece->masks[0].pivot.x, spawn.y - piece->masks[0].pivot.y))
+                continue;
+
+            for (int r = 0; r < piece->count; r++) {
+                const ShapeMask_St* mask = &piece->masks[r];
+
+                for (int left = 0; left + mask->width <= BOARD_WIDTH; left++) {
+                    int top = tetrominoFall_bitboardDrop(&node->bits, mask, left, -mask->pivot.y);
+                    if (top + mask->pivot.y < 0) continue;      // Blocked at once
+
+                    PlanNode_St* child = &children[childCount];
+                    child->bits = node->bits;
+                    tetrominoFall_bitboardPlace(&child->bits, mask, left, top);
+                    child->lines = node->lines + tetrominoFall_bitboardClearLines(&child->bits);
+
+                    // Same board as a sibling: same cells filled, so the same lines cleared and the same score
+                    u64 hash = hashBoard(&child->bits);
+                    u32 slot = (u32)hash & (u32)(tableSize - 1);
+                    bool duplicate = false;
+                    while (table[slot] && !duplicate) {
+                        duplicate = !memcmp(&children[table[slot] - 1].bits, &child->bits, sizeof(BitBoard_St));
+                        slot = (slot + 1) & (u32)(tableSize - 1);
+                    }
+                    if (duplicate) continue;
+
+                    table[slot] = (u32)childCount + 1;
+                    child->score = tetrominoFall_evaluateWeighted(&child->bits, child->lines, weights);
+                    child->order = childCount;
+                    child->first = depth == 0
+                        ? (MoveAlgoResult_St){ { left + mask->pivot.x, top + mask->pivot.y }, piece->rotations[r] }
+                        : node->first;
+                    childCount++;
+                }
+            }
+        }
+
+        // Every line of play topped out: keep the best board reached so far
+        if (!childCount) break;
+
+        qsort(children, childCount, sizeof(*children), compareNodes);
+        beamCount = childCount < beamWidth ? childCount : beamWidth;
+        memcpy(beam, children, sizeof(*beam) * beamCount);
+        result = beam[0].first;
+    }
+
+    free(beam);
+    free(children);
+    free(table);
+
+    return result;
+}
@@ -2,7 +2,7 @@
     @file shape.c
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
+    @date 2026-10-17
     @brief Core implementation of tetromino shapes and their transformations.
 */
 
@@ -17,6 +17,21 @@ void tetrominoFall_randomShape(BoardShape_St* boardShape) {
     boardShape->shapeName = n;
 }
 
+void tetrominoFall_seedShapes(PieceGenerator_St* generator, u32 seed) {
+    generator->state = seed;
+}
+
+void tetrominoFall_nextShape(PieceGenerator_St* generator, BoardShape_St* boardShape) {
+    generator->state = generator->state * 1664525u + 1013904223u;
+    int n = (int)((generator->state >> 8) % SHAPE_MAX_ID);
+
+    memcpy(boardShape->shape, tetraminosShapes[n], sizeof(Tetromino_t));
+    boardShape->color = tetraminosColors[n];
+    boardShape->position = (iVector2){4, 0};
+    boardShape->rotation = 0;
+    boardShape->shapeName = n;
+}
+
 void tetrominoFall_rotationCW(BoardShape_St* boardShape) {
     int xTemp;
     
@@ -0,0 +1,86 @@
+/**
+    @file simulation.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Implementation of the headless AI games.
+*/
+
+#include "core/simulation.h"
+#include "core/algo.h"
+#include "core/bitboard.h"
+#include "core/board.h"
+#include "core/game.h"
+#include "core/planner.h"
+#include "core/shape.h"
+
+/**
+    @brief Plans the falling piece with the next one in sight.
+
+    With nowhere to land, the piece is left to fall where it is.
+*/
+static MoveAlgoResult_St planShape(TetrominoFallGame_St* game, const PlannerConfig_St* planner) {
+    BitBoard_St bits;
+    BoardShape_St pieces[2] = { game->boardShape, game->nextBoardShape };
+    tetrominoFall_bitboardFromBoard(game->board, &bits);
+
+    MoveAlgoResult_St move = tetrominoFall_planMove(&bits, pieces, 2, planner);
+    if (move.rotation < 0)
+        move = (MoveAlgoResult_St){ game->boardShape.position, game->boardShape.rotation };
+
+    return move;
+}
+
+void tetrominoFall_defaultSimulation(SimulationConfig_St* config) {
+    *config = (SimulationConfig_St){
+        .seed = 1,
+        .games = 1000,
+        .maxPieces = 100,
+        .step = 1.0f / 60.0f,
+        .dropDuration = 0.01f,
+        .planner = { .weights = NULL, .beamWidth = AI_BEAM_WIDTH },
+    };
+}
+
+void tetrominoFall_simulateGame(TetrominoFallGame_St* game, const SimulationConfig_St* config, u32 seed, SimulationStats_St* stats) {
+    u64 evaluations = tetrominoFall_evaluationCount();
+    int pieces = 0;
+
+    memset(game, 0, sizeof(*game));
+    tetrominoFall_initBoard(game->board);
+    tetrominoFall_seedShapes(&game->generator, seed);
+    tetrominoFall_nextShape(&game->generator, &game->boardShape);
+    tetrominoFall_nextShape(&game->generator, &game->nextBoardShape);
+
+    MoveAlgoResult_St target = planShape(game, &config->planner);
+
+    for (;;) {
+        // The AI drops at its own pace, the line-count speed-up is for players
+        game->speed.duration = config->dropDuration;
+        tetrominoFall_automaticMovementTo(&game->speed, &game->boardShape, target, config->step);
+        stats->frames++;
+
+        GameStep_Et step = tetrominoFall_settleShape(game);
+        if (step == GAME_STEP_FALLING) continue;
+
+        pieces++;
+        if (step == GAME_STEP_OVER || (config->maxPieces > 0 && pieces >= config->maxPieces)) break;
+        target = planShape(game, &config->planner);
+    }
+
+    stats->games++;
+    stats->pieces += pieces;
+    stats->lines += game->clearedLineAmount;
+    stats->score += game->score;
+    stats->evaluations += tetrominoFall_evaluationCount() - evaluations;
+}
+
+void tetrominoFall_simulate(const SimulationConfig_St* config, SimulationStats_St* stats) {
+    TetrominoFallGame_St game;
+    memset(stats, 0, sizeof(*stats));
+
+    clock_t start = clock();
+    for (int g = 0; g < config->games; g++)
+        tetrominoFall_simulateGame(&game, config, config->seed + (u32)g, stats);
+
+    stats->cpuSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+}
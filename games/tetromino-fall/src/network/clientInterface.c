@@ -13,8 +13,6 @@
 #include "paramsMenu.h"
 #include "APIs/generalAPI.h"
 
-static const int SCORE_TABLE[5] = { 0, 40, 100, 300, 1200 };
-
 // Global params menu state for tetris
 static ParamsMenu_St tetrominoFall_paramsMenu = {0};
 
@@ -31,8 +29,9 @@ void tetrominoFall_init(void) {
 
     tetrominoFall_game.speed.duration = 1.0f;
 
-    tetrominoFall_randomShape(&tetrominoFall_game.boardShape);
-    tetrominoFall_randomShape(&tetrominoFall_game.nextBoardShape);
+    tetrominoFall_seedShapes(&tetrominoFall_game.generator, (u32)rand());
+    tetrominoFall_nextShape(&tetrominoFall_game.generator, &tetrominoFall_game.boardShape);
+    tetrominoFall_nextShape(&tetrominoFall_game.generator, &tetrominoFall_game.nextBoardShape);
 
     tetrominoFall_readHighScore(&tetrominoFall_game.highScore);
     tetrominoFall_initBoard(tetrominoFall_game.board);
@@ -48,30 +47,8 @@ void tetrominoFall_update(float dt) {
     tetrominoFall_mouvement(tetrominoFall_game.board, &tetrominoFall_game.boardShape, dt);
     tetrominoFall_automaticDrop(&tetrominoFall_game.speed, &tetrominoFall_game.boardShape, dt);
 
-    if (tetrominoFall_isOOB(tetrominoFall_game.boardShape) || tetrominoFall_isColliding(tetrominoFall_game.board, tetrominoFall_game.boardShape)) {
-        tetrominoFall_game.boardShape.position.y--;
-        tetrominoFall_putShapeInBoard(tetrominoFall_game.board, tetrominoFall_game.boardShape);
-
-        tetrominoFall_game.boardShape = tetrominoFall_game.nextBoardShape;
-        tetrominoFall_randomShape(&tetrominoFall_game.nextBoardShape);
-
-        if (tetrominoFall_isColliding(tetrominoFall_game.board, tetrominoFall_game.boardShape)) {
-            tetrominoFall_writeHighScore(tetrominoFall_game.highScore, tetrominoFall_game.score);
-        }
-    }
-
-    int clearedCount = 0;
-    tetrominoFall_handleLineClears(tetrominoFall_game.board, tetrominoFall_game.clearedLines, &clearedCount);
-
-    tetrominoFall_game.clearedLineAmount += clearedCount;
-    tetrominoFall_game.difficultyMultiplier = (int) fminf(29, tetrominoFall_game.clearedLineAmount / 10.0f);
-
-    if (clearedCount > 0 && clearedCount <= 4) {
-        tetrominoFall_game.score += SCORE_TABLE[clearedCount] * (tetrominoFall_game.difficultyMultiplier + 1);
-    }
-
-    if (clearedCount > 0 && tetrominoFall_game.clearedLineAmount % 10 == 0) {
-        tetrominoFall_game.speed.duration = fmaxf(0.3f, 1.0f - 0.025f * tetrominoFall_game.difficultyMultiplier);
+    if (tetrominoFall_settleShape(&tetrominoFall_game) == GAME_STEP_OVER) {
+        tetrominoFall_writeHighScore(tetrominoFall_game.highScore, tetrominoFall_game.score);
     }
 }
 
@@ -2,8 +2,8 @@
     @file globals.c
     @author Maxime CHAUVEAU
     @date 2026-04-07
-    @date 2026-04-14
-    @brief Global variable definitions including tetramino shapes, colors, and input repeat settings.
+    @date 2026-10-17
+    @brief Global variable definitions including tetramino shapes, colors, input repeat settings and AI weights.
 */
 #include "utils/globals.h"
 #include "core/shape.h"
@@ -21,4 +21,15 @@ Color tetraminosColors[] = {
     {255, 161, 0, 255}      /* ORANGE */
 };
 
-Tetromino_t tetraminosShapes[] = {I_SHAPE, O_SHAPE, T_SHAPE, S_SHAPE, Z_SHAPE, J_SHAPE, L_SHAPE};
\ No newline at end of file
+Tetromino_t tetraminosShapes[] = {I_SHAPE, O_SHAPE, T_SHAPE, S_SHAPE, Z_SHAPE, J_SHAPE, L_SHAPE};
+
+/* Found by `make run-tuner` (greedy self-play, 8 games of up to 20000 pieces): 3335 lines per game, 141 with the hand-set -10/-5/-1/-5/+20 */
+const AiWeights_St defaultAiWeights = {{
+    [AI_FEATURE_HOLES]              = -0.6362f,
+    [AI_FEATURE_AGGREGATE_HEIGHT]   = -0.4060f,
+    [AI_FEATURE_BUMPINESS]          = -0.0001f,
+    [AI_FEATURE_MAX_HEIGHT]         = -0.1352f,
+    [AI_FEATURE_LINES]              = 0.3693f,
+    [AI_FEATURE_ROW_TRANSITIONS]    = -0.4088f,
+    [AI_FEATURE_COLUMN_TRANSITIONS] = -0.3295f,
+}};
@@ -0,0 +1,77 @@
+/**
+    @file simulator.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Headless AI games, the regression benchmark of the AI and board code.
+
+    Plays --games seeded games without a window (simulation.h): the frame
+    time is fixed, the AI plans each piece with the next one in sight and
+    steers it down, and the real game rules lock it and clear the lines.
+    A seed always plays the same games, so two builds compare on the same
+    work: the lines and score totals must match when only speed changed.
+
+    Reported at the end:
+        - games, pieces and frames per CPU-second
+        - average game length, in pieces and lines
+        - boards evaluated by the AI, in total and per piece
+        - totals of lines and score, the fingerprint of the games played
+
+    Not part of run-tests. Build and run it with `make simulator` /
+    `make run-simulator SIMULATOR_ARGS="..."` from games/tetromino-fall.
+*/
+#include "core/simulation.h"
+
+static bool parseArgs(int argc, char* argv[], SimulationConfig_St* cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if      (strncmp(a, "--games=", 8) == 0)           cfg->games = atoi(a + 8);
+        else if (strncmp(a, "--pieces=", 9) == 0)          cfg->maxPieces = atoi(a + 9);
+        else if (strncmp(a, "--beam=", 7) == 0)            cfg->planner.beamWidth = atoi(a + 7);
+        else if (strncmp(a, "--fps=", 6) == 0)             cfg->step = 1.0f / (float)atof(a + 6);
+        else if (strncmp(a, "--drop=", 7) == 0)            cfg->dropDuration = (float)atof(a + 7);
+        else if (strncmp(a, "--seed=", 7) == 0)            cfg->seed = (u32)strtoul(a + 7, NULL, 10);
+        else return false;
+    }
+    if (cfg->games < 1) cfg->games = 1;
+    return cfg->step > 0.0f && cfg->dropDuration > 0.0f;
+}
+
+static void printUsage(const char* self, const SimulationConfig_St* cfg) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --games=N            games played (default %d)\n"
+        "  --pieces=N           pieces per game at most, 0 = until the top-out (default %d)\n"
+        "  --beam=N             planner beam width (default %d)\n"
+        "  --fps=F              fixed frames per second (default %.0f)\n"
+        "  --drop=S             seconds per row of the AI piece (default %.2f)\n"
+        "  --seed=N             seed of the first game, the next ones follow (default %u)\n",
+        self, cfg->games, cfg->maxPieces, cfg->planner.beamWidth, 1.0f / cfg->step, cfg->dropDuration, cfg->seed);
+}
+
+int main(int argc, char* argv[]) {
+    SimulationConfig_St cfg;
+    tetrominoFall_defaultSimulation(&cfg);
+    if (!parseArgs(argc, argv, &cfg)) {
+        tetrominoFall_defaultSimulation(&cfg);
+        printUsage(argv[0], &cfg);
+        return 2;
+    }
+
+    SimulationStats_St stats;
+    tetrominoFall_simulate(&cfg, &stats);
+
+    double seconds = stats.cpuSeconds > 0.0 ? stats.cpuSeconds : 1e-9;
+    printf("[SIMULATOR] %llu games, seeds %u..%u, beam %d, %llu pieces max\n",
+           (unsigned long long)stats.games, cfg.seed, cfg.seed + (u32)cfg.games - 1,
+           cfg.planner.beamWidth, (unsigned long long)cfg.maxPieces);
+    printf("[SIMULATOR] %.2f CPU-s: %.0f games/s, %.0f pieces/s, %.0f frames/s\n",
+           stats.cpuSeconds, stats.games / seconds, stats.pieces / seconds, stats.frames / seconds);
+    printf("[SIMULATOR] average game: %.1f pieces, %.1f lines\n",
+           (double)stats.pieces / stats.games, (double)stats.lines / stats.games);
+    printf("[SIMULATOR] evaluations: %llu, %.1f per piece\n",
+           (unsigned long long)stats.evaluations, stats.pieces ? (double)stats.evaluations / stats.pieces : 0.0);
+    printf("[SIMULATOR] fingerprint: %llu lines, %llu score\n",
+           (unsigned long long)stats.lines, (unsigned long long)stats.score);
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+/**
+    @file tuner.c
+    @author Fshimi-Hawlk
+    @date 2026-10-17
+    @brief Offline self-play tuner of the AI weights.
+
+    Plays whole games without a window: the pieces come from a seeded
+    PieceGenerator_St, each one is hard-dropped where the planner
+    (planner.h) puts it with the previews in sight, and the game ends when
+    a piece cannot spawn or after --pieces pieces. Games on the bitboard
+    alone run faster than the full rules of simulation.h. A set of weights
+    is worth the mean lines it clears over --games games.
+
+    The search is a (1+1) evolution strategy started from defaultAiWeights:
+    each generation perturbs the best weights, plays the same games (same
+    seeds) with the candidate and keeps it if it clears more lines. The
+    weights are kept at unit length, the score only depends on their ratios.
+
+    By default the games are played greedily (no preview, beam of 1): the
+    weights alone keep that player alive, so sets are told apart within
+    seconds, and the planner's look-ahead only adds to what they find.
+
+    Reported every generation and at the end:
+        - mean lines of the best weights and of the candidate
+        - lines cleared and pieces placed per CPU-second, all games counted
+        - the best weights, as an initializer for defaultAiWeights
+
+    Not part of run-tests: it runs for minutes. Build and run it with
+    `make tuner` / `make run-tuner TUNER_ARGS="..."` from games/tetromino-fall.
+*/
+#include "core/bitboard.h"
+#include "core/planner.h"
+#include "core/shape.h"
+#include "utils/globals.h"
+
+/**
+    @brief Command-line settings of the tuner.
+*/
+typedef struct {
+    int generations;
+    int games;                      // Games per evaluation of a set of weights
+    int pieces;                     // Pieces per game at most
+    int previews;                   // Preview pieces the planner sees
+    int beamWidth;
+    u32 seed;
+} TunerConfig_St;
+
+/**
+    @brief Totals of every game played, for the throughput.
+*/
+typedef struct {
+    u64 lines;
+    u64 pieces;
+} TunerTotals_St;
+
+static const char* featureNames[AI_FEATURE_COUNT] = {
+    [AI_FEATURE_HOLES]              = "AI_FEATURE_HOLES",
+    [AI_FEATURE_AGGREGATE_HEIGHT]   = "AI_FEATURE_AGGREGATE_HEIGHT",
+    [AI_FEATURE_BUMPINESS]          = "AI_FEATURE_BUMPINESS",
+    [AI_FEATURE_MAX_HEIGHT]         = "AI_FEATURE_MAX_HEIGHT",
+    [AI_FEATURE_LINES]              = "AI_FEATURE_LINES",
+    [AI_FEATURE_ROW_TRANSITIONS]    = "AI_FEATURE_ROW_TRANSITIONS",
+    [AI_FEATURE_COLUMN_TRANSITIONS] = "AI_FEATURE_COLUMN_TRANSITIONS",
+};
+
+static u32 nextRandom(u32* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+/**
+    @brief Standard normal deviate (Box-Muller).
+*/
+static float gaussian(u32* state) {
+    float u = ((float)nextRandom(state) + 1.0f) / 16777217.0f;
+    float v = (float)nextRandom(state) / 16777216.0f;
+    return sqrtf(-2.0f * logf(u)) * cosf(2.0f * PI * v);
+}
+
+static void normalize(AiWeights_St* weights) {
+    float length = 0.0f;
+    for (int i = 0; i < AI_FEATURE_COUNT; i++)
+        length += weights->weights[i] * weights->weights[i];
+
+    length = sqrtf(length);
+    if (length <= 0.0f) return;
+    for (int i = 0; i < AI_FEATURE_COUNT; i++)
+        weights->weights[i] /= length;
+}
+
+/**
+    @brief Plays one game with the planner and returns the lines it cleared.
+*/
+static int playGame(const AiWeights_St* weights, u32 seed, const TunerConfig_St* cfg, TunerTotals_St* totals) {
+    BitBoard_St bits = {0};
+    BoardShape_St queue[PLANNER_MAX_PIECES];
+    PieceGenerator_St generator;
+    PlannerConfig_St planner = { .weights = weights, .beamWidth = cfg->beamWidth };
+    int count = cfg->previews + 1;
+    int lines = 0;
+
+    tetrominoFall_seedShapes(&generator, seed);
+    for (int i = 0; i < count; i++)
+        tetrominoFall_nextShape(&generator, &queue[i]);
+
+    int placed = 0;
+    for (; placed < cfg->pieces; placed++) {
+        ShapeMask_St mask;
+        tetrominoFall_shapeMaskFrom(&queue[0], &mask);
+        if (tetrominoFall_bitboardCollides(&bits, &mask, queue[0].position.x - mask.pivot.x, queue[0].position.y - mask.pivot.y))
+            break;
+
+        MoveAlgoResult_St move = tetrominoFall_planMove(&bits, queue, count, &planner);
+        if (move.rotation < 0) break;
+
+        BoardShape_St piece = queue[0];
+        while (piece.rotation != move.rotation)
+            tetrominoFall_rotationCW(&piece);
+        tetrominoFall_shapeMaskFrom(&piece, &mask);
+        tetrominoFall_bitboardPlace(&bits, &mask, move.position.x - mask.pivot.x, move.position.y - mask.pivot.y);
+        lines += tetrominoFall_bitboardClearLines(&bits);
+
+        memmove(&queue[0], &queue[1], sizeof(queue[0]) * (count - 1));
+        tetrominoFall_nextShape(&generator, &queue[count - 1]);
+    }
+
+    totals->lines += lines;
+    totals->pieces += placed;
+    return lines;
+}
+
+static float meanLines(const AiWeights_St* weights, const TunerConfig_St* cfg, TunerTotals_St* totals) {
+    long lines = 0;
+    for (int g = 0; g < cfg->games; g++)
+        lines += playGame(weights, cfg->seed + (u32)g * 7919u, cfg, totals);
+
+    return (float)lines / (float)cfg->games;
+}
+
+static void printWeights(const AiWeights_St* weights) {
+    printf("const AiWeights_St defaultAiWeights = {{\n");
+    for (int i = 0; i < AI_FEATURE_COUNT; i++)
+        printf("    [%s]%*s= %.4ff,\n", featureNames[i], (int)(30 - strlen(featureNames[i])), "", weights->weights[i]);
+    printf("}};\n");
+}
+
+static bool parseArgs(int argc, char* argv[], TunerConfig_St* cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if      (strncmp(a, "--generations=", 14) == 0)    cfg->generations = atoi(a + 14);
+        else if (strncmp(a, "--games=", 8) == 0)           cfg->games = atoi(a + 8);
+        else if (strncmp(a, "--pieces=", 9) == 0)          cfg->pieces = atoi(a + 9);
+        else if (strncmp(a, "--previews=", 11) == 0)       cfg->previews = atoi(a + 11);
+        else if (strncmp(a, "--beam=", 7) == 0)            cfg->beamWidth = atoi(a + 7);
+        else if (strncmp(a, "--seed=", 7) == 0)            cfg->seed = (u32)strtoul(a + 7, NULL, 10);
+        else return false;
+    }
+    if (cfg->games < 1) cfg->games = 1;
+    if (cfg->previews < 0 || cfg->previews >= PLANNER_MAX_PIECES) cfg->previews = cfg->previews < 0 ? 0 : PLANNER_MAX_PIECES - 1;
+    return true;
+}
+
+static void printUsage(const char* self) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --generations=N      candidates tried (default 120)\n"
+        "  --games=N            games per candidate, same seeds for all (default 8)\n"
+        "  --pieces=N           pieces per game at most (default 20000)\n"
+        "  --previews=N         preview pieces the planner sees (default 0, max %d)\n"
+        "  --beam=N             planner beam width (default 1, the game uses %d)\n"
+        "  --seed=N             seed of the games and of the perturbations (default 1)\n",
+        self, PLANNER_MAX_PIECES - 1, AI_BEAM_WIDTH);
+}
+
+int main(int argc, char* argv[]) {
+    TunerConfig_St cfg = {
+        .generations = 120, .games = 8, .pieces = 20000, .previews = 0, .beamWidth = 1, .seed = 1
+    };
+    if (!parseArgs(argc, argv, &cfg)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    TunerTotals_St totals = {0};
+    u32 random = cfg.seed ^ 0xA5A5A5A5u;
+    float sigma = 0.3f;
+    clock_t start = clock();
+
+    AiWeights_St best = defaultAiWeights;
+    normalize(&best);
+    float bestLines = meanLines(&best, &cfg, &totals);
+    printf("[TUNER] start: %.1f lines per game\n", bestLines);
+
+    for (int gen = 1; gen <= cfg.generations; gen++) {
+        AiWeights_St candidate = best;
+        for (int i = 0; i < AI_FEATURE_COUNT; i++)
+            candidate.weights[i] += sigma * gaussian(&random);
+        normalize(&candidate);
+
+        float lines = meanLines(&candidate, &cfg, &totals);
+        bool kept = lines > bestLines;
+        if (kept) {
+            best = candidate;
+            bestLines = lines;
+        }
+
+        // 1/5th success rule: widen the steps while they pay off, narrow them otherwise
+        sigma *= kept ? 1.5f : 0.9f;
+        if (sigma < 0.02f) sigma = 0.02f;
+        if (sigma > 1.0f) sigma = 1.0f;
+
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("[TUNER] gen %3d: candidate %6.1f, best %6.1f lines per game%s | %.0f lines/CPU-s, %.0f pieces/CPU-s\n",
+               gen, lines, bestLines, kept ? " (kept)" : "",
+               totals.lines / seconds, totals.pieces / seconds);
+        fflush(stdout);
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("\n[TUNER] %llu lines and %llu pieces in %.1f CPU-s: %.0f lines/CPU-s\n",
+           (unsigned long long)totals.lines, (unsigned long long)totals.pieces, seconds, totals.lines / seconds);
+    printf("[TUNER] best: %.1f lines per game over %d games of at most %d pieces\n\n", bestLines, cfg.games, cfg.pieces);
+    printWeights(&best);
+
+    return 0;
+}
@@ -2,11 +2,17 @@
     @file test.c
     @author Fshimi-Hawlk
     @date 2026-02-06
-    @date 2026-04-14
-    @brief Unit tests for the Tetromino Fall core logic, covering collision detection, board placement, and rotations.
+    @date 2026-10-17
+    @brief Unit tests for the Tetromino Fall core logic, covering collision detection, board placement, rotations and the AI bitboard.
 */
+#include "core/algo.h"
+#include "core/bitboard.h"
 #include "core/board.h"
+#include "core/game.h"
+#include "core/planner.h"
 #include "core/shape.h"
+#include "core/simulation.h"
+#include "utils/globals.h"
 #include <assert.h>
 
 void test_areCoordinatesOOB(void);
@@ -17,6 +23,17 @@ void test_detectFullLines(void);
 void test_rotationCW(void);
 void test_rotationCCW(void);
 
+void test_bitboardCollision(void);
+void test_bitboardLines(void);
+void test_bitboardEvaluation(void);
+void test_planMove(void);
+void test_planMoveExhaustive(void);
+void test_findBestMoveSpeed(void);
+
+void test_pieceGenerator(void);
+void test_settleShape(void);
+void test_simulation(void);
+
 int main(void) {
     test_areCoordinatesOOB();
     test_isCollidingAt();
@@ -26,6 +43,17 @@ int main(void) {
     test_rotationCW();
     test_rotationCCW();
 
+    test_bitboardCollision();
+    test_bitboardLines();
+    test_bitboardEvaluation();
+    test_planMove();
+    test_planMoveExhaustive();
+    test_findBestMoveSpeed();
+
+    test_pieceGenerator();
+    test_settleShape();
+    test_simulation();
+
     return 0;
 }
 
@@ -33,26 +61,26 @@ void test_areCoordinatesOOB(void) {
     printf("=== Test areCoordinatesOOB ===\n");
     
     // Test valid coordinates (within bounds)
-    assert(!areCoordinatesOOB(0, 0));
+    assert(!tetrominoFall_areCoordinatesOOB(0, 0));
     printf("✓ Test (0, 0): valid\n");
     
-    assert(!areCoordinatesOOB(BOARD_WIDTH - 1, BOARD_HEIGHT - 1));
+    assert(!tetrominoFall_areCoordinatesOOB(BOARD_WIDTH - 1, BOARD_HEIGHT - 1));
     printf("✓ Test (%d, %d): valid\n", BOARD_WIDTH - 1, BOARD_HEIGHT - 1);
     
-    assert(!areCoordinatesOOB(5, 5));
+    assert(!tetrominoFall_areCoordinatesOOB(5, 5));
     printf("✓ Test (5, 5): valid\n");
     
     // Test invalid coordinates (out of bounds)
-    assert(areCoordinatesOOB(-1, 5));
+    assert(tetrominoFall_areCoordinatesOOB(-1, 5));
     printf("✓ Test (-1, 5): out of bounds (x < 0)\n");
     
-    assert(areCoordinatesOOB(BOARD_WIDTH, 5));
+    assert(tetrominoFall_areCoordinatesOOB(BOARD_WIDTH, 5));
     printf("✓ Test (%d, 5): out of bounds (x >= BOARD_WIDTH)\n", BOARD_WIDTH);
     
-    assert(areCoordinatesOOB(5, BOARD_HEIGHT));
+    assert(tetrominoFall_areCoordinatesOOB(5, BOARD_HEIGHT));
     printf("✓ Test (5, %d): out of bounds (y >= BOARD_HEIGHT)\n", BOARD_HEIGHT);
     
-    assert(areCoordinatesOOB(-1, BOARD_HEIGHT));
+    assert(tetrominoFall_areCoordinatesOOB(-1, BOARD_HEIGHT));
     printf("✓ Test (-1, %d): out of bounds (x < 0 AND y >= BOARD_HEIGHT)\n", BOARD_HEIGHT);
     
     printf("\n=== All tests passed! ===\n\n");
@@ -60,27 +88,27 @@ void test_areCoordinatesOOB(void) {
 
 void test_isCollidingAt(void) {
     printf("=== Test isCollidingAt ===\n");
-    board_t board;
-    initBoard(board);
+    Board_t board;
+    tetrominoFall_initBoard(board);
     
     // Create a simple shape (2x2 square)
-    boardShape_st shape = {
+    BoardShape_St shape = {
         .shape = {{0, 0}, {1, 0}, {0, 1}, {1, 1}},
         .position = {0, 0},
         .color = {255, 0, 0, 255}
     };
     
     // Test 1: no collision on empty board
-    assert(!isCollidingAt(board, shape, (iVector2){0, 0}));
+    assert(!tetrominoFall_isCollidingAt(board, shape, (iVector2){0, 0}));
     printf("✓ No collision on empty board\n");
     
     // Test 2: place a shape and verify collision
-    putShapeInBoard(board, shape);
-    assert(isCollidingAt(board, shape, (iVector2){0, 0}));
+    tetrominoFall_putShapeInBoard(board, shape);
+    assert(tetrominoFall_isCollidingAt(board, shape, (iVector2){0, 0}));
     printf("✓ Collision detected with placed shape\n");
     
     // Test 3: no collision if we shift position
-    assert(!isCollidingAt(board, shape, (iVector2){5, 5}));
+    assert(!tetrominoFall_isCollidingAt(board, shape, (iVector2){5, 5}));
     printf("✓ No collision at shifted position\n");
     
     printf("=== All isCollidingAt tests passed! ===\n\n");
@@ -88,10 +116,10 @@ void test_isCollidingAt(void) {
 
 void test_putShapeInBoard(void) {
     printf("=== Test putShapeInBoard ===\n");
-    board_t board;
-    initBoard(board);
+    Board_t board;
+    tetrominoFall_initBoard(board);
     
-    boardShape_st shape = {
+    BoardShape_St shape = {
         .shape = {{0, 0}, {1, 0}, {0, 1}, {1, 1}},
         .position = {3, 5},
         .color = {100, 150, 200, 255}
@@ -102,7 +130,7 @@ void test_putShapeInBoard(void) {
     printf("✓ Board empty before insertion\n");
     
     // Insert the shape
-    putShapeInBoard(board, shape);
+    tetrominoFall_putShapeInBoard(board, shape);
     
     // Verify the shape is placed
     assert(!ColorIsEqual(board[5][3], BOARD_BACKGROUND_COLOR));
@@ -120,15 +148,15 @@ void test_putShapeInBoard(void) {
 
 void test_detectFullLines(void) {
     printf("=== Test detectFullLines ===\n");
-    board_t board;
-    initBoard(board);
+    Board_t board;
+    tetrominoFall_initBoard(board);
     
     Color testColor = {255, 255, 255, 255};
     
     // Test 1: empty board, no complete lines
     int lineArray[4] = {0};
     int lineNb = 0;
-    detectFullLines(board, lineArray, &lineNb);
+    tetrominoFall_detectFullLines(board, lineArray, &lineNb);
     assert(lineNb == 0);
     printf("✓ Empty board: 0 complete lines\n");
     
@@ -137,7 +165,7 @@ void test_detectFullLines(void) {
         board[10][x] = testColor;
     }
     lineNb = 0;
-    detectFullLines(board, lineArray, &lineNb);
+    tetrominoFall_detectFullLines(board, lineArray, &lineNb);
     assert(lineNb == 1);
     assert(lineArray[0] == 10);
     printf("✓ One complete line detected at y=10\n");
@@ -147,7 +175,7 @@ void test_detectFullLines(void) {
         board[15][x] = testColor;
     }
     lineNb = 0;
-    detectFullLines(board, lineArray, &lineNb);
+    tetrominoFall_detectFullLines(board, lineArray, &lineNb);
     assert(lineNb == 2);
     printf("✓ Two complete lines detected\n");
     
@@ -158,7 +186,7 @@ void test_rotationCW(void) {
     printf("=== Test rotationCW ===\n");
     
     // Create L-shape (asymmetric to see rotation)
-    boardShape_st shape = {
+    BoardShape_St shape = {
         .shape = {{0, 0}, {1, 0}, {0, 1}, {0, 2}},
         .position = {0, 0},
         .color = {255, 0, 0, 255},
@@ -172,7 +200,7 @@ void test_rotationCW(void) {
     }
     
     // Test 1: clockwise rotation
-    rotationCW(&shape);
+    tetrominoFall_rotationCW(&shape);
     assert(shape.rotation == 1);
     printf("✓ Rotation counter at 1\n");
     
@@ -188,9 +216,9 @@ void test_rotationCW(void) {
     printf("✓ Coordinates modified after rotation\n");
     
     // Test 2: 4 rotations = return to original
-    rotationCW(&shape);
-    rotationCW(&shape);
-    rotationCW(&shape);
+    tetrominoFall_rotationCW(&shape);
+    tetrominoFall_rotationCW(&shape);
+    tetrominoFall_rotationCW(&shape);
     assert(shape.rotation == 0);
     printf("✓ 4 CW rotations = full rotation\n");
     
@@ -207,7 +235,7 @@ void test_rotationCCW(void) {
     printf("=== Test rotationCCW ===\n");
     
     // Create L-shape (asymmetric)
-    boardShape_st shape = {
+    BoardShape_St shape = {
         .shape = {{0, 0}, {1, 0}, {0, 1}, {0, 2}},
         .position = {0, 0},
         .color = {0, 255, 0, 255},
@@ -220,14 +248,14 @@ void test_rotationCCW(void) {
     }
     
     // Test 1: counter-clockwise rotation
-    rotationCCW(&shape);
+    tetrominoFall_rotationCCW(&shape);
     assert(shape.rotation == 3);
     printf("✓ Rotation counter at 3\n");
     
     // Test 2: 4 CCW rotations = return to original
-    rotationCCW(&shape);
-    rotationCCW(&shape);
-    rotationCCW(&shape);
+    tetrominoFall_rotationCCW(&shape);
+    tetrominoFall_rotationCCW(&shape);
+    tetrominoFall_rotationCCW(&shape);
     assert(shape.rotation == 0);
     printf("✓ 4 CCW rotations = full rotation\n");
     
@@ -238,8 +266,8 @@ void test_rotationCCW(void) {
     printf("✓ Coordinates back to original after 4 rotations\n");
     
     // Test 3: CW + CCW = identity
-    rotationCW(&shape);
-    rotationCCW(&shape);
+    tetrominoFall_rotationCW(&shape);
+    tetrominoFall_rotationCCW(&shape);
     assert(shape.rotation == 0);
     for (int i = 0; i < 4; i++) {
         assert(shape.shape[i].x == original[i].x);
@@ -249,3 +277,447 @@ void test_rotationCCW(void) {
     
     printf("=== All rotationCCW tests passed! ===\n\n");
 }
+
+/**
+    @brief Fills the `rows` bottom rows of a board at random, about `percent`% of the cells.
+*/
+static void randomBoard(Board_t board, int rows, int percent) {
+    tetrominoFall_initBoard(board);
+    for (int y = BOARD_HEIGHT - rows; y < BOARD_HEIGHT; y++)
+        for (int x = 0; x < BOARD_WIDTH; x++)
+            if (rand() % 100 < percent)
+                board[y][x] = tetraminosColors[rand() % SHAPE_MAX_ID];
+}
+
+/**
+    @brief The Color-grid evaluation the bitboard replaced, kept as the reference.
+*/
+static int referenceEvaluate(Board_t board) {
+    int holes = 0, aggregateHeight = 0, bumpiness = 0, completeLines = 0, maxHeight = 0;
+    int columnHeights[BOARD_WIDTH];
+
+    for (int x = 0; x < BOARD_WIDTH; x++) {
+        columnHeights[x] = 0;
+        bool blockFound = false;
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            if (!ColorIsEqual(board[y][x], BOARD_BACKGROUND_COLOR)) {
+                if (!blockFound) {
+                    blockFound = true;
+                    columnHeights[x] = BOARD_HEIGHT - y;
+                    aggregateHeight += columnHeights[x];
+                    if (columnHeights[x] > maxHeight) maxHeight = columnHeights[x];
+                }
+            } else if (blockFound) {
+                holes++;
+            }
+        }
+    }
+    for (int x = 0; x < BOARD_WIDTH - 1; x++)
+        bumpiness += abs(columnHeights[x] - columnHeights[x + 1]);
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        bool full = true;
+        for (int x = 0; x < BOARD_WIDTH && full; x++)
+            full = !ColorIsEqual(board[y][x], BOARD_BACKGROUND_COLOR);
+        completeLines += full;
+    }
+
+    return -10 * holes - 5 * aggregateHeight - bumpiness - 5 * maxHeight + 20 * completeLines;
+}
+
+void test_bitboardCollision(void) {
+    printf("=== Test bitboard collision ===\n");
+    srand(1);
+
+    Board_t board;
+    BitBoard_St bits;
+    int checks = 0;
+
+    for (int n = 0; n < 50; n++) {
+        randomBoard(board, 8, 40);
+        tetrominoFall_bitboardFromBoard(board, &bits);
+
+        for (int id = 0; id < SHAPE_MAX_ID; id++) {
+            BoardShape_St shape = { .rotation = 0, .shapeName = id };
+            memcpy(shape.shape, tetraminosShapes[id], sizeof(Tetromino_t));
+
+            for (int rot = 0; rot < 4; rot++) {
+                ShapeMask_St mask;
+                tetrominoFall_shapeMaskFrom(&shape, &mask);
+
+                for (int y = -2; y <= BOARD_HEIGHT; y++) {
+                    for (int x = -2; x <= BOARD_WIDTH + 1; x++) {
+                        bool expected = tetrominoFall_isCollidingAt(board, shape, (iVector2){x, y});
+                        assert(tetrominoFall_bitboardCollides(&bits, &mask, x - mask.pivot.x, y - mask.pivot.y) == expected);
+                        checks++;
+                    }
+                }
+
+                tetrominoFall_rotationCW(&shape);
+            }
+        }
+    }
+    printf("✓ %d positions agree with isCollidingAt\n", checks);
+
+    printf("=== All bitboard collision tests passed! ===\n\n");
+}
+
+void test_bitboardLines(void) {
+    printf("=== Test bitboard lines ===\n");
+
+    BitBoard_St bits = {0};
+    bits.rows[BOARD_HEIGHT - 1] = BOARD_FULL_ROW;
+    bits.rows[BOARD_HEIGHT - 2] = 0x0F0;
+    bits.rows[BOARD_HEIGHT - 3] = BOARD_FULL_ROW;
+    bits.rows[BOARD_HEIGHT - 4] = 0x001;
+
+    assert(tetrominoFall_bitboardClearLines(&bits) == 2);
+    assert(bits.rows[BOARD_HEIGHT - 1] == 0x0F0);
+    assert(bits.rows[BOARD_HEIGHT - 2] == 0x001);
+    assert(bits.rows[BOARD_HEIGHT - 3] == 0);
+    printf("✓ Two full lines cleared, the rows above dropped\n");
+
+    assert(tetrominoFall_bitboardClearLines(&bits) == 0);
+    printf("✓ Nothing cleared without a full line\n");
+
+    printf("=== All bitboard lines tests passed! ===\n\n");
+}
+
+void test_bitboardEvaluation(void) {
+    printf("=== Test bitboard evaluation ===\n");
+    srand(2);
+
+    Board_t board;
+    BoardFeatures_St features;
+    BitBoard_St bits;
+
+    // A column of 3 with a hole at its bottom, and a single block
+    tetrominoFall_initBoard(board);
+    board[BOARD_HEIGHT - 3][0] = CYAN;
+    board[BOARD_HEIGHT - 2][0] = CYAN;
+    board[BOARD_HEIGHT - 1][4] = CYAN;
+    tetrominoFall_bitboardFromBoard(board, &bits);
+    tetrominoFall_bitboardFeatures(&bits, &features);
+    assert(features.holes == 1 && features.aggregateHeight == 4 && features.maxHeight == 3);
+    assert(features.bumpiness == 3 + 1 + 1 && features.completeLines == 0);
+    assert(features.rowTransitions == 2 * (BOARD_HEIGHT - 3) + 2 + 2 + 4);
+    assert(features.columnTransitions == 1 + 0 + 2 + (BOARD_WIDTH - 1));
+    printf("✓ Holes, heights, bumpiness and transitions of a known board\n");
+
+    for (int n = 0; n < 1000; n++) {
+        randomBoard(board, 1 + rand() % BOARD_HEIGHT, rand() % 101);
+        assert(tetrominoFall_evaluateBoard(board) == referenceEvaluate(board));
+    }
+    printf("✓ Same score as the Color-grid evaluation on 1000 boards\n");
+
+    printf("=== All bitboard evaluation tests passed! ===\n\n");
+}
+
+/**
+    @brief Shape `id` in its spawn rotation, at its spawn position.
+*/
+static BoardShape_St spawnShape(int id) {
+    BoardShape_St shape = { .position = {4, 0}, .rotation = 0, .shapeName = id };
+    memcpy(shape.shape, tetraminosShapes[id], sizeof(Tetromino_t));
+    return shape;
+}
+
+/**
+    @brief Places a planned move on the bitboard and clears the lines.
+    @return The lines cleared.
+*/
+static int applyMove(BitBoard_St* bits, BoardShape_St shape, MoveAlgoResult_St move) {
+    ShapeMask_St mask;
+    while (shape.rotation != move.rotation)
+        tetrominoFall_rotationCW(&shape);
+    tetrominoFall_shapeMaskFrom(&shape, &mask);
+
+    assert(!tetrominoFall_bitboardCollides(bits, &mask, move.position.x - mask.pivot.x, move.position.y - mask.pivot.y));
+    tetrominoFall_bitboardPlace(bits, &mask, move.position.x - mask.pivot.x, move.position.y - mask.pivot.y);
+
+    return tetrominoFall_bitboardClearLines(bits);
+}
+
+/**
+    @brief Best score of `shape` dropped anywhere on `bits`, lines cleared counted.
+*/
+static float bestDropScore(const BitBoard_St* bits, BoardShape_St shape, int lines, const AiWeights_St* weights) {
+    float best = -INFINITY;
+
+    for (int rot = 0; rot < 4; rot++) {
+        ShapeMask_St mask;
+        tetrominoFall_shapeMaskFrom(&shape, &mask);
+
+        for (int col = 0; col < BOARD_WIDTH; col++) {
+            int left = col - mask.pivot.x;
+            int top = tetrominoFall_bitboardDrop(bits, &mask, left, -mask.pivot.y);
+            if (top + mask.pivot.y < 0) continue;
+
+            BitBoard_St temp = *bits;
+            tetrominoFall_bitboardPlace(&temp, &mask, left, top);
+            int cleared = tetrominoFall_bitboardClearLines(&temp);
+            float score = tetrominoFall_evaluateWeighted(&temp, lines + cleared, weights);
+            if (score > best) best = score;
+        }
+
+        tetrominoFall_rotationCW(&shape);
+    }
+
+    return best;
+}
+
+void test_planMove(void) {
+    printf("=== Test planMove ===\n");
+
+    BitBoard_St bits = {0};
+    PlannerConfig_St config = { .weights = NULL, .beamWidth = AI_BEAM_WIDTH };
+
+    // Four rows full but the right column: the I piece goes down the well standing
+    for (int y = BOARD_HEIGHT - 4; y < BOARD_HEIGHT; y++)
+        bits.rows[y] = BOARD_FULL_ROW & ~(1u << (BOARD_WIDTH - 1));
+
+    BoardShape_St pieces[2] = { spawnShape(I_SHAPE_ID), spawnShape(O_SHAPE_ID) };
+    MoveAlgoResult_St move = tetrominoFall_planMove(&bits, pieces, 2, &config);
+    assert(move.rotation == 1 || move.rotation == 3);
+    assert(applyMove(&bits, pieces[0], move) == 4);
+    for (int y = 0; y < BOARD_HEIGHT; y++) assert(bits.rows[y] == 0);
+    printf("✓ The I piece clears four lines in the well\n");
+
+    // The result is the findBestMove one
+    Board_t board;
+    srand(4);
+    for (int n = 0; n < 200; n++) {
+        randomBoard(board, 8, 60);
+        tetrominoFall_bitboardFromBoard(board, &bits);
+        pieces[0] = spawnShape(rand() % SHAPE_MAX_ID);
+        pieces[1] = spawnShape(rand() % SHAPE_MAX_ID);
+
+        MoveAlgoResult_St planned = tetrominoFall_planMove(&bits, pieces, 2, &config);
+        MoveAlgoResult_St found = tetrominoFall_findBestMove(board, pieces[0], pieces[1]);
+        assert(planned.rotation == found.rotation && planned.position.x == found.position.x && planned.position.y == found.position.y);
+    }
+    printf("✓ findBestMove plans the current and next pieces\n");
+
+    // Only a one-cell wide column left: the O piece lands nowhere
+    for (int y = 0; y < BOARD_HEIGHT; y++)
+        bits.rows[y] = BOARD_FULL_ROW & ~1u;
+    move = tetrominoFall_planMove(&bits, &pieces[1], 1, &config);
+    assert(move.rotation == -1);
+    printf("✓ No move when the piece cannot land\n");
+
+    // The T cannot spawn after any placement of the I: the current move still comes back
+    memset(&bits, 0, sizeof(bits));
+    for (int y = 1; y < BOARD_HEIGHT; y++)
+        bits.rows[y] = BOARD_FULL_ROW & ~(1u << (y % BOARD_WIDTH));
+    pieces[0] = spawnShape(I_SHAPE_ID);
+    pieces[1] = spawnShape(T_SHAPE_ID);
+    move = tetrominoFall_planMove(&bits, pieces, 2, &config);
+    assert(move.rotation == 0 && move.position.y == 0);
+    assert(applyMove(&bits, pieces[0], move) == 0);
+    printf("✓ The current piece is placed even when the game ends after it\n");
+
+    printf("=== All planMove tests passed! ===\n\n");
+}
+
+void test_planMoveExhaustive(void) {
+    printf("=== Test planMove against an exhaustive search ===\n");
+    srand(5);
+
+    // A beam wider than the placements of one piece keeps them all: two pieces are then searched exhaustively
+    PlannerConfig_St config = { .weights = NULL, .beamWidth = PLANNER_MAX_BEAM };
+    Board_t board;
+    BitBoard_St bits;
+
+    for (int n = 0; n < 300; n++) {
+        randomBoard(board, 1 + rand() % 10, 70);
+        tetrominoFall_bitboardFromBoard(board, &bits);
+        BoardShape_St pieces[2] = { spawnShape(rand() % SHAPE_MAX_ID), spawnShape(rand() % SHAPE_MAX_ID) };
+
+        // Best pair by brute force
+        float best = -INFINITY;
+        BoardShape_St shape = pieces[0];
+        for (int rot = 0; rot < 4; rot++) {
+            ShapeMask_St mask;
+            tetrominoFall_shapeMaskFrom(&shape, &mask);
+            for (int col = 0; col < BOARD_WIDTH; col++) {
+                int left = col - mask.pivot.x;
+                int top = tetrominoFall_bitboardDrop(&bits, &mask, left, -mask.pivot.y);
+                if (top + mask.pivot.y < 0) continue;
+
+                BitBoard_St placed = bits;
+                tetrominoFall_bitboardPlace(&placed, &mask, left, top);
+                int lines = tetrominoFall_bitboardClearLines(&placed);
+                float score = bestDropScore(&placed, pieces[1], lines, &defaultAiWeights);
+                if (score > best) best = score;
+            }
+            tetrominoFall_rotationCW(&shape);
+        }
+
+        // The planned move reaches it
+        MoveAlgoResult_St move = tetrominoFall_planMove(&bits, pieces, 2, &config);
+        BitBoard_St placed = bits;
+        int lines = applyMove(&placed, pieces[0], move);
+        assert(bestDropScore(&placed, pieces[1], lines, &defaultAiWeights) == best);
+    }
+    printf("✓ 300 boards: the planned move leads to the best pair of placements\n");
+
+    printf("=== All exhaustive planMove tests passed! ===\n\n");
+}
+
+void test_findBestMoveSpeed(void) {
+    printf("=== Test findBestMove speed ===\n");
+    srand(3);
+
+    Board_t board;
+    BoardShape_St shape = {0}, nextShape = {0};
+    int calls = 0;
+    clock_t start = clock();
+
+    while (clock() - start < CLOCKS_PER_SEC / 2) {
+        randomBoard(board, 6, 50);
+        tetrominoFall_randomShape(&shape);
+        tetrominoFall_randomShape(&nextShape);
+
+        MoveAlgoResult_St move = tetrominoFall_findBestMove(board, shape, nextShape);
+        assert(move.rotation >= 0 && move.rotation < 4);
+        calls++;
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("✓ %.0f decisions/s with one preview and a beam of %d\n", calls / seconds, AI_BEAM_WIDTH);
+
+    // Deeper look-ahead, as the tuner can run it
+    BitBoard_St bits;
+    BoardShape_St pieces[4] = {0};
+    PlannerConfig_St config = { .weights = NULL, .beamWidth = 64 };
+    calls = 0;
+    start = clock();
+
+    while (clock() - start < CLOCKS_PER_SEC / 2) {
+        randomBoard(board, 6, 50);
+        tetrominoFall_bitboardFromBoard(board, &bits);
+        for (int i = 0; i < 4; i++)
+            tetrominoFall_randomShape(&pieces[i]);
+
+        MoveAlgoResult_St move = tetrominoFall_planMove(&bits, pieces, 4, &config);
+        assert(move.rotation >= 0 && move.rotation < 4);
+        calls++;
+    }
+
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("✓ %.0f decisions/s with three previews and a beam of 64\n", calls / seconds);
+
+    printf("=== All findBestMove speed tests passed! ===\n\n");
+}
+
+void test_pieceGenerator(void) {
+    printf("=== Test piece generator ===\n");
+
+    PieceGenerator_St a, b;
+    BoardShape_St pa, pb;
+    int counts[SHAPE_MAX_ID] = {0};
+    bool differs = false;
+
+    tetrominoFall_seedShapes(&a, 42);
+    tetrominoFall_seedShapes(&b, 42);
+    for (int i = 0; i < 7000; i++) {
+        tetrominoFall_nextShape(&a, &pa);
+        tetrominoFall_nextShape(&b, &pb);
+        assert(pa.shapeName == pb.shapeName && pa.rotation == 0);
+        assert(pa.position.x == 4 && pa.position.y == 0);
+        assert(!memcmp(pa.shape, tetraminosShapes[pa.shapeName], sizeof(Tetromino_t)));
+        counts[pa.shapeName]++;
+    }
+    printf("✓ The same seed deals the same pieces\n");
+
+    for (int id = 0; id < SHAPE_MAX_ID; id++)
+        assert(counts[id] > 800 && counts[id] < 1200);
+    printf("✓ The seven shapes come about as often\n");
+
+    tetrominoFall_seedShapes(&a, 42);
+    tetrominoFall_seedShapes(&b, 43);
+    for (int i = 0; i < 20 && !differs; i++) {
+        tetrominoFall_nextShape(&a, &pa);
+        tetrominoFall_nextShape(&b, &pb);
+        differs = pa.shapeName != pb.shapeName;
+    }
+    assert(differs);
+    printf("✓ Another seed deals other pieces\n");
+
+    printf("=== All piece generator tests passed! ===\n\n");
+}
+
+void test_settleShape(void) {
+    printf("=== Test settleShape ===\n");
+
+    TetrominoFallGame_St game = {0};
+    tetrominoFall_initBoard(game.board);
+    tetrominoFall_seedShapes(&game.generator, 7);
+    game.boardShape = spawnShape(I_SHAPE_ID);
+    tetrominoFall_nextShape(&game.generator, &game.nextBoardShape);
+    game.speed.duration = 1.0f;
+
+    // A row full but for the four cells the I fills
+    for (int x = 0; x < BOARD_WIDTH; x++)
+        if (x < 3 || x > 6) game.board[BOARD_HEIGHT - 1][x] = CYAN;
+
+    assert(tetrominoFall_settleShape(&game) == GAME_STEP_FALLING);
+    printf("✓ A falling piece stays in play\n");
+
+    // One frame of a second per row: one row per step, the lock when it goes through the floor
+    int steps = 0;
+    GameStep_Et step;
+    do {
+        tetrominoFall_automaticDrop(&game.speed, &game.boardShape, 1.0f);
+        step = tetrominoFall_settleShape(&game);
+        steps++;
+    } while (step == GAME_STEP_FALLING);
+
+    assert(step == GAME_STEP_LOCKED && steps == BOARD_HEIGHT);
+    assert(game.clearedLineAmount == 1 && game.score == 40);
+    for (int x = 0; x < BOARD_WIDTH; x++)
+        assert(ColorIsEqual(game.board[BOARD_HEIGHT - 1][x], BOARD_BACKGROUND_COLOR));
+    printf("✓ The I locks on the floor and clears the line\n");
+
+    printf("=== All settleShape tests passed! ===\n\n");
+}
+
+void test_simulation(void) {
+    printf("=== Test headless simulation ===\n");
+
+    SimulationConfig_St config;
+    SimulationStats_St stats = {0}, again = {0};
+    TetrominoFallGame_St first, second;
+    tetrominoFall_defaultSimulation(&config);
+    config.maxPieces = 60;
+
+    // A seed always plays the same game
+    tetrominoFall_simulateGame(&first, &config, 11, &stats);
+    tetrominoFall_simulateGame(&second, &config, 11, &again);
+    assert(!memcmp(first.board, second.board, sizeof(Board_t)));
+    assert(first.score == second.score && first.clearedLineAmount == second.clearedLineAmount);
+    assert(!memcmp(&stats, &again, sizeof(stats)));
+    assert(stats.games == 1 && stats.pieces == 60 && stats.lines > 0 && stats.evaluations > 0);
+    printf("✓ Seed 11 plays the same 60 pieces twice: %llu lines, %llu frames\n",
+           (unsigned long long)stats.lines, (unsigned long long)stats.frames);
+
+    // Without the cap the game goes on until the top-out: a beam of 1 and a bad weight get there fast
+    AiWeights_St reckless = {{ [AI_FEATURE_AGGREGATE_HEIGHT] = 1.0f }};
+    config.maxPieces = 0;
+    config.planner = (PlannerConfig_St){ .weights = &reckless, .beamWidth = 1 };
+    memset(&stats, 0, sizeof(stats));
+    tetrominoFall_simulateGame(&first, &config, 3, &stats);
+    assert(stats.pieces > 0 && stats.pieces < 200);
+    assert(!tetrominoFall_isOOB(first.boardShape) && tetrominoFall_isColliding(first.board, first.boardShape));
+    printf("✓ A game without a cap ends on the top-out, after %llu pieces\n", (unsigned long long)stats.pieces);
+
+    // Throughput of the default AI on short games
+    tetrominoFall_defaultSimulation(&config);
+    config.games = 100;
+    config.maxPieces = 20;
+    tetrominoFall_simulate(&config, &stats);
+    assert(stats.games == 100 && stats.pieces == 2000);
+    printf("✓ %.0f games/s, %.0f pieces/s, %.1f evaluations per piece\n",
+           stats.games / stats.cpuSeconds, stats.pieces / stats.cpuSeconds, (double)stats.evaluations / stats.pieces);
+
+    printf("=== All headless simulation tests passed! ===\n\n");
+}
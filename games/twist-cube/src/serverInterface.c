@@ -16,6 +16,9 @@
 #include "APIs/generalAPI.h"
 #include "networkInterface.h"
 
+#define RUBIK_ELIMINATION_DELAY 30.0f  ///< Seconds between two eliminations
+#define RUBIK_IDLE_SLEEP_MS     1000   ///< Tick interval outside of a race
+
 /**
     @brief Definition of enum RubikActionCodes_e
 */
@@ -46,13 +49,16 @@ typedef struct {
     int seed;
 } RubikServerState;
 
+void twistCube_initInstance(void* state) {
+    RubikServerState* rs = (RubikServerState*)state;
+    rs->status = 0;
+    rs->seed = (int)time(NULL);
+    rs->eliminationTimer = 0;
+}
+
 void* twistCube_createInstance(void) {
     RubikServerState* rs = calloc(1, sizeof(RubikServerState));
-    if (rs) {
-        rs->status = 0;
-        rs->seed = (int)time(NULL);
-        rs->eliminationTimer = 0;
-    }
+    if (rs) twistCube_initInstance(rs);
     return rs;
 }
 
@@ -79,7 +85,7 @@ void twistCube_onAction(void *state, s32 roomId, s32 playerId, u8 action, const
         u16 netId = htons((u16)internalId);
         u8 bufAck[64];
         memset(bufAck, 0, sizeof(bufAck));
-        GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_TWIST_CUBE, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)) };
+        GameTLVHeader_St tlvAck = { .gameId = MINI_GAME_ID_TWIST_CUBE, .action = ACTION_CODE_JOIN_ACK, .length = htons(sizeof(u16)), .isReliable = true };
         memcpy(bufAck, &tlvAck, sizeof(tlvAck));
         memcpy(bufAck + sizeof(tlvAck), &netId, sizeof(u16));
         broadcast(UNICAST, playerId, ACTION_CODE_GAME_DATA, bufAck, sizeof(tlvAck) + sizeof(u16));
@@ -87,13 +93,13 @@ void twistCube_onAction(void *state, s32 roomId, s32 playerId, u8 action, const
     else if (realAction == ACTION_CODE_START_GAME) {
         log_info("[RUBIK] Room %d: Game starting (triggered by player %d)", roomId, playerId);
         rs->status = 1;
-        rs->eliminationTimer = 30.0f;
+        rs->eliminationTimer = RUBIK_ELIMINATION_DELAY;
         rs->seed = (int)time(NULL);
         u32 net_seed = htonl((u32)rs->seed);
 
         u8 buf[64];
         memset(buf, 0, sizeof(buf));
-        GameTLVHeader_St tlv_scr = { .gameId = MINI_GAME_ID_TWIST_CUBE, .action = ACTION_CODE_RUBIK_SCRAMBLE, .length = htons(sizeof(u32)) };
+        GameTLVHeader_St tlv_scr = { .gameId = MINI_GAME_ID_TWIST_CUBE, .action = ACTION_CODE_RUBIK_SCRAMBLE, .length = htons(sizeof(u32)), .isReliable = true };
         memcpy(buf, &tlv_scr, sizeof(tlv_scr));
         memcpy(buf + sizeof(tlv_scr), &net_seed, sizeof(u32));
         broadcast(roomId, -1, ACTION_CODE_GAME_DATA, buf, sizeof(tlv_scr) + sizeof(u32));    }
@@ -105,12 +111,55 @@ void twistCube_onAction(void *state, s32 roomId, s32 playerId, u8 action, const
     }
 }
 
-void twistCube_onTick(void* state) {
+/**
+    @brief Battle royale clock: every RUBIK_ELIMINATION_DELAY seconds the
+           least advanced player still in the race is eliminated.
+
+    Progress only changes through actions, so the room sleeps until the
+    next elimination is due.
+*/
+void twistCube_onRoomTick(void* state, ServerTickContext_St* ctx) {
     RubikServerState* rs = (RubikServerState*)state;
-    if (rs->status != 1) return;
-    
-    // Battle Royale Logic: Eliminate weakest every 30s
-    // Simplified for now: just a placeholder logic
+    if (rs->status != 1) {
+        ctx->sleepMs = RUBIK_IDLE_SLEEP_MS;
+        return;
+    }
+
+    rs->eliminationTimer -= ctx->dt;
+    if (rs->eliminationTimer > 0.0f) {
+        ctx->sleepMs = (u32)(rs->eliminationTimer * 1000.0f) + 1;
+        return;
+    }
+
+    int weakest = -1;
+    int remaining = 0;
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        RubikPlayer* p = &rs->players[i];
+        if (!p->active || p->eliminated) continue;
+        remaining++;
+        if (weakest == -1 || p->progress < rs->players[weakest].progress) weakest = i;
+    }
+
+    if (remaining > 1) {
+        rs->players[weakest].eliminated = true;
+        log_info("[RUBIK] Room %d: player %d eliminated (%.0f%%)", ctx->roomId, weakest, rs->players[weakest].progress);
+
+        u32 netId = htonl((u32)weakest);
+        u8 buf[64];
+        GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_TWIST_CUBE, .action = ACTION_CODE_RUBIK_ELIMINATE, .length = htons(sizeof(u32)), .isReliable = true };
+        memcpy(buf, &tlv, sizeof(tlv));
+        memcpy(buf + sizeof(tlv), &netId, sizeof(u32));
+        ctx->broadcast(ctx->roomId, -1, ACTION_CODE_GAME_DATA, buf, sizeof(tlv) + sizeof(u32));
+        remaining--;
+    }
+
+    if (remaining <= 1) {
+        rs->status = 0;
+        ctx->sleepMs = RUBIK_IDLE_SLEEP_MS;
+        return;
+    }
+    rs->eliminationTimer = RUBIK_ELIMINATION_DELAY;
+    ctx->sleepMs = (u32)(RUBIK_ELIMINATION_DELAY * 1000.0f);
 }
 
 void twistCube_onPlayerLeave(void* state, s32 playerId) {
@@ -127,7 +176,9 @@ GameServerInterface_St twistCube_serverInterface = {
     .gameName = "Twist Cube",
     .createInstance = twistCube_createInstance,
     .onAction = twistCube_onAction,
-    .onTick = twistCube_onTick,
+    .onRoomTick = twistCube_onRoomTick,
     .onPlayerLeave = twistCube_onPlayerLeave,
-    .destroyInstance = twistCube_destroyInstance
+    .destroyInstance = twistCube_destroyInstance,
+    .instanceSize = sizeof(RubikServerState),
+    .initInstance = twistCube_initInstance
 };
@@ -106,4 +106,29 @@ void lobby_choosePlayerTexture(PlayerVisuals_St* const visuals, Player_St* const
  */
 void lobby_toggleSkinMenu(PlayerVisuals_St* const visuals);
 
+// ────────────────────────────────────────────────
+// Network pose quantization
+// ────────────────────────────────────────────────
+
+/**
+    @brief Packs a position and rotation into the wire pose.
+
+    Coordinates are rounded to 1 / LOBBY_POS_QUANT pixel and clamped to the
+    s16 range; the angle is wrapped to one turn and stored on 256 steps.
+
+    @param position  World position in pixels
+    @param angle     Rotation in degrees (any range)
+    @return Pose in network byte order
+ */
+LobbyPoseNet_St lobby_quantizePose(const Vector2 position, const f32 angle);
+
+/**
+    @brief Unpacks a wire pose.
+
+    @param pose      Pose in network byte order
+    @param position  Receives the world position in pixels
+    @param angle     Receives the rotation in degrees, in [0, 360)
+ */
+void lobby_dequantizePose(const LobbyPoseNet_St* const pose, Vector2* const position, f32* const angle);
+
 #endif // CORE_GAME_H
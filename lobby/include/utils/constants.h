@@ -81,4 +81,17 @@
 #define LEAF_DRIFT_FREQUENCY    0.25f     //< slow, long curves (still visible even if flutter = 0)
 #define LEAF_DRIFT_AMPLITUDE    135.0f     //< strength of the gentle curving drift
 
+// ────────────────────────────────────────────────
+// Network replication of the other players
+// ────────────────────────────────────────────────
+
+#define LOBBY_SNAPSHOT_HZ        20         ///< Position snapshots the server sends per second.
+#define LOBBY_MOVE_SEND_HZ       20         ///< Maximum position updates per second a client sends.
+#define LOBBY_POS_QUANT          2.0f       ///< Wire steps per pixel (s16 coordinates cover ±16383 px).
+#define LOBBY_AOI_ENTER_RADIUS   1400.0f    ///< Distance under which another player becomes visible.
+#define LOBBY_AOI_LEAVE_RADIUS   1600.0f    ///< Distance over which a visible player is dropped (hysteresis).
+#define LOBBY_SNAPSHOT_REFRESH   20         ///< Every N snapshots, resend every visible player even if still (loss recovery).
+#define LOBBY_INTERP_DELAY       0.1f       ///< Remote players are drawn this far (seconds) behind the newest snapshot.
+#define LOBBY_JITTER_SLOTS       8          ///< Snapshots buffered per remote player.
+
 #endif
\ No newline at end of file
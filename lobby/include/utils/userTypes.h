@@ -147,19 +147,73 @@ typedef struct {
     Texture   textures[__playerTextureCount];
 } PlayerVisuals_St;
 
+/**
+    @brief Lobby action codes carried in the game TLV (gameId MINI_GAME_ID_LOBBY).
+           ACTION_CODE_LOBBY_MOVE (client -> server, LobbyPoseNet_St) and
+           ACTION_CODE_LOBBY_CHAT keep their base codes.
+*/
+enum {
+    ACTION_CODE_LOBBY_PLAYER_INFO = firstAvailableActionCode,   ///< Both ways, reliable: LobbyPlayerInfoNet_St records (on join / skin change)
+    ACTION_CODE_LOBBY_SNAPSHOT,                                 ///< Server -> client, unreliable: LobbySnapshotHeader_St + LobbySnapshotEntry_St[count]
+    ACTION_CODE_LOBBY_PLAYER_GONE                               ///< Server -> client, reliable: u8 ids that left the area of interest
+};
+
 #pragma pack(push, 1)
 /**
- * @brief Simplified player structure for network transmission.
- */
+    @brief Quantized player pose on the wire (coordinates in network byte order).
+*/
+typedef struct {
+    s16   x, y;         ///< Position * LOBBY_POS_QUANT
+    u8    angle;        ///< Rotation, 256 steps per turn
+} LobbyPoseNet_St;
+
+/**
+    @brief Identity of a lobby player, sent once on join and again on skin change.
+*/
 typedef struct {
-    f32   x, y;
-    f32   angle;
+    u8    playerId;     ///< Filled in by the server (ignored client -> server)
     u8    textureId;
-    bool  active;
     char  name[32];
-} PlayerNet_St;
+} LobbyPlayerInfoNet_St;
+
+/**
+    @brief Header of a batched position snapshot (network byte order).
+*/
+typedef struct {
+    u32   serverTimeMs; ///< Room clock when the snapshot was taken
+    u8    count;        ///< Entries following the header
+} LobbySnapshotHeader_St;
+
+/**
+    @brief One player in a snapshot: new in the area of interest, moved, or periodic refresh.
+*/
+typedef struct {
+    u8              playerId;
+    LobbyPoseNet_St pose;
+} LobbySnapshotEntry_St;
 #pragma pack(pop)
 
+#if MAX_CLIENTS > 256
+    #error "Lobby snapshots carry player ids on one byte"
+#endif
+
+/**
+    @brief One received pose of a remote player, stamped with the server time.
+*/
+typedef struct {
+    f64     time;
+    Vector2 position;
+    f32     angle;
+} PoseSample_St;
+
+/**
+    @brief Jitter buffer of a remote player: poses in server-time order, oldest first.
+*/
+typedef struct {
+    PoseSample_St samples[LOBBY_JITTER_SLOTS];
+    u32           count;
+} PoseJitterBuffer_St;
+
 /**
     @brief Physics and movement state of the player character in the lobby.
 */
@@ -187,7 +241,7 @@ typedef struct {
     bool    onIce;
     f32     portalTeleportCooldown;
 
-    Vector2 targetPosition; // Network sync
+    PoseJitterBuffer_St netPoses; // Network sync (remote players only)
 } Player_St;
 
 /**
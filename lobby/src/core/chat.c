@@ -59,7 +59,7 @@ void updateChat(void) {
         if (IsKeyPressed(KEY_ENTER)) {
             if (lobby_game.chat.inputPos > 0 && networkSocket != -1) {
                 u16 payloadLen = (u16)strlen(lobby_game.chat.inputBuffer) + 1;
-                GameTLVHeader_St tlv = { .gameId = 0, .action = ACTION_CODE_LOBBY_CHAT, .length = htons(payloadLen) };
+                GameTLVHeader_St tlv = { .gameId = 0, .action = ACTION_CODE_LOBBY_CHAT, .length = htons(payloadLen), .isReliable = true };
                 RUDPHeader_St h; rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
                 h.senderId = htons((u16)lobby_game.clientId);
                 
@@ -70,6 +70,7 @@ void updateChat(void) {
                 memcpy(buffer + offset, lobby_game.chat.inputBuffer, payloadLen); offset += (size_t)payloadLen;
                 
                 send(networkSocket, buffer, offset, 0);
+                rudpTrackReliable(&serverConnection, buffer, (u16)offset);
                 addChatMessage(TextFormat("%s >", lobby_game.player.name), lobby_game.chat.inputBuffer);
                 lobby_game.chat.inputPos = 0;
                 lobby_game.chat.inputBuffer[0] = '\0';
@@ -361,3 +361,23 @@ void lobby_toggleSkinMenu(PlayerVisuals_St* const visuals) {
         visuals->isTextureMenuOpen = !visuals->isTextureMenuOpen;
     }
 }
+
+LobbyPoseNet_St lobby_quantizePose(const Vector2 position, const f32 angle) {
+    f32 qx = Clamp(roundf(position.x * LOBBY_POS_QUANT), -32767.0f, 32767.0f);
+    f32 qy = Clamp(roundf(position.y * LOBBY_POS_QUANT), -32767.0f, 32767.0f);
+
+    f32 turn = fmodf(angle, 360.0f);
+    if (turn < 0.0f) turn += 360.0f;
+
+    return (LobbyPoseNet_St) {
+        .x     = (s16)htons((u16)(s16)qx),
+        .y     = (s16)htons((u16)(s16)qy),
+        .angle = (u8)((u32)lroundf(turn * 256.0f / 360.0f) & 0xFF),
+    };
+}
+
+void lobby_dequantizePose(const LobbyPoseNet_St* const pose, Vector2* const position, f32* const angle) {
+    position->x = (s16)ntohs((u16)pose->x) / LOBBY_POS_QUANT;
+    position->y = (s16)ntohs((u16)pose->y) / LOBBY_POS_QUANT;
+    *angle = pose->angle * 360.0f / 256.0f;
+}
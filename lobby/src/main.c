@@ -136,6 +136,7 @@ void initNetwork(const char* ip, const char* pseudo) {
     serverAddr.sin_port = htons(8080);
     inet_pton(AF_INET, ip, &serverAddr.sin_addr);
 
+    rudpReleaseConnection(&serverConnection);
     rudpInitConnection(&serverConnection);
 
     // Connect socket to allow using send() instead of sendto() for gameplay
@@ -150,7 +151,9 @@ void initNetwork(const char* ip, const char* pseudo) {
     memcpy(buf, &h, sizeof(h));
     strncpy((char*)buf + sizeof(h), pseudo, 31);
 
-    send(networkSocket, buf, sizeof(h) + strlen(pseudo) + 1, 0);
+    u16 joinLen = (u16)(sizeof(h) + strlen(pseudo) + 1);
+    send(networkSocket, buf, joinLen, 0);
+    rudpTrackReliable(&serverConnection, buf, joinLen);
     log_info("Sent JOIN_GAME for player '%s'", pseudo);
 
     int flags = fcntl(networkSocket, F_GETFL, 0);
@@ -159,6 +162,101 @@ void initNetwork(const char* ip, const char* pseudo) {
     log_info("Network initialized towards %s:8080", ip);
 }
 
+// RUDPSend_Ft adapter for retransmissions over the connected socket
+static void sendToServer(void* userData, const u8* data, u16 length) {
+    (void)userData;
+    send(networkSocket, data, length, 0);
+}
+
+/**
+    @brief Sends a bare ack if nothing outgoing piggybacked one, then resends expired reliable packets.
+*/
+static void serviceReliability(void) {
+    if (serverConnection.ackPending) {
+        RUDPHeader_St ack;
+        rudpGenerateHeader(&serverConnection, RUDP_ACTION_ACK_ONLY, &ack);
+        ack.senderId = htons((u16) lobby_game.clientId);
+        send(networkSocket, &ack, sizeof(ack), 0);
+    }
+    rudpResendExpired(&serverConnection, sendToServer, NULL);
+}
+
+/**
+    @brief Routes one server message (plain datagram or bundle record) to its handler.
+*/
+static void handleServerMessage(u16 senderId, u8 action, u8* payload, u16 payloadLen) {
+    if (action == ACTION_CODE_JOIN_ERROR) {
+        log_error("[NET] Join rejected by server: %s", (char*)payload);
+        lobby_setConnectionError((char*)payload);
+        lobby_game.currentState = GAME_STATE_CONNECTION;
+        // Reset network state if needed
+        rudpReleaseConnection(&serverConnection);
+        rudpInitConnection(&serverConnection);
+
+    } else if (action == ACTION_CODE_LOBBY_ROOM_INFO) {
+        lobby_handleRoomList(payload, payloadLen / sizeof(RoomInfo_St));
+
+    } else if (action == ACTION_CODE_LOBBY_SWITCH_GAME) {
+        if (payloadLen < sizeof(SwitchGamePayload_St)) return;
+        SwitchGamePayload_St confirm;
+        memcpy(&confirm, payload, sizeof(confirm));
+        u8 nextGame = confirm.gameId;
+        log_info("[NET] Server confirmed switch to Game %d, Room %u (gen %u)", nextGame, ntohs(confirm.roomId), ntohs(confirm.generation));
+
+        lobby_closeRoomSelector();
+
+        if (nextGame < __miniGameIdCount) {
+            if (currentMiniGame && currentMiniGame->destroy) {
+                currentMiniGame->destroy();
+            }
+            currentMiniGameID = (MiniGameId_Et) nextGame;
+            currentMiniGame = miniGameInterfaces[currentMiniGameID];
+            if (currentMiniGame && currentMiniGame->init) currentMiniGame->init();
+            lobby_game.currentState = (nextGame == MINI_GAME_ID_LOBBY) ? GAME_STATE_GAMEPLAY : GAME_STATE_INGAME;
+            if (nextGame == MINI_GAME_ID_LOBBY) lobby_initWaitingRoom();
+        }
+
+    } else if (action == ACTION_CODE_GAME_DATA) {
+        if (payloadLen < sizeof(GameTLVHeader_St)) return;
+
+        GameTLVHeader_St tlv;
+        memcpy(&tlv, payload, sizeof(tlv));
+        u16 tlv_data_len = ntohs(tlv.length);
+        
+        if (tlv_data_len <= payloadLen - sizeof(GameTLVHeader_St)) {
+            if (tlv.gameId < __miniGameIdCount && miniGameInterfaces[tlv.gameId]) {
+                miniGameInterfaces[tlv.gameId]->onData(senderId, tlv.action, payload + sizeof(tlv), tlv_data_len);
+            }
+        }
+
+    } else if (currentMiniGame && currentMiniGame->onData) {
+        if (action < firstAvailableActionCode || action == ACTION_CODE_JOIN_ACK) {
+            currentMiniGame->onData(senderId, action, payload, payloadLen);
+        }
+    }
+}
+
+/**
+    @brief Splits an ACTION_CODE_BUNDLE payload into its records and handles each in order.
+*/
+static void handleBundle(u8* payload, u16 payloadLen) {
+    u16 offset = 0;
+    while (offset + sizeof(BundleRecordHeader_St) <= payloadLen) {
+        BundleRecordHeader_St record;
+        memcpy(&record, payload + offset, sizeof(record));
+        offset += sizeof(record);
+
+        u16 length = ntohs(record.length);
+        if (length > payloadLen - offset) {
+            log_warn("[NET] Truncated bundle record (%u > %u bytes left)", length, payloadLen - offset);
+            return;
+        }
+
+        handleServerMessage(ntohs(record.senderId), record.action, payload + offset, length);
+        offset += length;
+    }
+}
+
 void receiveNetworkData(void) {
     if (networkSocket < 0) return;
 
@@ -189,60 +287,17 @@ void receiveNetworkData(void) {
             }
 
             if (!rudpProcessIncoming(&serverConnection, &header)) continue;
+            if (header.action == RUDP_ACTION_ACK_ONLY) continue;
         
             u8* payload = buffer + sizeof(RUDPHeader_St);
             u16 payloadLen = (u16) (bytesRead - sizeof(RUDPHeader_St));
-            u16 senderId = ntohs(header.senderId);
-
-            if (header.action == ACTION_CODE_JOIN_ERROR) {
-                log_error("[NET] Join rejected by server: %s", (char*)payload);
-                lobby_setConnectionError((char*)payload);
-                lobby_game.currentState = GAME_STATE_CONNECTION;
-                // Reset network state if needed
-                rudpInitConnection(&serverConnection);
-
-            } else if (header.action == ACTION_CODE_LOBBY_ROOM_INFO) {
-                lobby_handleRoomList(payload, payloadLen / sizeof(RoomInfo_St));
-
-            } else if (header.action == ACTION_CODE_LOBBY_SWITCH_GAME) {
-                if (payloadLen < 2) return;
-                u8 nextGame = payload[0];
-                u8 roomId = payload[1];
-                log_info("[NET] Server confirmed switch to Game %d, Room %d", nextGame, roomId);
-
-                lobby_closeRoomSelector();
 
-                if (nextGame < __miniGameIdCount) {
-                    if (currentMiniGame && currentMiniGame->destroy) {
-                        currentMiniGame->destroy();
-                    }
-                    currentMiniGameID = (MiniGameId_Et) nextGame;
-                    currentMiniGame = miniGameInterfaces[currentMiniGameID];
-                    if (currentMiniGame && currentMiniGame->init) currentMiniGame->init();
-                    lobby_game.currentState = (nextGame == MINI_GAME_ID_LOBBY) ? GAME_STATE_GAMEPLAY : GAME_STATE_INGAME;
-                    if (nextGame == MINI_GAME_ID_LOBBY) lobby_initWaitingRoom();
-                }
-
-            } else if (header.action == ACTION_CODE_GAME_DATA) {
-                if (payloadLen < sizeof(GameTLVHeader_St)) return;
-
-                GameTLVHeader_St tlv;
-                memcpy(&tlv, payload, sizeof(tlv));
-                u16 tlv_data_len = ntohs(tlv.length);
-                
-                if (tlv_data_len <= payloadLen - sizeof(GameTLVHeader_St)) {
-                    if (tlv.gameId < __miniGameIdCount && miniGameInterfaces[tlv.gameId]) {
-                        miniGameInterfaces[tlv.gameId]->onData(senderId, tlv.action, payload + sizeof(tlv), tlv_data_len);
-                    }
-                }
-
-            } else if (currentMiniGame && currentMiniGame->onData) {
-                if (header.action < firstAvailableActionCode || header.action == ACTION_CODE_JOIN_ACK) {
-                    currentMiniGame->onData(senderId, header.action, payload, payloadLen);
-                }
-            }
+            if (header.action == ACTION_CODE_BUNDLE) handleBundle(payload, payloadLen);
+            else handleServerMessage(ntohs(header.senderId), header.action, payload, payloadLen);
         }
     }
+
+    serviceReliability();
 }
 
 void spawn_server(void) {
@@ -24,10 +24,136 @@
 
 #include "utils/globals.h"
 
-static f32Vector2 lastSentPos = {0};
-static bool firstFrame = true;
+#define SNAPSHOT_INTERVAL       (1.0 / LOBBY_SNAPSHOT_HZ)
+#define MOVE_KEEPALIVE          1.0f    ///< An unchanged pose is still resent this often (seconds), in case the last one was lost
+
+static LobbyPoseNet_St lastSentPose = {0};
+static bool poseSent = false;
+static f32  moveSendTimer = 0.0f;
+static s32  lastSentTexture = -1;       ///< -1 until the identity went out in this lobby session
+static f64  serverClock = 0.0;          ///< Estimate of the newest server time we can hear (seconds)
+static bool serverClockSynced = false;
 static bool isFirstInit = true;
 
+/**
+    @brief Sends one lobby TLV message to the server.
+*/
+static void sendLobbyMessage(u8 action, const void* data, u16 len, bool reliable) {
+    if (networkSocket < 0) return;
+
+    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_LOBBY, .action = action, .length = htons(len), .isReliable = reliable };
+    RUDPHeader_St h; rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
+    h.senderId = htons((u16)lobby_game.clientId);
+
+    u8 buffer[256];
+    if (sizeof(h) + sizeof(tlv) + len > sizeof(buffer)) return;
+    memcpy(buffer, &h, sizeof(h));
+    memcpy(buffer + sizeof(h), &tlv, sizeof(tlv));
+    memcpy(buffer + sizeof(h) + sizeof(tlv), data, len);
+
+    u16 total = (u16)(sizeof(h) + sizeof(tlv) + len);
+    send(networkSocket, buffer, total, 0);
+    if (reliable) rudpTrackReliable(&serverConnection, buffer, total);
+}
+
+/**
+    @brief Sends the identity when it changed, then the pose at most LOBBY_MOVE_SEND_HZ times per second.
+*/
+static void sendLocalPlayerState(const f32 dt) {
+    if (networkSocket < 0) return;
+    const Player_St* me = &lobby_game.player;
+
+    if (lastSentTexture != (s32)me->textureId) {
+        LobbyPlayerInfoNet_St info = { .textureId = (u8)me->textureId };
+        strncpy(info.name, me->name, sizeof(info.name) - 1);
+        sendLobbyMessage(ACTION_CODE_LOBBY_PLAYER_INFO, &info, sizeof(info), true);
+        lastSentTexture = (s32)me->textureId;
+    }
+
+    moveSendTimer += dt;
+    if (moveSendTimer < 1.0f / LOBBY_MOVE_SEND_HZ) return;
+
+    LobbyPoseNet_St pose = lobby_quantizePose(me->position, me->angle);
+    bool unchanged = poseSent && memcmp(&pose, &lastSentPose, sizeof(pose)) == 0;
+    if (unchanged && moveSendTimer < MOVE_KEEPALIVE) return;
+
+    sendLobbyMessage(ACTION_CODE_LOBBY_MOVE, &pose, sizeof(pose), false);
+    lastSentPose = pose;
+    poseSent = true;
+    moveSendTimer = 0.0f;
+}
+
+/**
+    @brief Pulls the local estimate of the server clock toward a snapshot stamp.
+
+    Small corrections absorb network jitter without making remote players
+    stutter; a large gap (first snapshot, long stall) resets the clock.
+*/
+static void syncServerClock(const f64 snapshotTime) {
+    if (!serverClockSynced || fabs(snapshotTime - serverClock) > 1.0) {
+        serverClock = snapshotTime;
+        serverClockSynced = true;
+        return;
+    }
+    serverClock += (snapshotTime - serverClock) * 0.1;
+}
+
+static void appendPoseSample(PoseJitterBuffer_St* const buffer, const PoseSample_St sample) {
+    if (buffer->count == LOBBY_JITTER_SLOTS) {
+        memmove(buffer->samples, buffer->samples + 1, (LOBBY_JITTER_SLOTS - 1) * sizeof(PoseSample_St));
+        buffer->count--;
+    }
+    buffer->samples[buffer->count++] = sample;
+}
+
+/**
+    @brief Stores a received pose; late or duplicate snapshots are dropped.
+*/
+static void pushPoseSample(PoseJitterBuffer_St* const buffer, const f64 time, const Vector2 position, const f32 angle) {
+    if (buffer->count > 0) {
+        PoseSample_St newest = buffer->samples[buffer->count - 1];
+        if (time <= newest.time) return;
+
+        // Players are left out of snapshots while they stand still: pin the
+        // old pose right before this one so the motion does not get smeared
+        // over the whole pause.
+        if (time - newest.time > 1.5 * SNAPSHOT_INTERVAL) {
+            newest.time = time - SNAPSHOT_INTERVAL;
+            appendPoseSample(buffer, newest);
+        }
+    }
+    appendPoseSample(buffer, (PoseSample_St) { .time = time, .position = position, .angle = angle });
+}
+
+/**
+    @brief Interpolates the buffered poses at `renderTime`, holding the ends of the buffer.
+*/
+static void samplePose(const PoseJitterBuffer_St* const buffer, const f64 renderTime, Vector2* const position, f32* const angle) {
+    const PoseSample_St* samples = buffer->samples;
+    u32 last = buffer->count - 1;
+
+    if (renderTime <= samples[0].time || last == 0) {
+        *position = samples[0].position;
+        *angle = samples[0].angle;
+        return;
+    }
+    if (renderTime >= samples[last].time) {
+        *position = samples[last].position;
+        *angle = samples[last].angle;
+        return;
+    }
+
+    u32 i = 0;
+    while (samples[i + 1].time < renderTime) i++;
+    const PoseSample_St* a = &samples[i];
+    const PoseSample_St* b = &samples[i + 1];
+    f32 t = (f32)((renderTime - a->time) / (b->time - a->time));
+
+    *position = Vector2Lerp(a->position, b->position, t);
+    f32 turn = fmodf(b->angle - a->angle + 540.0f, 360.0f) - 180.0f; // Shortest way around
+    *angle = a->angle + turn * t;
+}
+
 static void updateCameraOnWindowResize(LobbyGame_St* const game) {
     // Re-center the camera offset for the new window dimensions.
     // Zoom is intentionally NOT changed: resizing should reveal more/less
@@ -44,7 +170,12 @@ void lobby_init(void) {
     lobby_initAudio();
     paramsMenu_init(&paramsMenu);
 
-    firstFrame = true;
+    poseSent = false;
+    moveSendTimer = 0.0f;
+    lastSentTexture = -1;
+    serverClockSynced = false;
+    // The server catches us up with everyone's identity and pose on join
+    memset(lobby_game.otherPlayers, 0, sizeof(lobby_game.otherPlayers));
 
     s32 savedId = isFirstInit ? -1 : lobby_game.clientId;
     isFirstInit = false;
@@ -137,8 +268,9 @@ void lobby_onData(s32 playerID, u8 action, const void* data, u16 len) {
     }
     if (playerID == lobby_game.clientId) return;
 
-    if (playerID >= MAX_CLIENTS && action != ACTION_CODE_JOIN_ACK && action != ACTION_CODE_LOBBY_ROOM_INFO) {
-        return; // Prevent OOB for server playerID (999)
+    if (playerID >= MAX_CLIENTS && action != ACTION_CODE_JOIN_ACK && action != ACTION_CODE_LOBBY_ROOM_INFO
+        && action < firstAvailableActionCode) {
+        return; // Prevent OOB for server playerID (999); lobby actions carry their player ids in the payload
     }
 
     switch (action) {
@@ -148,23 +280,55 @@ void lobby_onData(s32 playerID, u8 action, const void* data, u16 len) {
             lobby_game.clientId = ntohs(tempID);
         } break;
 
-        case ACTION_CODE_LOBBY_MOVE: {
-            if (playerID >= MAX_CLIENTS) break;
-            if (len < sizeof(PlayerNet_St)) break;
-            PlayerNet_St net;
-            memcpy(&net, data, sizeof(PlayerNet_St));
-            Player_St* p = &lobby_game.otherPlayers[playerID];
-            if (!p->active) {
-                p->position = (Vector2){ net.x, net.y };
-                p->targetPosition = p->position;
-            } else {
-                p->targetPosition = (Vector2){ net.x, net.y };
+        case ACTION_CODE_LOBBY_PLAYER_INFO: {
+            for (u16 off = 0; off + sizeof(LobbyPlayerInfoNet_St) <= len; off += sizeof(LobbyPlayerInfoNet_St)) {
+                LobbyPlayerInfoNet_St info;
+                memcpy(&info, (const u8*)data + off, sizeof(info));
+                if (info.playerId == lobby_game.clientId) continue;
+
+                Player_St* p = &lobby_game.otherPlayers[info.playerId];
+                p->textureId = (info.textureId < __playerTextureCount) ? (PlayerTextureId_Et)info.textureId : PLAYER_TEXTURE_DEFAULT;
+                strncpy(p->name, info.name, 31);
+                p->name[31] = '\0';
+            }
+        } break;
+
+        case ACTION_CODE_LOBBY_SNAPSHOT: {
+            if (len < sizeof(LobbySnapshotHeader_St)) break;
+            LobbySnapshotHeader_St header;
+            memcpy(&header, data, sizeof(header));
+            if (len < sizeof(header) + header.count * sizeof(LobbySnapshotEntry_St)) break;
+
+            f64 time = ntohl(header.serverTimeMs) / 1000.0;
+            syncServerClock(time);
+
+            for (u32 k = 0; k < header.count; k++) {
+                LobbySnapshotEntry_St entry;
+                memcpy(&entry, (const u8*)data + sizeof(header) + k * sizeof(entry), sizeof(entry));
+                if (entry.playerId == lobby_game.clientId) continue;
+
+                Player_St* p = &lobby_game.otherPlayers[entry.playerId];
+                Vector2 position;
+                f32 angle;
+                lobby_dequantizePose(&entry.pose, &position, &angle);
+
+                if (!p->active) {
+                    p->active = true;
+                    p->radius = 20.0f;
+                    p->position = position;
+                    p->angle = angle;
+                    p->netPoses.count = 0;
+                }
+                pushPoseSample(&p->netPoses, time, position, angle);
+            }
+        } break;
+
+        case ACTION_CODE_LOBBY_PLAYER_GONE: {
+            for (u16 k = 0; k < len; k++) {
+                u8 id = ((const u8*)data)[k];
+                lobby_game.otherPlayers[id].active = false;
+                lobby_game.otherPlayers[id].netPoses.count = 0;
             }
-            p->angle = net.angle;
-            p->textureId = (PlayerTextureId_Et)net.textureId;
-            p->active = net.active;
-            p->radius = 20.0f;
-            strncpy(p->name, net.name, 31);
         } break;
 
         case ACTION_CODE_LOBBY_CHAT: {
@@ -187,6 +351,7 @@ void lobby_onData(s32 playerID, u8 action, const void* data, u16 len) {
         case ACTION_CODE_QUIT_GAME: {
             if (playerID < MAX_CLIENTS) {
                 lobby_game.otherPlayers[playerID].active = false;
+                lobby_game.otherPlayers[playerID].netPoses.count = 0;
             }
         } break;
     }
@@ -194,6 +359,16 @@ void lobby_onData(s32 playerID, u8 action, const void* data, u16 len) {
 
 void lobby_update(f32 dt) {
     updateChat();
+
+    // Remote players are drawn a little in the past, between two snapshots
+    serverClock += dt;
+    f64 renderTime = serverClock - LOBBY_INTERP_DELAY;
+    for (s32 i = 0; i < MAX_CLIENTS; i++) {
+        Player_St* p = &lobby_game.otherPlayers[i];
+        if (p->active && i != lobby_game.clientId && p->netPoses.count > 0) {
+            samplePose(&p->netPoses, renderTime, &p->position, &p->angle);
+        }
+    }
     // toggleEditorMode removed: now handled by interaction zone in main.c
 
     if (lobby_game.chat.isOpen) {
@@ -244,21 +419,6 @@ void lobby_update(f32 dt) {
 
     paramsMenu_update(&paramsMenu);
 
-    // Interpolate other players
-    for (s32 i = 0; i < MAX_CLIENTS; i++) {
-        if (lobby_game.otherPlayers[i].active && i != lobby_game.clientId) {
-            Player_St* p = &lobby_game.otherPlayers[i];
-            // Simple lerp for smooth movement
-            p->position.x += (p->targetPosition.x - p->position.x) * 15.0f * dt;
-            p->position.y += (p->targetPosition.y - p->position.y) * 15.0f * dt;
-            
-            // If very close, just snap
-            if (CheckCollisionCircles(p->position, 1.0f, p->targetPosition, 1.0f)) {
-                p->position = p->targetPosition;
-            }
-        }
-    }
-
     lobby_toggleSkinMenu(&lobby_game.playerVisuals);
 
     if (lobby_game.playerVisuals.isTextureMenuOpen) {
@@ -268,27 +428,7 @@ void lobby_update(f32 dt) {
     lobby_updateGrass(&lobby_game.player, GetFrameTime(), gameTime, lobby_game.cam);
     lobby_updateAtmosphericEffects(dt, &lobby_game.player, lobby_game.cam);
 
-    if (lobby_game.player.position.x != lastSentPos.x || lobby_game.player.position.y != lastSentPos.y || firstFrame) {
-        PlayerNet_St net = {
-            .x = lobby_game.player.position.x, .y = lobby_game.player.position.y,
-            .angle = lobby_game.player.angle, .textureId = (u8)lobby_game.player.textureId,
-            .active = true
-        };
-        strncpy(net.name, lobby_game.player.name, 31);
-
-        GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_LOBBY, .action = ACTION_CODE_LOBBY_MOVE, .length = htons(sizeof(PlayerNet_St)) };
-        RUDPHeader_St h; rudpGenerateHeader(&serverConnection, ACTION_CODE_GAME_DATA, &h);
-        h.senderId = htons((u16)lobby_game.clientId);
-        
-        u8 buffer[1024];
-        memcpy(buffer, &h, sizeof(h));
-        memcpy(buffer + sizeof(h), &tlv, sizeof(tlv));
-        memcpy(buffer + sizeof(h) + sizeof(tlv), &net, sizeof(net));
-        
-        send(networkSocket, buffer, sizeof(h) + sizeof(tlv) + sizeof(net), 0);
-        lastSentPos = (f32Vector2){lobby_game.player.position.x, lobby_game.player.position.y};
-        firstFrame = false;
-    }
+    sendLocalPlayerState(dt);
 }
 
 void lobby_draw(void) {
@@ -4,43 +4,267 @@
     @date 2026-03-30
     @date 2026-04-14
     @brief Server-side implementation of the Lobby module.
+
+    The room keeps the last pose each player reported and replicates it at
+    LOBBY_SNAPSHOT_HZ: every observer gets one batched snapshot holding
+    only the players inside its area of interest that are new to it, moved
+    since the previous snapshot, or due for the periodic refresh. Players
+    leaving the area (or the room) are announced reliably. Names travel
+    only in ACTION_CODE_LOBBY_PLAYER_INFO, when a player joins or changes
+    skin.
 */
 
-#include "networkInterface.h"
-#include "APIs/generalAPI.h"
+#include "core/game.h"
 
 #include "sharedUtils/debug.h"
 
+#define LOBBY_IDLE_SLEEP_MS         1000    ///< Tick interval while nobody has joined
+#define LOBBY_SNAPSHOT_INTERVAL     (1.0f / LOBBY_SNAPSHOT_HZ)
+#define LOBBY_INFO_BATCH            32      ///< Player infos per message when catching up a newcomer
+
+/// Snapshot entries per message: the record (bundle prefix + TLV + snapshot) fits BUNDLE_MTU
+#define LOBBY_SNAPSHOT_MAX_ENTRIES  ((BUNDLE_MTU - sizeof(BundleRecordHeader_St) - sizeof(GameTLVHeader_St) - sizeof(LobbySnapshotHeader_St)) / sizeof(LobbySnapshotEntry_St))
+
+/**
+    @brief Authoritative replication state of one lobby player.
+*/
 typedef struct {
-    int dummy;
+    bool            joined;     ///< Sent its PLAYER_INFO
+    bool            hasPose;    ///< Sent at least one MOVE
+    bool            dirty;      ///< Pose changed since the last snapshot
+    LobbyPoseNet_St pose;       ///< Last pose, as it goes on the wire
+    Vector2         position;   ///< Decoded pose, for the interest checks
+    u8              textureId;
+    char            name[32];
+} LobbyServerPlayer_St;
+
+typedef struct {
+    LobbyServerPlayer_St players[MAX_CLIENTS];
+    u8                   visible[MAX_CLIENTS][MAX_CLIENTS / 8];  ///< visible[observer] bit j: observer was sent player j
+    u32                  joinedCount;
+    u32                  snapshotCount;
+    f64                  clock;                                  ///< Room time (seconds), stamps the snapshots
+    f32                  snapshotTimer;
 } LobbyServerState;
 
+static bool isVisible(const LobbyServerState* s, s32 observer, s32 player) {
+    return (s->visible[observer][player >> 3] >> (player & 7)) & 1;
+}
+
+static void setVisible(LobbyServerState* s, s32 observer, s32 player, bool visible) {
+    if (visible) s->visible[observer][player >> 3] |= (u8)(1 << (player & 7));
+    else         s->visible[observer][player >> 3] &= (u8)~(1 << (player & 7));
+}
+
+/**
+    @brief Sends one lobby TLV message; roomId UNICAST targets `target` alone.
+*/
+static void sendLobby(BroadcastMessage_Ft broadcast, s32 roomId, s32 target, u8 lobbyAction, bool reliable, const void* data, u16 len) {
+    u8 buf[sizeof(GameTLVHeader_St) + sizeof(LobbySnapshotHeader_St) + MAX_CLIENTS * sizeof(LobbySnapshotEntry_St)];
+    if (len > sizeof(buf) - sizeof(GameTLVHeader_St)) return;
+
+    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_LOBBY, .action = lobbyAction, .length = htons(len), .isReliable = reliable };
+    memcpy(buf, &tlv, sizeof(tlv));
+    memcpy(buf + sizeof(tlv), data, len);
+    broadcast(roomId, target, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv) + len));
+}
+
+static LobbyPlayerInfoNet_St playerInfo(const LobbyServerState* s, s32 playerId) {
+    LobbyPlayerInfoNet_St info = { .playerId = (u8)playerId, .textureId = s->players[playerId].textureId };
+    memcpy(info.name, s->players[playerId].name, sizeof(info.name));
+    return info;
+}
+
+/**
+    @brief Catches a newcomer up with the identity of everyone already in the lobby.
+*/
+static void sendKnownInfos(const LobbyServerState* s, s32 newcomer, BroadcastMessage_Ft broadcast) {
+    LobbyPlayerInfoNet_St batch[LOBBY_INFO_BATCH];
+    u32 n = 0;
+    for (s32 i = 0; i < MAX_CLIENTS; i++) {
+        if (i == newcomer || !s->players[i].joined) continue;
+        batch[n++] = playerInfo(s, i);
+        if (n == LOBBY_INFO_BATCH) {
+            sendLobby(broadcast, UNICAST, newcomer, ACTION_CODE_LOBBY_PLAYER_INFO, true, batch, (u16)(n * sizeof(batch[0])));
+            n = 0;
+        }
+    }
+    if (n > 0) sendLobby(broadcast, UNICAST, newcomer, ACTION_CODE_LOBBY_PLAYER_INFO, true, batch, (u16)(n * sizeof(batch[0])));
+}
+
+static void handlePlayerInfo(LobbyServerState* s, s32 room_id, s32 player_id, const u8* data, u16 len, BroadcastMessage_Ft broadcast) {
+    if (len < sizeof(LobbyPlayerInfoNet_St)) return;
+    LobbyPlayerInfoNet_St info;
+    memcpy(&info, data, sizeof(info));
+
+    LobbyServerPlayer_St* p = &s->players[player_id];
+    p->textureId = info.textureId;
+    memcpy(p->name, info.name, sizeof(p->name));
+    p->name[sizeof(p->name) - 1] = '\0';
+
+    bool newcomer = !p->joined;
+    if (newcomer) {
+        p->joined = true;
+        s->joinedCount++;
+    }
+
+    LobbyPlayerInfoNet_St relay = playerInfo(s, player_id);
+    sendLobby(broadcast, room_id, player_id, ACTION_CODE_LOBBY_PLAYER_INFO, true, &relay, sizeof(relay));
+    if (newcomer) sendKnownInfos(s, player_id, broadcast);
+}
+
+static void handleMove(LobbyServerState* s, s32 player_id, const u8* data, u16 len) {
+    if (len < sizeof(LobbyPoseNet_St)) return;
+    LobbyServerPlayer_St* p = &s->players[player_id];
+
+    LobbyPoseNet_St pose;
+    memcpy(&pose, data, sizeof(pose));
+    if (p->hasPose && memcmp(&pose, &p->pose, sizeof(pose)) == 0) return;
+
+    f32 angle;
+    p->pose = pose;
+    lobby_dequantizePose(&pose, &p->position, &angle);
+    p->hasPose = true;
+    p->dirty = true;
+}
+
+void lobby_initInstance(void* state) {
+    memset(state, 0, sizeof(LobbyServerState));
+}
+
 void* lobby_createInstance(void) {
     LobbyServerState* s = malloc(sizeof(LobbyServerState));
-    if (s) s->dummy = 0;
+    if (s) lobby_initInstance(s);
     return s;
 }
 
 void lobby_onAction(void* state, s32 room_id, s32 player_id, u8 action, const void* payload, u16 len, BroadcastMessage_Ft broadcast) {
-    UNUSED(state);
-    if (action == ACTION_CODE_GAME_DATA && len >= sizeof(GameTLVHeader_St)) {
-        GameTLVHeader_St* tlv = (GameTLVHeader_St*)payload;
-        if (tlv->gameId == MINI_GAME_ID_LOBBY) {
-            if (tlv->action == ACTION_CODE_LOBBY_MOVE || tlv->action == ACTION_CODE_LOBBY_CHAT) {
-                // Broadcast movement and chat to everyone
-                broadcast(room_id, player_id, action, payload, len);
+    LobbyServerState* s = (LobbyServerState*)state;
+    if (action != ACTION_CODE_GAME_DATA || len < sizeof(GameTLVHeader_St)) return;
+    if (player_id < 0 || player_id >= MAX_CLIENTS) return;
+
+    GameTLVHeader_St tlv;
+    memcpy(&tlv, payload, sizeof(tlv));
+    if (tlv.gameId != MINI_GAME_ID_LOBBY) return;
+
+    const u8* data = (const u8*)payload + sizeof(tlv);
+    u16 dataLen = (u16)(len - sizeof(tlv));
+
+    switch (tlv.action) {
+        case ACTION_CODE_LOBBY_CHAT:
+            broadcast(room_id, player_id, action, payload, len);
+            break;
+
+        case ACTION_CODE_LOBBY_MOVE:
+            handleMove(s, player_id, data, dataLen);
+            break;
+
+        case ACTION_CODE_LOBBY_PLAYER_INFO:
+            handlePlayerInfo(s, room_id, player_id, data, dataLen, broadcast);
+            break;
+    }
+}
+
+/**
+    @brief Sends the first `count` entries of a snapshot buffer to one observer.
+*/
+static void sendSnapshot(const LobbyServerState* s, s32 observer, u8* snapshot, u32 count, BroadcastMessage_Ft broadcast) {
+    LobbySnapshotHeader_St header = { .serverTimeMs = htonl((u32)(s->clock * 1000.0)), .count = (u8)count };
+    memcpy(snapshot, &header, sizeof(header));
+    sendLobby(broadcast, UNICAST, observer, ACTION_CODE_LOBBY_SNAPSHOT, false, snapshot, (u16)(sizeof(header) + count * sizeof(LobbySnapshotEntry_St)));
+}
+
+/**
+    @brief Builds and sends the snapshot (and departures) of every observer.
+
+    A crowded area of interest is split into several snapshots of at most
+    LOBBY_SNAPSHOT_MAX_ENTRIES, each small enough to never be IP-fragmented.
+*/
+static void sendSnapshots(LobbyServerState* s, BroadcastMessage_Ft broadcast) {
+    const f32 enter2 = LOBBY_AOI_ENTER_RADIUS * LOBBY_AOI_ENTER_RADIUS;
+    const f32 leave2 = LOBBY_AOI_LEAVE_RADIUS * LOBBY_AOI_LEAVE_RADIUS;
+
+    u8 snapshot[sizeof(LobbySnapshotHeader_St) + LOBBY_SNAPSHOT_MAX_ENTRIES * sizeof(LobbySnapshotEntry_St)];
+    LobbySnapshotEntry_St* entries = (LobbySnapshotEntry_St*)(snapshot + sizeof(LobbySnapshotHeader_St));
+    u8 gone[MAX_CLIENTS];
+
+    for (s32 o = 0; o < MAX_CLIENTS; o++) {
+        const LobbyServerPlayer_St* observer = &s->players[o];
+        if (!observer->joined || !observer->hasPose) continue;
+
+        // Stagger the full refreshes so they do not all land on the same tick
+        bool refresh = (s->snapshotCount + (u32)o) % LOBBY_SNAPSHOT_REFRESH == 0;
+        u32 count = 0, goneCount = 0;
+
+        for (s32 j = 0; j < MAX_CLIENTS; j++) {
+            if (j == o) continue;
+            const LobbyServerPlayer_St* p = &s->players[j];
+            bool wasVisible = isVisible(s, o, j);
+
+            bool inside = false;
+            if (p->joined && p->hasPose) {
+                f32 dist2 = Vector2DistanceSqr(observer->position, p->position);
+                inside = dist2 <= (wasVisible ? leave2 : enter2);
+            }
+
+            if (!inside) {
+                if (wasVisible) {
+                    setVisible(s, o, j, false);
+                    gone[goneCount++] = (u8)j;
+                }
+                continue;
+            }
+
+            if (!wasVisible || p->dirty || refresh) {
+                setVisible(s, o, j, true);
+                entries[count++] = (LobbySnapshotEntry_St) { .playerId = (u8)j, .pose = p->pose };
+                if (count == LOBBY_SNAPSHOT_MAX_ENTRIES) {
+                    sendSnapshot(s, o, snapshot, count, broadcast);
+                    count = 0;
+                }
             }
         }
+
+        if (count > 0) sendSnapshot(s, o, snapshot, count, broadcast);
+        if (goneCount > 0) {
+            sendLobby(broadcast, UNICAST, o, ACTION_CODE_LOBBY_PLAYER_GONE, true, gone, (u16)goneCount);
+        }
     }
+
+    for (s32 j = 0; j < MAX_CLIENTS; j++) s->players[j].dirty = false;
+    s->snapshotCount++;
 }
 
-void lobby_tick(void* state) {
-    UNUSED(state);
+void lobby_tick(void* state, ServerTickContext_St* ctx) {
+    LobbyServerState* s = (LobbyServerState*)state;
+    s->clock += ctx->dt;
+
+    if (s->joinedCount == 0) {
+        s->snapshotTimer = 0.0f;
+        ctx->sleepMs = LOBBY_IDLE_SLEEP_MS;
+        return;
+    }
+
+    s->snapshotTimer += ctx->dt;
+    if (s->snapshotTimer >= LOBBY_SNAPSHOT_INTERVAL) {
+        s->snapshotTimer -= LOBBY_SNAPSHOT_INTERVAL;
+        if (s->snapshotTimer > LOBBY_SNAPSHOT_INTERVAL) s->snapshotTimer = 0.0f; // Late tick: no catch-up burst
+        sendSnapshots(s, ctx->broadcast);
+    }
+
+    // Moves wake the room early; it only sends on the snapshot cadence
+    u32 waitMs = (u32)ceilf((LOBBY_SNAPSHOT_INTERVAL - s->snapshotTimer) * 1000.0f);
+    ctx->sleepMs = waitMs > 0 ? waitMs : 1;
 }
 
 void lobby_onPlayerLeave(void* state, s32 player_id) {
-    UNUSED(state);
-    UNUSED(player_id);
+    LobbyServerState* s = (LobbyServerState*)state;
+    if (player_id < 0 || player_id >= MAX_CLIENTS) return;
+
+    if (s->players[player_id].joined) s->joinedCount--;
+    memset(&s->players[player_id], 0, sizeof(s->players[player_id]));
+    // Observers that saw the player get it in their next PLAYER_GONE
+    memset(s->visible[player_id], 0, sizeof(s->visible[player_id]));
 }
 
 void lobby_destroyInstance(void* state) {
@@ -51,7 +275,9 @@ GameServerInterface_St lobby_serverInterface = {
     .gameName = "lobby",
     .createInstance = lobby_createInstance,
     .onAction = lobby_onAction,
-    .onTick = lobby_tick,
+    .onRoomTick = lobby_tick,
     .onPlayerLeave = lobby_onPlayerLeave,
-    .destroyInstance = lobby_destroyInstance
+    .destroyInstance = lobby_destroyInstance,
+    .instanceSize = sizeof(LobbyServerState),
+    .initInstance = lobby_initInstance
 };
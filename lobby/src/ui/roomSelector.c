@@ -28,6 +28,22 @@ static bool    lobby_waitingForServer = false;
 static float   lobby_waitingTimer     = 0.0f;
 #define LOBBY_WAITING_TIMEOUT 5.0f
 
+/**
+    @brief Sends a LOBBY_SWITCH_GAME request (create with ROOM_ID_NEW, or join roomId/generation).
+*/
+static void lobby_sendSwitchGame(u8 gameId, u16 roomId, u16 generation) {
+    RUDPHeader_St h;
+    rudpGenerateHeader(&serverConnection, ACTION_CODE_LOBBY_SWITCH_GAME, &h);
+    h.senderId = htons((u16)lobby_game.clientId);
+
+    SwitchGamePayload_St request = { .gameId = gameId, .roomId = htons(roomId), .generation = htons(generation) };
+    u8 buf[64];
+    memcpy(buf, &h, sizeof(h));
+    memcpy(buf + sizeof(h), &request, sizeof(request));
+
+    send(networkSocket, buf, sizeof(h) + sizeof(request), 0);
+}
+
 void lobby_initRoomSelector(void) {
     lobby_roomSelectorOpen = false;
     lobby_roomsCount = 0;
@@ -71,6 +87,7 @@ void lobby_handleRoomList(const void* data, s32 count) {
     for (s32 i = 0; i < lobby_roomsCount; i++) {
         lobby_discoveredRooms[i].id = ntohs(lobby_discoveredRooms[i].id);
         lobby_discoveredRooms[i].playerCount = ntohs(lobby_discoveredRooms[i].playerCount);
+        lobby_discoveredRooms[i].generation = ntohs(lobby_discoveredRooms[i].generation);
         log_info("[UI] Room %d: '%s' by %s (%d players)", 
                lobby_discoveredRooms[i].id, lobby_discoveredRooms[i].name, 
                lobby_discoveredRooms[i].creator, lobby_discoveredRooms[i].playerCount);
@@ -98,28 +115,11 @@ bool lobby_updateRoomSelector(void) {
     }
 
     if (IsKeyPressed(KEY_ENTER)) {
+        u8 gameId = (lobby_currentGameId == -1) ? (u8)MINI_GAME_ID_LOBBY : (u8)lobby_currentGameId;
         if (lobby_roomsCount > 0) {
-            RUDPHeader_St h;
-            rudpGenerateHeader(&serverConnection, ACTION_CODE_LOBBY_SWITCH_GAME, &h);
-            h.senderId = htons((u16)lobby_game.clientId);
-
-            u8 buf[64];
-            memcpy(buf, &h, sizeof(h));
-            buf[sizeof(h)] = (lobby_currentGameId == -1) ? (u8)MINI_GAME_ID_LOBBY : (u8)lobby_currentGameId;
-            buf[sizeof(h) + 1] = (s8)lobby_discoveredRooms[0].id;
-
-            send(networkSocket, buf, sizeof(h) + 2, 0);
+            lobby_sendSwitchGame(gameId, lobby_discoveredRooms[0].id, lobby_discoveredRooms[0].generation);
         } else {
-            RUDPHeader_St h;
-            rudpGenerateHeader(&serverConnection, ACTION_CODE_LOBBY_SWITCH_GAME, &h);
-            h.senderId = htons((u16)lobby_game.clientId);
-
-            u8 buf[64];
-            memcpy(buf, &h, sizeof(h));
-            buf[sizeof(h)] = (lobby_currentGameId == -1) ? (u8)MINI_GAME_ID_LOBBY : (u8)lobby_currentGameId;
-            buf[sizeof(h) + 1] = (s8)-1;
-
-            send(networkSocket, buf, sizeof(h) + 2, 0);
+            lobby_sendSwitchGame(gameId, ROOM_ID_NEW, 0);
         }
         lobby_waitingForServer = true; lobby_waitingTimer = 0.0f;
         return true;
@@ -141,16 +141,7 @@ bool lobby_updateRoomSelector(void) {
 
         Rectangle btnNew = { (float)GetScreenWidth()/2 + 10, (float)GetScreenHeight()/2 + 150, 200, 40 };
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(GetMousePosition(), btnNew)) {
-            RUDPHeader_St h;
-            rudpGenerateHeader(&serverConnection, ACTION_CODE_LOBBY_SWITCH_GAME, &h);
-            h.senderId = htons((u16)lobby_game.clientId);
-
-            u8 buf[64];
-            memcpy(buf, &h, sizeof(h));
-            buf[sizeof(h)] = (u8)lobby_currentGameId;
-            buf[sizeof(h) + 1] = (s8)-1;
-
-            send(networkSocket, buf, sizeof(h) + 2, 0);
+            lobby_sendSwitchGame((u8)lobby_currentGameId, ROOM_ID_NEW, 0);
             lobby_waitingForServer = true; lobby_waitingTimer = 0.0f;
             return true;
         }
@@ -160,16 +151,8 @@ bool lobby_updateRoomSelector(void) {
     for (s32 i = 0; i < lobby_roomsCount; i++) {
         Rectangle r = { (float)GetScreenWidth()/2 - 150, (float)GetScreenHeight()/2 - 100 + (i * 50), 300, 40 };
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(GetMousePosition(), r)) {
-            RUDPHeader_St h;
-            rudpGenerateHeader(&serverConnection, ACTION_CODE_LOBBY_SWITCH_GAME, &h);
-            h.senderId = htons((u16)lobby_game.clientId);
-
-            u8 buf[64];
-            memcpy(buf, &h, sizeof(h));
-            buf[sizeof(h)] = (lobby_currentGameId == -1) ? (u8)MINI_GAME_ID_LOBBY : (u8)lobby_currentGameId;
-            buf[sizeof(h) + 1] = (s8)lobby_discoveredRooms[i].id;
-
-            send(networkSocket, buf, sizeof(h) + 2, 0);
+            u8 gameId = (lobby_currentGameId == -1) ? (u8)MINI_GAME_ID_LOBBY : (u8)lobby_currentGameId;
+            lobby_sendSwitchGame(gameId, lobby_discoveredRooms[i].id, lobby_discoveredRooms[i].generation);
             lobby_waitingForServer = true; lobby_waitingTimer = 0.0f;
             return true;
         }
@@ -0,0 +1,57 @@
+/**
+    @file instancePool.h
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Slab allocator for fixed-size game instance states.
+
+    The server keeps one pool per game type: room states are carved out
+    of large slabs and recycled through a free list, so creating and
+    destroying short-lived rooms does not go back to malloc/free. Slabs
+    are only returned to the system by instancePoolDestroy().
+    Not thread-safe: only the server I/O thread acquires and releases.
+*/
+#ifndef INSTANCE_POOL_H
+#define INSTANCE_POOL_H
+
+#include "baseTypes.h"
+
+#include <stddef.h>
+
+#define INSTANCE_POOL_ALIGN      16      ///< Block alignment (matches malloc on 64-bit targets)
+#define INSTANCE_POOL_SLAB_BYTES 65536   ///< Target slab size; a slab always holds at least INSTANCE_POOL_MIN_BLOCKS
+#define INSTANCE_POOL_MIN_BLOCKS 4       ///< Lower bound of blocks per slab for very large states
+
+/**
+    @brief Pool of equally sized blocks.
+*/
+typedef struct {
+    size_t blockSize;       ///< Requested size rounded up to INSTANCE_POOL_ALIGN
+    u32    blocksPerSlab;   ///< Blocks carved from each slab
+    void*  freeList;        ///< Singly linked free blocks (link stored in the block)
+    void*  slabs;           ///< Singly linked slabs, for instancePoolDestroy()
+    u32    slabCount;       ///< Slabs allocated so far
+    u32    inUse;           ///< Blocks currently handed out
+} InstancePool_St;
+
+/**
+    @brief Prepares an empty pool; no memory is allocated until the first acquire.
+*/
+void instancePoolInit(InstancePool_St* pool, size_t blockSize);
+
+/**
+    @brief Returns a zeroed block, allocating a new slab when the free list is empty.
+    @return NULL on allocation failure.
+*/
+void* instancePoolAcquire(InstancePool_St* pool);
+
+/**
+    @brief Gives a block back to the pool it was acquired from.
+*/
+void instancePoolRelease(InstancePool_St* pool, void* block);
+
+/**
+    @brief Frees every slab. Blocks still in use become invalid.
+*/
+void instancePoolDestroy(InstancePool_St* pool);
+
+#endif // INSTANCE_POOL_H
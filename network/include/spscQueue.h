@@ -0,0 +1,77 @@
+/**
+    @file spscQueue.h
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Bounded lock-free single-producer / single-consumer queue of fixed-size slots.
+
+    Used between the server I/O thread and the room workers: exactly one
+    thread may push and exactly one (other) thread may pop. Slots are
+    filled in place (`spscBeginPush` / `spscCommitPush`) and read in place
+    (`spscPeek` / `spscPop`), so large messages are copied only once.
+*/
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "baseTypes.h"
+
+#include <stdatomic.h>
+
+#define SPSC_CACHE_LINE 64  ///< Keeps producer and consumer indices on separate cache lines
+
+/**
+    @brief Ring of `capacity` slots of `slotSize` bytes each (capacity is a power of two).
+
+    `head` is only written by the consumer and `tail` only by the producer;
+    each side caches the other's index to avoid touching its cache line on
+    every operation.
+*/
+typedef struct {
+    _Alignas(SPSC_CACHE_LINE) _Atomic u32 head; ///< Next slot to pop (consumer-owned)
+    u32  cachedTail;                            ///< Consumer's last view of tail
+
+    _Alignas(SPSC_CACHE_LINE) _Atomic u32 tail; ///< Next slot to fill (producer-owned)
+    u32  cachedHead;                            ///< Producer's last view of head
+
+    _Alignas(SPSC_CACHE_LINE) u32 mask;         ///< capacity - 1
+    u32  slotSize;                              ///< Bytes per slot
+    u8*  slots;                                 ///< capacity * slotSize bytes
+} SPSCQueue_St;
+
+/**
+    @brief Allocates the ring. Capacity is rounded up to a power of two.
+    @return false on allocation failure.
+*/
+bool spscInit(SPSCQueue_St* queue, u32 capacity, u32 slotSize);
+
+/**
+    @brief Releases the slot storage. No thread may use the queue afterwards.
+*/
+void spscDestroy(SPSCQueue_St* queue);
+
+/**
+    @brief Producer: returns the next free slot, or NULL when the ring is full.
+    @note  The slot becomes visible to the consumer only after spscCommitPush().
+*/
+void* spscBeginPush(SPSCQueue_St* queue);
+
+/**
+    @brief Producer: publishes the slot returned by the last spscBeginPush().
+*/
+void spscCommitPush(SPSCQueue_St* queue);
+
+/**
+    @brief Consumer: returns the oldest published slot, or NULL when empty.
+*/
+void* spscPeek(SPSCQueue_St* queue);
+
+/**
+    @brief Consumer: releases the slot returned by spscPeek() back to the producer.
+*/
+void spscPop(SPSCQueue_St* queue);
+
+/**
+    @brief Approximate number of queued slots (exact when called by either endpoint with the other idle).
+*/
+u32 spscSize(SPSCQueue_St* queue);
+
+#endif // SPSC_QUEUE_H
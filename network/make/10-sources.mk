@@ -1,6 +1,7 @@
 # Dirs
 SRC_DIR := src
 TEST_DIR := tests
+BENCH_DIR := $(TEST_DIR)/bench
 
 # Library/shared sources/objects (recursive, excluding main.c)
 LIB_SOURCES := $(shell find $(SRC_DIR) -name '*.c' ! -name '$(MAIN_NAME).c')
@@ -10,10 +11,14 @@ LIB_OBJECTS := $(LIB_SOURCES:$(SRC_DIR)/%.c=$(OBJ_DIR)/%.o)
 MAIN_SOURCE := $(SRC_DIR)/$(MAIN_NAME).c
 MAIN_OBJECT := $(OBJ_DIR)/$(MAIN_NAME).o
 
-# Test sources/objects/bins (recursive)
-TEST_SOURCES := $(shell find $(TEST_DIR) -name '*.c')
+# Test sources/objects/bins (recursive, benchmarks excluded: they need a live server)
+TEST_SOURCES := $(shell find $(TEST_DIR) -name '*.c' ! -path '$(BENCH_DIR)/*')
 TEST_OBJECTS := $(TEST_SOURCES:$(TEST_DIR)/%.c=$(OBJ_DIR)/tests/%.o)
 TEST_BINS := $(TEST_SOURCES:$(TEST_DIR)/%.c=$(TEST_BIN_DIR)/%$(EXE_EXT))
 
+# Load generator (tests/bench/loadgen.c)
+LOADGEN_OBJECT := $(OBJ_DIR)/tests/bench/loadgen.o
+LOADGEN_BIN := $(BUILD_DIR)/bin/loadgen$(EXE_EXT)
+
 # All deps
-DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d)
+DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d) $(LOADGEN_OBJECT:.o=.d)
@@ -1,5 +1,5 @@
 # Prevent make from deleting intermediate object files
-.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS)
+.SECONDARY: $(LIB_OBJECTS) $(MAIN_OBJECT) $(TEST_OBJECTS) $(LOADGEN_OBJECT)
 
 # Rules
 $(BIN): $(LIB_OBJECTS) $(MAIN_OBJECT) $(filter %.a, $(EXTRA_LDFLAGS))
@@ -14,6 +14,10 @@ $(TEST_BIN_DIR)/% : $(LIB_OBJECTS) $(OBJ_DIR)/tests/%.o
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
 
+$(LOADGEN_BIN): $(LIB_OBJECTS) $(LOADGEN_OBJECT)
+	$(SILENT_PREFIX)mkdir -p $(@D)
+	$(SILENT_PREFIX)$(CC) $^ $(LDFLAGS) -o $@
+
 $(OBJ_DIR)/tests/%.o: $(TEST_DIR)/%.c
 	$(SILENT_PREFIX)mkdir -p $(@D)
 	$(SILENT_PREFIX)$(CC) $(CFLAGS) -Isrc $(DEP_FLAGS) -c $< -o $@
@@ -6,6 +6,11 @@ tests: $(TEST_BINS)
 	fi
 
 
+loadgen: $(LOADGEN_BIN)
+
+run-loadgen: loadgen
+	$(SILENT_PREFIX)./$(LOADGEN_BIN) $(LOADGEN_ARGS)
+
 run-tests: tests
 	@if [ -z "$(TEST_BINS)" ]; then \
 		:; \
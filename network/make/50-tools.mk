@@ -21,7 +21,7 @@ ifeq ($(NO_DEPENDENCY_TRACKING),1)
 else
 	DEP_FLAGS := -MMD -MP
 	# All dependency files
-	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d)
+	DEPS := $(LIB_OBJECTS:.o=.d) $(MAIN_OBJECT:.o=.d) $(TEST_OBJECTS:.o=.d) $(LOADGEN_OBJECT:.o=.d)
 endif
 
 ifneq ($(NO_DEPENDENCY_TRACKING),1)
@@ -55,6 +55,8 @@ help:
 	@echo "    run-main             Run the main binary (uses Valgrind in valgrind-debug mode)"
 	@echo "    run-gdb              Debug the main binary with gdb"
 	@echo "    run-tests            Build and run all tests, reporting failures at the end"
+	@echo "    loadgen              Build the headless load generator (build/bin/loadgen)"
+	@echo "    run-loadgen          Load a running server with simulated clients (LOADGEN_ARGS=\"--clients=100 ...\")"
 	@echo "    clean                Remove all build artifacts and build folder"
 	@echo "    doxygen              Build documentation"
 	@echo "    clean-docs           Remove all of the generated documentation"
@@ -74,6 +76,7 @@ help:
 	@echo "    NO_DEPENDENCY_TRACKING=1    Disable automatic dependency tracking (.d files)"
 	@echo "    EXTRA_CFLAGS=\"<str>\"        Add custom compiler flags"
 	@echo "    EXTRA_LDFLAGS=\"<str>\"       Add custom linker flags"
+	@echo "    LOADGEN_ARGS=\"<str>\"        Options for run-loadgen (see build/bin/loadgen --help)"
 	@echo ""
 	@echo "Portability Notes:"
 	@echo "    run-tests uses stdbuf (from GNU coreutils) if available for reliable output on crashes;"
@@ -10,4 +10,5 @@ BASE_CFLAGS := \
 BASE_LDFLAGS := \
 	-L$(RAYLIB_LIB_DIR) \
 	-l:libraylib.a \
-	-lm
\ No newline at end of file
+	-lm \
+	-lpthread
\ No newline at end of file
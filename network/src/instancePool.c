@@ -0,0 +1,76 @@
+/**
+    @file instancePool.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Slab allocator for fixed-size game instance states (see instancePool.h).
+
+    A slab is one malloc'd region: an aligned header linking it to the
+    other slabs, followed by blocksPerSlab blocks. Free blocks store the
+    free-list link in their first bytes.
+*/
+#include "instancePool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SLAB_HEADER_SIZE (((sizeof(void*)) + INSTANCE_POOL_ALIGN - 1) & ~(size_t)(INSTANCE_POOL_ALIGN - 1))
+
+void instancePoolInit(InstancePool_St* pool, size_t blockSize) {
+    memset(pool, 0, sizeof(*pool));
+    if (blockSize < sizeof(void*)) blockSize = sizeof(void*);
+    pool->blockSize = (blockSize + INSTANCE_POOL_ALIGN - 1) & ~(size_t)(INSTANCE_POOL_ALIGN - 1);
+
+    size_t perSlab = INSTANCE_POOL_SLAB_BYTES / pool->blockSize;
+    pool->blocksPerSlab = (u32)(perSlab < INSTANCE_POOL_MIN_BLOCKS ? INSTANCE_POOL_MIN_BLOCKS : perSlab);
+}
+
+/**
+    @brief Allocates one slab and threads all its blocks onto the free list.
+*/
+static bool growPool(InstancePool_St* pool) {
+    u8* slab = malloc(SLAB_HEADER_SIZE + (size_t)pool->blocksPerSlab * pool->blockSize);
+    if (slab == NULL) return false;
+
+    *(void**)slab = pool->slabs;
+    pool->slabs = slab;
+    pool->slabCount++;
+
+    // Push in reverse so blocks are handed out in address order
+    u8* blocks = slab + SLAB_HEADER_SIZE;
+    for (u32 i = pool->blocksPerSlab; i-- > 0;) {
+        void* block = blocks + (size_t)i * pool->blockSize;
+        *(void**)block = pool->freeList;
+        pool->freeList = block;
+    }
+    return true;
+}
+
+void* instancePoolAcquire(InstancePool_St* pool) {
+    if (pool->freeList == NULL && !growPool(pool)) return NULL;
+
+    void* block = pool->freeList;
+    pool->freeList = *(void**)block;
+    pool->inUse++;
+    memset(block, 0, pool->blockSize);
+    return block;
+}
+
+void instancePoolRelease(InstancePool_St* pool, void* block) {
+    if (block == NULL) return;
+    *(void**)block = pool->freeList;
+    pool->freeList = block;
+    pool->inUse--;
+}
+
+void instancePoolDestroy(InstancePool_St* pool) {
+    void* slab = pool->slabs;
+    while (slab != NULL) {
+        void* next = *(void**)slab;
+        free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->freeList = NULL;
+    pool->slabCount = 0;
+    pool->inUse = 0;
+}
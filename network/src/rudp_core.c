@@ -4,9 +4,33 @@
     @date 2026-03-18
     @date 2026-04-14
     @brief Cœur du protocole Reliable UDP (RUDP) simplifié.
+
+    Les paquets fiables sont conservés dans une fenêtre d'envoi jusqu'à leur
+    acquittement (champ `ack` + `ackBitfield` du pair) et renvoyés après
+    expiration du RTO, estimé à la manière de la RFC 6298. Chaque renvoi prend
+    un nouveau numéro de séquence ; `messageSequence` garde celui du premier
+    envoi pour que le pair ne livre le message qu'une fois.
 */
 #include "rudp_core.h"
 #include <arpa/inet.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Horloge monotone par défaut, en microsecondes.
+ */
+static u64 defaultClock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000ull + (u64)ts.tv_nsec / 1000ull;
+}
+
+static RUDPClock_Ft rudpClock = defaultClock;
+
+void rudpSetClock(RUDPClock_Ft clock) {
+    rudpClock = clock ? clock : defaultClock;
+}
 
 /**
  * @brief Initialise l'état d'une session RUDP.
@@ -18,9 +42,23 @@
  * @param conn État de la connexion à réinitialiser.
  */
 void rudpInitConnection(RUDPConnection_St *conn) {
+    memset(conn, 0, sizeof(*conn));
     conn->local_sequence = 0;
     conn->remote_sequence = 65535; 
     conn->receive_history = 0;
+    conn->rtoUs = RUDP_INITIAL_RTO_US;
+}
+
+/**
+ * @brief Libère les copies de renvoi de la fenêtre d'envoi.
+ * 
+ * @param conn Connexion initialisée ou remise à zéro.
+ */
+void rudpReleaseConnection(RUDPConnection_St *conn) {
+    for (u32 i = 0; i < RUDP_SEND_WINDOW; ++i) {
+        free(conn->sendWindow[i].data);
+        conn->sendWindow[i] = (RUDPSentPacket_St) {0};
+    }
 }
 
 /**
@@ -42,29 +80,121 @@ static inline bool sequenceMoreRecent(u16 s1, u16 s2) {
  * 
  * Incrémente la séquence locale et inclut les informations d'acquittement 
  * courant (remote_sequence et historique) pour informer le pair de l'état de notre réception.
+ * Tout en-tête sortant porte ces acquittements : plus besoin d'un ACK dédié.
  * 
  * @param conn   État actif de la connexion.
  * @param action Code d'action (Lobby ou Jeu).
  * @param out_h  Structure d'en-tête à remplir.
  */
 void rudpGenerateHeader(RUDPConnection_St *conn, u8 action, RUDPHeader_St *out_h) {
-    out_h->sequence     = htons(conn->local_sequence++);
+    // Un ACK nu ne consomme pas de séquence : le pair n'en lit que les acquittements
+    // (voir rudpProcessIncoming), son numéro n'est jamais interprété.
+    out_h->sequence     = htons(action == RUDP_ACTION_ACK_ONLY
+                                ? (u16)(conn->local_sequence - 1)
+                                : conn->local_sequence++);
     out_h->ack          = htons(conn->remote_sequence);
     out_h->ackBitfield = htonl(conn->receive_history);
     out_h->action       = action;
     out_h->senderId    = 0; // Défini ultérieurement par le serveur ou le main client
+    out_h->messageSequence = out_h->sequence;
+    conn->ackPending   = false;
+}
+
+/**
+ * @brief Intègre une mesure de RTT (RFC 6298, gains 1/8 et 1/4, terme de granularité G).
+ */
+static void updateRtt(RUDPConnection_St *conn, u32 sampleUs) {
+    if (conn->srttUs == 0) {
+        conn->srttUs   = sampleUs;
+        conn->rttVarUs = sampleUs / 2;
+    } else {
+        u32 delta = (conn->srttUs > sampleUs) ? conn->srttUs - sampleUs : sampleUs - conn->srttUs;
+        conn->rttVarUs = (3 * conn->rttVarUs + delta) / 4;
+        conn->srttUs   = (7 * conn->srttUs + sampleUs) / 8;
+    }
+
+    u32 variance = 4 * conn->rttVarUs;
+    if (variance < RUDP_RTO_GRANULARITY_US) variance = RUDP_RTO_GRANULARITY_US;
+
+    u32 rto = conn->srttUs + variance;
+    if (rto < RUDP_MIN_RTO_US) rto = RUDP_MIN_RTO_US;
+    if (rto > RUDP_MAX_RTO_US) rto = RUDP_MAX_RTO_US;
+    conn->rtoUs = rto;
+}
+
+/**
+ * @brief Indique si `sequence` est couverte par l'acquittement `ack` + `bitfield` du pair.
+ */
+static inline bool isAcked(u16 sequence, u16 ack, u32 bitfield) {
+    u16 distance = (u16)(ack - sequence);
+    return distance == 0 || (distance <= HISTORY_SIZE && (bitfield & (1u << (distance - 1))));
+}
+
+/**
+ * @brief Retire de la fenêtre d'envoi tous les paquets couverts par l'acquittement du pair.
+ * 
+ * Un paquet est retiré dès que son dernier envoi ou son premier envoi est acquitté ;
+ * seuls les paquets jamais renvoyés fournissent une mesure de RTT (algorithme de Karn).
+ */
+static void processAcks(RUDPConnection_St *conn, u16 ack, u32 bitfield) {
+    u64 now = rudpClock();
+
+    for (u32 i = 0; i < RUDP_SEND_WINDOW; ++i) {
+        RUDPSentPacket_St *p = &conn->sendWindow[i];
+        if (!p->inUse) continue;
+
+        if (!isAcked(p->sequence, ack, bitfield) && !isAcked(p->messageSequence, ack, bitfield)) continue;
+
+        if (p->retries == 0) updateRtt(conn, (u32)(now - p->firstSentUs));
+        p->inUse = false;
+        conn->packetsAcked++;
+    }
+}
+
+/**
+ * @brief Fait avancer la fenêtre de livraison jusqu'à `seq` en oubliant les séquences qui en sortent.
+ */
+static void advanceDelivered(RUDPConnection_St *conn, u16 seq) {
+    u32 steps = (u16)(seq - conn->remote_sequence);
+    if (steps > RUDP_DELIVERY_WINDOW) steps = RUDP_DELIVERY_WINDOW;
+    for (u32 k = 1; k <= steps; ++k) {
+        u32 bit = (u16)(conn->remote_sequence + k) % RUDP_DELIVERY_WINDOW;
+        conn->deliveredHistory[bit / 32] &= ~(1u << (bit % 32));
+    }
+}
+
+/**
+ * @brief Marque un message comme livré.
+ * @return false s'il l'était déjà (renvoi d'un message reçu) ou s'il est hors fenêtre.
+ */
+static bool markDelivered(RUDPConnection_St *conn, u16 messageSeq) {
+    if ((u16)(conn->remote_sequence - messageSeq) >= RUDP_DELIVERY_WINDOW) return false;
+
+    u32 bit  = messageSeq % RUDP_DELIVERY_WINDOW;
+    u32 mask = 1u << (bit % 32);
+    if (conn->deliveredHistory[bit / 32] & mask) return false;
+    conn->deliveredHistory[bit / 32] |= mask;
+    return true;
 }
 
 /**
  * @brief Analyse un paquet entrant et met à jour l'état de réception local.
  * 
- * Gère deux cas :
+ * Un ACK nu n'apporte que des acquittements : il ne touche ni à remote_sequence
+ * ni à l'historique. Sa séquence est celle du dernier paquet envoyé par le pair ;
+ * si ce paquet fiable s'est perdu, l'enregistrer ferait rejeter son renvoi comme
+ * doublon après l'avoir acquitté.
+ * 
+ * La séquence du paquet alimente l'historique d'acquittement :
  * 1. Paquet plus récent : Décale l'historique et met à jour la séquence de référence.
  * 2. Paquet en retard (jitter) : Vérifie dans l'historique s'il est manquant et l'accepte si oui.
  * 
+ * Un paquet nouveau n'est livré que si son message (`messageSequence`) ne l'a pas
+ * déjà été : le renvoi d'un message reçu dont l'ACK s'est perdu est acquitté, pas relivré.
+ * 
  * @param conn État de la connexion à mettre à jour.
  * @param in_h En-tête du paquet reçu (en format réseau).
- * @return true si le paquet est nouveau ou nécessaire (doit être traité), 
+ * @return true si le paquet est nouveau ou nécessaire (doit être traité) ou si c'est un ACK nu,
  *         false s'il s'agit d'un doublon ou s'il est hors fenêtre.
  */
 bool rudpProcessIncoming(RUDPConnection_St *conn, const RUDPHeader_St *in_h) {
@@ -72,13 +202,10 @@ bool rudpProcessIncoming(RUDPConnection_St *conn, const RUDPHeader_St *in_h) {
     u16 ack = ntohs(in_h->ack);
     u32 bitfield = ntohl(in_h->ackBitfield);
 
-    /* 
-       Traitement des ACKs du pair :
-       Le pair nous dit qu'il a reçu jusqu'à 'ack' et les paquets du 'bitfield'.
-       Ici, on pourrait nettoyer une file de retransmission locale.
-    */
-    (void)ack;
-    (void)bitfield;
+    // Le pair nous dit qu'il a reçu jusqu'à 'ack' et les paquets du 'bitfield',
+    // y compris quand le paquet lui-même est un doublon.
+    processAcks(conn, ack, bitfield);
+    if (in_h->action == RUDP_ACTION_ACK_ONLY) return true;
 
     // Cas 1 : Le paquet est plus récent que tout ce qu'on a vu
     if (sequenceMoreRecent(seq, conn->remote_sequence)) {
@@ -90,8 +217,10 @@ bool rudpProcessIncoming(RUDPConnection_St *conn, const RUDPHeader_St *in_h) {
             // Décale l'historique et marque le précédent remote_sequence comme reçu (bit 0)
             conn->receive_history = (conn->receive_history << difference) | ((u32)1 << (difference - 1));
         }
+        advanceDelivered(conn, seq);
         conn->remote_sequence = seq;
-        return true;
+        conn->ackPending = true;
+        return markDelivered(conn, ntohs(in_h->messageSequence));
     } 
     
     // Cas 2 : Le paquet est arrivé en retard mais dans la fenêtre de l'historique
@@ -100,9 +229,107 @@ bool rudpProcessIncoming(RUDPConnection_St *conn, const RUDPHeader_St *in_h) {
         u32 mask = 1U << (diff_old - 1);
         if (!(conn->receive_history & mask)) {
             conn->receive_history |= mask;
-            return true; // Paquet retardataire accepté car non reçu précédemment
+            conn->ackPending = true;
+            return markDelivered(conn, ntohs(in_h->messageSequence)); // Retardataire accepté s'il n'a pas été livré
         }
     }
 
+    // Un doublon signifie que notre acquittement s'est perdu : on le renverra.
+    if (diff_old <= HISTORY_SIZE) conn->ackPending = true;
+
     return false; // Doublon ou trop vieux
+}
+
+/**
+ * @brief Conserve une copie d'un paquet fiable jusqu'à son acquittement.
+ * 
+ * Le paquet prend un créneau libre ; si la fenêtre est pleine, il remplace le
+ * plus ancien message en attente, compté comme perdu. La copie n'est réallouée
+ * que si le datagramme dépasse la plus grande copie déjà faite dans ce créneau.
+ */
+bool rudpTrackReliable(RUDPConnection_St *conn, const u8 *datagram, u16 length) {
+    if (length < sizeof(RUDPHeader_St) || length > RUDP_MAX_PACKET_SIZE) return false;
+
+    RUDPHeader_St h;
+    memcpy(&h, datagram, sizeof(h));
+    u16 seq = ntohs(h.sequence);
+
+    RUDPSentPacket_St *p = NULL;
+    for (u32 i = 0; i < RUDP_SEND_WINDOW && (p == NULL || p->inUse); ++i) {
+        RUDPSentPacket_St *slot = &conn->sendWindow[i];
+        if (p == NULL || !slot->inUse
+            || (u16)(seq - slot->messageSequence) > (u16)(seq - p->messageSequence)) p = slot;
+    }
+    if (length > p->capacity) {
+        u8 *grown = realloc(p->data, length);
+        if (grown == NULL) return false;
+        p->data     = grown;
+        p->capacity = length;
+    }
+    if (p->inUse) conn->packetsLost++;
+
+    p->inUse       = true;
+    p->sequence    = seq;
+    p->messageSequence = ntohs(h.messageSequence);
+    p->retries     = 0;
+    p->length      = length;
+    p->firstSentUs = rudpClock();
+    p->lastSentUs  = p->firstSentUs;
+    memcpy(p->data, datagram, length);
+    return true;
+}
+
+/**
+ * @brief Renvoie les paquets dont le délai (RTO doublé à chaque essai, au plus ×4) a expiré.
+ * 
+ * Chaque renvoi prend un nouveau numéro de séquence : il reste dans la fenêtre
+ * d'acquittement du pair quel que soit le trafic parti entre-temps. Le message est
+ * abandonné après RUDP_MAX_RETRIES renvois, ou quand son premier envoi sort de la
+ * fenêtre de livraison du pair, qui ne saurait plus l'écarter s'il l'a déjà reçu.
+ * 
+ * Les acquittements embarqués sont rafraîchis pour que le renvoi serve aussi d'ACK.
+ */
+u32 rudpResendExpired(RUDPConnection_St *conn, RUDPSend_Ft send, void *userData) {
+    u64 now = rudpClock();
+    u32 resent = 0;
+
+    for (u32 i = 0; i < RUDP_SEND_WINDOW; ++i) {
+        RUDPSentPacket_St *p = &conn->sendWindow[i];
+        if (!p->inUse) continue;
+
+        u8  shift   = p->retries < RUDP_MAX_BACKOFF_SHIFT ? p->retries : RUDP_MAX_BACKOFF_SHIFT;
+        u64 timeout = (u64)conn->rtoUs << shift;
+        if (timeout > RUDP_MAX_RTO_US) timeout = RUDP_MAX_RTO_US;
+        if (now - p->lastSentUs < timeout) continue;
+
+        if (p->retries >= RUDP_MAX_RETRIES
+            || (u16)(conn->local_sequence - p->messageSequence) >= RUDP_DELIVERY_WINDOW) {
+            p->inUse = false;
+            conn->packetsLost++;
+            continue;
+        }
+
+        RUDPHeader_St *h = (RUDPHeader_St *)p->data;
+        p->sequence    = conn->local_sequence++;
+        h->sequence    = htons(p->sequence);
+        h->ack         = htons(conn->remote_sequence);
+        h->ackBitfield = htonl(conn->receive_history);
+        conn->ackPending = false;
+
+        send(userData, p->data, p->length);
+        p->lastSentUs = now;
+        p->retries++;
+        conn->packetsRetransmitted++;
+        resent++;
+    }
+
+    return resent;
+}
+
+u32 rudpPendingCount(const RUDPConnection_St *conn) {
+    u32 count = 0;
+    for (u32 i = 0; i < RUDP_SEND_WINDOW; ++i) {
+        if (conn->sendWindow[i].inUse) count++;
+    }
+    return count;
 }
\ No newline at end of file
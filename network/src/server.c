@@ -4,7 +4,23 @@
     @date 2026-03-31
     @date 2026-04-14
     @brief Authoritative RUDP server with multi-module support.
+
+    On Linux the main loop sleeps in epoll_wait() on the UDP socket and a
+    timerfd armed at TICK_US: every wakeup drains the socket with recvmmsg()
+    and every outgoing datagram goes through a queue flushed with sendmmsg().
+    Other POSIX targets keep a select()-driven loop over the same stages.
+
+    With `--workers=N` room simulation moves off the I/O thread: rooms are
+    sharded over N workers (room i belongs to worker i % N), each worker
+    ticks its rooms on its own 60 Hz clock, actions reach a room through
+    its SPSC inbox and broadcasts come back through the worker's SPSC
+    outbox, drained by the I/O thread. A room's state is only ever touched
+    by its worker, so a slow room only delays the rooms of its own shard.
 */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     // recvmmsg() / sendmmsg()
+#endif
+
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
@@ -15,12 +31,24 @@
 #include <sys/select.h>
 #include <stddef.h>
 #include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
 
 #include "APIs/generalAPI.h"
 #include "gameRegistry.h"
 #include "networkInterface.h"
 #include "logger.h"
 #include "raylib.h"
+#include "spscQueue.h"
+#include "instancePool.h"
 
 // 
 // Configuration constants
@@ -30,13 +58,42 @@
 #define TICK_US                 16666                                   /**< Fréquence de mise à jour (60 Hz). */
 #define CLIENT_TIMEOUT_US       (60 * MICROSECONDS_IN_A_SECOND)         /**< Délai de déconnexion automatique (60 secondes). */
 #define SERVER_DISPLAY_NAME     "Multi-Mini-Games Server"
-#define MAX_PAYLOAD_SIZE        (2048 - sizeof(RUDPHeader_St))          /**< Taille maximale de la charge utile. */
-#define ACTION_CODE_ACK_ONLY    0x00                                    /**< RUDP-level acknowledgment only. */
+#define DATAGRAM_SIZE           RUDP_MAX_PACKET_SIZE                    /**< Taille maximale d'un datagramme. */
+#define MAX_PAYLOAD_SIZE        (DATAGRAM_SIZE - sizeof(RUDPHeader_St)) /**< Taille maximale de la charge utile. */
+#define ACTION_CODE_ACK_ONLY    RUDP_ACTION_ACK_ONLY                    /**< RUDP-level acknowledgment only. */
+#define RECV_BATCH_SIZE         32                                      /**< Datagrams pulled per recvmmsg() call. */
+#define MAX_RECV_BATCHES        16                                      /**< Batches drained per wakeup before yielding to the tick. */
+#define SEND_BATCH_SIZE         64                                      /**< Queued datagrams before a forced sendmmsg() flush. */
+#define MAX_CATCHUP_TICKS       4                                       /**< Ticks replayed at most after a stall. */
+#define STATS_REPORT_US         (5 * MICROSECONDS_IN_A_SECOND)          /**< Interval between two throughput reports. */
+#define CLIENT_HASH_CAPACITY    (2 * MAX_CLIENTS)                       /**< Address table slots (power of two, load <= 0.5). */
+#define NO_CLIENT               (-1)                                    /**< Empty hash slot / end of a member list. */
+#define MAX_ROOM_WORKERS        8                                       /**< Upper bound for --workers. */
+#define ROOM_INBOX_SLOTS        16                                      /**< Pending events per game room (actions beyond are dropped). */
+#define LOBBY_INBOX_SLOTS       1024                                    /**< Pending events for room 0, which gets every lobby move. */
+#define WORKER_OUTBOX_SLOTS     512                                     /**< Pending broadcasts per worker before it waits on the I/O thread. */
+#define JITTER_BUCKETS          12                                      /**< Bucket b counts ticks started < (64 us << b) late; the last one is open. */
+#define ROOM_CHUNK_SIZE         64                                      /**< Room slots allocated together; chunks never move. */
+#define MAX_ROOM_CHUNKS         1023                                    /**< Keeps every room index below ROOM_ID_NEW. */
+#define ROOM_LIST_MAX           (MAX_PAYLOAD_SIZE / sizeof(RoomInfo_St)) /**< Rooms described in one ROOM_INFO reply. */
 
 // 
 // Internal client representation
 // 
 
+/**
+    @brief Messages queued for one client until the end of the tick.
+
+    Holds `[BundleRecordHeader_St][payload]` records, sent as a single
+    ACTION_CODE_BUNDLE datagram (or as a plain datagram if only one record).
+*/
+typedef struct {
+    u16  length;            ///< Bytes used in data
+    u16  count;             ///< Records packed so far
+    bool reliable;          ///< At least one record must be delivered reliably
+    u8   data[BUNDLE_MTU];  ///< Packed records
+} OutBundle_St;
+
 /**
     @brief Server-side representation of a connected client.
 */
@@ -46,11 +103,29 @@ typedef struct {
     RUDPConnection_St rudpState;        ///< Per-client RUDP state
     struct timeval    lastSeen;         ///< Last activity timestamp
     int               roomId;           ///< Current room (0 = Lobby)
+    int               prevInRoom;       ///< Previous member of roomId, NO_CLIENT if first
+    int               nextInRoom;       ///< Next member of roomId, NO_CLIENT if last
     char              name[32];         ///< Player chosen name
+    OutBundle_St      outbox;           ///< Messages waiting for the end-of-tick flush
 } UDPClient_St;
 
+/**
+    @brief Per-room histogram of how late each onTick started, in log2 buckets.
+
+    Written by the thread running the room, read and reset by the I/O thread
+    when reporting, hence the relaxed atomics.
+*/
+typedef struct {
+    _Atomic u32 buckets[JITTER_BUCKETS];    ///< Tick counts per lateness bucket
+    _Atomic u32 maxUs;                      ///< Worst lateness since last report
+} TickJitter_St;
+
 /**
     @brief Server-side representation of a game room (instance).
+
+    Slots live in fixed chunks and are recycled; `generation` tells apart
+    successive rooms using the same index. generation, inbox, live and
+    jitter belong to the slot and survive resetRoom().
 */
 typedef struct {
     bool                          active;     ///< True when room is in use
@@ -61,19 +136,119 @@ typedef struct {
     char                          name[32];       ///< Display name (e.g. "Room #1")
     char                          creatorName[32]; ///< Name of the player who created it
     int                           hostId;     ///< Client ID of the host
+    int                           firstMember; ///< Head of the member list (UDPClient_St.nextInRoom)
+    int                           memberCount; ///< Clients currently in the room
+    bool                          closing;    ///< Destroy posted to the owning worker, slot not reusable yet
+    bool                          pooled;     ///< state comes from instancePools[gameId]
+    u16                           generation; ///< Bumped each time the slot is freed
+    SPSCQueue_St                  inbox;      ///< RoomEvent_St queue, only allocated with workers
+    atomic_bool                   live;       ///< Instance exists and may be ticked by its worker
+    TickJitter_St                 jitter;     ///< Tick lateness
+    u64                           lastTickUs; ///< Start of the previous tick, owned by the ticking thread
+    u64                           nextTickUs; ///< Earliest next tick requested by the module (0 = next tick)
 } Room_St;
 
+/**
+    @brief Kind of event carried by a room inbox.
+*/
+typedef enum {
+    ROOM_EVENT_ACTION,      ///< Player action for module->onAction
+    ROOM_EVENT_LEAVE,       ///< Player left, module->onPlayerLeave
+    ROOM_EVENT_DESTROY,     ///< Last event of a room: module->destroyInstance
+} RoomEventKind_Et;
+
+/**
+    @brief One entry of a room inbox (I/O thread -> room worker).
+*/
+typedef struct {
+    u8  kind;                       ///< RoomEventKind_Et
+    u8  action;                     ///< Action code (ROOM_EVENT_ACTION)
+    u16 len;                        ///< Bytes used in payload
+    s32 playerId;                   ///< Sender / leaving player
+    u8  payload[MAX_PAYLOAD_SIZE];  ///< Copy of the datagram payload
+} RoomEvent_St;
+
+/**
+    @brief One entry of a worker outbox (room worker -> I/O thread), replayed through serverBroadcast().
+*/
+typedef struct {
+    s32 roomId;                     ///< Target room or UNICAST
+    s32 excludeId;                  ///< Excluded player / unicast target
+    u8  action;                     ///< Action code
+    u16 len;                        ///< Bytes used in payload
+    u8  payload[MAX_PAYLOAD_SIZE];  ///< Copy of the broadcast payload
+} RoomBroadcast_St;
+
+/**
+    @brief A room simulation thread and its outgoing broadcast queue.
+*/
+typedef struct {
+    int          index;     ///< Shard number: owns rooms index, index + workerCount, ...
+    pthread_t    thread;    ///< Worker thread handle
+    SPSCQueue_St outbox;    ///< RoomBroadcast_St entries for the I/O thread
+} RoomWorker_St;
+
+/**
+    @brief One outgoing datagram waiting for the next send flush.
+*/
+typedef struct {
+    struct sockaddr_in address;             ///< Destination endpoint
+    u16                length;              ///< Bytes used in data
+    u8                 data[DATAGRAM_SIZE]; ///< Header + payload, ready for the wire
+} OutDatagram_St;
+
+/**
+    @brief Ingest/egress counters, reset every STATS_REPORT_US.
+
+    Loop latency is the time spent doing work after a wakeup (receive,
+    dispatch, tick, flush), i.e. how long a datagram can wait behind
+    the current iteration. txMessages / txPackets is the coalescing ratio.
+*/
+typedef struct {
+    u64       rxPackets;        ///< Datagrams received
+    u64       rxBatches;        ///< Non-empty receive calls
+    u64       txPackets;        ///< Datagrams sent
+    u64       txBatches;        ///< Send flushes
+    u64       txBytes;          ///< Bytes handed to the socket
+    u64       txMessages;       ///< Logical messages queued (before coalescing)
+    u64       ticks;            ///< Simulation ticks run
+    u64       inboxDrops;       ///< Room actions dropped because the inbox was full
+    u64       loops;            ///< Loop iterations that did work
+    u64       loopBusyUs;       ///< Sum of per-iteration work time
+    u64       loopMaxUs;        ///< Worst iteration in the window
+    long long windowStartUs;    ///< Start of the current report window
+} ServerStats_St;
+
 // 
 // Globals
 // 
 
-#define MAX_ROOMS 16
-
 static int          masterSocket = -1;              ///< Main server listening socket
 static UDPClient_St clients[MAX_CLIENTS] = {0};     ///< Table of connected clients
-static Room_St      rooms[MAX_ROOMS] = {0};         ///< Table of active game rooms
+static Room_St*     roomChunks[MAX_ROOM_CHUNKS];    ///< Room slots, ROOM_CHUNK_SIZE per chunk
+static _Atomic u32  roomCapacity = 0;               ///< Allocated slots (published after the chunk, read by workers)
+static u16          freeRoomIds[MAX_ROOM_CHUNKS * ROOM_CHUNK_SIZE]; ///< Stack of unused room slots
+static u32          freeRoomCount = 0;
+static u32          activeRoomCount = 0;            ///< Rooms currently open, lobby included
+static InstancePool_St instancePools[__miniGameIdCount]; ///< Per-game recycled state blocks
 static volatile bool keepRunning = true;
 
+static s16 clientHash[CLIENT_HASH_CAPACITY];        ///< (addr, port) -> client slot, NO_CLIENT when empty
+static int freeClientIds[MAX_CLIENTS];              ///< Stack of unused client slots
+static int freeClientCount = 0;
+
+static OutDatagram_St sendQueue[SEND_BATCH_SIZE];               ///< Pending outgoing datagrams
+static int            sendQueueCount = 0;                       ///< Number of used sendQueue entries
+static u8             recvBuffers[RECV_BATCH_SIZE][DATAGRAM_SIZE]; ///< recvmmsg() landing buffers
+static struct sockaddr_in recvAddresses[RECV_BATCH_SIZE];       ///< Source endpoint per landing buffer
+static ServerStats_St stats = {0};
+static u64            tickDueUs = 0;                            ///< Scheduled start of the next inline tick (monotonic)
+
+static int            workerCount = 0;                          ///< 0 = rooms run inline on the I/O thread
+static RoomWorker_St  workers[MAX_ROOM_WORKERS];                ///< Room simulation threads
+static atomic_bool    workersRunning = false;                   ///< Cleared to stop the workers
+static _Thread_local RoomWorker_St* currentWorker = NULL;       ///< Worker running on this thread, NULL on the I/O thread
+
 // 
 // Helper functions
 // 
@@ -92,6 +267,26 @@ static long long getTimeUs(void) {
     return (long long)tv.tv_sec * MICROSECONDS_IN_A_SECOND + tv.tv_usec;
 }
 
+/**
+    @brief Monotonic time in microseconds, used for tick scheduling and jitter.
+*/
+static u64 monotonicUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * MICROSECONDS_IN_A_SECOND + (u64)ts.tv_nsec / 1000;
+}
+
+/**
+    @brief Sleeps until a monotonic deadline (returns at once if it already passed).
+*/
+static void sleepUntilUs(u64 deadlineUs) {
+    for (u64 now = monotonicUs(); now < deadlineUs; now = monotonicUs()) {
+        u64 waitUs = deadlineUs - now;
+        struct timespec ts = { (time_t)(waitUs / MICROSECONDS_IN_A_SECOND), (long)(waitUs % MICROSECONDS_IN_A_SECOND) * 1000L };
+        nanosleep(&ts, NULL);
+    }
+}
+
 /**
     @brief Sets a socket to non-blocking mode.
 */
@@ -101,29 +296,327 @@ static void setNonBlocking(int fd) {
 }
 
 /**
-    @brief Finds existing client by address or creates a new slot.
+    @brief Home slot of an endpoint in clientHash (Fibonacci hashing of addr:port).
 */
-static int findOrCreateClient(struct sockaddr_in* addr) {
-    for (int i = 0; i < MAX_CLIENTS; ++i) {
-        if (clients[i].active &&
-            clients[i].address.sin_addr.s_addr == addr->sin_addr.s_addr &&
-            clients[i].address.sin_port == addr->sin_port) {
-            return i;
+static u32 hashAddress(const struct sockaddr_in* addr) {
+    u64 key = ((u64)addr->sin_addr.s_addr << 16) | addr->sin_port;
+    return (u32)((key * 0x9E3779B97F4A7C15ull) >> 32) & (CLIENT_HASH_CAPACITY - 1);
+}
+
+static bool sameAddress(const struct sockaddr_in* a, const struct sockaddr_in* b) {
+    return a->sin_addr.s_addr == b->sin_addr.s_addr && a->sin_port == b->sin_port;
+}
+
+/**
+    @brief Resets the address table and the free-slot stack.
+*/
+static void initClientTable(void) {
+    for (int i = 0; i < CLIENT_HASH_CAPACITY; ++i) clientHash[i] = NO_CLIENT;
+    freeClientCount = 0;
+    for (int i = MAX_CLIENTS - 1; i >= 0; --i) freeClientIds[freeClientCount++] = i;
+}
+
+/**
+    @brief Linear-probing lookup; returns the client id or NO_CLIENT.
+*/
+static int findClient(const struct sockaddr_in* addr) {
+    for (u32 h = hashAddress(addr); clientHash[h] != NO_CLIENT; h = (h + 1) & (CLIENT_HASH_CAPACITY - 1)) {
+        if (sameAddress(&clients[clientHash[h]].address, addr)) return clientHash[h];
+    }
+    return NO_CLIENT;
+}
+
+/**
+    @brief Removes a client from clientHash with backward-shift deletion (no tombstones).
+*/
+static void unhashClient(int clientId) {
+    u32 mask = CLIENT_HASH_CAPACITY - 1;
+    u32 hole = hashAddress(&clients[clientId].address);
+    while (clientHash[hole] != clientId) {
+        if (clientHash[hole] == NO_CLIENT) return;
+        hole = (hole + 1) & mask;
+    }
+
+    // Pull later entries of the probe run back into the hole when their home allows it
+    for (u32 next = (hole + 1) & mask; clientHash[next] != NO_CLIENT; next = (next + 1) & mask) {
+        u32 home = hashAddress(&clients[clientHash[next]].address);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            clientHash[hole] = clientHash[next];
+            hole = next;
         }
     }
+    clientHash[hole] = NO_CLIENT;
+}
 
-    for (int i = 0; i < MAX_CLIENTS; ++i) {
-        if (!clients[i].active) {
-            memset(&clients[i], 0, sizeof(UDPClient_St));
-            clients[i].active = true;
-            clients[i].address = *addr;
-            clients[i].roomId = 0; 
-            rudpInitConnection(&clients[i].rudpState);
-            gettimeofday(&clients[i].lastSeen, NULL);
-            return i;
+/**
+    @brief Slot of a room index (must be below roomCapacity).
+*/
+static Room_St* roomAt(u32 roomId) {
+    return &roomChunks[roomId / ROOM_CHUNK_SIZE][roomId % ROOM_CHUNK_SIZE];
+}
+
+/**
+    @brief Open room with this index, or NULL.
+*/
+static Room_St* getRoom(int roomId) {
+    if (roomId < 0 || (u32)roomId >= atomic_load_explicit(&roomCapacity, memory_order_relaxed)) return NULL;
+    Room_St* r = roomAt((u32)roomId);
+    return r->active ? r : NULL;
+}
+
+/**
+    @brief Clears the per-room fields of a slot, keeping the slot-owned ones.
+*/
+static void resetRoom(Room_St* r) {
+    r->active = false;
+    r->id = 0;
+    r->gameId = 0;
+    r->module = NULL;
+    r->state = NULL;
+    memset(r->name, 0, sizeof(r->name));
+    memset(r->creatorName, 0, sizeof(r->creatorName));
+    r->hostId = NO_CLIENT;
+    r->firstMember = NO_CLIENT;
+    r->memberCount = 0;
+    r->closing = false;
+    r->pooled = false;
+}
+
+/**
+    @brief Adds a chunk of ROOM_CHUNK_SIZE free slots.
+*/
+static bool growRooms(void) {
+    u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_relaxed);
+    u32 chunk = capacity / ROOM_CHUNK_SIZE;
+    if (chunk >= MAX_ROOM_CHUNKS) return false;
+
+    Room_St* slots = calloc(ROOM_CHUNK_SIZE, sizeof(Room_St));
+    if (slots == NULL) return false;
+    for (int i = 0; i < ROOM_CHUNK_SIZE; ++i) {
+        resetRoom(&slots[i]);
+        atomic_init(&slots[i].live, false);
+        if (workerCount > 0 && !spscInit(&slots[i].inbox, ROOM_INBOX_SLOTS, sizeof(RoomEvent_St))) {
+            for (int j = 0; j < i; ++j) spscDestroy(&slots[j].inbox);
+            free(slots);
+            return false;
         }
     }
-    return -1;
+    roomChunks[chunk] = slots;
+
+    // Lowest index on top of the stack
+    for (u32 i = capacity + ROOM_CHUNK_SIZE; i-- > capacity;) freeRoomIds[freeRoomCount++] = (u16)i;
+    atomic_store_explicit(&roomCapacity, capacity + ROOM_CHUNK_SIZE, memory_order_release);
+    log_debug("Room table grown to %u slots", capacity + ROOM_CHUNK_SIZE);
+    return true;
+}
+
+/**
+    @brief Builds a fresh state for a room, from the game's slab pool when the module supports it.
+*/
+static void* createRoomState(Room_St* r) {
+    const GameServerInterface_St* module = r->module;
+    if (module->instanceSize > 0 && module->initInstance) {
+        InstancePool_St* pool = &instancePools[r->gameId];
+        if (pool->blockSize == 0) instancePoolInit(pool, module->instanceSize);
+        void* state = instancePoolAcquire(pool);
+        if (state == NULL) return NULL;
+        module->initInstance(state);
+        r->pooled = true;
+        return state;
+    }
+    return module->createInstance ? module->createInstance() : NULL;
+}
+
+/**
+    @brief Module-side teardown of a room state; runs on the thread that owns the room.
+    @note  A pooled block itself goes back to its pool in closeRoom(), on the I/O thread.
+*/
+static void finalizeRoomState(Room_St* r) {
+    if (r->state == NULL) return;
+    if (r->pooled) {
+        if (r->module->releaseInstance) r->module->releaseInstance(r->state);
+    } else if (r->module->destroyInstance) {
+        r->module->destroyInstance(r->state);
+    }
+}
+
+/**
+    @brief Returns a finalized room's slot (and pooled state block) for reuse.
+*/
+static void closeRoom(Room_St* r) {
+    if (r->pooled && r->state) instancePoolRelease(&instancePools[r->gameId], r->state);
+    u16 id = (u16)r->id;
+    resetRoom(r);
+    r->generation++;
+    freeRoomIds[freeRoomCount++] = id;
+    activeRoomCount--;
+}
+
+/**
+    @brief Unlinks a client from its room's member list.
+*/
+static void leaveRoom(int clientId) {
+    UDPClient_St* c = &clients[clientId];
+    Room_St* r = roomAt((u32)c->roomId);
+
+    if (c->prevInRoom != NO_CLIENT) clients[c->prevInRoom].nextInRoom = c->nextInRoom;
+    else r->firstMember = c->nextInRoom;
+    if (c->nextInRoom != NO_CLIENT) clients[c->nextInRoom].prevInRoom = c->prevInRoom;
+
+    c->prevInRoom = c->nextInRoom = NO_CLIENT;
+    r->memberCount--;
+}
+
+/**
+    @brief Moves a client into roomId's member list (pushed at the head).
+*/
+static void moveClientToRoom(int clientId, int roomId) {
+    UDPClient_St* c = &clients[clientId];
+    leaveRoom(clientId);
+
+    Room_St* r = roomAt((u32)roomId);
+    c->roomId = roomId;
+    c->nextInRoom = r->firstMember;
+    if (r->firstMember != NO_CLIENT) clients[r->firstMember].prevInRoom = clientId;
+    r->firstMember = clientId;
+    r->memberCount++;
+}
+
+static void flushClientOutbox(int clientId);
+
+/**
+    @brief Frees a client slot: room membership, address table and id.
+*/
+static void releaseClient(int clientId) {
+    if (!clients[clientId].active) return;
+    flushClientOutbox(clientId);
+    leaveRoom(clientId);
+    unhashClient(clientId);
+    rudpReleaseConnection(&clients[clientId].rudpState);
+    clients[clientId].active = false;
+    freeClientIds[freeClientCount++] = clientId;
+}
+
+/**
+    @brief Finds existing client by address or creates a new slot (both O(1)).
+*/
+static int findOrCreateClient(struct sockaddr_in* addr) {
+    int existing = findClient(addr);
+    if (existing != NO_CLIENT) return existing;
+    if (freeClientCount == 0) return -1;
+
+    int id = freeClientIds[--freeClientCount];
+    UDPClient_St* c = &clients[id];
+    memset(c, 0, sizeof(UDPClient_St));
+    c->active = true;
+    c->address = *addr;
+    rudpInitConnection(&c->rudpState);
+    gettimeofday(&c->lastSeen, NULL);
+
+    // New clients start in the lobby (room 0)
+    c->roomId = 0;
+    c->prevInRoom = NO_CLIENT;
+    Room_St* lobby = roomAt(0);
+    c->nextInRoom = lobby->firstMember;
+    if (lobby->firstMember != NO_CLIENT) clients[lobby->firstMember].prevInRoom = id;
+    lobby->firstMember = id;
+    lobby->memberCount++;
+
+    u32 h = hashAddress(addr);
+    while (clientHash[h] != NO_CLIENT) h = (h + 1) & (CLIENT_HASH_CAPACITY - 1);
+    clientHash[h] = (s16)id;
+    return id;
+}
+
+/**
+    @brief Sends every queued datagram, with a single sendmmsg() where available.
+*/
+static void flushSendQueue(void) {
+    if (sendQueueCount == 0) return;
+
+#ifdef __linux__
+    struct mmsghdr msgs[SEND_BATCH_SIZE];
+    struct iovec   iov[SEND_BATCH_SIZE];
+    memset(msgs, 0, sizeof(struct mmsghdr) * (size_t)sendQueueCount);
+
+    for (int i = 0; i < sendQueueCount; ++i) {
+        iov[i].iov_base = sendQueue[i].data;
+        iov[i].iov_len  = sendQueue[i].length;
+        msgs[i].msg_hdr.msg_iov     = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen  = 1;
+        msgs[i].msg_hdr.msg_name    = &sendQueue[i].address;
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    int sent = 0;
+    for (int i = 0; i < sendQueueCount; ++i) stats.txBytes += sendQueue[i].length;
+    while (sent < sendQueueCount) {
+        int r = sendmmsg(masterSocket, msgs + sent, (unsigned int)(sendQueueCount - sent), 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            // Socket buffer full or transient error: UDP is lossy anyway, drop the rest.
+            log_warn("sendmmsg dropped %d datagram(s): %s", sendQueueCount - sent, strerror(errno));
+            break;
+        }
+        sent += r;
+    }
+    stats.txPackets += (u64)sent;
+#else
+    for (int i = 0; i < sendQueueCount; ++i) {
+        if (sendto(masterSocket, sendQueue[i].data, sendQueue[i].length, 0,
+                   (struct sockaddr*)&sendQueue[i].address, sizeof(struct sockaddr_in)) >= 0) {
+            stats.txPackets++;
+            stats.txBytes += sendQueue[i].length;
+        }
+    }
+#endif
+
+    stats.txBatches++;
+    sendQueueCount = 0;
+}
+
+/**
+    @brief Appends a datagram (header + optional payload) to the send queue.
+*/
+static OutDatagram_St* queueDatagram(const struct sockaddr_in* address, const RUDPHeader_St* header,
+                                     const void* payload, u16 len) {
+    if (sendQueueCount == SEND_BATCH_SIZE) flushSendQueue();
+    if (len > MAX_PAYLOAD_SIZE) len = MAX_PAYLOAD_SIZE;
+
+    OutDatagram_St* out = &sendQueue[sendQueueCount++];
+    out->address = *address;
+    memcpy(out->data, header, sizeof(RUDPHeader_St));
+    if (len > 0 && payload != NULL) memcpy(out->data + sizeof(RUDPHeader_St), payload, len);
+    else len = 0;
+    out->length = (u16)(sizeof(RUDPHeader_St) + len);
+    return out;
+}
+
+/**
+    @brief RUDPSend_Ft adapter: queues a retransmitted datagram for a client.
+*/
+static void resendToClient(void* userData, const u8* data, u16 length) {
+    const UDPClient_St* client = (const UDPClient_St*)userData;
+    if (sendQueueCount == SEND_BATCH_SIZE) flushSendQueue();
+
+    OutDatagram_St* out = &sendQueue[sendQueueCount++];
+    out->address = client->address;
+    out->length  = length;
+    memcpy(out->data, data, length);
+}
+
+/**
+    @brief Tells whether a server-emitted message must be tracked for retransmission.
+
+    Game traffic is opt-in through the TLV `isReliable` flag so that high-rate
+    streams (e.g. lobby movement) stay fire-and-forget. Other control codes
+    change client state and are always reliable.
+*/
+static bool isReliableMessage(u8 action, const void* payload, u16 len) {
+    if (action == ACTION_CODE_ACK_ONLY) return false;
+    if (action != ACTION_CODE_GAME_DATA) return true;
+    if (payload == NULL || len < sizeof(GameTLVHeader_St)) return false;
+    return ((const GameTLVHeader_St*)payload)->isReliable;
 }
 
 static void serverSendAck(int clientId) {
@@ -131,28 +624,370 @@ static void serverSendAck(int clientId) {
     RUDPHeader_St header;
     rudpGenerateHeader(&clients[clientId].rudpState, ACTION_CODE_ACK_ONLY, &header);
     header.senderId = htons(999);
-    sendto(masterSocket, &header, sizeof(RUDPHeader_St), 0,
-           (struct sockaddr*)&clients[clientId].address, sizeof(struct sockaddr_in));
+    queueDatagram(&clients[clientId].address, &header, NULL, 0);
 }
 
-static void serverBroadcast(int roomId, int excludeId, u8 action, const void* payload, u16 len) {
-    u8 buffer[2048];
-    if (len > MAX_PAYLOAD_SIZE) len = MAX_PAYLOAD_SIZE;
+/**
+    @brief Stamps a header for one recipient and queues the datagram right away.
+*/
+static void sendDatagramNow(int clientId, u16 senderId, u8 action, const void* payload, u16 len, bool reliable) {
+    UDPClient_St* c = &clients[clientId];
+    RUDPHeader_St header;
+    rudpGenerateHeader(&c->rudpState, action, &header);
+    header.senderId = htons(senderId);
+    OutDatagram_St* out = queueDatagram(&c->address, &header, payload, len);
+    if (reliable) rudpTrackReliable(&c->rudpState, out->data, out->length);
+}
+
+/**
+    @brief Sends a client's pending records: plain datagram for one, bundle for several.
+*/
+static void flushClientOutbox(int clientId) {
+    OutBundle_St* box = &clients[clientId].outbox;
+    if (box->count == 0) return;
+
+    if (box->count == 1) {
+        BundleRecordHeader_St record;
+        memcpy(&record, box->data, sizeof(record));
+        sendDatagramNow(clientId, ntohs(record.senderId), record.action,
+                        box->data + sizeof(record), ntohs(record.length), box->reliable);
+    } else {
+        sendDatagramNow(clientId, 999, ACTION_CODE_BUNDLE, box->data, box->length, box->reliable);
+    }
+
+    box->length = 0;
+    box->count = 0;
+    box->reliable = false;
+}
 
+/**
+    @brief End-of-tick flush of every client outbox.
+
+    The outbox datagram carries the client's acks; a bare ack only goes to
+    clients that sent something ack-worthy and got nothing back this tick.
+*/
+static void flushAllOutboxes(void) {
     for (int i = 0; i < MAX_CLIENTS; ++i) {
         if (!clients[i].active) continue;
-        bool shouldSend = (roomId == UNICAST) ? (i == excludeId) : (clients[i].roomId == roomId && i != excludeId);
-
-        if (shouldSend) {
-            RUDPHeader_St header;
-            rudpGenerateHeader(&clients[i].rudpState, action, &header);
-            u16 finalSenderId = (roomId == UNICAST || excludeId == -1) ? 999 : (u16)excludeId;
-            header.senderId = htons(finalSenderId); 
-            memcpy(buffer, &header, sizeof(RUDPHeader_St));
-            if (len > 0 && payload != NULL) memcpy(buffer + sizeof(RUDPHeader_St), payload, len);
-            sendto(masterSocket, buffer, sizeof(RUDPHeader_St) + len, 0,
-                   (struct sockaddr*)&clients[i].address, sizeof(struct sockaddr_in));
+        flushClientOutbox(i);
+        if (clients[i].rudpState.ackPending) serverSendAck(i);
+    }
+}
+
+/**
+    @brief Appends a message to a client's outbox, flushing first if it would overflow BUNDLE_MTU.
+*/
+static void sendToClient(int clientId, u16 senderId, u8 action, const void* payload, u16 len, bool reliable) {
+    OutBundle_St* box = &clients[clientId].outbox;
+    u32 recordSize = sizeof(BundleRecordHeader_St) + len;
+    stats.txMessages++;
+
+    if (recordSize > BUNDLE_MTU) {
+        // Too big to share a datagram: keep ordering, then send it alone
+        flushClientOutbox(clientId);
+        sendDatagramNow(clientId, senderId, action, payload, len, reliable);
+        return;
+    }
+    if (box->length + recordSize > BUNDLE_MTU) flushClientOutbox(clientId);
+
+    BundleRecordHeader_St record = { .action = action, .senderId = htons(senderId), .length = htons(len) };
+    memcpy(box->data + box->length, &record, sizeof(record));
+    if (len > 0 && payload != NULL) memcpy(box->data + box->length + sizeof(record), payload, len);
+    box->length += (u16)recordSize;
+    box->count++;
+    box->reliable |= reliable;
+}
+
+static void serverBroadcast(int roomId, int excludeId, u8 action, const void* payload, u16 len) {
+    if (len > MAX_PAYLOAD_SIZE) len = MAX_PAYLOAD_SIZE;
+    bool reliable = isReliableMessage(action, payload, len);
+    u16 finalSenderId = (roomId == UNICAST || excludeId == -1) ? 999 : (u16)excludeId;
+
+    if (roomId == UNICAST) {
+        if (excludeId >= 0 && excludeId < MAX_CLIENTS && clients[excludeId].active) {
+            sendToClient(excludeId, finalSenderId, action, payload, len, reliable);
         }
+        return;
+    }
+    Room_St* r = getRoom(roomId);
+    if (r == NULL) return;
+
+    for (int i = r->firstMember; i != NO_CLIENT; i = clients[i].nextInRoom) {
+        if (i != excludeId) sendToClient(i, finalSenderId, action, payload, len, reliable);
+    }
+}
+
+// 
+// Room execution (inline or on a worker)
+// 
+
+/**
+    @brief Broadcast callback handed to the game modules.
+
+    On the I/O thread it sends directly; on a room worker it queues the
+    message in the worker outbox, waiting for space rather than dropping.
+*/
+static void roomBroadcast(s32 roomId, s32 excludeId, u8 action, const void* payload, u16 len) {
+    if (currentWorker == NULL) {
+        serverBroadcast(roomId, excludeId, action, payload, len);
+        return;
+    }
+    if (len > MAX_PAYLOAD_SIZE) len = MAX_PAYLOAD_SIZE;
+
+    RoomBroadcast_St* out;
+    while ((out = spscBeginPush(&currentWorker->outbox)) == NULL) {
+        if (!atomic_load_explicit(&workersRunning, memory_order_relaxed)) return;
+        sched_yield();
+    }
+    out->roomId = roomId;
+    out->excludeId = excludeId;
+    out->action = action;
+    out->len = len;
+    if (len > 0 && payload != NULL) memcpy(out->payload, payload, len);
+    spscCommitPush(&currentWorker->outbox);
+}
+
+/**
+    @brief I/O thread: replays every queued worker broadcast through serverBroadcast().
+*/
+static void drainWorkerOutboxes(void) {
+    for (int w = 0; w < workerCount; ++w) {
+        RoomBroadcast_St* msg;
+        while ((msg = spscPeek(&workers[w].outbox)) != NULL) {
+            serverBroadcast(msg->roomId, msg->excludeId, msg->action, msg->len ? msg->payload : NULL, msg->len);
+            spscPop(&workers[w].outbox);
+        }
+    }
+}
+
+/**
+    @brief I/O thread: queues an event for a room's worker.
+
+    Actions are dropped (and counted) when the inbox is full, like a lost
+    datagram; leave/destroy events must arrive, so we wait for space while
+    keeping the outboxes drained so the worker cannot block on us.
+*/
+static void postRoomEvent(int roomId, RoomEventKind_Et kind, s32 playerId, u8 action, const void* payload, u16 len) {
+    RoomEvent_St* ev;
+    SPSCQueue_St* inbox = &roomAt((u32)roomId)->inbox;
+    while ((ev = spscBeginPush(inbox)) == NULL) {
+        if (kind == ROOM_EVENT_ACTION) {
+            stats.inboxDrops++;
+            return;
+        }
+        drainWorkerOutboxes();
+        sched_yield();
+    }
+    if (len > MAX_PAYLOAD_SIZE) len = MAX_PAYLOAD_SIZE;
+    ev->kind = (u8)kind;
+    ev->action = action;
+    ev->len = len;
+    ev->playerId = playerId;
+    if (len > 0 && payload != NULL) memcpy(ev->payload, payload, len);
+    spscCommitPush(inbox);
+}
+
+/**
+    @brief Delivers a player action to a room module.
+*/
+static void roomDispatchAction(int roomId, int clientId, u8 action, const void* payload, u16 len) {
+    Room_St* r = getRoom(roomId);
+    if (r == NULL || r->closing || !r->module || !r->module->onAction || r->state == NULL) return;
+    if (workerCount > 0) postRoomEvent(roomId, ROOM_EVENT_ACTION, clientId, action, payload, len);
+    else {
+        r->module->onAction(r->state, roomId, clientId, action, payload, len, roomBroadcast);
+        r->nextTickUs = 0;
+    }
+}
+
+/**
+    @brief Tells a room (the lobby included) that a player left it.
+*/
+static void roomPlayerLeave(int roomId, int clientId) {
+    Room_St* r = getRoom(roomId);
+    if (roomId < 0 || r == NULL || r->closing || !r->module || !r->module->onPlayerLeave) return;
+    if (workerCount > 0) postRoomEvent(roomId, ROOM_EVENT_LEAVE, clientId, 0, NULL, 0);
+    else {
+        r->module->onPlayerLeave(r->state, clientId);
+        r->nextTickUs = 0;
+    }
+}
+
+/**
+    @brief Makes a freshly created room visible to its worker.
+*/
+static void publishRoom(Room_St* r) {
+    for (int b = 0; b < JITTER_BUCKETS; ++b) atomic_store_explicit(&r->jitter.buckets[b], 0, memory_order_relaxed);
+    atomic_store_explicit(&r->jitter.maxUs, 0, memory_order_relaxed);
+    r->lastTickUs = 0;
+    r->nextTickUs = 0;
+    atomic_store_explicit(&r->live, true, memory_order_release);
+}
+
+/**
+    @brief Adds one tick start to the room's lateness histogram.
+*/
+static void recordTickJitter(TickJitter_St* jitter, u64 lateUs) {
+    int bucket = 0;
+    while (bucket < JITTER_BUCKETS - 1 && lateUs >= (64ull << bucket)) bucket++;
+    atomic_fetch_add_explicit(&jitter->buckets[bucket], 1, memory_order_relaxed);
+    if (lateUs > atomic_load_explicit(&jitter->maxUs, memory_order_relaxed)) {
+        atomic_store_explicit(&jitter->maxUs, (u32)lateUs, memory_order_relaxed);
+    }
+}
+
+/**
+    @brief Runs one module tick, measuring how late it starts against its schedule.
+
+    Modules implementing onRoomTick get the real elapsed time and may ask to
+    sleep; legacy onTick modules are still called on every server tick.
+*/
+static void runRoomTick(Room_St* r, u64 dueUs) {
+    if (!r->module || !r->state) return;
+    if (r->module->onRoomTick == NULL) {
+        if (r->module->onTick == NULL) return;
+        u64 now = monotonicUs();
+        recordTickJitter(&r->jitter, now > dueUs ? now - dueUs : 0);
+        r->module->onTick(r->state);
+        return;
+    }
+
+    if (r->nextTickUs > dueUs) return;
+
+    u64 now = monotonicUs();
+    recordTickJitter(&r->jitter, now > dueUs ? now - dueUs : 0);
+
+    ServerTickContext_St ctx = {
+        .dt        = r->lastTickUs ? (f32)(now - r->lastTickUs) / 1e6f : (f32)TICK_US / 1e6f,
+        .roomId    = r->id,
+        .broadcast = roomBroadcast,
+        .sleepMs   = 0
+    };
+    r->lastTickUs = now;
+    r->module->onRoomTick(r->state, &ctx);
+    r->nextTickUs = ctx.sleepMs ? dueUs + (u64)ctx.sleepMs * 1000 : 0;
+}
+
+/**
+    @brief Worker side: applies every queued event of one room.
+*/
+static void drainRoomInbox(Room_St* r) {
+    RoomEvent_St* ev;
+    while ((ev = spscPeek(&r->inbox)) != NULL) {
+        switch ((RoomEventKind_Et)ev->kind) {
+            case ROOM_EVENT_ACTION:
+                r->module->onAction(r->state, r->id, ev->playerId, ev->action, ev->len ? ev->payload : NULL, ev->len, roomBroadcast);
+                r->nextTickUs = 0;
+                break;
+            case ROOM_EVENT_LEAVE:
+                r->module->onPlayerLeave(r->state, ev->playerId);
+                r->nextTickUs = 0;
+                break;
+            case ROOM_EVENT_DESTROY:
+                finalizeRoomState(r);
+                atomic_store_explicit(&r->live, false, memory_order_release);
+                break;
+        }
+        spscPop(&r->inbox);
+    }
+}
+
+/**
+    @brief Worker thread: every TICK_US, drains and ticks the rooms of its shard.
+*/
+static void* roomWorkerMain(void* arg) {
+    currentWorker = (RoomWorker_St*)arg;
+    u64 dueUs = monotonicUs() + TICK_US;
+
+    while (atomic_load_explicit(&workersRunning, memory_order_acquire)) {
+        sleepUntilUs(dueUs);
+        u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_acquire);
+        for (u32 i = (u32)currentWorker->index; i < capacity; i += (u32)workerCount) {
+            Room_St* r = roomAt(i);
+            if (!atomic_load_explicit(&r->live, memory_order_acquire)) continue;
+            drainRoomInbox(r);
+            if (atomic_load_explicit(&r->live, memory_order_relaxed)) runRoomTick(r, dueUs);
+        }
+
+        // Same catch-up policy as the I/O thread: replay a few late ticks, then resync
+        dueUs += TICK_US;
+        u64 now = monotonicUs();
+        if (now > dueUs + MAX_CATCHUP_TICKS * TICK_US) dueUs = now + TICK_US;
+    }
+    return NULL;
+}
+
+/**
+    @brief Allocates the queues and starts `count` room workers.
+    @return false if anything failed (the server then keeps running rooms inline).
+*/
+static bool startRoomWorkers(int count) {
+    u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_relaxed);
+    for (u32 i = 0; i < capacity; ++i) {
+        u32 slots = (i == 0) ? LOBBY_INBOX_SLOTS : ROOM_INBOX_SLOTS;
+        if (!spscInit(&roomAt(i)->inbox, slots, sizeof(RoomEvent_St))) return false;
+    }
+    for (int w = 0; w < count; ++w) {
+        workers[w].index = w;
+        if (!spscInit(&workers[w].outbox, WORKER_OUTBOX_SLOTS, sizeof(RoomBroadcast_St))) return false;
+    }
+
+    workerCount = count;
+    atomic_store(&workersRunning, true);
+    for (int w = 0; w < count; ++w) {
+        if (pthread_create(&workers[w].thread, NULL, roomWorkerMain, &workers[w]) != 0) {
+            log_error("Failed to start room worker %d", w);
+            atomic_store(&workersRunning, false);
+            for (int j = 0; j < w; ++j) pthread_join(workers[j].thread, NULL);
+            workerCount = 0;
+            return false;
+        }
+    }
+    log_info("Room simulation sharded over %d worker thread(s)", count);
+    return true;
+}
+
+/**
+    @brief Stops and joins the workers, then forwards what they had queued.
+*/
+static void stopRoomWorkers(void) {
+    if (workerCount == 0) return;
+    atomic_store(&workersRunning, false);
+    for (int w = 0; w < workerCount; ++w) pthread_join(workers[w].thread, NULL);
+    drainWorkerOutboxes();
+}
+
+/**
+    @brief Logs the tick lateness of every live room and resets the histograms.
+*/
+static void reportTickJitter(void) {
+    u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_relaxed);
+    for (u32 i = 0; i < capacity; ++i) {
+        Room_St* r = roomAt(i);
+        if (!r->active) continue;
+
+        u32 counts[JITTER_BUCKETS];
+        u64 total = 0;
+        for (int b = 0; b < JITTER_BUCKETS; ++b) {
+            counts[b] = atomic_exchange_explicit(&r->jitter.buckets[b], 0, memory_order_relaxed);
+            total += counts[b];
+        }
+        u32 maxUs = atomic_exchange_explicit(&r->jitter.maxUs, 0, memory_order_relaxed);
+        if (total == 0) continue;
+
+        // Upper bound of the bucket holding the p50 / p99 tick (the open last bucket is bounded by max)
+        u64 p50Us = 0, p99Us = 0, seen = 0;
+        for (int b = 0; b < JITTER_BUCKETS; ++b) {
+            u64 boundUs = (b == JITTER_BUCKETS - 1) ? (u64)maxUs + 1 : (64ull << b);
+            seen += counts[b];
+            if (p50Us == 0 && seen * 2 >= total) p50Us = boundUs;
+            if (p99Us == 0 && seen * 100 >= total * 99) p99Us = boundUs;
+        }
+        char shard[24] = "";
+        if (workerCount > 0) snprintf(shard, sizeof(shard), ", worker %u", i % (u32)workerCount);
+        log_info("[JITTER] room %u (%s%s) ticks %llu | p50 < %llu us, p99 < %llu us, max %u us",
+                 i, r->module ? r->module->gameName : "?", shard,
+                 (ullong)total, (ullong)p50Us, (ullong)p99Us, maxUs);
     }
 }
 
@@ -161,12 +996,8 @@ static void handleDiscovery(struct sockaddr_in* clientAddr) {
     memset(&response, 0, sizeof(response));
     response.action = ACTION_CODE_DISCOVERY_INFO;
     response.senderId = htons(999);
-    u8 buffer[512];
-    memcpy(buffer, &response, sizeof(RUDPHeader_St));
     const char* info = SERVER_DISPLAY_NAME;
-    memcpy(buffer + sizeof(RUDPHeader_St), info, strlen(info) + 1);
-    sendto(masterSocket, buffer, sizeof(RUDPHeader_St) + (u16)strlen(info) + 1, 0,
-           (struct sockaddr*)clientAddr, sizeof(struct sockaddr_in));
+    queueDatagram(clientAddr, &response, info, (u16)(strlen(info) + 1));
 }
 
 static void checkTimeouts(void) {
@@ -178,37 +1009,415 @@ static void checkTimeouts(void) {
             if (diff > CLIENT_TIMEOUT_US) {
                 log_info("Client %d timed out", i);
                 int rId = clients[i].roomId;
-                if (rId > 0 && rooms[rId].active && rooms[rId].module && rooms[rId].module->onPlayerLeave) {
-                    rooms[rId].module->onPlayerLeave(rooms[rId].state, i);
-                }
-                clients[i].active = false;
+                roomPlayerLeave(rId, i);
+                releaseClient(i);
                 serverBroadcast(rId, i, ACTION_CODE_QUIT_GAME, NULL, 0);
             }
         }
     }
 }
 
-static void sendRoomList(int clientId) {
-    RoomInfo_St info[MAX_ROOMS];
-    int count = 0;
-    for (int i = 0; i < MAX_ROOMS; i++) {
-        if (rooms[i].active) {
-            info[count].id = htons((u16)i);
-            int pCount = 0;
-            for (int j = 0; j < MAX_CLIENTS; j++) if (clients[j].active && clients[j].roomId == i) pCount++;
-            info[count].playerCount = htons((u16)pCount);
-            strncpy(info[count].name, rooms[i].name, 31);
-            info[count].name[31] = '\0';
-            strncpy(info[count].creator, rooms[i].creatorName, 31);
-            info[count].creator[31] = '\0';
+/**
+    @brief Replies with the open rooms of one game (every room for MINI_GAME_ID_LOBBY), up to ROOM_LIST_MAX.
+*/
+static void sendRoomList(int clientId, MiniGameId_Et gameFilter) {
+    RoomInfo_St info[ROOM_LIST_MAX];
+    u32 count = 0;
+    u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_relaxed);
+    for (u32 i = 0; i < capacity && count < ROOM_LIST_MAX; i++) {
+        Room_St* r = roomAt(i);
+        if (!r->active || r->closing) continue;
+        if (gameFilter != MINI_GAME_ID_LOBBY && r->gameId != gameFilter) continue;
+
+        info[count].id = htons((u16)i);
+        info[count].playerCount = htons((u16)r->memberCount);
+        strncpy(info[count].name, r->name, 31);
+        info[count].name[31] = '\0';
+        strncpy(info[count].creator, r->creatorName, 31);
+        info[count].creator[31] = '\0';
+        info[count].generation = htons(r->generation);
+        count++;
+    }
+    serverBroadcast(UNICAST, clientId, ACTION_CODE_LOBBY_ROOM_INFO, info, (u16)(count * sizeof(RoomInfo_St)));
+}
+
+/**
+    @brief Takes a free slot and creates the game instance; returns the room or NULL.
+*/
+static Room_St* openRoom(MiniGameId_Et gameId, int hostId) {
+    const GameServerInterface_St* module = getGameServerInterface(gameId);
+    if (module == NULL) return NULL;
+    if (freeRoomCount == 0 && !growRooms()) {
+        log_warn("Room table full, cannot open a %s room", module->gameName);
+        return NULL;
+    }
+
+    u16 id = freeRoomIds[--freeRoomCount];
+    Room_St* r = roomAt(id);
+    r->id = id;
+    r->gameId = gameId;
+    r->module = module;
+    r->state = createRoomState(r);
+    if (r->state == NULL) {
+        resetRoom(r);
+        freeRoomIds[freeRoomCount++] = id;
+        return NULL;
+    }
+
+    r->active = true;
+    r->hostId = hostId;
+    if (hostId >= 0) strncpy(r->creatorName, clients[hostId].name, 31);
+    snprintf(r->name, sizeof(r->name), "Room #%u", id);
+    activeRoomCount++;
+    publishRoom(r);
+    return r;
+}
+
+/**
+    @brief Runs one simulation step: timeouts, empty-room cleanup and module ticks.
+
+    Module ticks only run here when there are no workers; otherwise empty
+    rooms are handed to their worker for destruction and the slot is freed
+    once the worker reports the instance gone.
+*/
+static void serverTick(void) {
+    u64 dueUs = tickDueUs;
+    tickDueUs += TICK_US;
+    stats.ticks++;
+    checkTimeouts();
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].active) rudpResendExpired(&clients[i].rudpState, resendToClient, &clients[i]);
+    }
+
+    u32 capacity = atomic_load_explicit(&roomCapacity, memory_order_relaxed);
+    for (u32 i = 0; i < capacity; i++) {
+        Room_St* r = roomAt(i);
+        if (!r->active) continue;
+
+        // Check if room is empty (excluding lobby)
+        if (i > 0) {
+            if (r->closing) {
+                if (!atomic_load_explicit(&r->live, memory_order_acquire)) closeRoom(r);
+                continue;
+            }
+            if (r->memberCount == 0) {
+                log_info("Destroying empty room %u (%s)", i, r->name);
+                if (workerCount > 0) {
+                    r->closing = true;
+                    postRoomEvent((int)i, ROOM_EVENT_DESTROY, -1, 0, NULL, 0);
+                    continue;
+                }
+                finalizeRoomState(r);
+                atomic_store_explicit(&r->live, false, memory_order_relaxed);
+                closeRoom(r);
+                continue;
+            }
+        }
+
+        if (workerCount == 0) runRoomTick(r, dueUs);
+    }
+
+    // After a long stall, restart the schedule instead of reporting every tick as late
+    u64 now = monotonicUs();
+    if (now > tickDueUs + MAX_CATCHUP_TICKS * TICK_US) tickDueUs = now + TICK_US;
+}
+
+/**
+    @brief Creates or joins a room and confirms it with a SwitchGamePayload_St.
+
+    Also accepts the older 2-byte form (gameId, s8 room, -1 to create),
+    which carries no generation and therefore joins whatever room holds
+    that index.
+*/
+static void handleSwitchGame(int clientId, const u8* payload, u16 len) {
+    MiniGameId_Et targetGameId;
+    u32 targetRoomId;
+    bool checkGeneration = false;
+    u16 generation = 0;
+
+    if (len >= sizeof(SwitchGamePayload_St)) {
+        SwitchGamePayload_St request;
+        memcpy(&request, payload, sizeof(request));
+        targetGameId = (MiniGameId_Et)request.gameId;
+        targetRoomId = ntohs(request.roomId);
+        generation = ntohs(request.generation);
+        checkGeneration = true;
+    } else if (len >= 2) {
+        targetGameId = (MiniGameId_Et)payload[0];
+        targetRoomId = ((s8)payload[1] == -1) ? ROOM_ID_NEW : payload[1];
+    } else return;
+
+    Room_St* r = NULL;
+    if (targetRoomId == ROOM_ID_NEW) {
+        if (targetGameId == MINI_GAME_ID_LOBBY || targetGameId >= __miniGameIdCount) return;
+        r = openRoom(targetGameId, clientId);
+    } else {
+        r = getRoom((int)targetRoomId);
+        if (r != NULL && (r->closing || (checkGeneration && r->generation != generation))) r = NULL;
+        if (r == NULL) log_info("Client %d asked for stale or unknown room %u", clientId, targetRoomId);
+    }
+    if (r == NULL) return;
+
+    if (clients[clientId].roomId != r->id) roomPlayerLeave(clients[clientId].roomId, clientId);
+    moveClientToRoom(clientId, r->id);
+    SwitchGamePayload_St resp = { .gameId = (u8)r->gameId, .roomId = htons((u16)r->id), .generation = htons(r->generation) };
+    serverBroadcast(UNICAST, clientId, ACTION_CODE_LOBBY_SWITCH_GAME, &resp, sizeof(resp));
+}
+
+/**
+    @brief Decodes and dispatches a single received datagram.
+*/
+static void handleDatagram(const u8* buf, ssize_t received, struct sockaddr_in* clientAddr) {
+    if (received < (ssize_t)sizeof(RUDPHeader_St)) return;
+
+    const RUDPHeader_St* h = (const RUDPHeader_St*)buf;
+    if (h->action == ACTION_CODE_DISCOVERY_QUERY) {
+        handleDiscovery(clientAddr);
+        return;
+    }
+
+    int clientId = findOrCreateClient(clientAddr);
+    if (clientId == -1) return;
+    // Duplicate of a packet we already handled: our ack was lost, the end-of-tick flush repeats it
+    if (!rudpProcessIncoming(&clients[clientId].rudpState, h)) return;
+
+    gettimeofday(&clients[clientId].lastSeen, NULL);
+    if (h->action == ACTION_CODE_ACK_ONLY) return;
+
+    int currentRoomId = clients[clientId].roomId;
+
+    if (h->action == ACTION_CODE_LOBBY_ROOM_QUERY) {
+        bool filtered = received > (ssize_t)sizeof(RUDPHeader_St) && buf[sizeof(RUDPHeader_St)] < __miniGameIdCount;
+        sendRoomList(clientId, filtered ? (MiniGameId_Et)buf[sizeof(RUDPHeader_St)] : MINI_GAME_ID_LOBBY);
+    }
+    else if (h->action == ACTION_CODE_QUIT_GAME) {
+        int rId = clients[clientId].roomId;
+        roomPlayerLeave(rId, clientId);
+        moveClientToRoom(clientId, 0);
+        serverBroadcast(rId, clientId, ACTION_CODE_QUIT_GAME, NULL, 0);
+    }
+    else if (h->action == ACTION_CODE_JOIN_GAME) {
+        char proposedName[32] = {0};
+        if (received > (ssize_t)sizeof(RUDPHeader_St)) {
+            u16 nameLen = (u16)(received - sizeof(RUDPHeader_St));
+            if (nameLen > 31) nameLen = 31;
+            memcpy(proposedName, buf + sizeof(RUDPHeader_St), nameLen);
+        } else strncpy(proposedName, "unnamed", 31);
+
+        bool duplicate = false;
+        for (int i = 0; i < MAX_CLIENTS; i++) {
+            if (clients[i].active && i != clientId && strcmp(clients[i].name, proposedName) == 0) {
+                if (clients[i].address.sin_addr.s_addr == clients[clientId].address.sin_addr.s_addr) {
+                    releaseClient(i);
+                } else { duplicate = true; break; }
+            }
+        }
+
+        if (duplicate) {
+            serverBroadcast(UNICAST, clientId, ACTION_CODE_JOIN_ERROR, "Pseudo taken", 13);
+            releaseClient(clientId);
+            return;
+        }
+        strncpy(clients[clientId].name, proposedName, 31);
+        clients[clientId].name[31] = '\0';
+        u16 assigned_id = htons((u16)clientId);
+        serverBroadcast(UNICAST, clientId, ACTION_CODE_JOIN_ACK, &assigned_id, sizeof(u16));
+    }
+    else if (h->action == ACTION_CODE_LOBBY_SWITCH_GAME) {
+        handleSwitchGame(clientId, buf + sizeof(RUDPHeader_St), (u16)(received - sizeof(RUDPHeader_St)));
+    }
+    else {
+        roomDispatchAction(currentRoomId, clientId, h->action, buf + sizeof(RUDPHeader_St), (u16)(received - sizeof(RUDPHeader_St)));
+    }
+    // Replies above wait in the outbox: the end-of-tick flush carries the ack, bare or piggybacked
+}
+
+/**
+    @brief Pulls pending datagrams off the socket in batches and dispatches them.
+
+    Stops when the socket is empty or after MAX_RECV_BATCHES batches, so that a
+    flood cannot starve the tick; the level-triggered wakeup brings us back.
+*/
+static void drainSocket(void) {
+    for (int batch = 0; batch < MAX_RECV_BATCHES; ++batch) {
+        int count = 0;
+
+#ifdef __linux__
+        struct mmsghdr msgs[RECV_BATCH_SIZE];
+        struct iovec   iov[RECV_BATCH_SIZE];
+        memset(msgs, 0, sizeof(msgs));
+
+        for (int i = 0; i < RECV_BATCH_SIZE; ++i) {
+            iov[i].iov_base = recvBuffers[i];
+            iov[i].iov_len  = DATAGRAM_SIZE;
+            msgs[i].msg_hdr.msg_iov     = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+            msgs[i].msg_hdr.msg_name    = &recvAddresses[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        }
+
+        count = recvmmsg(masterSocket, msgs, RECV_BATCH_SIZE, MSG_DONTWAIT, NULL);
+        if (count <= 0) break;
+
+        for (int i = 0; i < count; ++i) {
+            handleDatagram(recvBuffers[i], (ssize_t)msgs[i].msg_len, &recvAddresses[i]);
+        }
+#else
+        while (count < RECV_BATCH_SIZE) {
+            socklen_t addrLen = sizeof(struct sockaddr_in);
+            ssize_t received = recvfrom(masterSocket, recvBuffers[0], DATAGRAM_SIZE, 0,
+                                        (struct sockaddr*)&recvAddresses[0], &addrLen);
+            if (received < 0) break;
+            handleDatagram(recvBuffers[0], received, &recvAddresses[0]);
             count++;
         }
+        if (count == 0) break;
+#endif
+
+        stats.rxPackets += (u64)count;
+        stats.rxBatches++;
+        if (count < RECV_BATCH_SIZE) break;
     }
-    serverBroadcast(UNICAST, clientId, ACTION_CODE_LOBBY_ROOM_INFO, info, (u16)(count * sizeof(RoomInfo_St)));
+
+    flushSendQueue();
 }
 
+/**
+    @brief Records the work time of one loop iteration and logs a report every STATS_REPORT_US.
+*/
+static void recordLoopStats(long long wakeUs) {
+    long long now = getTimeUs();
+    u64 busyUs = (u64)(now - wakeUs);
+
+    stats.loops++;
+    stats.loopBusyUs += busyUs;
+    if (busyUs > stats.loopMaxUs) stats.loopMaxUs = busyUs;
+
+    long long elapsed = now - stats.windowStartUs;
+    if (elapsed < STATS_REPORT_US) return;
+
+    if (stats.rxPackets > 0 || stats.txPackets > 0) {
+        f64 seconds = (f64)elapsed / MICROSECONDS_IN_A_SECOND;
+        log_info("[STATS] rx %.0f pkt/s (%.1f/batch) | tx %.0f pkt/s (%.1f/batch) | loop avg %.1f us, max %llu us",
+                 stats.rxPackets / seconds,
+                 stats.rxBatches ? (f64)stats.rxPackets / stats.rxBatches : 0.0,
+                 stats.txPackets / seconds,
+                 stats.txBatches ? (f64)stats.txPackets / stats.txBatches : 0.0,
+                 stats.loops ? (f64)stats.loopBusyUs / stats.loops : 0.0,
+                 (ullong)stats.loopMaxUs);
+        log_info("[STATS] per tick: %.1f datagrams, %.0f bytes | %.2f messages/datagram",
+                 stats.ticks ? (f64)stats.txPackets / stats.ticks : 0.0,
+                 stats.ticks ? (f64)stats.txBytes / stats.ticks : 0.0,
+                 stats.txPackets ? (f64)stats.txMessages / stats.txPackets : 0.0);
+        log_info("[STATS] rooms: %u open / %u slots", activeRoomCount, (u32)atomic_load(&roomCapacity));
+        if (stats.inboxDrops > 0) log_warn("[STATS] %llu room actions dropped (inbox full)", (ullong)stats.inboxDrops);
+        reportTickJitter();
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    stats.windowStartUs = now;
+}
+
+#ifdef __linux__
+/**
+    @brief Event loop: epoll over the socket and a TICK_US timerfd.
+*/
+static void runEventLoop(void) {
+    int epollFd = epoll_create1(0);
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (epollFd < 0 || timerFd < 0) { perror("epoll/timerfd"); goto cleanup; }
+
+    struct itimerspec period = {
+        .it_interval = { 0, TICK_US * 1000L },
+        .it_value    = { 0, TICK_US * 1000L },
+    };
+    timerfd_settime(timerFd, 0, &period, NULL);
+
+    struct epoll_event ev = { .events = EPOLLIN };
+    ev.data.fd = masterSocket;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, masterSocket, &ev);
+    ev.data.fd = timerFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev);
+    tickDueUs = monotonicUs() + TICK_US;
+
+    while (keepRunning) {
+        struct epoll_event events[2];
+        int ready = epoll_wait(epollFd, events, 2, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        long long wakeUs = getTimeUs();
+        for (int e = 0; e < ready; ++e) {
+            if (events[e].data.fd == timerFd) {
+                u64 expirations = 0;
+                if (read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)) continue;
+                if (expirations > MAX_CATCHUP_TICKS) expirations = MAX_CATCHUP_TICKS;
+                while (expirations--) serverTick();
+                drainWorkerOutboxes();
+                flushAllOutboxes();
+                flushSendQueue();
+            } else {
+                drainSocket();
+            }
+        }
+        recordLoopStats(wakeUs);
+    }
+
+// Both descriptors may be partially created when setup fails
+cleanup:
+    if (timerFd >= 0) close(timerFd);
+    if (epollFd >= 0) close(epollFd);
+}
+#else
+/**
+    @brief Portable fallback loop: select() with a timeout up to the next tick.
+*/
+static void runEventLoop(void) {
+    long long next_tick = getTimeUs() + TICK_US;
+    tickDueUs = monotonicUs() + TICK_US;
+
+    while (keepRunning) {
+        long long now = getTimeUs();
+        long long wait = next_tick - now;
+        if (wait < 0) wait = 0;
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(masterSocket, &readfds);
+        struct timeval timeout = { (time_t)(wait / MICROSECONDS_IN_A_SECOND), (suseconds_t)(wait % MICROSECONDS_IN_A_SECOND) };
+
+        int ready = select(masterSocket + 1, &readfds, NULL, NULL, &timeout);
+        long long wakeUs = getTimeUs();
+
+        if (ready > 0) drainSocket();
+
+        int catchUp = 0;
+        while (wakeUs >= next_tick && catchUp++ < MAX_CATCHUP_TICKS) {
+            serverTick();
+            next_tick += TICK_US;
+        }
+        if (wakeUs >= next_tick) next_tick = wakeUs + TICK_US;
+        drainWorkerOutboxes();
+        flushAllOutboxes();
+        flushSendQueue();
+
+        recordLoopStats(wakeUs);
+    }
+}
+#endif
+
 int main(int argc, char* argv[]) {
-    (void)argc; (void)argv;
+    int requestedWorkers = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--workers=", 10) == 0) requestedWorkers = atoi(argv[i] + 10);
+        else fprintf(stderr, "Usage: %s [--workers=N]  (N room threads, 0 = inline, max %d)\n", argv[0], MAX_ROOM_WORKERS);
+    }
+    if (requestedWorkers < 0) requestedWorkers = 0;
+    if (requestedWorkers > MAX_ROOM_WORKERS) requestedWorkers = MAX_ROOM_WORKERS;
+
     initLogger();
     log_info("SERVER STARTING...");
 
@@ -224,153 +1433,26 @@ int main(int argc, char* argv[]) {
 
     if (bind(masterSocket, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) { perror("bind"); return 1; }
 
-    rooms[0].active = true;
-    rooms[0].id = 0;
-    rooms[0].gameId = MINI_GAME_ID_LOBBY;
-    rooms[0].module = getGameServerInterface(MINI_GAME_ID_LOBBY);
-    if (rooms[0].module) rooms[0].state = rooms[0].module->createInstance();
-    strncpy(rooms[0].name, "Central Lobby", sizeof(rooms[0].name) - 1);
+    initClientTable();
 
-    signal(SIGINT, handle_sigint);
-    long long next_tick = getTimeUs() + TICK_US;
+    // The first slot handed out is 0: the lobby, never destroyed
+    Room_St* lobby = openRoom(MINI_GAME_ID_LOBBY, NO_CLIENT);
+    if (lobby == NULL || lobby->id != 0) { log_error("Could not create the lobby room"); return 1; }
+    strncpy(lobby->name, "Central Lobby", sizeof(lobby->name) - 1);
 
-    while (keepRunning) {
-        long long now = getTimeUs();
-        if (now >= next_tick) {
-            checkTimeouts();
-            for (int i = 0; i < MAX_ROOMS; i++) {
-                if (rooms[i].active) {
-                    // Check if room is empty (excluding lobby)
-                    if (i > 0) {
-                        bool empty = true;
-                        for (int j = 0; j < MAX_CLIENTS; j++) {
-                            if (clients[j].active && clients[j].roomId == i) {
-                                empty = false;
-                                break;
-                            }
-                        }
-                        if (empty) {
-                            log_info("Destroying empty room %d (%s)", i, rooms[i].name);
-                            if (rooms[i].module && rooms[i].module->destroyInstance) {
-                                rooms[i].module->destroyInstance(rooms[i].state);
-                            }
-                            memset(&rooms[i], 0, sizeof(Room_St));
-                            continue;
-                        }
-                    }
-
-                    if (rooms[i].module && rooms[i].module->onTick && rooms[i].state) {
-                        rooms[i].module->onTick(rooms[i].state);
-                    }
-                }
-            }
-            next_tick += TICK_US;
-        }
+    if (requestedWorkers > 0 && !startRoomWorkers(requestedWorkers)) {
+        log_warn("Room workers unavailable, running rooms on the I/O thread");
+    }
 
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        FD_SET(masterSocket, &readfds);
-        struct timeval timeout = {0, 1000}; 
-
-        if (select(masterSocket + 1, &readfds, NULL, NULL, &timeout) > 0) {
-            u8 buf[2048];
-            struct sockaddr_in clientAddr;
-            socklen_t addrLen = sizeof(clientAddr);
-            ssize_t received = recvfrom(masterSocket, buf, sizeof(buf), 0, (struct sockaddr*)&clientAddr, &addrLen);
-
-            if (received >= (ssize_t)sizeof(RUDPHeader_St)) {
-                RUDPHeader_St* h = (RUDPHeader_St*)buf;
-                if (h->action == ACTION_CODE_DISCOVERY_QUERY) {
-                    handleDiscovery(&clientAddr);
-                    continue;
-                }
+    signal(SIGINT, handle_sigint);
+    stats.windowStartUs = getTimeUs();
 
-                int clientId = findOrCreateClient(&clientAddr);
-                if (clientId != -1 && rudpProcessIncoming(&clients[clientId].rudpState, h)) {
-                    gettimeofday(&clients[clientId].lastSeen, NULL);
-                    int currentRoomId = clients[clientId].roomId;
-
-                    if (h->action == ACTION_CODE_LOBBY_ROOM_QUERY) sendRoomList(clientId);
-                    else if (h->action == ACTION_CODE_QUIT_GAME) {
-                        int rId = clients[clientId].roomId;
-                        if (rId > 0 && rooms[rId].active && rooms[rId].module && rooms[rId].module->onPlayerLeave) {
-                            rooms[rId].module->onPlayerLeave(rooms[rId].state, clientId);
-                        }
-                        clients[clientId].roomId = 0;
-                        serverBroadcast(rId, clientId, ACTION_CODE_QUIT_GAME, NULL, 0);
-                    }
-                    else if (h->action == ACTION_CODE_JOIN_GAME) {
-                        char proposedName[32] = {0};
-                        if (received > (ssize_t)sizeof(RUDPHeader_St)) {
-                            u16 nameLen = (u16)(received - sizeof(RUDPHeader_St));
-                            if (nameLen > 31) nameLen = 31;
-                            memcpy(proposedName, buf + sizeof(RUDPHeader_St), nameLen);
-                        } else strncpy(proposedName, "unnamed", 31);
-
-                        bool duplicate = false;
-                        for (int i = 0; i < MAX_CLIENTS; i++) {
-                            if (clients[i].active && i != clientId && strcmp(clients[i].name, proposedName) == 0) {
-                                if (clients[i].address.sin_addr.s_addr == clients[clientId].address.sin_addr.s_addr) {
-                                    clients[i].active = false;
-                                } else { duplicate = true; break; }
-                            }
-                        }
-
-                        if (duplicate) {
-                            serverBroadcast(UNICAST, clientId, ACTION_CODE_JOIN_ERROR, "Pseudo taken", 13);
-                            clients[clientId].active = false;
-                            continue;
-                        }
-                        strncpy(clients[clientId].name, proposedName, 31);
-                        clients[clientId].name[31] = '\0';
-                        u16 assigned_id = htons((u16)clientId);
-                        serverBroadcast(UNICAST, clientId, ACTION_CODE_JOIN_ACK, &assigned_id, sizeof(u16));
-                    }
-                    else if (h->action == ACTION_CODE_LOBBY_SWITCH_GAME) {
-                        if (received >= (ssize_t)(sizeof(RUDPHeader_St) + 2)) {
-                            MiniGameId_Et targetGameId = (MiniGameId_Et)buf[sizeof(RUDPHeader_St)];
-                            s8 targetRoomId = (s8)buf[sizeof(RUDPHeader_St) + 1];
-
-                            if (targetRoomId == -1) {
-                                if (targetGameId != MINI_GAME_ID_LOBBY && targetGameId < __miniGameIdCount) {
-                                    for (int i = 1; i < MAX_ROOMS; i++) {
-                                        if (!rooms[i].active) {
-                                            rooms[i].active = true;
-                                            rooms[i].id = i;
-                                            rooms[i].gameId = targetGameId;
-                                            rooms[i].module = getGameServerInterface(targetGameId);
-                                            if (rooms[i].module) {
-                                                rooms[i].state = rooms[i].module->createInstance();
-                                                rooms[i].hostId = clientId;
-                                                strncpy(rooms[i].creatorName, clients[clientId].name, 31);
-                                                snprintf(rooms[i].name, sizeof(rooms[i].name), "Room #%d", i);
-                                                clients[clientId].roomId = i;
-                                                u8 resp[2] = { (u8)targetGameId, (u8)i };
-                                                serverBroadcast(UNICAST, clientId, ACTION_CODE_LOBBY_SWITCH_GAME, resp, 2);
-                                            } else rooms[i].active = false;
-                                            break;
-                                        }
-                                    }
-                                }
-                            } else if (targetRoomId >= 0 && targetRoomId < MAX_ROOMS && rooms[(int)targetRoomId].active) {
-                                clients[clientId].roomId = (int)targetRoomId;
-                                u8 resp[2] = { (u8)rooms[(int)targetRoomId].gameId, (u8)targetRoomId };
-                                serverBroadcast(UNICAST, clientId, ACTION_CODE_LOBBY_SWITCH_GAME, resp, 2);
-                            }
-                        }
-                    }
-                    else {
-                        Room_St* r = &rooms[currentRoomId];
-                        if (r->active && r->module && r->module->onAction && r->state != NULL) {
-                            r->module->onAction(r->state, currentRoomId, clientId, h->action, buf + sizeof(RUDPHeader_St), (u16)(received - sizeof(RUDPHeader_St)), serverBroadcast);
-                        }
-                    }
-                    serverSendAck(clientId);
-                }
-            }
-        }
-    }
+    runEventLoop();
 
+    stopRoomWorkers();
+    flushAllOutboxes();
+    flushSendQueue();
+    for (int i = 0; i < MAX_CLIENTS; ++i) rudpReleaseConnection(&clients[i].rudpState);
     if (masterSocket != -1) close(masterSocket);
     log_info("SERVER SHUTDOWN CLEANLY");
     return 0;
@@ -0,0 +1,160 @@
+/**
+    @file snapshotDelta.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Snapshot / delta compression for state sync (see snapshotDelta.h).
+
+    Snapshot `seq` lives in frame slot `seq % SNAPSHOT_HISTORY` on both
+    sides; `seqs[]` tells whether a slot still holds the wanted seq.
+*/
+#include "snapshotDelta.h"
+
+#include <arpa/inet.h>
+#include <string.h>
+
+#define RLE_MAX_RUN         255
+#define RLE_MIN_ZERO_BREAK  3       ///< Zero bytes needed to end a literal run (shorter gaps are cheaper inline)
+
+static u8* frameAt(const SnapshotHistory_St* history, u16 seq) {
+    return history->frames + (size_t)(seq % SNAPSHOT_HISTORY) * history->size;
+}
+
+/**
+    @brief Returns the stored frame for `seq`, or NULL if it was overwritten or never stored.
+*/
+static const u8* findFrame(const SnapshotHistory_St* history, u16 seq) {
+    if (seq == SNAPSHOT_SEQ_NONE) return NULL;
+    if (history->seqs[seq % SNAPSHOT_HISTORY] != seq) return NULL;
+    return frameAt(history, seq);
+}
+
+static void storeFrame(SnapshotHistory_St* history, u16 seq, const void* snapshot) {
+    memcpy(frameAt(history, seq), snapshot, history->size);
+    history->seqs[seq % SNAPSHOT_HISTORY] = seq;
+    history->lastSeq = seq;
+}
+
+void snapshotHistoryInit(SnapshotHistory_St* history, void* storage, u16 size) {
+    memset(history, 0, sizeof(*history));
+    history->size = size;
+    history->frames = storage;
+    memset(storage, 0, (size_t)SNAPSHOT_HISTORY * size);
+}
+
+void snapshotHistoryCopy(SnapshotHistory_St* dst, const SnapshotHistory_St* src) {
+    if (dst == src || dst->size != src->size) return;
+    dst->lastSeq = src->lastSeq;
+    memcpy(dst->seqs, src->seqs, sizeof(dst->seqs));
+    memcpy(dst->frames, src->frames, (size_t)SNAPSHOT_HISTORY * src->size);
+}
+
+u16 snapshotPush(SnapshotHistory_St* history, const void* snapshot) {
+    u16 seq = (u16)(history->lastSeq + 1);
+    if (seq == SNAPSHOT_SEQ_NONE) seq++;
+    storeFrame(history, seq, snapshot);
+    return seq;
+}
+
+/**
+    @brief RLE-encodes `cur XOR base` (base NULL = zeros).
+    @return false if the runs do not fit in `cap` bytes.
+*/
+static bool encodeRuns(const u8* cur, const u8* base, u16 size, u8* out, u16 cap, u16* written) {
+    #define XOR_AT(i) ((u8)(cur[(i)] ^ (base ? base[(i)] : 0)))
+
+    // Trailing unchanged bytes are implied
+    u32 end = size;
+    while (end > 0 && XOR_AT(end - 1) == 0) end--;
+
+    u32 pos = 0, n = 0;
+    while (pos < end) {
+        u32 zeros = 0;
+        while (pos + zeros < end && zeros < RLE_MAX_RUN && XOR_AT(pos + zeros) == 0) zeros++;
+        pos += zeros;
+
+        u32 literals = 0;
+        while (pos + literals < end && literals < RLE_MAX_RUN) {
+            u32 i = pos + literals;
+            if (XOR_AT(i) == 0 && i + RLE_MIN_ZERO_BREAK - 1 < end) {
+                u32 z = 1;
+                while (z < RLE_MIN_ZERO_BREAK && XOR_AT(i + z) == 0) z++;
+                if (z == RLE_MIN_ZERO_BREAK) break;
+            }
+            literals++;
+        }
+
+        if (n + 2 + literals > cap) return false;
+        out[n++] = (u8)zeros;
+        out[n++] = (u8)literals;
+        for (u32 k = 0; k < literals; ++k) out[n++] = XOR_AT(pos + k);
+        pos += literals;
+    }
+    *written = (u16)n;
+    return true;
+
+    #undef XOR_AT
+}
+
+u16 snapshotEncode(const SnapshotHistory_St* history, u16 seq, u16 ackedSeq, void* out, u16 cap) {
+    const u8* cur = findFrame(history, seq);
+    if (cur == NULL || cap < sizeof(SnapshotHeader_St)) return 0;
+
+    // A baseline newer than `seq` cannot be used (the client never had to ack it first)
+    const u8* base = snapshotSeqNewer(ackedSeq, seq) ? NULL : findFrame(history, ackedSeq);
+
+    SnapshotHeader_St header = {
+        .seq     = htons(seq),
+        .baseSeq = htons(base ? ackedSeq : SNAPSHOT_SEQ_NONE),
+        .size    = htons(history->size)
+    };
+    memcpy(out, &header, sizeof(header));
+
+    u16 body = 0;
+    if (!encodeRuns(cur, base, history->size, (u8*)out + sizeof(header), (u16)(cap - sizeof(header)), &body)) return 0;
+    return (u16)(sizeof(header) + body);
+}
+
+void snapshotOnAck(u16* ackedSeq, u16 seq) {
+    if (seq == SNAPSHOT_SEQ_NONE || *ackedSeq == SNAPSHOT_SEQ_NONE || snapshotSeqNewer(seq, *ackedSeq)) {
+        *ackedSeq = seq;
+    }
+}
+
+SnapshotDecodeResult_Et snapshotDecode(SnapshotHistory_St* history, const void* msg, u16 len, void* out, u16* seq) {
+    if (len < sizeof(SnapshotHeader_St)) return SNAPSHOT_NEED_KEYFRAME;
+
+    SnapshotHeader_St header;
+    memcpy(&header, msg, sizeof(header));
+    u16 msgSeq  = ntohs(header.seq);
+    u16 baseSeq = ntohs(header.baseSeq);
+    *seq = msgSeq;
+
+    if (msgSeq == SNAPSHOT_SEQ_NONE || ntohs(header.size) != history->size) return SNAPSHOT_NEED_KEYFRAME;
+    if (history->lastSeq != SNAPSHOT_SEQ_NONE && !snapshotSeqNewer(msgSeq, history->lastSeq)) return SNAPSHOT_STALE;
+
+    u8* dst = out;
+    if (baseSeq == SNAPSHOT_SEQ_NONE) {
+        memset(dst, 0, history->size);
+    } else {
+        const u8* base = findFrame(history, baseSeq);
+        if (base == NULL) return SNAPSHOT_NEED_KEYFRAME;
+        memcpy(dst, base, history->size);
+    }
+
+    const u8* body = (const u8*)msg + sizeof(header);
+    u32 bodyLen = len - sizeof(header);
+    u32 p = 0, pos = 0;
+    while (p < bodyLen) {
+        if (p + 2 > bodyLen) return SNAPSHOT_NEED_KEYFRAME;
+        u32 zeros = body[p], literals = body[p + 1];
+        p += 2;
+        pos += zeros;
+        if (pos + literals > history->size || p + literals > bodyLen) return SNAPSHOT_NEED_KEYFRAME;
+        for (u32 k = 0; k < literals; ++k) dst[pos + k] ^= body[p + k];
+        pos += literals;
+        p += literals;
+    }
+
+    storeFrame(history, msgSeq, dst);
+    return SNAPSHOT_APPLIED;
+}
@@ -0,0 +1,69 @@
+/**
+    @file spscQueue.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Bounded lock-free SPSC ring (see spscQueue.h).
+
+    Indices run freely and wrap at 2^32; `tail - head` is the fill level.
+    The producer publishes a slot with a release store of `tail`, the
+    consumer frees it with a release store of `head`, each paired with an
+    acquire load on the other side.
+*/
+#include "spscQueue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool spscInit(SPSCQueue_St* queue, u32 capacity, u32 slotSize) {
+    u32 rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+
+    memset(queue, 0, sizeof(*queue));
+    queue->slots = malloc((size_t)rounded * slotSize);
+    if (queue->slots == NULL) return false;
+
+    queue->mask = rounded - 1;
+    queue->slotSize = slotSize;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    return true;
+}
+
+void spscDestroy(SPSCQueue_St* queue) {
+    free(queue->slots);
+    queue->slots = NULL;
+}
+
+void* spscBeginPush(SPSCQueue_St* queue) {
+    u32 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cachedHead > queue->mask) {
+        queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cachedHead > queue->mask) return NULL;
+    }
+    return queue->slots + (size_t)(tail & queue->mask) * queue->slotSize;
+}
+
+void spscCommitPush(SPSCQueue_St* queue) {
+    u32 tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+}
+
+void* spscPeek(SPSCQueue_St* queue) {
+    u32 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == queue->cachedTail) {
+        queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cachedTail) return NULL;
+    }
+    return queue->slots + (size_t)(head & queue->mask) * queue->slotSize;
+}
+
+void spscPop(SPSCQueue_St* queue) {
+    u32 head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+u32 spscSize(SPSCQueue_St* queue) {
+    u32 tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    u32 head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    return tail - head;
+}
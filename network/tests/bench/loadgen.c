@@ -0,0 +1,685 @@
+/**
+    @file loadgen.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Headless load generator and soak benchmark for the RUDP server.
+
+    Simulates N clients on one machine, each with its own UDP socket and
+    RUDP connection. Every client does the ACTION_CODE_JOIN_GAME handshake,
+    announces itself to the lobby, then keeps sending lobby moves and chat
+    and periodically hops into a Bingo room (half the clients create one,
+    the other half join the latest created) before quitting back.
+
+    Reported every interval and at the end:
+        - datagrams, bytes and messages per second, both directions
+        - ack round trip: client send -> server ack covering that sequence
+        - chat relay latency: sender -> another simulated client
+        - room hop latency: SWITCH_GAME request -> confirmation
+        - server CPU usage, read from /proc (--pid or --spawn)
+
+    Not part of run-tests: it needs a running server. Build and run it with
+    `make loadgen` / `make run-loadgen LOADGEN_ARGS="..."` from network/.
+*/
+#include "rudp_core.h"
+#include "networkInterface.h"
+#include "APIs/generalAPI.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#define LOADGEN_RTT_SLOTS           64          ///< Sent datagrams remembered per client for ack RTT (> ack bitfield reach)
+#define LOADGEN_JOIN_TIMEOUT_US     3000000ull
+#define LOADGEN_HOP_TIMEOUT_US      1000000ull
+#define LOADGEN_JOIN_STAGGER_US     2000ull     ///< Delay between two client joins, avoids one giant burst
+#define LOADGEN_CHAT_TAG            "loadgen "
+
+/**
+    @name Lobby wire format, mirrored from lobby/include/utils/userTypes.h
+    The lobby headers pull raylib in, the network module does not.
+    @{
+*/
+#define LOADGEN_LOBBY_PLAYER_INFO   firstAvailableActionCode        ///< ACTION_CODE_LOBBY_PLAYER_INFO
+#define LOADGEN_LOBBY_SNAPSHOT      (firstAvailableActionCode + 1)  ///< ACTION_CODE_LOBBY_SNAPSHOT
+#define LOADGEN_LOBBY_POS_QUANT     2.0f                            ///< LOBBY_POS_QUANT
+
+#pragma pack(push, 1)
+typedef struct {
+    s16 x, y;
+    u8  angle;
+} LoadPose_St;                      ///< LobbyPoseNet_St
+
+typedef struct {
+    u8   playerId;
+    u8   textureId;
+    char name[32];
+} LoadPlayerInfo_St;                ///< LobbyPlayerInfoNet_St
+#pragma pack(pop)
+/** @} */
+
+/**
+    @brief Command line settings.
+*/
+typedef struct {
+    const char* host;
+    u16         port;
+    u32         clients;
+    f64         durationS;
+    f64         moveHz;
+    f64         chatIntervalS;
+    f64         hopIntervalS;       ///< 0 disables room hops
+    f64         reportIntervalS;
+    int         serverPid;          ///< 0 = CPU not measured
+    const char* spawnPath;          ///< Server binary to start and stop ourselves
+    const char* serverArgs;         ///< Extra arguments for the spawned server, space separated
+    const char* serverLog;          ///< Where the spawned server's output goes
+} LoadConfig_St;
+
+typedef enum {
+    LOAD_CLIENT_CONNECTING,
+    LOAD_CLIENT_LOBBY,
+    LOAD_CLIENT_SWITCHING,
+    LOAD_CLIENT_IN_GAME,
+    LOAD_CLIENT_FAILED
+} LoadClientState_Et;
+
+typedef struct {
+    u16  seq;
+    bool pending;
+    u64  sentUs;
+} LoadSentSlot_St;
+
+/**
+    @brief One simulated client.
+*/
+typedef struct {
+    int                 fd;
+    RUDPConnection_St   conn;
+    u16                 id;
+    LoadClientState_Et  state;
+    u64                 stateSinceUs;   ///< When the current state (or pending request) started
+    u64                 joinAtUs;
+    bool                joinSent;
+    u64                 nextMoveUs;
+    u64                 nextChatUs;
+    u64                 nextHopUs;
+    bool                hopCreates;     ///< Creates rooms rather than joining the latest one
+    f32                 homeX;
+    f32                 phase;
+    LoadSentSlot_St     sent[LOADGEN_RTT_SLOTS];
+} LoadClient_St;
+
+/**
+    @brief Growable array of latency samples (microseconds).
+*/
+typedef struct {
+    u32*   values;
+    size_t count;
+    size_t capacity;
+} LoadSamples_St;
+
+typedef struct {
+    u64            txDatagrams, txBytes;
+    u64            rxDatagrams, rxBytes, rxMessages;
+    u64            snapshots, chats;
+    u64            hopsOk, hopsFailed;
+    u64            resends;
+    LoadSamples_St ackRtt, relay, hop;
+} LoadStats_St;
+
+static LoadStats_St intervalStats, totalStats;
+static SwitchGamePayload_St lastCreatedRoom;    ///< Room joiners hop into (roomId ROOM_ID_NEW until one exists)
+
+static u64 nowUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000ull + (u64)ts.tv_nsec / 1000ull;
+}
+
+static void addSample(LoadSamples_St* samples, u64 valueUs) {
+    if (samples->count == samples->capacity) {
+        size_t capacity = samples->capacity ? samples->capacity * 2 : 4096;
+        u32* grown = realloc(samples->values, capacity * sizeof(u32));
+        if (grown == NULL) return;
+        samples->values = grown;
+        samples->capacity = capacity;
+    }
+    samples->values[samples->count++] = valueUs > UINT32_MAX ? UINT32_MAX : (u32)valueUs;
+}
+
+static int compareU32(const void* a, const void* b) {
+    u32 x = *(const u32*)a, y = *(const u32*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+    @brief Sorts the samples in place and returns the value at `percent` (nearest rank).
+*/
+static f64 percentileMs(LoadSamples_St* samples, f64 percent) {
+    if (samples->count == 0) return 0.0;
+    qsort(samples->values, samples->count, sizeof(u32), compareU32);
+    size_t rank = (size_t)(percent / 100.0 * (f64)(samples->count - 1) + 0.5);
+    return samples->values[rank] / 1000.0;
+}
+
+/**
+    @brief Adds the interval counters and samples to the totals, then clears the interval.
+*/
+static void mergeInterval(void) {
+    LoadStats_St* i = &intervalStats;
+    LoadStats_St* t = &totalStats;
+    t->txDatagrams += i->txDatagrams; t->txBytes += i->txBytes;
+    t->rxDatagrams += i->rxDatagrams; t->rxBytes += i->rxBytes; t->rxMessages += i->rxMessages;
+    t->snapshots += i->snapshots; t->chats += i->chats;
+    t->hopsOk += i->hopsOk; t->hopsFailed += i->hopsFailed;
+    t->resends += i->resends;
+
+    LoadSamples_St* from[] = { &i->ackRtt, &i->relay, &i->hop };
+    LoadSamples_St* to[]   = { &t->ackRtt, &t->relay, &t->hop };
+    for (int k = 0; k < 3; ++k) {
+        for (size_t s = 0; s < from[k]->count; ++s) addSample(to[k], from[k]->values[s]);
+        from[k]->count = 0;
+    }
+
+    LoadSamples_St keep[] = { i->ackRtt, i->relay, i->hop };
+    memset(i, 0, sizeof(*i));
+    i->ackRtt = keep[0]; i->relay = keep[1]; i->hop = keep[2];
+}
+
+/**
+    @brief Total user + system CPU time of a process, in seconds (-1 if unreadable).
+*/
+static f64 processCpuSeconds(int pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE* f = fopen(path, "r");
+    if (f == NULL) return -1.0;
+
+    char line[1024];
+    size_t n = fread(line, 1, sizeof(line) - 1, f);
+    fclose(f);
+    line[n] = '\0';
+
+    // The command name may hold spaces: fields are counted from its closing parenthesis
+    char* p = strrchr(line, ')');
+    if (p == NULL) return -1.0;
+    unsigned long utime, stime;
+    if (sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2) return -1.0;
+    return (f64)(utime + stime) / (f64)sysconf(_SC_CLK_TCK);
+}
+
+//
+// Sending
+//
+
+static void rawSend(LoadClient_St* c, const u8* data, u16 length) {
+    if (send(c->fd, data, length, 0) < 0) return;
+    intervalStats.txDatagrams++;
+    intervalStats.txBytes += length;
+}
+
+static void resendCallback(void* userData, const u8* data, u16 length) {
+    rawSend(userData, data, length);
+    intervalStats.resends++;
+}
+
+static void sendMessage(LoadClient_St* c, u8 action, const void* payload, u16 len, bool reliable) {
+    u8 buf[RUDP_MAX_PACKET_SIZE];
+    if (sizeof(RUDPHeader_St) + len > sizeof(buf)) return;
+
+    RUDPHeader_St h;
+    rudpGenerateHeader(&c->conn, action, &h);
+    h.senderId = htons(c->id);
+    memcpy(buf, &h, sizeof(h));
+    if (len > 0) memcpy(buf + sizeof(h), payload, len);
+    u16 total = (u16)(sizeof(h) + len);
+
+    u16 seq = ntohs(h.sequence);
+    c->sent[seq % LOADGEN_RTT_SLOTS] = (LoadSentSlot_St) { .seq = seq, .pending = true, .sentUs = nowUs() };
+
+    rawSend(c, buf, total);
+    if (reliable) rudpTrackReliable(&c->conn, buf, total);
+}
+
+static void sendLobby(LoadClient_St* c, u8 lobbyAction, const void* data, u16 len, bool reliable) {
+    u8 buf[256];
+    if (sizeof(GameTLVHeader_St) + len > sizeof(buf)) return;
+    GameTLVHeader_St tlv = { .gameId = MINI_GAME_ID_LOBBY, .action = lobbyAction, .length = htons(len), .isReliable = reliable };
+    memcpy(buf, &tlv, sizeof(tlv));
+    memcpy(buf + sizeof(tlv), data, len);
+    sendMessage(c, ACTION_CODE_GAME_DATA, buf, (u16)(sizeof(tlv) + len), reliable);
+}
+
+static void sendPlayerInfo(LoadClient_St* c, u32 index) {
+    LoadPlayerInfo_St info = { .textureId = 0 };
+    snprintf(info.name, sizeof(info.name), "lg%d-%u", (int)getpid() % 10000, index);
+    sendLobby(c, LOADGEN_LOBBY_PLAYER_INFO, &info, sizeof(info), true);
+}
+
+static void sendMove(LoadClient_St* c) {
+    // Walk back and forth around a home spot; homes are spread so interest filtering matters
+    f32 x = c->homeX + 150.0f * sinf(c->phase);
+    LoadPose_St pose = {
+        .x     = (s16)htons((u16)(s16)(x * LOADGEN_LOBBY_POS_QUANT)),
+        .y     = (s16)htons((u16)(s16)(480.0f * LOADGEN_LOBBY_POS_QUANT)),
+        .angle = (u8)(c->phase * 40.0f)
+    };
+    sendLobby(c, ACTION_CODE_LOBBY_MOVE, &pose, sizeof(pose), false);
+}
+
+static void sendChat(LoadClient_St* c) {
+    char text[48];
+    int n = snprintf(text, sizeof(text), LOADGEN_CHAT_TAG "%llu", (unsigned long long)nowUs());
+    sendLobby(c, ACTION_CODE_LOBBY_CHAT, text, (u16)(n + 1), true);
+}
+
+static void sendHop(LoadClient_St* c) {
+    SwitchGamePayload_St request = { .gameId = MINI_GAME_ID_BINGO, .roomId = htons(ROOM_ID_NEW) };
+    if (!c->hopCreates && lastCreatedRoom.roomId != htons(ROOM_ID_NEW) && lastCreatedRoom.roomId != 0) {
+        request = lastCreatedRoom;
+    }
+    sendMessage(c, ACTION_CODE_LOBBY_SWITCH_GAME, &request, sizeof(request), true);
+}
+
+//
+// Receiving
+//
+
+/**
+    @brief Turns the ack fields of a server header into RTT samples.
+*/
+static void onAckFields(LoadClient_St* c, const RUDPHeader_St* h, u64 now) {
+    u16 ack = ntohs(h->ack);
+    u32 bitfield = ntohl(h->ackBitfield);
+    for (int s = 0; s < LOADGEN_RTT_SLOTS; ++s) {
+        LoadSentSlot_St* slot = &c->sent[s];
+        if (!slot->pending) continue;
+        u16 behind = (u16)(ack - slot->seq);
+        if (behind >= 0x8000) continue;                 // Newer than the ack: still in flight
+        if (behind > HISTORY_SIZE) { slot->pending = false; continue; } // Beyond the bitfield, never acked
+        if (behind == 0 || (bitfield & (1u << (behind - 1)))) {
+            addSample(&intervalStats.ackRtt, now - slot->sentUs);
+            slot->pending = false;
+        }
+    }
+}
+
+static void handleMessage(LoadClient_St* c, u32 index, u8 action, const u8* payload, u16 len, u64 now) {
+    intervalStats.rxMessages++;
+
+    switch (action) {
+        case ACTION_CODE_JOIN_ACK: {
+            if (c->state != LOAD_CLIENT_CONNECTING || len < sizeof(u16)) break;
+            u16 id;
+            memcpy(&id, payload, sizeof(id));
+            c->id = ntohs(id);
+            c->state = LOAD_CLIENT_LOBBY;
+            c->stateSinceUs = now;
+            sendPlayerInfo(c, index);
+        } break;
+
+        case ACTION_CODE_JOIN_ERROR:
+            fprintf(stderr, "[LOADGEN] client %u rejected: %.*s\n", index, (int)len, (const char*)payload);
+            c->state = LOAD_CLIENT_FAILED;
+            break;
+
+        case ACTION_CODE_LOBBY_SWITCH_GAME: {
+            if (c->state != LOAD_CLIENT_SWITCHING || len < sizeof(SwitchGamePayload_St)) break;
+            SwitchGamePayload_St confirm;
+            memcpy(&confirm, payload, sizeof(confirm));
+            if (confirm.gameId == MINI_GAME_ID_LOBBY) break;
+
+            addSample(&intervalStats.hop, now - c->stateSinceUs);
+            intervalStats.hopsOk++;
+            if (c->hopCreates) lastCreatedRoom = confirm;
+            c->state = LOAD_CLIENT_IN_GAME;
+            c->stateSinceUs = now;
+        } break;
+
+        case ACTION_CODE_GAME_DATA: {
+            if (len < sizeof(GameTLVHeader_St)) break;
+            GameTLVHeader_St tlv;
+            memcpy(&tlv, payload, sizeof(tlv));
+            if (tlv.gameId != MINI_GAME_ID_LOBBY) break;
+
+            const u8* data = payload + sizeof(tlv);
+            u16 dataLen = (u16)(len - sizeof(tlv));
+            if (tlv.action == LOADGEN_LOBBY_SNAPSHOT) {
+                intervalStats.snapshots++;
+            } else if (tlv.action == ACTION_CODE_LOBBY_CHAT) {
+                intervalStats.chats++;
+                char text[48] = {0};
+                memcpy(text, data, dataLen < sizeof(text) - 1 ? dataLen : sizeof(text) - 1);
+                unsigned long long sentUs;
+                if (sscanf(text, LOADGEN_CHAT_TAG "%llu", &sentUs) == 1 && sentUs <= now) {
+                    addSample(&intervalStats.relay, now - sentUs);
+                }
+            }
+        } break;
+    }
+}
+
+static void receiveAll(LoadClient_St* c, u32 index) {
+    u8 buf[RUDP_MAX_PACKET_SIZE];
+    for (;;) {
+        ssize_t received = recv(c->fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (received < (ssize_t)sizeof(RUDPHeader_St)) return;
+        u64 now = nowUs();
+        intervalStats.rxDatagrams++;
+        intervalStats.rxBytes += (u64)received;
+
+        RUDPHeader_St h;
+        memcpy(&h, buf, sizeof(h));
+        onAckFields(c, &h, now);
+        if (!rudpProcessIncoming(&c->conn, &h) || h.action == RUDP_ACTION_ACK_ONLY) continue;
+
+        u8* payload = buf + sizeof(h);
+        u16 payloadLen = (u16)(received - sizeof(h));
+        if (h.action != ACTION_CODE_BUNDLE) {
+            handleMessage(c, index, h.action, payload, payloadLen, now);
+            continue;
+        }
+
+        u16 offset = 0;
+        while (offset + sizeof(BundleRecordHeader_St) <= payloadLen) {
+            BundleRecordHeader_St record;
+            memcpy(&record, payload + offset, sizeof(record));
+            offset += sizeof(record);
+            u16 length = ntohs(record.length);
+            if (length > payloadLen - offset) break;
+            handleMessage(c, index, record.action, payload + offset, length, now);
+            offset += length;
+        }
+    }
+}
+
+//
+// Client behaviour
+//
+
+static void driveClient(LoadClient_St* c, u32 index, const LoadConfig_St* cfg, u64 now) {
+    const u64 moveUs = cfg->moveHz > 0.0 ? (u64)(1e6 / cfg->moveHz) : 0;
+    const u64 chatUs = (u64)(cfg->chatIntervalS * 1e6);
+    const u64 hopUs  = (u64)(cfg->hopIntervalS * 1e6);
+
+    switch (c->state) {
+        case LOAD_CLIENT_CONNECTING:
+            if (!c->joinSent && now >= c->joinAtUs) {
+                char name[32];
+                int n = snprintf(name, sizeof(name), "lg%d-%u", (int)getpid() % 10000, index);
+                sendMessage(c, ACTION_CODE_JOIN_GAME, name, (u16)(n + 1), true);
+                c->joinSent = true;
+                c->stateSinceUs = now;
+            } else if (c->joinSent && now - c->stateSinceUs > LOADGEN_JOIN_TIMEOUT_US) {
+                fprintf(stderr, "[LOADGEN] client %u: no JOIN_ACK\n", index);
+                c->state = LOAD_CLIENT_FAILED;
+            }
+            break;
+
+        case LOAD_CLIENT_LOBBY:
+            if (moveUs > 0 && now >= c->nextMoveUs) {
+                c->phase += 0.2f;
+                sendMove(c);
+                c->nextMoveUs = now + moveUs;
+            }
+            if (chatUs > 0 && now >= c->nextChatUs) {
+                sendChat(c);
+                c->nextChatUs = now + chatUs;
+            }
+            if (hopUs > 0 && now >= c->nextHopUs) {
+                sendHop(c);
+                c->state = LOAD_CLIENT_SWITCHING;
+                c->stateSinceUs = now;
+            }
+            break;
+
+        case LOAD_CLIENT_SWITCHING:
+            if (now - c->stateSinceUs > LOADGEN_HOP_TIMEOUT_US) {
+                intervalStats.hopsFailed++;     // Usually the joined room closed meanwhile
+                c->state = LOAD_CLIENT_LOBBY;
+                c->nextHopUs = now + hopUs;
+            }
+            break;
+
+        case LOAD_CLIENT_IN_GAME:
+            if (now - c->stateSinceUs >= hopUs / 2) {
+                sendMessage(c, ACTION_CODE_QUIT_GAME, NULL, 0, true);
+                c->state = LOAD_CLIENT_LOBBY;
+                c->nextHopUs = now + hopUs;
+                sendPlayerInfo(c, index);
+            }
+            break;
+
+        case LOAD_CLIENT_FAILED:
+            return;
+    }
+
+    if (c->conn.ackPending) {
+        RUDPHeader_St ack;
+        rudpGenerateHeader(&c->conn, RUDP_ACTION_ACK_ONLY, &ack);
+        ack.senderId = htons(c->id);
+        rawSend(c, (const u8*)&ack, sizeof(ack));
+    }
+    rudpResendExpired(&c->conn, resendCallback, c);
+}
+
+//
+// Setup and reporting
+//
+
+static bool parseArgs(int argc, char* argv[], LoadConfig_St* cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if      (strncmp(a, "--clients=", 10) == 0)        cfg->clients = (u32)atoi(a + 10);
+        else if (strncmp(a, "--duration=", 11) == 0)       cfg->durationS = atof(a + 11);
+        else if (strncmp(a, "--host=", 7) == 0)            cfg->host = a + 7;
+        else if (strncmp(a, "--port=", 7) == 0)            cfg->port = (u16)atoi(a + 7);
+        else if (strncmp(a, "--move-hz=", 10) == 0)        cfg->moveHz = atof(a + 10);
+        else if (strncmp(a, "--chat-interval=", 16) == 0)  cfg->chatIntervalS = atof(a + 16);
+        else if (strncmp(a, "--hop-interval=", 15) == 0)   cfg->hopIntervalS = atof(a + 15);
+        else if (strncmp(a, "--report=", 9) == 0)          cfg->reportIntervalS = atof(a + 9);
+        else if (strncmp(a, "--pid=", 6) == 0)             cfg->serverPid = atoi(a + 6);
+        else if (strncmp(a, "--spawn=", 8) == 0)           cfg->spawnPath = a + 8;
+        else if (strncmp(a, "--server-args=", 14) == 0)    cfg->serverArgs = a + 14;
+        else if (strncmp(a, "--server-log=", 13) == 0)     cfg->serverLog = a + 13;
+        else return false;
+    }
+    if (cfg->clients == 0 || cfg->clients > MAX_CLIENTS) cfg->clients = cfg->clients ? MAX_CLIENTS : 1;
+    if (cfg->reportIntervalS <= 0.0) cfg->reportIntervalS = 1.0;
+    return true;
+}
+
+static void printUsage(const char* self) {
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --clients=N          simulated clients (default 50, max %d)\n"
+        "  --duration=S         seconds of load (default 30)\n"
+        "  --host=IP --port=P   server address (default 127.0.0.1:8080)\n"
+        "  --move-hz=F          lobby moves per second per client (default 20)\n"
+        "  --chat-interval=S    seconds between chat lines per client (default 2, 0 = off)\n"
+        "  --hop-interval=S     seconds between room hops per client (default 6, 0 = off)\n"
+        "  --report=S           report interval (default 1)\n"
+        "  --pid=PID            measure the CPU of an already running server\n"
+        "  --spawn=PATH         start the server binary, measure it, stop it at the end\n"
+        "  --server-args=\"...\"  arguments for the spawned server (e.g. \"--workers=2\")\n"
+        "  --server-log=PATH    output of the spawned server (default /dev/null)\n",
+        self, MAX_CLIENTS);
+}
+
+static int spawnServer(const char* path, const char* args, const char* logPath) {
+    char argBuf[256] = {0};
+    char* argvChild[16] = { (char*)path };
+    int argcChild = 1;
+    if (args != NULL) {
+        strncpy(argBuf, args, sizeof(argBuf) - 1);
+        for (char* tok = strtok(argBuf, " "); tok != NULL && argcChild < 15; tok = strtok(NULL, " ")) {
+            argvChild[argcChild++] = tok;
+        }
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int logFd = open(logPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (logFd >= 0) {
+            dup2(logFd, STDOUT_FILENO);
+            dup2(logFd, STDERR_FILENO);
+        }
+        execv(path, argvChild);
+        perror("execv");
+        _exit(127);
+    }
+    if (pid > 0) usleep(300000); // Let it bind before the first JOIN
+    return pid > 0 ? (int)pid : 0;
+}
+
+static u32 countInState(const LoadClient_St* clients, u32 n, LoadClientState_Et state) {
+    u32 count = 0;
+    for (u32 i = 0; i < n; ++i) count += clients[i].state == state;
+    return count;
+}
+
+static void reportInterval(const LoadClient_St* clients, u32 n, f64 elapsedS, f64 spanS, f64 cpuPercent) {
+    LoadStats_St* s = &intervalStats;
+    u32 connected = n - countInState(clients, n, LOAD_CLIENT_CONNECTING) - countInState(clients, n, LOAD_CLIENT_FAILED);
+    char cpu[32] = "n/a";
+    if (cpuPercent >= 0.0) snprintf(cpu, sizeof(cpu), "%.1f%%", cpuPercent);
+
+    printf("[LOADGEN] t=%5.1fs clients %u/%u | tx %6.0f dg/s %7.1f KB/s | rx %6.0f dg/s %7.1f KB/s %7.0f msg/s"
+           " | ack RTT p50 %.2f p99 %.2f ms | relay p50 %.2f p99 %.2f ms | hops %llu ok %llu failed | server CPU %s\n",
+           elapsedS, connected, n,
+           s->txDatagrams / spanS, s->txBytes / spanS / 1024.0,
+           s->rxDatagrams / spanS, s->rxBytes / spanS / 1024.0, s->rxMessages / spanS,
+           percentileMs(&s->ackRtt, 50), percentileMs(&s->ackRtt, 99),
+           percentileMs(&s->relay, 50), percentileMs(&s->relay, 99),
+           (unsigned long long)s->hopsOk, (unsigned long long)s->hopsFailed, cpu);
+    fflush(stdout);
+}
+
+static void reportTotal(u32 connected, u32 n, f64 elapsedS, f64 cpuPercent) {
+    LoadStats_St* t = &totalStats;
+    printf("\n=== Load generator summary (%u/%u clients, %.1f s) ===\n", connected, n, elapsedS);
+    printf("  sent      %10.0f datagrams/s  %9.1f KB/s  (%llu resends)\n",
+           t->txDatagrams / elapsedS, t->txBytes / elapsedS / 1024.0, (unsigned long long)t->resends);
+    printf("  received  %10.0f datagrams/s  %9.1f KB/s  %9.0f messages/s  (%.2f per datagram)\n",
+           t->rxDatagrams / elapsedS, t->rxBytes / elapsedS / 1024.0, t->rxMessages / elapsedS,
+           t->rxDatagrams ? (f64)t->rxMessages / t->rxDatagrams : 0.0);
+    printf("  lobby     %10.0f snapshots/s  %9.0f chat lines/s\n", t->snapshots / elapsedS, t->chats / elapsedS);
+
+    struct { const char* name; LoadSamples_St* samples; } rows[] = {
+        { "ack RTT  ", &t->ackRtt }, { "relay    ", &t->relay }, { "room hop ", &t->hop }
+    };
+    for (int r = 0; r < 3; ++r) {
+        LoadSamples_St* s = rows[r].samples;
+        printf("  %s p50 %7.2f ms  p99 %7.2f ms  max %7.2f ms  (%zu samples)\n", rows[r].name,
+               percentileMs(s, 50), percentileMs(s, 99), percentileMs(s, 100), s->count);
+    }
+    printf("  hops      %llu ok, %llu failed\n", (unsigned long long)t->hopsOk, (unsigned long long)t->hopsFailed);
+    if (cpuPercent >= 0.0) printf("  server CPU %.1f%% of one core\n", cpuPercent);
+    else                   printf("  server CPU n/a (use --pid=PID or --spawn=PATH)\n");
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig_St cfg = {
+        .host = "127.0.0.1", .port = 8080, .clients = 50, .durationS = 30.0,
+        .moveHz = 20.0, .chatIntervalS = 2.0, .hopIntervalS = 6.0, .reportIntervalS = 1.0,
+        .serverLog = "/dev/null"
+    };
+    if (!parseArgs(argc, argv, &cfg)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (cfg.spawnPath != NULL) {
+        cfg.serverPid = spawnServer(cfg.spawnPath, cfg.serverArgs, cfg.serverLog);
+        if (cfg.serverPid == 0) return 1;
+    }
+
+    struct sockaddr_in server = { .sin_family = AF_INET, .sin_port = htons(cfg.port) };
+    if (inet_pton(AF_INET, cfg.host, &server.sin_addr) != 1) {
+        fprintf(stderr, "[LOADGEN] bad host %s\n", cfg.host);
+        return 2;
+    }
+
+    LoadClient_St* clients = calloc(cfg.clients, sizeof(LoadClient_St));
+    struct pollfd* fds = calloc(cfg.clients, sizeof(struct pollfd));
+    if (clients == NULL || fds == NULL) return 1;
+
+    u64 start = nowUs();
+    lastCreatedRoom.roomId = htons(ROOM_ID_NEW);
+    for (u32 i = 0; i < cfg.clients; ++i) {
+        LoadClient_St* c = &clients[i];
+        c->fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (c->fd < 0 || connect(c->fd, (struct sockaddr*)&server, sizeof(server)) < 0) {
+            perror("socket");
+            return 1;
+        }
+        rudpInitConnection(&c->conn);
+        c->state = LOAD_CLIENT_CONNECTING;
+        c->joinAtUs = start + i * LOADGEN_JOIN_STAGGER_US;
+        c->hopCreates = (i % 2) == 0;
+        c->homeX = -1500.0f + (f32)((i * 397) % 3000);
+        c->phase = (f32)i;
+        // Spread the periodic actions so clients do not fire in lockstep
+        c->nextChatUs = c->joinAtUs + (u64)(cfg.chatIntervalS * 1e6 * (f64)i / cfg.clients);
+        c->nextHopUs  = c->joinAtUs + (u64)(cfg.hopIntervalS * 1e6 * (f64)(i + 1) / cfg.clients);
+        fds[i] = (struct pollfd) { .fd = c->fd, .events = POLLIN };
+    }
+
+    f64 cpuStart = cfg.serverPid ? processCpuSeconds(cfg.serverPid) : -1.0;
+    f64 cpuLast = cpuStart;
+    u64 end = start + (u64)(cfg.durationS * 1e6);
+    u64 reportUs = (u64)(cfg.reportIntervalS * 1e6);
+    u64 lastReport = start;
+
+    for (u64 now = start; now < end; now = nowUs()) {
+        if (poll(fds, cfg.clients, 1) > 0) {
+            for (u32 i = 0; i < cfg.clients; ++i) {
+                if (fds[i].revents & POLLIN) receiveAll(&clients[i], i);
+            }
+        }
+        now = nowUs();
+        for (u32 i = 0; i < cfg.clients; ++i) driveClient(&clients[i], i, &cfg, now);
+
+        if (now - lastReport >= reportUs) {
+            f64 span = (now - lastReport) / 1e6;
+            f64 cpu = -1.0, cpuNow = cfg.serverPid ? processCpuSeconds(cfg.serverPid) : -1.0;
+            if (cpuNow >= 0.0 && cpuLast >= 0.0) cpu = (cpuNow - cpuLast) / span * 100.0;
+            cpuLast = cpuNow;
+
+            reportInterval(clients, cfg.clients, (now - start) / 1e6, span, cpu);
+            mergeInterval();
+            lastReport = now;
+        }
+    }
+    mergeInterval();
+
+    f64 elapsed = (nowUs() - start) / 1e6;
+    f64 cpuEnd = cfg.serverPid ? processCpuSeconds(cfg.serverPid) : -1.0;
+    f64 cpuTotal = (cpuStart >= 0.0 && cpuEnd >= 0.0) ? (cpuEnd - cpuStart) / elapsed * 100.0 : -1.0;
+    u32 connected = cfg.clients - countInState(clients, cfg.clients, LOAD_CLIENT_CONNECTING) - countInState(clients, cfg.clients, LOAD_CLIENT_FAILED);
+    reportTotal(connected, cfg.clients, elapsed, cpuTotal);
+
+    // Leave the rooms; the client slots themselves expire with the server's client timeout
+    for (u32 i = 0; i < cfg.clients; ++i) {
+        if (clients[i].state != LOAD_CLIENT_CONNECTING && clients[i].state != LOAD_CLIENT_FAILED) {
+            RUDPHeader_St h;
+            rudpGenerateHeader(&clients[i].conn, ACTION_CODE_QUIT_GAME, &h);
+            h.senderId = htons(clients[i].id);
+            rawSend(&clients[i], (const u8*)&h, sizeof(h));
+        }
+        close(clients[i].fd);
+        rudpReleaseConnection(&clients[i].conn);
+    }
+    if (cfg.spawnPath != NULL) {
+        kill(cfg.serverPid, SIGINT);
+        waitpid(cfg.serverPid, NULL, 0);
+    }
+
+    free(clients);
+    free(fds);
+    return connected > 0 ? 0 : 1;
+}
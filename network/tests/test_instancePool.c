@@ -0,0 +1,71 @@
+/**
+    @file test_instancePool.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Unit tests for the game instance slab pool.
+*/
+#include "instancePool.h"
+#include <stdio.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Test size rounding, alignment and slab sizing.
+ */
+void test_pool_init() {
+    InstancePool_St pool;
+    instancePoolInit(&pool, 3);
+    assert(pool.blockSize == INSTANCE_POOL_ALIGN);
+    assert(pool.blocksPerSlab == INSTANCE_POOL_SLAB_BYTES / INSTANCE_POOL_ALIGN);
+
+    instancePoolInit(&pool, 1 << 20);
+    assert(pool.blocksPerSlab == INSTANCE_POOL_MIN_BLOCKS);
+    assert(pool.slabs == NULL && pool.slabCount == 0);
+    printf("test_pool_init passed\n");
+}
+
+/**
+ * Test that blocks are zeroed, aligned, distinct and recycled without new slabs.
+ */
+void test_pool_recycle() {
+    InstancePool_St pool;
+    instancePoolInit(&pool, 2000);
+    u32 n = pool.blocksPerSlab;
+
+    void* blocks[64];
+    assert(n <= 64);
+    for (u32 i = 0; i < n; ++i) {
+        blocks[i] = instancePoolAcquire(&pool);
+        assert(blocks[i] != NULL);
+        assert(((uintptr_t)blocks[i] % INSTANCE_POOL_ALIGN) == 0);
+        for (size_t b = 0; b < pool.blockSize; ++b) assert(((u8*)blocks[i])[b] == 0);
+        memset(blocks[i], 0xAB, pool.blockSize);
+        for (u32 j = 0; j < i; ++j) assert(blocks[j] != blocks[i]);
+    }
+    assert(pool.slabCount == 1 && pool.inUse == n);
+
+    // Churn: release and reacquire many times, the slab count must not move
+    for (int round = 0; round < 10000; ++round) {
+        u32 k = (u32)round % n;
+        instancePoolRelease(&pool, blocks[k]);
+        blocks[k] = instancePoolAcquire(&pool);
+        assert(((u8*)blocks[k])[pool.blockSize - 1] == 0);
+    }
+    assert(pool.slabCount == 1 && pool.inUse == n);
+
+    // One more block needs a second slab
+    void* extra = instancePoolAcquire(&pool);
+    assert(extra != NULL && pool.slabCount == 2 && pool.inUse == n + 1);
+
+    instancePoolDestroy(&pool);
+    assert(pool.slabCount == 0 && pool.inUse == 0);
+    printf("test_pool_recycle passed\n");
+}
+
+int main() {
+    test_pool_init();
+    test_pool_recycle();
+    printf("All instance pool tests passed!\n");
+    return 0;
+}
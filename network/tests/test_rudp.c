@@ -4,14 +4,22 @@
     @date 2026-04-14
     @date 2026-04-14
     @brief Unit tests for RUDP implementation.
+
+    The loss tests drive two connections over a simulated link (fixed one-way
+    delay, seeded random drops) with a fake clock, so they are deterministic
+    and run in milliseconds.
 */
 #include "rudp_core.h"
 #include "networkInterface.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <assert.h>
 #include <string.h>
 #include <arpa/inet.h>
 
+static u64 fakeNowUs = 0;
+static u64 fakeClock(void) { return fakeNowUs; }
+
 
 
 /** 
@@ -49,6 +57,7 @@ void test_rudp_process_incoming() {
     RUDPHeader_St h;
     memset(&h, 0, sizeof(h));
     h.sequence = htons(0);
+    h.messageSequence = h.sequence;
     h.action = ACTION_CODE_GAME_DATA;
 
     assert(rudpProcessIncoming(&conn, &h) == true);
@@ -60,36 +69,383 @@ void test_rudp_process_incoming() {
     
     // Test newer
     h.sequence = htons(1);
+    h.messageSequence = h.sequence;
     assert(rudpProcessIncoming(&conn, &h) == true);
     assert(conn.remote_sequence == 1);
+
+    // Resend of message 1 under a fresh sequence: acked, not delivered twice
+    h.sequence = htons(2);
+    assert(rudpProcessIncoming(&conn, &h) == false);
+    assert(conn.remote_sequence == 2 && (conn.receive_history & 1u) && conn.ackPending);
+
+    // Message 3 delayed: its resend is delivered, the late original is not
+    h.sequence = htons(4);
+    h.messageSequence = htons(3);
+    assert(rudpProcessIncoming(&conn, &h) == true);
+    h.sequence = htons(3);
+    assert(rudpProcessIncoming(&conn, &h) == false);
+    assert(conn.remote_sequence == 4 && (conn.receive_history & 1u));
     
     printf("test_rudp_process_incoming passed\n");
 }
 
 /**
- * Test rudpSendPacket sends a packet with the correct sequence and action.
+ * Test rudpTrackReliable keeps reliable packets until acked, and only them.
  */
 void test_rudp_send_packet() {
-    RUDPConnection_St conn;
-    rudpInitConnection(&conn);
-    
+    rudpSetClock(fakeClock);
+    fakeNowUs = 0;
+
+    RUDPConnection_St sender, receiver;
+    rudpInitConnection(&sender);
+    rudpInitConnection(&receiver);
+
+    u8 datagram[64];
     RUDPHeader_St h;
-    memset(&h, 0, sizeof(h));
-    h.sequence = htons(0);
-    h.action = ACTION_CODE_GAME_DATA;
 
-    rudpSendPacket(&conn, &h, NULL, 0);
-    assert(conn.local_sequence == 1);
+    // Unreliable: consumes a sequence number, nothing tracked
+    rudpGenerateHeader(&sender, ACTION_CODE_GAME_DATA, &h);
+    assert(sender.local_sequence == 1);
+    assert(rudpPendingCount(&sender) == 0);
+
+    // Reliable: tracked until the peer's header acknowledges it
+    rudpGenerateHeader(&sender, ACTION_CODE_GAME_DATA, &h);
+    memcpy(datagram, &h, sizeof(h));
+    assert(rudpTrackReliable(&sender, datagram, sizeof(h)) == true);
+    assert(rudpPendingCount(&sender) == 1);
+    assert(sender.sendWindow[0].capacity == sizeof(h));   // copy sized to the datagram
+
+    assert(rudpProcessIncoming(&receiver, &h) == true);
+    assert(receiver.ackPending == true);
+
+    fakeNowUs = 30000;
+    RUDPHeader_St ack;
+    rudpGenerateHeader(&receiver, RUDP_ACTION_ACK_ONLY, &ack);
+    assert(receiver.ackPending == false);
+    rudpProcessIncoming(&sender, &ack);
+    assert(rudpPendingCount(&sender) == 0);
+    assert(sender.srttUs == 30000);
+    assert(sender.ackPending == false);  // bare acks are never acked back
+    assert(receiver.local_sequence == 0); // ...and do not consume a sequence number
+
+    rudpReleaseConnection(&sender);
+    assert(sender.sendWindow[0].data == NULL);
+    rudpSetClock(NULL);
     printf("test_rudp_send_packet passed\n");
 }
 
 /**
- * Test rudpSendPacket sends a packet with the correct sequence and action.
+ * Test a bare ack sent after a lost reliable packet: it carries that packet's
+ * sequence number and must not make the peer reject the resend as a duplicate.
+ */
+void test_rudp_bare_ack_after_loss() {
+    rudpSetClock(fakeClock);
+    fakeNowUs = 0;
+
+    RUDPConnection_St client, server;
+    rudpInitConnection(&client);
+    rudpInitConnection(&server);
+
+    // Server -> client reliable data, lost on the way
+    RUDPHeader_St data;
+    rudpGenerateHeader(&server, ACTION_CODE_GAME_DATA, &data);
+    assert(rudpTrackReliable(&server, (const u8*)&data, sizeof(data)) == true);
+
+    // Server acks something of the client's: same sequence number as the lost data
+    RUDPHeader_St ack;
+    rudpGenerateHeader(&server, RUDP_ACTION_ACK_ONLY, &ack);
+    assert(ack.sequence == data.sequence);
+    assert(rudpProcessIncoming(&client, &ack) == true);
+    assert(client.remote_sequence == 65535 && client.receive_history == 0);
+    assert(client.ackPending == false);
+
+    // The client's next header must not ack the lost data...
+    RUDPHeader_St reply;
+    rudpGenerateHeader(&client, ACTION_CODE_GAME_DATA, &reply);
+    rudpProcessIncoming(&server, &reply);
+    assert(rudpPendingCount(&server) == 1);
+
+    // ...and the resend is accepted as new
+    fakeNowUs = RUDP_INITIAL_RTO_US;
+    RUDPHeader_St resent;
+    memcpy(&resent, server.sendWindow[0].data, sizeof(resent));
+    assert(rudpProcessIncoming(&client, &resent) == true);
+
+    rudpReleaseConnection(&server);
+    rudpSetClock(NULL);
+    printf("test_rudp_bare_ack_after_loss passed\n");
+}
+
+// ── Loss injection ──────────────────────────────────────────────
+
+#define SIM_ONE_WAY_US      15000u      ///< Link latency in each direction
+#define SIM_STEP_US         1000u       ///< Simulation resolution
+#define SIM_SEND_PERIOD_US  25000u      ///< One reliable message every 25 ms
+#define SIM_STREAM_PERIOD_US 1000u      ///< Unreliable stream mixed in: one header-only datagram per ms
+#define SIM_MESSAGES        400
+#define SIM_MAX_IN_FLIGHT   4096
+
+typedef struct {
+    u64 deliverAtUs;
+    bool toReceiver;
+    u16 length;
+    u8  data[64];
+} SimPacket_St;
+
+typedef struct {
+    SimPacket_St packets[SIM_MAX_IN_FLIGHT];
+    u32  count;
+    f32  lossRate;
+    bool toReceiver;    ///< Direction used by simSend()
+} SimLink_St;
+
+static void simSend(void* userData, const u8* data, u16 length) {
+    SimLink_St* link = (SimLink_St*)userData;
+    if ((f32)rand() / (f32)RAND_MAX < link->lossRate) return;
+    assert(link->count < SIM_MAX_IN_FLIGHT && length <= sizeof(link->packets[0].data));
+
+    SimPacket_St* p = &link->packets[link->count++];
+    p->deliverAtUs = fakeNowUs + SIM_ONE_WAY_US;
+    p->toReceiver  = link->toReceiver;
+    p->length      = length;
+    memcpy(p->data, data, length);
+}
+
+static int compareU64(const void* a, const void* b) {
+    u64 x = *(const u64*)a, y = *(const u64*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Sends SIM_MESSAGES reliable messages over a lossy link and checks every one arrives.
+ * Reports average and p99 delivery latency (first arrival - original send).
+ * A non-zero `streamPeriodUs` mixes in an unreliable stream on the same connection,
+ * which pushes dozens of sequence numbers past every lost reliable packet.
+ */
+static void runLossSimulation(f32 lossRate, u64 streamPeriodUs) {
+    rudpSetClock(fakeClock);
+    fakeNowUs = 0;
+    srand(1234);
+
+    static SimLink_St link;
+    memset(&link, 0, sizeof(link));
+    link.lossRate = lossRate;
+
+    RUDPConnection_St sender, receiver;
+    rudpInitConnection(&sender);
+    rudpInitConnection(&receiver);
+
+    u64 sentAt[SIM_MESSAGES];
+    u64 latency[SIM_MESSAGES];
+    bool delivered[SIM_MESSAGES] = {0};
+    u32 deliveredCount = 0, sentCount = 0;
+
+    while (deliveredCount < SIM_MESSAGES && fakeNowUs < 60u * 1000000u) {
+        // Sender: new message on schedule, then retransmissions
+        link.toReceiver = true;
+        if (sentCount < SIM_MESSAGES && fakeNowUs >= (u64)sentCount * SIM_SEND_PERIOD_US) {
+            RUDPHeader_St h;
+            rudpGenerateHeader(&sender, ACTION_CODE_GAME_DATA, &h);
+            u8 datagram[sizeof(h) + sizeof(u32)];
+            u32 messageId = htonl(sentCount);
+            memcpy(datagram, &h, sizeof(h));
+            memcpy(datagram + sizeof(h), &messageId, sizeof(messageId));
+            rudpTrackReliable(&sender, datagram, sizeof(datagram));
+            sentAt[sentCount++] = fakeNowUs;
+            simSend(&link, datagram, sizeof(datagram));
+        }
+        if (streamPeriodUs && fakeNowUs % streamPeriodUs == 0) {
+            RUDPHeader_St h;
+            rudpGenerateHeader(&sender, ACTION_CODE_GAME_DATA, &h);
+            simSend(&link, (const u8*)&h, sizeof(h));
+        }
+        rudpResendExpired(&sender, simSend, &link);
+
+        // Deliver everything due this step
+        for (u32 i = 0; i < link.count; ) {
+            SimPacket_St* p = &link.packets[i];
+            if (p->deliverAtUs > fakeNowUs) { ++i; continue; }
+
+            RUDPHeader_St h;
+            memcpy(&h, p->data, sizeof(h));
+            if (p->toReceiver) {
+                if (rudpProcessIncoming(&receiver, &h) && p->length > sizeof(h)) {
+                    u32 messageId;
+                    memcpy(&messageId, p->data + sizeof(h), sizeof(messageId));
+                    messageId = ntohl(messageId);
+                    assert(!delivered[messageId]);  // duplicates must be filtered
+                    delivered[messageId] = true;
+                    latency[messageId] = fakeNowUs - sentAt[messageId];
+                    deliveredCount++;
+                }
+            } else {
+                rudpProcessIncoming(&sender, &h);
+            }
+            link.packets[i] = link.packets[--link.count];
+        }
+
+        // Receiver: bare ack once per step when something arrived
+        if (receiver.ackPending) {
+            RUDPHeader_St ack;
+            rudpGenerateHeader(&receiver, RUDP_ACTION_ACK_ONLY, &ack);
+            link.toReceiver = false;
+            simSend(&link, (const u8*)&ack, sizeof(ack));
+        }
+
+        fakeNowUs += SIM_STEP_US;
+    }
+
+    assert(deliveredCount == SIM_MESSAGES);
+    assert(sender.packetsLost == 0);
+
+    u64 total = 0;
+    for (u32 i = 0; i < SIM_MESSAGES; ++i) total += latency[i];
+    qsort(latency, SIM_MESSAGES, sizeof(u64), compareU64);
+
+    f64 avgMs = (f64)total / SIM_MESSAGES / 1000.0;
+    f64 p99Ms = (f64)latency[SIM_MESSAGES * 99 / 100] / 1000.0;
+    printf("  loss %4.1f%%%s: avg %6.2f ms, p99 %7.2f ms, srtt %5.1f ms, rto %6.1f ms, %u resends\n",
+           lossRate * 100.0f, streamPeriodUs ? " + stream" : "", avgMs, p99Ms, sender.srttUs / 1000.0, sender.rtoUs / 1000.0,
+           sender.packetsRetransmitted);
+
+    // Loss-free delivery is one-way latency; retransmits should stay within a few RTOs
+    assert(latency[0] == SIM_ONE_WAY_US);
+    assert(p99Ms < 10.0 * (2.0 * SIM_ONE_WAY_US / 1000.0) + RUDP_MIN_RTO_US / 1000.0 * 8.0);
+
+    rudpReleaseConnection(&sender);
+    rudpSetClock(NULL);
+}
+
+/**
+ * One side of the bidirectional simulation: sends its own reliable messages
+ * and acks the other side's with bare acks.
+ */
+typedef struct {
+    RUDPConnection_St conn;
+    u64  sendPeriodUs;
+    u32  sentCount;
+    u32  deliveredCount;            ///< Messages of the other side received
+    bool delivered[SIM_MESSAGES];   ///< Indexed by the other side's message id
+} SimPeer_St;
+
+/**
+ * Both sides send SIM_MESSAGES reliable messages over a lossy link and both ack
+ * with bare acks, so bare acks and reliable data share each side's sequence space.
+ */
+static void runBidirectionalSimulation(f32 lossRate) {
+    rudpSetClock(fakeClock);
+    fakeNowUs = 0;
+    srand(4321);
+
+    static SimLink_St link;
+    memset(&link, 0, sizeof(link));
+    link.lossRate = lossRate;
+
+    static SimPeer_St peers[2];
+    memset(peers, 0, sizeof(peers));
+    peers[0].sendPeriodUs = SIM_SEND_PERIOD_US;
+    peers[1].sendPeriodUs = SIM_SEND_PERIOD_US + 10000u;
+    for (u32 s = 0; s < 2; ++s) rudpInitConnection(&peers[s].conn);
+
+    while ((peers[0].deliveredCount < SIM_MESSAGES || peers[1].deliveredCount < SIM_MESSAGES)
+           && fakeNowUs < 120u * 1000000u) {
+        for (u32 s = 0; s < 2; ++s) {
+            SimPeer_St* peer = &peers[s];
+            link.toReceiver = s == 0;   // toReceiver: towards peer 1
+
+            if (peer->sentCount < SIM_MESSAGES && fakeNowUs >= (u64)peer->sentCount * peer->sendPeriodUs) {
+                RUDPHeader_St h;
+                rudpGenerateHeader(&peer->conn, ACTION_CODE_GAME_DATA, &h);
+                u8 datagram[sizeof(h) + sizeof(u32)];
+                u32 messageId = htonl(peer->sentCount++);
+                memcpy(datagram, &h, sizeof(h));
+                memcpy(datagram + sizeof(h), &messageId, sizeof(messageId));
+                rudpTrackReliable(&peer->conn, datagram, sizeof(datagram));
+                simSend(&link, datagram, sizeof(datagram));
+            }
+            rudpResendExpired(&peer->conn, simSend, &link);
+        }
+
+        for (u32 i = 0; i < link.count; ) {
+            SimPacket_St* p = &link.packets[i];
+            if (p->deliverAtUs > fakeNowUs) { ++i; continue; }
+
+            SimPeer_St* peer = &peers[p->toReceiver ? 1 : 0];
+            RUDPHeader_St h;
+            memcpy(&h, p->data, sizeof(h));
+            if (rudpProcessIncoming(&peer->conn, &h) && h.action != RUDP_ACTION_ACK_ONLY) {
+                u32 messageId;
+                memcpy(&messageId, p->data + sizeof(h), sizeof(messageId));
+                messageId = ntohl(messageId);
+                assert(!peer->delivered[messageId]);
+                peer->delivered[messageId] = true;
+                peer->deliveredCount++;
+            }
+            link.packets[i] = link.packets[--link.count];
+        }
+
+        for (u32 s = 0; s < 2; ++s) {
+            if (!peers[s].conn.ackPending) continue;
+            RUDPHeader_St ack;
+            rudpGenerateHeader(&peers[s].conn, RUDP_ACTION_ACK_ONLY, &ack);
+            link.toReceiver = s == 0;
+            simSend(&link, (const u8*)&ack, sizeof(ack));
+        }
+
+        fakeNowUs += SIM_STEP_US;
+    }
+
+    for (u32 s = 0; s < 2; ++s) {
+        assert(peers[s].deliveredCount == SIM_MESSAGES);
+        assert(peers[s].conn.packetsLost == 0);
+    }
+    printf("  loss %4.1f%%: both ways delivered, %u + %u resends\n", lossRate * 100.0f,
+           peers[0].conn.packetsRetransmitted, peers[1].conn.packetsRetransmitted);
+
+    for (u32 s = 0; s < 2; ++s) rudpReleaseConnection(&peers[s].conn);
+    rudpSetClock(NULL);
+}
+
+/**
+ * Test reliable delivery and latency under 0-20% random loss in both directions.
+ */
+void test_rudp_loss_injection() {
+    const f32 rates[] = { 0.0f, 0.05f, 0.10f, 0.20f };
+    for (u32 i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) runLossSimulation(rates[i], 0);
+    printf("test_rudp_loss_injection passed\n");
+}
+
+/**
+ * Test reliable delivery under loss while a 1 kHz unreliable stream shares the
+ * connection: a resend goes out long after 32 newer packets and must still land.
+ */
+void test_rudp_loss_with_stream() {
+    const f32 rates[] = { 0.05f, 0.10f, 0.20f };
+    for (u32 i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) runLossSimulation(rates[i], SIM_STREAM_PERIOD_US);
+    printf("test_rudp_loss_with_stream passed\n");
+}
+
+/**
+ * Test reliable delivery both ways under 0-20% random loss, bare acks included.
+ */
+void test_rudp_bidirectional_loss() {
+    const f32 rates[] = { 0.0f, 0.05f, 0.10f, 0.20f };
+    for (u32 i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) runBidirectionalSimulation(rates[i]);
+    printf("test_rudp_bidirectional_loss passed\n");
+}
+
+/**
+ * Runs every RUDP test.
  */
 int main() {
     test_rudp_init();
     test_rudp_header_gen();
     test_rudp_process_incoming();
+    test_rudp_send_packet();
+    test_rudp_bare_ack_after_loss();
+    test_rudp_loss_injection();
+    test_rudp_loss_with_stream();
+    test_rudp_bidirectional_loss();
     printf("All RUDP tests passed!\n");
     return 0;
 }
@@ -0,0 +1,173 @@
+/**
+    @file test_snapshotDelta.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Unit tests for the snapshot / delta sync codec.
+*/
+#include "snapshotDelta.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <arpa/inet.h>
+#include <string.h>
+
+#define SNAP_SIZE 1000
+
+static u8 serverFrames[SNAPSHOT_HISTORY * SNAP_SIZE];
+static u8 clientFrames[SNAPSHOT_HISTORY * SNAP_SIZE];
+static u8 wire[SNAPSHOT_MAX_ENCODED(SNAP_SIZE)];
+
+/**
+ * Test that the first message is a keyframe and a one-byte change costs a few bytes.
+ */
+void test_snapshot_keyframe_then_delta() {
+    SnapshotHistory_St server, client;
+    snapshotHistoryInit(&server, serverFrames, SNAP_SIZE);
+    snapshotHistoryInit(&client, clientFrames, SNAP_SIZE);
+    u16 acked = SNAPSHOT_SEQ_NONE;
+
+    u8 state[SNAP_SIZE], decoded[SNAP_SIZE];
+    for (int i = 0; i < SNAP_SIZE; ++i) state[i] = (u8)(i * 7 + 1);
+
+    u16 seq = snapshotPush(&server, state);
+    u16 len = snapshotEncode(&server, seq, acked, wire, sizeof(wire));
+    assert(len > SNAP_SIZE);
+    SnapshotHeader_St header;
+    memcpy(&header, wire, sizeof(header));
+    assert(ntohs(header.baseSeq) == SNAPSHOT_SEQ_NONE);
+
+    u16 gotSeq;
+    assert(snapshotDecode(&client, wire, len, decoded, &gotSeq) == SNAPSHOT_APPLIED);
+    assert(gotSeq == seq && memcmp(decoded, state, SNAP_SIZE) == 0);
+    snapshotOnAck(&acked, gotSeq);
+
+    state[200] ^= 0x5A;
+    seq = snapshotPush(&server, state);
+    len = snapshotEncode(&server, seq, acked, wire, sizeof(wire));
+    assert(len == sizeof(SnapshotHeader_St) + 3);
+    assert(snapshotDecode(&client, wire, len, decoded, &gotSeq) == SNAPSHOT_APPLIED);
+    assert(memcmp(decoded, state, SNAP_SIZE) == 0);
+
+    // Unchanged state: header only
+    seq = snapshotPush(&server, state);
+    len = snapshotEncode(&server, seq, gotSeq, wire, sizeof(wire));
+    assert(len == sizeof(SnapshotHeader_St));
+    assert(snapshotDecode(&client, wire, len, decoded, &gotSeq) == SNAPSHOT_APPLIED);
+    assert(memcmp(decoded, state, SNAP_SIZE) == 0);
+
+    // Replayed message is stale
+    assert(snapshotDecode(&client, wire, len, decoded, &gotSeq) == SNAPSHOT_STALE);
+    printf("test_snapshot_keyframe_then_delta passed\n");
+}
+
+/**
+ * Test the keyframe fallbacks: baseline out of the history, unknown baseline on the client.
+ */
+void test_snapshot_fallbacks() {
+    SnapshotHistory_St server, client;
+    snapshotHistoryInit(&server, serverFrames, SNAP_SIZE);
+    snapshotHistoryInit(&client, clientFrames, SNAP_SIZE);
+
+    u8 state[SNAP_SIZE], decoded[SNAP_SIZE];
+    memset(state, 0, sizeof(state));
+    u16 first = snapshotPush(&server, state);
+
+    for (int i = 0; i < SNAPSHOT_HISTORY; ++i) {
+        state[i] = (u8)(i + 1);
+        snapshotPush(&server, state);
+    }
+    u16 seq = server.lastSeq;
+
+    // Client acked `first` long ago, it has been overwritten: keyframe
+    u16 len = snapshotEncode(&server, seq, first, wire, sizeof(wire));
+    SnapshotHeader_St header;
+    memcpy(&header, wire, sizeof(header));
+    assert(ntohs(header.baseSeq) == SNAPSHOT_SEQ_NONE);
+    u16 gotSeq;
+    assert(snapshotDecode(&client, wire, len, decoded, &gotSeq) == SNAPSHOT_APPLIED);
+    assert(memcmp(decoded, state, SNAP_SIZE) == 0);
+
+    // Delta against a baseline the client never received
+    SnapshotHistory_St fresh;
+    static u8 freshFrames[SNAPSHOT_HISTORY * SNAP_SIZE];
+    snapshotHistoryInit(&fresh, freshFrames, SNAP_SIZE);
+    len = snapshotEncode(&server, seq, (u16)(seq - 1), wire, sizeof(wire));
+    assert(snapshotDecode(&fresh, wire, len, decoded, &gotSeq) == SNAPSHOT_NEED_KEYFRAME);
+
+    // Truncated or mis-sized messages
+    assert(snapshotDecode(&fresh, wire, 3, decoded, &gotSeq) == SNAPSHOT_NEED_KEYFRAME);
+    static u8 otherFrames[SNAPSHOT_HISTORY * 10];
+    SnapshotHistory_St other;
+    snapshotHistoryInit(&other, otherFrames, 10);
+    assert(snapshotDecode(&other, wire, len, decoded, &gotSeq) == SNAPSHOT_NEED_KEYFRAME);
+    printf("test_snapshot_fallbacks passed\n");
+}
+
+/**
+ * Test ack ordering across the u16 wrap and the keyframe request.
+ */
+void test_snapshot_acks() {
+    u16 acked = SNAPSHOT_SEQ_NONE;
+    snapshotOnAck(&acked, 65534);
+    snapshotOnAck(&acked, 2);
+    assert(acked == 2);
+    snapshotOnAck(&acked, 65535);
+    assert(acked == 2);
+    snapshotOnAck(&acked, SNAPSHOT_SEQ_NONE);
+    assert(acked == SNAPSHOT_SEQ_NONE);
+
+    SnapshotHistory_St server;
+    snapshotHistoryInit(&server, serverFrames, SNAP_SIZE);
+    server.lastSeq = 65535;
+    u8 state[SNAP_SIZE] = {0};
+    assert(snapshotPush(&server, state) == 1);
+    printf("test_snapshot_acks passed\n");
+}
+
+/**
+ * Test random edits over many frames with random acks, including the worst-case pattern.
+ */
+void test_snapshot_fuzz() {
+    SnapshotHistory_St server, client;
+    snapshotHistoryInit(&server, serverFrames, SNAP_SIZE);
+    snapshotHistoryInit(&client, clientFrames, SNAP_SIZE);
+    u16 acked = SNAPSHOT_SEQ_NONE;
+    srand(1234);
+
+    u8 state[SNAP_SIZE], decoded[SNAP_SIZE];
+    memset(state, 0, sizeof(state));
+    for (int round = 0; round < 20000; ++round) {
+        if (round % 1000 == 999) {
+            for (int i = 0; i < SNAP_SIZE; ++i) state[i] = (i % 3 == 0) ? (u8)(rand() | 1) : 0;
+        } else {
+            int edits = rand() % 16;
+            for (int e = 0; e < edits; ++e) state[rand() % SNAP_SIZE] = (u8)rand();
+        }
+
+        u16 seq = snapshotPush(&server, state);
+        u16 len = snapshotEncode(&server, seq, acked, wire, sizeof(wire));
+        assert(len > 0 && len <= sizeof(wire));
+
+        // Drop a quarter of the messages and half of the acks
+        if (rand() % 4 == 0) continue;
+        u16 gotSeq;
+        SnapshotDecodeResult_Et res = snapshotDecode(&client, wire, len, decoded, &gotSeq);
+        if (res == SNAPSHOT_NEED_KEYFRAME) {
+            snapshotOnAck(&acked, SNAPSHOT_SEQ_NONE);
+            continue;
+        }
+        assert(res == SNAPSHOT_APPLIED);
+        assert(memcmp(decoded, state, SNAP_SIZE) == 0);
+        if (rand() % 2) snapshotOnAck(&acked, gotSeq);
+    }
+    printf("test_snapshot_fuzz passed\n");
+}
+
+int main() {
+    test_snapshot_keyframe_then_delta();
+    test_snapshot_fallbacks();
+    test_snapshot_acks();
+    test_snapshot_fuzz();
+    printf("All snapshot delta tests passed!\n");
+    return 0;
+}
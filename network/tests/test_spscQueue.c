@@ -0,0 +1,128 @@
+/**
+    @file test_spscQueue.c
+    @author Multi Mini-Games Team
+    @date 2026-10-17
+    @brief Unit tests for the lock-free SPSC queue.
+
+    The threaded test pushes a long numbered sequence through a small ring
+    so producer and consumer constantly hit the full/empty edges; any lost,
+    duplicated or reordered slot fails the checksum or the order check.
+*/
+#include "spscQueue.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define THREADED_MESSAGES 2000000u
+
+typedef struct {
+    u32 index;
+    u32 check;
+    u8  filler[56];
+} TestSlot_St;
+
+/**
+ * Test capacity rounding, full/empty detection and FIFO order on one thread.
+ */
+void test_spsc_single_thread() {
+    SPSCQueue_St q;
+    assert(spscInit(&q, 5, sizeof(u32)));
+    assert(q.mask == 7);
+    assert(spscPeek(&q) == NULL);
+
+    for (u32 i = 0; i < 8; ++i) {
+        u32* slot = spscBeginPush(&q);
+        assert(slot != NULL);
+        *slot = i;
+        spscCommitPush(&q);
+    }
+    assert(spscBeginPush(&q) == NULL);
+    assert(spscSize(&q) == 8);
+
+    for (u32 i = 0; i < 8; ++i) {
+        u32* slot = spscPeek(&q);
+        assert(slot != NULL && *slot == i);
+        spscPop(&q);
+    }
+    assert(spscPeek(&q) == NULL);
+    assert(spscSize(&q) == 0);
+
+    spscDestroy(&q);
+    printf("test_spsc_single_thread passed\n");
+}
+
+/**
+ * Test that indices keep working across the 2^32 wrap.
+ */
+void test_spsc_index_wrap() {
+    SPSCQueue_St q;
+    assert(spscInit(&q, 4, sizeof(u32)));
+    atomic_store(&q.head, 0xFFFFFFFEu);
+    atomic_store(&q.tail, 0xFFFFFFFEu);
+    q.cachedHead = q.cachedTail = 0xFFFFFFFEu;
+
+    for (u32 i = 0; i < 4; ++i) {
+        u32* slot = spscBeginPush(&q);
+        assert(slot != NULL);
+        *slot = i;
+        spscCommitPush(&q);
+    }
+    assert(spscBeginPush(&q) == NULL);
+    for (u32 i = 0; i < 4; ++i) {
+        u32* slot = spscPeek(&q);
+        assert(slot != NULL && *slot == i);
+        spscPop(&q);
+    }
+    assert(spscPeek(&q) == NULL);
+
+    spscDestroy(&q);
+    printf("test_spsc_index_wrap passed\n");
+}
+
+static void* producerThread(void* arg) {
+    SPSCQueue_St* q = arg;
+    for (u32 i = 0; i < THREADED_MESSAGES; ++i) {
+        TestSlot_St* slot;
+        while ((slot = spscBeginPush(q)) == NULL) sched_yield();
+        slot->index = i;
+        slot->check = i * 2654435761u;
+        memset(slot->filler, (int)(i & 0xFF), sizeof(slot->filler));
+        spscCommitPush(q);
+    }
+    return NULL;
+}
+
+/**
+ * Test one producer and one consumer thread hammering a 16-slot ring.
+ */
+void test_spsc_threaded() {
+    SPSCQueue_St q;
+    assert(spscInit(&q, 16, sizeof(TestSlot_St)));
+
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, producerThread, &q) == 0);
+
+    for (u32 expected = 0; expected < THREADED_MESSAGES; ++expected) {
+        TestSlot_St* slot;
+        while ((slot = spscPeek(&q)) == NULL) sched_yield();
+        assert(slot->index == expected);
+        assert(slot->check == expected * 2654435761u);
+        assert(slot->filler[0] == (u8)(expected & 0xFF) && slot->filler[55] == (u8)(expected & 0xFF));
+        spscPop(&q);
+    }
+
+    pthread_join(producer, NULL);
+    assert(spscPeek(&q) == NULL);
+    spscDestroy(&q);
+    printf("test_spsc_threaded passed (%u messages)\n", THREADED_MESSAGES);
+}
+
+int main() {
+    test_spsc_single_thread();
+    test_spsc_index_wrap();
+    test_spsc_threaded();
+    printf("All SPSC queue tests passed!\n");
+    return 0;
+}